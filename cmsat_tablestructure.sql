@@ -15,6 +15,21 @@ CREATE TABLE `timepassed` (
   `percenttimeremain` float DEFAULT NULL
 );
 
+DROP TABLE IF EXISTS `inprocess`;
+CREATE TABLE `inprocess` (
+  `simplifications` bigint(20) NOT NULL,
+  `conflicts` bigint(20) NOT NULL,
+  `runtime` float NOT NULL,
+  `name` varchar(200) NOT NULL,
+  `elapsed` float NOT NULL,
+  `bogoprops` bigint(20) NOT NULL,
+  `vars_removed` bigint(20) NOT NULL,
+  `cls_removed` bigint(20) NOT NULL,
+  `lits_removed` bigint(20) NOT NULL,
+  `units` bigint(20) NOT NULL,
+  `budget_mult` float NOT NULL
+);
+
 DROP TABLE IF EXISTS `memused`;
 CREATE TABLE `memused` (
   `simplifications` bigint(20) NOT NULL,
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2020  Mate Soos
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; version 2
+# of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+# 02110-1301, USA.
+
+
+# Compiles the XGBoost models written by cldata_predict.py (booster.save_model()
+# JSON files) into C++ tables. Every tree is padded to a complete binary tree
+# of the depth of the deepest tree, so evaluation is a fixed number of
+# branch-free steps per tree, see src/compiledforest.h
+
+import argparse
+import json
+import sys
+
+
+def load_trees(fname):
+    with open(fname, "r") as f:
+        model = json.load(f)
+
+    learner = model["learner"]
+    objective = learner["objective"]["name"]
+    if objective != "reg:squarederror":
+        print("ERROR: only reg:squarederror models are supported, '%s' is %s"
+              % (fname, objective))
+        exit(-1)
+
+    base_score = float(learner["learner_model_param"]["base_score"])
+    num_feature = int(learner["learner_model_param"]["num_feature"])
+    trees = learner["gradient_booster"]["model"]["trees"]
+    return base_score, num_feature, trees
+
+
+def tree_depth(tree, node=0):
+    left = tree["left_children"][node]
+    if left == -1:
+        return 0
+    right = tree["right_children"][node]
+    return 1 + max(tree_depth(tree, left), tree_depth(tree, right))
+
+
+def pad_tree(tree, depth):
+    """Returns (internal nodes, leaves) of the complete tree of given depth.
+    Internal nodes are (feature, threshold, default_left), in BFS order."""
+    num_internal = (1 << depth) - 1
+    internal = [(0, 0.0, 1)] * num_internal
+    leaves = [0.0] * (1 << depth)
+
+    # (complete tree position, original node or leaf value)
+    todo = [(0, 0)]
+    while todo:
+        pos, node = todo.pop()
+        left = tree["left_children"][node]
+        if left == -1:
+            # A leaf above the last level: every leaf below it gets its value
+            value = tree["split_conditions"][node]
+            first = pos
+            num = 1
+            while first < num_internal:
+                first = 2*first + 1
+                num *= 2
+            for i in range(num):
+                leaves[first - num_internal + i] = value
+            continue
+
+        internal[pos] = (tree["split_indices"][node],
+                         tree["split_conditions"][node],
+                         tree["default_left"][node])
+        todo.append((2*pos + 1, left))
+        todo.append((2*pos + 2, tree["right_children"][node]))
+
+    return internal, leaves
+
+
+def fmt_float(x):
+    s = "%.9g" % x
+    if "." not in s and "e" not in s:
+        s += ".0"
+    return s + "f"
+
+
+def write_array(f, ctype, name, vals, per_line=8):
+    f.write("static const %s %s[] = {\n" % (ctype, name))
+    for i in range(0, len(vals), per_line):
+        f.write("    " + ", ".join(vals[i:i+per_line]) + ",\n")
+    f.write("};\n\n")
+
+
+def write_model(f, name, fname):
+    base_score, num_feature, trees = load_trees(fname)
+    depth = max([tree_depth(t) for t in trees] + [1])
+    if depth > 16:
+        print("ERROR: tree depth %d too large to pad in '%s'" % (depth, fname))
+        exit(-1)
+
+    feats = []
+    thrs = []
+    def_left = []
+    leaves = []
+    for t in trees:
+        internal, l = pad_tree(t, depth)
+        for feat, thr, dl in internal:
+            assert feat < num_feature
+            feats.append(str(feat))
+            thrs.append(fmt_float(thr))
+            def_left.append(str(int(dl)))
+        leaves.extend([fmt_float(x) for x in l])
+
+    f.write("// %s: %d trees of depth %d, from %s\n"
+            % (name, len(trees), depth, fname))
+    write_array(f, "uint16_t", "%s_feat" % name, feats, 16)
+    write_array(f, "float", "%s_thr" % name, thrs)
+    write_array(f, "uint8_t", "%s_def_left" % name, def_left, 32)
+    write_array(f, "float", "%s_leaf" % name, leaves)
+    f.write("static const uint32_t %s_num_features = %d;\n" % (name, num_feature))
+    f.write("static const CompiledForest %s = {\n" % name)
+    f.write("    %d, %d, %s\n" % (len(trees), depth, fmt_float(base_score)))
+    f.write("    , %s_feat, %s_thr, %s_def_left, %s_leaf\n" % ((name,)*4))
+    f.write("};\n\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Compile XGBoost clause predictor models into C++")
+    parser.add_argument("short", help="predictor_short.json")
+    parser.add_argument("long", help="predictor_long.json")
+    parser.add_argument("forever", help="predictor_forever.json")
+    parser.add_argument("out", help="Header to write, e.g. cl_predictors_models.h")
+    options = parser.parse_args()
+
+    with open(options.out, "w") as f:
+        f.write("// Generated by scripts/crystal/xgboost_codegen.py, do not edit\n\n")
+        f.write("#ifndef __CL_PREDICTORS_MODELS_H__\n")
+        f.write("#define __CL_PREDICTORS_MODELS_H__\n\n")
+        f.write("#include \"compiledforest.h\"\n\n")
+        f.write("namespace CMSat {\n\n")
+        write_model(f, "compiled_short", options.short)
+        write_model(f, "compiled_long", options.long)
+        write_model(f, "compiled_forever", options.forever)
+        f.write("}\n\n#endif\n")
+
+    print("Wrote models to %s" % options.out)
@@ -0,0 +1,64 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2018, Mate Soos
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Runs a distributed solve on this host: one coordinator and N worker
+# processes, each worker with a different random seed. Prints the
+# coordinator's output and exits with its exit code (10: SAT, 20: UNSAT).
+# Example:
+#   ./run_local.py --workers 4 -- ../../build/cryptominisat5 hard.cnf
+# Everything after "--" is the worker's command line; the coordinator runs
+# the same executable.
+
+from __future__ import print_function
+import argparse
+import subprocess
+import sys
+
+parser = argparse.ArgumentParser(description="Distributed solve on localhost")
+parser.add_argument("--workers", type=int, default=2, help="Number of worker processes")
+parser.add_argument("--port", type=int, default=5100, help="TCP port of the coordinator")
+parser.add_argument("--verb", type=int, default=1, help="Verbosity of the coordinator")
+parser.add_argument("--workerverb", type=int, default=0, help="Verbosity of the workers")
+parser.add_argument("cmd", nargs=argparse.REMAINDER, help="-- EXECUTABLE [OPTIONS] CNF")
+args = parser.parse_args()
+
+cmd = [c for c in args.cmd if c != "--"]
+if len(cmd) < 2:
+    parser.error("give the executable and the CNF after '--'")
+
+exe = cmd[0]
+coord = subprocess.Popen([
+    exe, "--distcoord", str(args.workers), "--distport", str(args.port),
+    "--verb", str(args.verb)])
+
+workers = []
+for i in range(args.workers):
+    workers.append(subprocess.Popen(
+        cmd + ["--distworker", "127.0.0.1", "--distport", str(args.port),
+               "--random", str(i), "--verb", str(args.workerverb)],
+        stdout=subprocess.DEVNULL if args.workerverb == 0 else None))
+
+ret = coord.wait()
+for w in workers:
+    w.wait()
+sys.exit(ret)
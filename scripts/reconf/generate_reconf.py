@@ -95,9 +95,6 @@ for i in range(num):
 subprocess.call("./tocpp.py -i %s -n %d > ../../src/satzilla_features_to_reconf.cpp" % (ignore, num),
                 shell=True)
 
-subprocess.call("sed -i 's/red-/red_cl_distrib./g' ../../src/satzilla_features_to_reconf.cpp",
-                shell=True)
-
 upload = query_yes_no("Upload to AWS?")
 if upload:
     subprocess.call("aws s3 cp ../../src/satzilla_features_to_reconf.cpp s3://msoos-solve-data/solvers/", shell=True)
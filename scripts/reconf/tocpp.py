@@ -44,83 +44,27 @@ if options.num is None:
     print("ERROR: You must give the number of reconfs")
     exit(-1)
 
-print("""/******************************************
-Copyright (c) 2016, Mate Soos
+class Rule:
+    def __init__(self, plus, confidence):
+        self.plus = plus
+        self.confidence = confidence
+        self.conds = []
 
-Permission is hereby granted, free of charge, to any person obtaining a copy
-of this software and associated documentation files (the "Software"), to deal
-in the Software without restriction, including without limitation the rights
-to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-copies of the Software, and to permit persons to whom the Software is
-furnished to do so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in
-all copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
-THE SOFTWARE.
-***********************************************/
 
-#include "satzilla_features.h"
-#include <iostream>
-using std::cout;
-using std::endl;
-
-namespace CMSat {
-""")
-
-for i in range(options.num):
-    if i not in ignore:
-        print("double get_score%d(const SatZillaFeatures& satzilla_feat, const int verb);" % i)
-
-print("""
-int get_reconf_from_satzilla_features(const SatZillaFeatures& satzilla_feat, const int verb)
-{
-\tdouble best_score = 0.0;
-\tint best_val = 0;
-\tdouble score;
-""")
-
-for i in range(options.num):
-    if i in ignore:
-        continue
-
-    print("""
-\tscore = get_score%d(satzilla_feat, verb);
-\tif (verb >= 2)
-\t\tcout << "c Score for reconf %d is " << score << endl;
-\tif (best_score < score) {
-\t\tbest_score = score;
-\t\tbest_val = %d;
-\t}
-""" % (i, i, i))
-
-print("""
-\tif (verb >= 2)
-\t\tcout << "c Winning reconf is " << best_val << endl;
-\treturn best_val;
-}
-
-""")
+class Model:
+    def __init__(self, reconf):
+        self.reconf = reconf
+        self.default = None
+        self.rules = []
 
 
 def read_one_reconf(reconf_num):
     sys.stderr.write("Parsing reconf num %d\n" % reconf_num)
     f = open("outs/out%d.rules" % reconf_num)
+    model = Model(reconf_num)
     num_conds = 0
-    cond_no = 0
     num_rules = 0
-    rule_no = 0
-    string = ""
-
-    print("""
-double get_score%d(const SatZillaFeatures& satzilla_feat, const int verb)
-{""" % reconf_num)
+    rule = None
     for line in f:
         if "id=" in line:
             continue
@@ -134,11 +78,10 @@ double get_score%d(const SatZillaFeatures& satzilla_feat, const int verb)
             dat[elems[0]] = elems[1]
 
         if "conds" in dat:
-            assert num_conds == cond_no
+            assert rule is None or len(rule.conds) == num_conds
             num_conds = int(dat["conds"])
-            rule_class = dat["class"]
-            cond_no = 0
-            confidence = float(dat["confidence"])
+            rule = Rule(dat["class"] == "+", float(dat["confidence"]))
+            model.rules.append(rule)
             continue
 
         if "entries" in dat:
@@ -148,61 +91,181 @@ double get_score%d(const SatZillaFeatures& satzilla_feat, const int verb)
             num_rules = int(dat["rules"])
 
         if "default" in dat:
-            default = dat["default"]
-            if default == "+":
-                print("\tdouble default_val = %.2f;\n" % (1.0))
-            else:
-                print("\tdouble default_val = %.2f;\n" % (0.0))
-
-            print("\tdouble total_plus = 0.0;")
-            print("\tdouble total_neg = 0.0;")
+            model.default = dat["default"]
             continue
 
         # process rules
-        if cond_no == 0:
-            string = "\tif ("
-        else:
-            string += " &&\n\t\t"
-
-        string += "(satzilla_feat.%s %s %.5f)" % (dat["att"], dat["result"],
-                                         float(dat["cut"]))
-        cond_no += 1
-
-        # end rules
-        if cond_no == num_conds:
-            string += ")\n\t{"
-            print(string)
-
-            string = ""
-            if rule_class == "+":
-                string += "\t\ttotal_plus += %.3f;" % confidence
-            else:
-                string += "\t\ttotal_neg += %.3f;" % confidence
-
-            print(string)
-            print("\t}")
-            rule_no += 1
-
-    print("\t// num_rules:", num_rules)
-    print("\t// rule_no:", rule_no)
-    sys.stderr.write("num rules: %s rule_no: %s\n" % (num_rules, rule_no))
-    assert num_rules == rule_no
-    print("\t// default is:", default)
-    print("""
-\tif (total_plus == 0.0 && total_neg == 0.0) {
-\t\treturn default_val;
+        # "red-X" and "irred-X" are the clause distribution features
+        att = dat["att"].replace("red-", "red_cl_distrib.")
+        assert dat["result"] in ["<", ">"]
+        rule.conds.append((att, dat["result"], float(dat["cut"])))
+
+    sys.stderr.write("num rules: %s rule_no: %s\n" % (num_rules, len(model.rules)))
+    assert num_rules == len(model.rules)
+    assert model.default is not None
+    return model
+
+
+def feat_enum(att):
+    return "reconf_feat_" + att.replace(".", "_")
+
+
+models = []
+for i in range(options.num):
+    if i not in ignore:
+        models.append(read_one_reconf(i))
+
+# only the features the rules use are collected
+feats = []
+for model in models:
+    for rule in model.rules:
+        for att, _, _ in rule.conds:
+            if att not in feats:
+                feats.append(att)
+
+print("""/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+// Generated by scripts/reconf/tocpp.py, do not edit
+
+#include "satzilla_features.h"
+#include "satzilla_features_to_reconf.h"
+#include <iostream>
+using std::cout;
+using std::endl;
+
+namespace CMSat {
+
+enum ReconfFeature {""")
+for i, att in enumerate(feats):
+    print("\t%s = %d," % (feat_enum(att), i))
+print("""\treconf_feat_num = %d
+};
+
+struct ReconfCond {
+\tint feat;
+\tbool less;
+\tdouble cut;
+};
+
+struct ReconfRule {
+\tint first_cond;
+\tint num_conds;
+\tbool plus;
+\tdouble confidence;
+};
+
+struct ReconfModel {
+\tint reconf;
+\tdouble default_val;
+\tint first_rule;
+\tint num_rules;
+};
+""" % len(feats))
+
+conds = []
+rules = []
+model_lines = []
+for model in models:
+    first_rule = len(rules)
+    for rule in model.rules:
+        rules.append("\t{%d, %d, %s, %.3f}" % (
+            len(conds), len(rule.conds),
+            "true" if rule.plus else "false", rule.confidence))
+        for att, result, cut in rule.conds:
+            conds.append("\t{%s, %s, %.5f}" % (
+                feat_enum(att), "true" if result == "<" else "false", cut))
+
+    model_lines.append("\t{%d, %.2f, %d, %d}" % (
+        model.reconf, 1.0 if model.default == "+" else 0.0,
+        first_rule, len(model.rules)))
+
+print("static constexpr ReconfCond reconf_conds[] = {")
+print(",\n".join(conds))
+print("};\n")
+print("static constexpr ReconfRule reconf_rules[] = {")
+print(",\n".join(rules))
+print("};\n")
+print("static constexpr ReconfModel reconf_models[] = {")
+print(",\n".join(model_lines))
+print("};\n")
+
+print("""static void get_reconf_features(const SatZillaFeatures& satzilla_feat, double* vals)
+{""")
+for att in feats:
+    print("\tvals[%s] = satzilla_feat.%s;" % (feat_enum(att), att))
+print("""}
+
+static double get_score(const ReconfModel& model, const double* vals)
+{
+\tdouble total_plus = 0.0;
+\tdouble total_neg = 0.0;
+\tfor(int r = model.first_rule; r < model.first_rule + model.num_rules; r++) {
+\t\tconst ReconfRule& rule = reconf_rules[r];
+\t\tbool fires = true;
+\t\tfor(int c = rule.first_cond; c < rule.first_cond + rule.num_conds; c++) {
+\t\t\tconst ReconfCond& cond = reconf_conds[c];
+\t\t\tconst double val = vals[cond.feat];
+\t\t\tif (cond.less ? !(val < cond.cut) : !(val > cond.cut)) {
+\t\t\t\tfires = false;
+\t\t\t\tbreak;
+\t\t\t}
+\t\t}
+\t\tif (!fires) {
+\t\t\tcontinue;
+\t\t}
+\t\tif (rule.plus) {
+\t\t\ttotal_plus += rule.confidence;
+\t\t} else {
+\t\t\ttotal_neg += rule.confidence;
+\t\t}
 \t}
-\tif (verb >= 2) {
-\t\t//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
+
+\tif (total_plus == 0.0 && total_neg == 0.0) {
+\t\treturn model.default_val;
 \t}
 \treturn total_plus - total_neg;
 }
-""")
 
+int get_reconf_from_satzilla_features(const SatZillaFeatures& satzilla_feat, const int verb)
+{
+\tdouble vals[reconf_feat_num];
+\tget_reconf_features(satzilla_feat, vals);
 
-for i in range(options.num):
-    if i not in ignore:
-        read_one_reconf(i)
+\tdouble best_score = 0.0;
+\tint best_val = 0;
+\tfor(const ReconfModel& model: reconf_models) {
+\t\tconst double score = get_score(model, vals);
+\t\tif (verb >= 2)
+\t\t\tcout << "c Score for reconf " << model.reconf << " is " << score << endl;
+\t\tif (best_score < score) {
+\t\t\tbest_score = score;
+\t\t\tbest_val = model.reconf;
+\t\t}
+\t}
+
+\tif (verb >= 2)
+\t\tcout << "c Winning reconf is " << best_val << endl;
+\treturn best_val;
+}
 
-print("""
 } //end namespace""")
@@ -0,0 +1,108 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2018, Mate Soos
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Compares two JSON outputs of "cmsat-bench --macro" and reports the change of
+# the throughput numbers of every instance. Exits with 1 if any of them got
+# worse by more than --threshold percent. Example:
+#   cmsat-bench --macro --json before.json
+#   (rebuild)
+#   cmsat-bench --macro --json after.json
+#   ./compare_bench.py before.json after.json
+
+from __future__ import print_function
+import argparse
+import json
+import sys
+
+# (key, True if higher is better)
+METRICS = [
+    ("props_per_sec", True),
+    ("conflicts_per_sec", True),
+    ("parse_mb_per_sec", True),
+    ("clause_bytes_per_clause", False),
+]
+
+# Gauss throughput is only meaningful if enough time was spent in it
+MIN_GAUSS_TIME = 0.05
+
+
+def load(fname):
+    with open(fname) as f:
+        data = json.load(f)
+    return data, dict((inst["name"], inst) for inst in data["instances"])
+
+
+def metrics_of(inst):
+    ret = list(METRICS)
+    if inst["phases"].get("gauss", {}).get("time", 0) >= MIN_GAUSS_TIME:
+        ret.append(("gauss_calls_per_sec", True))
+    return ret
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two JSON outputs of cmsat-bench --macro")
+    parser.add_argument("--threshold", default=5.0, type=float,
+                        help="Percentage of slowdown that counts as a regression")
+    parser.add_argument("old")
+    parser.add_argument("new")
+    options = parser.parse_args()
+
+    old_data, old = load(options.old)
+    new_data, new = load(options.new)
+    print("old: %s  new: %s" % (old_data["sha1"], new_data["sha1"]))
+
+    regressions = 0
+    print("%-32s %-24s %14s %14s %8s" % ("instance", "metric", "old", "new", "change"))
+    for name in sorted(old):
+        if name not in new:
+            print("%-32s missing from %s" % (name, options.new))
+            continue
+
+        if old[name]["conflicts"] != new[name]["conflicts"] \
+                or old[name]["result"] != new[name]["result"]:
+            print("%-32s NOTE: search differs (conflicts %d -> %d, %s -> %s)" % (
+                name, old[name]["conflicts"], new[name]["conflicts"],
+                old[name]["result"], new[name]["result"]))
+
+        for key, higher_better in metrics_of(old[name]):
+            a = old[name][key]
+            b = new[name][key]
+            if a == 0:
+                continue
+            change = (b - a)/a*100.0
+            worse = -change if higher_better else change
+            mark = ""
+            if worse > options.threshold:
+                mark = " <-- REGRESSION"
+                regressions += 1
+            print("%-32s %-24s %14.2f %14.2f %+7.1f%%%s" % (
+                name, key, a, b, change, mark))
+
+    if regressions:
+        print("%d regression(s) above %.1f%%" % (regressions, options.threshold))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2018, Mate Soos
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Compares the malloc-ed watchlists to the pooled ones (--watchpool 1)
+# on propagation speed and peak RSS. Example:
+#   ./watchpool.py --solver ../../build/cryptominisat5 --maxconfl 200000 a.cnf b.cnf
+
+from __future__ import print_function
+import argparse
+import os
+import re
+import subprocess
+
+CONFIGS = [
+    ("vec", ["--watchpool", "0"]),
+    ("pool", ["--watchpool", "1"]),
+    ("pool+thp", ["--watchpool", "1", "--hugepages", "1"]),
+]
+
+
+def run_one(options, fname, extra):
+    cmd = [options.solver, "--verb", "1", "--maxconfl", str(options.maxconfl),
+           "--threads", "1"] + extra + [fname]
+    p = subprocess.Popen(cmd, stdout=subprocess.PIPE, universal_newlines=True)
+    out = p.stdout.read()
+    _, _, rusage = os.wait4(p.pid, 0)
+    p.stdout.close()
+
+    props = None
+    total_time = None
+    for line in out.split("\n"):
+        m = re.match(r"c propagations\s*:.*\(\s*([0-9.]+)([KM]?)\s*props/s", line)
+        if m:
+            mult = {"": 1e-6, "K": 1e-3, "M": 1.0}[m.group(2)]
+            props = float(m.group(1))*mult
+        m = re.match(r"c Total time \(this thread\)\s*:\s*([0-9.]+)", line)
+        if m:
+            total_time = float(m.group(1))
+
+    # ru_maxrss is in kilobytes on Linux
+    return props, total_time, rusage.ru_maxrss/1024.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--solver", default="cryptominisat5")
+    parser.add_argument("--maxconfl", default=200000, type=int)
+    parser.add_argument("--runs", default=3, type=int,
+                        help="Runs per config, the best one is kept")
+    parser.add_argument("files", nargs="+")
+    options = parser.parse_args()
+
+    print("%-30s %-9s %10s %9s %9s" % ("file", "config", "Mprops/s", "time", "RSS MB"))
+    for fname in options.files:
+        for name, extra in CONFIGS:
+            best = None
+            for _ in range(options.runs):
+                res = run_one(options, fname, extra)
+                if res[0] is None:
+                    continue
+                if best is None or res[0] > best[0]:
+                    best = res
+            if best is None:
+                print("%-30s %-9s %10s" % (os.path.basename(fname), name, "N/A"))
+                continue
+            print("%-30s %-9s %10.2f %9.2f %9.1f" % (
+                os.path.basename(fname), name, best[0], best[1], best[2]))
+
+
+if __name__ == "__main__":
+    main()
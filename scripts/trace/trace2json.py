@@ -0,0 +1,141 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2018, Mate Soos
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+# Converts the binary event trace written with --trace/--tracefile into the
+# Chrome trace JSON format, which chrome://tracing and ui.perfetto.dev open.
+# Example:
+#   cryptominisat5 --trace 100000 --tracefile run.trace a.cnf
+#   ./trace2json.py run.trace run.json
+
+from __future__ import print_function
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"CMSTRACE"
+VERSION = 1
+
+# Must match TraceType in src/eventtrace.h
+TYPES = ["restart", "reducedb", "inprocess", "gauss_on", "gauss_off", "sls", "sync"]
+
+# Meaning of the argument of the event, per type
+ARG_NAMES = ["conflicts_this_restart", "red_cls_left", "bogoprops",
+             "matrix", "matrix", "sls_call", "sync_call"]
+
+# start_ns, dur_ns, conflicts, arg, name, type, 5 bytes padding
+EVENT = struct.Struct("<QQQQHB5x")
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.at = 0
+
+    def get(self, fmt):
+        vals = struct.unpack_from(fmt, self.data, self.at)
+        self.at += struct.calcsize(fmt)
+        return vals
+
+    def get_bytes(self, num):
+        ret = self.data[self.at:self.at+num]
+        self.at += num
+        return ret
+
+
+def read_trace(fname):
+    with open(fname, "rb") as f:
+        r = Reader(f.read())
+
+    if r.get_bytes(len(MAGIC)) != MAGIC:
+        print("ERROR: '%s' is not an event trace" % fname)
+        exit(-1)
+    version, num_threads = r.get("<II")
+    if version != VERSION:
+        print("ERROR: trace version %d is not supported" % version)
+        exit(-1)
+
+    threads = []
+    for _ in range(num_threads):
+        thread_num, num_names = r.get("<II")
+        names = []
+        for _ in range(num_names):
+            length, = r.get("<H")
+            names.append(r.get_bytes(length).decode("utf-8", "replace"))
+
+        num_events, = r.get("<Q")
+        events = []
+        for _ in range(num_events):
+            events.append(EVENT.unpack_from(r.data, r.at))
+            r.at += EVENT.size
+        threads.append((thread_num, names, events))
+
+    return threads
+
+
+def to_chrome(threads):
+    first = None
+    for _, _, events in threads:
+        for ev in events:
+            if first is None or ev[0] < first:
+                first = ev[0]
+
+    out = []
+    for thread_num, names, events in threads:
+        out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": thread_num,
+                    "args": {"name": "solver thread %d" % thread_num}})
+        for start, dur, conflicts, arg, name, typ, in events:
+            tname = TYPES[typ] if typ < len(TYPES) else "type%d" % typ
+            ev = {
+                "name": "%s %s" % (tname, names[name]) if tname != "inprocess" else names[name],
+                "cat": tname,
+                "pid": 0,
+                "tid": thread_num,
+                "ts": (start - first) / 1000.0,
+                "args": {"conflicts": conflicts,
+                         ARG_NAMES[typ] if typ < len(ARG_NAMES) else "arg": arg}
+            }
+            if dur == 0:
+                ev["ph"] = "i"
+                ev["s"] = "t"
+            else:
+                ev["ph"] = "X"
+                ev["dur"] = dur / 1000.0
+            out.append(ev)
+
+    return {"traceEvents": out, "displayTimeUnit": "ms"}
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Convert an event trace to Chrome trace JSON")
+    parser.add_argument("trace", help="Binary trace written by the solver")
+    parser.add_argument("output", nargs="?", help="JSON output, default is stdout")
+    args = parser.parse_args()
+
+    chrome = to_chrome(read_trace(args.trace))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(chrome, f)
+    else:
+        json.dump(chrome, sys.stdout)
+        print()
@@ -0,0 +1,174 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __BIGNUM_H__
+#define __BIGNUM_H__
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+namespace CMSat {
+using std::vector;
+
+/**
+@brief Arbitrary-precision unsigned integer, for model counts
+
+Only what counting needs: addition, multiplication, multiplication by a
+power of two and printing in decimal. Limbs are 32 bits, least significant
+first, with no leading zero limbs.
+*/
+class BigNum
+{
+public:
+    BigNum(uint64_t val = 0)
+    {
+        while(val != 0) {
+            limbs.push_back((uint32_t)val);
+            val >>= 32;
+        }
+    }
+
+    bool is_zero() const
+    {
+        return limbs.empty();
+    }
+
+    BigNum& operator+=(const BigNum& other)
+    {
+        if (limbs.size() < other.limbs.size()) {
+            limbs.resize(other.limbs.size(), 0);
+        }
+        uint64_t carry = 0;
+        for(size_t i = 0; i < limbs.size(); i++) {
+            if (i >= other.limbs.size() && carry == 0) {
+                break;
+            }
+            carry += (uint64_t)limbs[i]
+                + (i < other.limbs.size() ? other.limbs[i] : 0);
+            limbs[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        if (carry) {
+            limbs.push_back((uint32_t)carry);
+        }
+        return *this;
+    }
+
+    BigNum& operator*=(const BigNum& other)
+    {
+        if (is_zero() || other.is_zero()) {
+            limbs.clear();
+            return *this;
+        }
+        vector<uint32_t> res(limbs.size() + other.limbs.size(), 0);
+        for(size_t i = 0; i < limbs.size(); i++) {
+            uint64_t carry = 0;
+            for(size_t j = 0; j < other.limbs.size(); j++) {
+                carry += (uint64_t)limbs[i]*other.limbs[j] + res[i+j];
+                res[i+j] = (uint32_t)carry;
+                carry >>= 32;
+            }
+            res[i+other.limbs.size()] = (uint32_t)carry;
+        }
+        limbs.swap(res);
+        trim();
+        return *this;
+    }
+
+    //Multiply by 2^bits
+    BigNum& operator<<=(uint32_t bits)
+    {
+        if (is_zero()) {
+            return *this;
+        }
+        limbs.insert(limbs.begin(), bits/32, 0);
+        bits %= 32;
+        if (bits) {
+            uint32_t carry = 0;
+            for(uint32_t& limb: limbs) {
+                const uint32_t next = limb >> (32-bits);
+                limb = (limb << bits) | carry;
+                carry = next;
+            }
+            if (carry) {
+                limbs.push_back(carry);
+            }
+        }
+        return *this;
+    }
+
+    bool operator==(const BigNum& other) const
+    {
+        return limbs == other.limbs;
+    }
+
+    std::string to_string() const
+    {
+        if (is_zero()) {
+            return "0";
+        }
+
+        //Peel off 9 decimal digits at a time
+        vector<uint32_t> num(limbs);
+        vector<uint32_t> parts;
+        while(!num.empty()) {
+            uint64_t rem = 0;
+            for(size_t i = num.size(); i > 0; i--) {
+                const uint64_t cur = (rem << 32) | num[i-1];
+                num[i-1] = (uint32_t)(cur / 1000000000ULL);
+                rem = cur % 1000000000ULL;
+            }
+            parts.push_back((uint32_t)rem);
+            while(!num.empty() && num.back() == 0) {
+                num.pop_back();
+            }
+        }
+
+        std::string s = std::to_string(parts.back());
+        for(size_t i = parts.size()-1; i > 0; i--) {
+            std::string part = std::to_string(parts[i-1]);
+            s += std::string(9-part.size(), '0') + part;
+        }
+        return s;
+    }
+
+    size_t mem_used() const
+    {
+        return limbs.capacity()*sizeof(uint32_t);
+    }
+
+private:
+    void trim()
+    {
+        while(!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+    }
+
+    vector<uint32_t> limbs;
+};
+
+}
+
+#endif //__BIGNUM_H__
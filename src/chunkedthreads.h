@@ -0,0 +1,71 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef __CHUNKEDTHREADS_H__
+#define __CHUNKEDTHREADS_H__
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace CMSat {
+
+//At most max_threads, but each thread must get at least min_per_thread items,
+//below that it's not worth starting threads
+inline uint32_t threads_for_chunks(
+    const size_t num
+    , const uint32_t max_threads
+    , const size_t min_per_thread
+) {
+    const size_t max_useful = std::max<size_t>(1, num/min_per_thread);
+    return std::max<size_t>(1, std::min<size_t>(max_threads, max_useful));
+}
+
+//Calls func(start, end, thread_num) over consecutive chunks of [0, num).
+//Chunk 0 is run on the calling thread.
+template<class Func>
+void run_chunks(const size_t num, const uint32_t num_threads, Func func)
+{
+    if (num_threads == 1) {
+        func(0, num, 0);
+        return;
+    }
+
+    const size_t chunk = (num + num_threads - 1)/num_threads;
+    std::vector<std::thread> threads;
+    for(uint32_t t = 1; t < num_threads; t++) {
+        const size_t start = std::min(num, t*chunk);
+        const size_t end = std::min(num, start + chunk);
+        threads.push_back(std::thread(func, start, end, t));
+    }
+    func(0, std::min(num, chunk), 0);
+    for(std::thread& th: threads) {
+        th.join();
+    }
+}
+
+}
+
+#endif //__CHUNKEDTHREADS_H__
@@ -23,37 +23,50 @@ THE SOFTWARE.
 #include "cl_predictors.h"
 #include "clause.h"
 #include "solver.h"
+#include "chunkedthreads.h"
 #include <cmath>
+#include <algorithm>
+#include <string>
+#ifdef FINAL_PREDICTOR_COMPILED
+#include "cl_predictors_models.h"
+#endif
 //#define MISSING_VAL std::numeric_limits<float>::quiet_NaN()
 #define MISSING_VAL  -1334556800.0f
 
 using namespace CMSat;
 
+#ifdef FINAL_PREDICTOR_COMPILED
+static_assert(compiled_short_num_features == PRED_COLS
+    && compiled_long_num_features == PRED_COLS
+    && compiled_forever_num_features == PRED_COLS
+    , "Compiled models were trained on a different feature set");
+
 ClPredictors::ClPredictors(Solver* _solver) :
     solver(_solver)
 {
-    BoosterHandle handle;
-    int ret;
+}
 
-    handles.push_back(handle);
-    ret = XGBoosterCreate(0, 0, &(handles[predict_type::short_pred]));
-    assert(ret == 0);
-    ret = XGBoosterSetParam(handles[predict_type::short_pred], "nthread", "1");
-    assert(ret == 0);
+ClPredictors::~ClPredictors()
+{
+}
 
-    BoosterHandle handle2;
-    handles.push_back(handle2);
-    ret = XGBoosterCreate(0, 0, &(handles[predict_type::long_pred]));
-    assert(ret == 0);
-    ret = XGBoosterSetParam(handles[predict_type::long_pred], "nthread", "1");
-    assert(ret == 0);
+//The models are compiled in, the files are not used
+void ClPredictors::load_models(const std::string& /*short_fname*/,
+                               const std::string& /*long_fname*/,
+                               const std::string& /*forever_fname*/)
+{
+}
 
-    BoosterHandle handle3;
-    handles.push_back(handle3);
-    ret = XGBoosterCreate(0, 0, &(handles[predict_type::forever_pred]));
-    assert(ret == 0);
-    ret = XGBoosterSetParam(handles[predict_type::forever_pred], "nthread", "1");
-    assert(ret == 0);
+#else
+ClPredictors::ClPredictors(Solver* _solver) :
+    solver(_solver)
+{
+    for(int i = 0; i < 3; i++) {
+        BoosterHandle handle;
+        int ret = XGBoosterCreate(0, 0, &handle);
+        assert(ret == 0);
+        handles.push_back(handle);
+    }
 }
 
 ClPredictors::~ClPredictors()
@@ -77,6 +90,7 @@ void ClPredictors::load_models(const std::string& short_fname,
     ret =XGBoosterLoadModel(handles[predict_type::forever_pred], forever_fname.c_str());
     assert(ret == 0);
 }
+#endif
 
 void ClPredictors::set_up_input(
     const CMSat::Clause* cl,
@@ -367,28 +381,14 @@ void ClPredictors::set_up_input(
     assert(x==cols);
 }
 
-float ClPredictors::predict_one(int num)
+void ClPredictors::start_batch(const size_t _num_rows)
 {
-    bst_ulong out_len;
-    const float *out_result;
-    int ret = XGBoosterPredict(
-        handles[num],
-        dmat,
-        0,  //0: normal prediction
-        0,  //use all trees
-        0,  //do not use for training
-        &out_len,
-        &out_result
-    );
-    assert(ret == 0);
-    assert(out_len == 1);
-
-    float retval = out_result[0];
-    return retval;
+    num_rows = _num_rows;
+    batch.resize(num_rows*PRED_COLS);
 }
 
-float ClPredictors::predict(
-    predict_type pred_type,
+void ClPredictors::set_up_row(
+    const size_t row,
     const CMSat::Clause* cl,
     const uint64_t sumConflicts,
     const int64_t  last_touched_diff,
@@ -398,7 +398,7 @@ float ClPredictors::predict(
     const double   act_ranking_rel,
     const uint32_t act_ranking_top_10)
 {
-    // convert to DMatrix
+    assert(row < num_rows);
     set_up_input(
         cl,
         sumConflicts,
@@ -409,57 +409,89 @@ float ClPredictors::predict(
         act_ranking_rel,
         act_ranking_top_10,
         PRED_COLS,
-        train);
-    int rows=1;
-    int ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
-    assert(ret == 0);
-
-    float val = predict_one(pred_type);
-    XGDMatrixFree(dmat);
+        batch.data() + row*PRED_COLS);
+}
 
-    return val;
+#ifdef FINAL_PREDICTOR_COMPILED
+void ClPredictors::predict_compiled(
+    const CompiledForest& forest,
+    const uint32_t num_threads,
+    float* out) const
+{
+    run_chunks(num_rows, std::max<uint32_t>(num_threads, 1)
+        , [&](const size_t start, const size_t end, const uint32_t) {
+            for(size_t i = start; i < end; i++) {
+                out[i] = forest.predict(batch.data() + i*PRED_COLS, MISSING_VAL);
+            }
+        });
 }
 
-void ClPredictors::predict(
-    const CMSat::Clause* cl,
-    const uint64_t sumConflicts,
-    const int64_t  last_touched_diff,
-    #ifdef EXTENDED_FEATURES
-    const int64_t  rdb1_last_touched_diff,
-    #endif
-    const double   act_ranking_rel,
-    const uint32_t act_ranking_top_10,
-    float& p_short,
-    float& p_long,
-    float& p_forever)
+void ClPredictors::predict_batch(
+    const uint32_t num_threads,
+    float* out_short,
+    float* out_long,
+    float* out_forever)
 {
-    // convert to DMatrix
-    set_up_input(
-        cl,
-        sumConflicts,
-        last_touched_diff,
-        #ifdef EXTENDED_FEATURES
-        rdb1_last_touched_diff,
-        #endif
-        act_ranking_rel,
-        act_ranking_top_10,
-        PRED_COLS,
-        train);
-    int rows=1;
-    int ret;
+    if (out_short) {
+        predict_compiled(compiled_short, num_threads, out_short);
+    }
+    if (out_long) {
+        predict_compiled(compiled_long, num_threads, out_long);
+    }
+    if (out_forever) {
+        predict_compiled(compiled_forever, num_threads, out_forever);
+    }
+}
 
-    ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
+#else
+void ClPredictors::predict_xgb(
+    const predict_type pred_type,
+    const uint32_t num_threads,
+    DMatrixHandle dmat,
+    float* out)
+{
+    int ret = XGBoosterSetParam(handles[pred_type], "nthread"
+        , std::to_string(std::max<uint32_t>(num_threads, 1)).c_str());
     assert(ret == 0);
-    p_short = predict_one(short_pred);
-    XGDMatrixFree(dmat);
 
-    ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
+    bst_ulong out_len;
+    const float *out_result;
+    ret = XGBoosterPredict(
+        handles[pred_type],
+        dmat,
+        0,  //0: normal prediction
+        0,  //use all trees
+        0,  //do not use for training
+        &out_len,
+        &out_result
+    );
     assert(ret == 0);
-    p_long = predict_one(long_pred);
-    XGDMatrixFree(dmat);
+    assert(out_len == num_rows);
+    std::copy(out_result, out_result + num_rows, out);
+}
+
+void ClPredictors::predict_batch(
+    const uint32_t num_threads,
+    float* out_short,
+    float* out_long,
+    float* out_forever)
+{
+    if (num_rows == 0) {
+        return;
+    }
 
-    ret = XGDMatrixCreateFromMat((float *)train, rows, PRED_COLS, MISSING_VAL, &dmat);
+    DMatrixHandle dmat;
+    int ret = XGDMatrixCreateFromMat(batch.data(), num_rows, PRED_COLS, MISSING_VAL, &dmat);
     assert(ret == 0);
-    p_forever = predict_one(forever_pred);
+    if (out_short) {
+        predict_xgb(short_pred, num_threads, dmat, out_short);
+    }
+    if (out_long) {
+        predict_xgb(long_pred, num_threads, dmat, out_long);
+    }
+    if (out_forever) {
+        predict_xgb(forever_pred, num_threads, dmat, out_forever);
+    }
     XGDMatrixFree(dmat);
 }
+#endif
@@ -32,7 +32,11 @@ THE SOFTWARE.
 
 #include <vector>
 #include <string>
+#ifdef FINAL_PREDICTOR_COMPILED
+#include "compiledforest.h"
+#else
 #include <xgboost/c_api.h>
+#endif
 
 using std::vector;
 
@@ -43,6 +47,13 @@ enum predict_type {short_pred=0, long_pred=1, forever_pred=2};
 class Solver;
 class Clause;
 
+/**
+@brief Predicts the usefulness of redundant clauses, in batches
+
+The features of all the clauses are written into one dense matrix with
+set_up_row(), which may be called from multiple threads for different rows.
+predict_batch() then scores all rows with the requested models at once.
+*/
 class ClPredictors
 {
 public:
@@ -52,8 +63,9 @@ public:
                      const std::string& long_fname,
                      const std::string& forever_fname);
 
-    float predict(
-        predict_type pred_type,
+    void start_batch(const size_t num_rows);
+    void set_up_row(
+        const size_t row,
         const CMSat::Clause* cl,
         const uint64_t sumConflicts,
         const int64_t  last_touched_diff,
@@ -63,21 +75,14 @@ public:
         const double   act_ranking_rel,
         const uint32_t act_ranking_top_10);
 
-    void predict(
-        const CMSat::Clause* cl,
-        const uint64_t sumConflicts,
-        const int64_t last_touched_diff,
-#ifdef EXTENDED_FEATURES
-        const int64_t rdb1_last_touched_diff,
-#endif
-        const double   act_ranking_rel,
-        const uint32_t act_ranking_top_10,
-        float& p_short,
-        float& p_long,
-        float& p_forever);
+    //Outputs that are NULL are not predicted
+    void predict_batch(
+        const uint32_t num_threads,
+        float* out_short,
+        float* out_long,
+        float* out_forever);
 
 private:
-    float predict_one(int num);
     void set_up_input(
         const CMSat::Clause* cl,
         const uint64_t sumConflicts,
@@ -89,9 +94,22 @@ private:
         const uint32_t act_ranking_top_10,
         const uint32_t cols,
         float* at);
+
+    vector<float> batch;
+    size_t num_rows = 0;
+#ifdef FINAL_PREDICTOR_COMPILED
+    void predict_compiled(
+        const CompiledForest& forest,
+        const uint32_t num_threads,
+        float* out) const;
+#else
+    void predict_xgb(
+        const predict_type pred_type,
+        const uint32_t num_threads,
+        DMatrixHandle dmat,
+        float* out);
     vector<BoosterHandle> handles;
-    float train[PRED_COLS];
-    DMatrixHandle dmat;
+#endif
     Solver* solver;
 };
 
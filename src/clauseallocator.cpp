@@ -56,108 +56,243 @@ using std::endl;
 //For listing each and every clause location:
 //#define DEBUG_CLAUSEALLOCATOR2
 
-#define MIN_LIST_SIZE (50000 * (sizeof(Clause) + 4*sizeof(Lit))/sizeof(BASE_DATA_TYPE))
-#define ALLOC_GROW_MULT 1.5
-
 #define MAXSIZE ((1ULL << (EFFECTIVELY_USEABLE_BITS))-1)
+#define MAX_SEG_SLOTS ((MAXSIZE+1) >> CL_SEG_BITS)
+
+//Segments that are less used than this are evacuated during consolidation
+#define SEG_EVACUATE_RATIO 0.8
+
+//Unless forced, at most this ratio of the live data is moved at once
+#define SEG_EVACUATE_MAX_RATIO 0.25
+
+static const size_t no_seg = std::numeric_limits<size_t>::max();
 
 ClauseAllocator::ClauseAllocator() :
-    dataStart(NULL)
+    cur_seg(no_seg)
     , size(0)
     , capacity(0)
     , currentlyUsedSize(0)
 {
-    assert(MIN_LIST_SIZE < MAXSIZE);
+}
+
+void ClauseAllocator::set_offset_shift(const uint32_t shift)
+{
+    //Can only be changed while empty, consolidate() changes it otherwise
+    assert(segs.empty());
+    assert(shift <= CL_MAX_OFFSET_SHIFT);
+    offset_shift = shift;
+    evac_shift = shift;
+}
+
+uint64_t ClauseAllocator::seg_words() const
+{
+    return 1ULL << (CL_SEG_BITS + offset_shift);
+}
+
+uint64_t ClauseAllocator::round_to_unit(const uint64_t words) const
+{
+    const uint64_t unit = 1ULL << offset_shift;
+    return (words + unit - 1) & ~(unit - 1);
+}
+
+//Growing the shift copies every live clause into new segments before the
+//old ones are freed, so both must fit into the slots at the same time.
+//Re-aligning adds at most one old unit of padding per clause, and the tail
+//of the new segments may stay unused, hence the slack.
+bool ClauseAllocator::near_limit() const
+{
+    if (offset_shift >= CL_MAX_OFFSET_SHIFT) {
+        return false;
+    }
+    if (slots_used*3 >= MAX_SEG_SLOTS*2) {
+        return true;
+    }
+
+    const uint64_t new_words = currentlyUsedSize + (live_cls << offset_shift);
+    uint64_t new_slots = new_words/(2*seg_words()) + 1;
+    new_slots += new_slots/8 + 1;
+    return slots_used + new_slots >= MAX_SEG_SLOTS;
 }
 
 /**
-@brief Frees all stacks
+@brief Frees all segments
 */
 ClauseAllocator::~ClauseAllocator()
 {
-    free(dataStart);
+    for(const Segment& seg: segs) {
+        if (seg.num_slots > 0) {
+            pages.dealloc(seg.mem);
+        }
+    }
 }
 
-void* ClauseAllocator::allocEnough(
-    uint32_t num_lits
-) {
-    //Try to quickly find a place at the end of a dataStart
-    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
-    uint64_t needed
-        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+/**
+@brief Allocates a new segment that can hold at least "needed" datapieces
 
-    if (size + needed > capacity) {
-        //Grow by default, but don't go under or over the limits
-        uint64_t newcapacity = capacity * ALLOC_GROW_MULT;
-        newcapacity = std::max<size_t>(newcapacity, MIN_LIST_SIZE);
-        while (newcapacity < size+needed) {
-            newcapacity *= ALLOC_GROW_MULT;
+Free slots are re-used, lowest first. Returns the head slot of the segment.
+*/
+size_t ClauseAllocator::open_segment(const uint64_t needed)
+{
+    const uint64_t num_slots = std::max<uint64_t>(1, (needed + seg_words() - 1)/seg_words());
+
+    //Find a run of free slots
+    size_t at = no_seg;
+    size_t run = 0;
+    for(size_t i = 0; i < segs.size(); i++) {
+        if (segs[i].mem != NULL) {
+            run = 0;
+            continue;
         }
-        assert(newcapacity >= size+needed);
-        newcapacity = std::min<size_t>(newcapacity, MAXSIZE);
-
-        //Oops, not enough space anyway
-        if (newcapacity < size + needed) {
-            std::cerr
-            << "ERROR: memory manager can't handle the load."
-#ifndef LARGE_OFFSETS
-            << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
-#endif
-            << " size: " << size
-            << " needed: " << needed
-            << " newcapacity: " << newcapacity
-            << endl;
-            std::cout
-            << "ERROR: memory manager can't handle the load."
-#ifndef LARGE_OFFSETS
-            << " **PLEASE RECOMPILE WITH -DLARGEMEM=ON**"
-#endif
-            << " size: " << size
-            << " needed: " << needed
-            << " newcapacity: " << newcapacity
-            << endl;
-
-            throw std::bad_alloc();
+        run++;
+        if (run == num_slots) {
+            at = i + 1 - num_slots;
+            break;
         }
+    }
+    if (at == no_seg) {
+        //Slots at the end that are free can be part of the new segment
+        at = segs.size() - run;
+    }
 
-        //Reallocate data
-        BASE_DATA_TYPE* new_dataStart;
-        new_dataStart = (BASE_DATA_TYPE*)realloc(
-            dataStart
-            , newcapacity*sizeof(BASE_DATA_TYPE)
-        );
+    //Oops, not enough space anyway
+    if (at + num_slots > MAX_SEG_SLOTS) {
+        std::cerr
+        << "ERROR: memory manager can't handle the load."
+        << " **PLEASE RUN WITH A LARGER --cloffsetshift**"
+        << " size: " << size
+        << " needed: " << needed
+        << " capacity: " << capacity
+        << endl;
+        std::cout
+        << "ERROR: memory manager can't handle the load."
+        << " **PLEASE RUN WITH A LARGER --cloffsetshift**"
+        << " size: " << size
+        << " needed: " << needed
+        << " capacity: " << capacity
+        << endl;
 
-        //Realloc failed?
-        if (new_dataStart == NULL) {
-            std::cerr
-            << "ERROR: while reallocating clause space"
-            << endl;
+        throw std::bad_alloc();
+    }
 
-            throw std::bad_alloc();
-        }
-        dataStart = new_dataStart;
+    const uint64_t words = num_slots*seg_words();
+    BASE_DATA_TYPE* mem = (BASE_DATA_TYPE*)pages.alloc(words*sizeof(BASE_DATA_TYPE));
+    if (mem == NULL) {
+        std::cerr
+        << "ERROR: while allocating clause space"
+        << endl;
 
-        //Update capacity to reflect the update
-        capacity = newcapacity;
+        throw std::bad_alloc();
     }
 
-    //Add clause to the set
-    Clause* pointer = (Clause*)(dataStart + size);
+    if (segs.size() < at + num_slots) {
+        segs.resize(at + num_slots);
+        seg_start.resize(at + num_slots, NULL);
+    }
+    for(size_t i = 0; i < num_slots; i++) {
+        Segment& seg = segs[at+i];
+        seg = Segment();
+        seg.mem = mem;
+        seg.head = at;
+        seg_start[at+i] = mem + i*seg_words();
+    }
+    segs[at].num_slots = num_slots;
+    segs[at].words = words;
+    seg_by_addr[mem] = at;
+    capacity += words;
+    slots_used += num_slots;
+
+    return at;
+}
+
+void ClauseAllocator::free_segment(const size_t at)
+{
+    Segment& seg = segs[at];
+    assert(seg.num_slots > 0);
+
+    size -= seg.used;
+    capacity -= seg.words;
+    currentlyUsedSize -= seg.live;
+    live_cls -= seg.live_cls;
+    slots_used -= seg.num_slots;
+    seg_by_addr.erase(seg.mem);
+    pages.dealloc(seg.mem);
+    if (cur_seg == at) {
+        cur_seg = no_seg;
+    }
+
+    const uint32_t num_slots = seg.num_slots;
+    for(size_t i = 0; i < num_slots; i++) {
+        segs[at+i] = Segment();
+        seg_start[at+i] = NULL;
+    }
+
+    //Shrink the slot table if the end is free
+    while (!segs.empty() && segs.back().mem == NULL) {
+        segs.pop_back();
+        seg_start.pop_back();
+    }
+}
+
+void* ClauseAllocator::allocEnough(
+    uint32_t num_lits
+) {
+    //Try to quickly find a place at the end of the current segment
+    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
+    uint64_t needed
+        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+    needed = round_to_unit(needed);
+
+    size_t at = cur_seg;
+    if (needed > seg_words()) {
+        //Gets its own segment, the current one can still be used
+        at = open_segment(needed);
+    } else if (at == no_seg || segs[at].used + needed > segs[at].words) {
+        at = open_segment(needed);
+        cur_seg = at;
+    }
+
+    //Add clause to the segment
+    Segment& seg = segs[at];
+    Clause* pointer = (Clause*)(seg.mem + seg.used);
+    seg.used += needed;
+    seg.live += needed;
+    seg.live_cls++;
+    live_cls++;
     size += needed;
     currentlyUsedSize += needed;
 
     return pointer;
 }
 
+//Returns the head slot of the segment holding the pointer
+size_t ClauseAllocator::find_segment(const BASE_DATA_TYPE* p) const
+{
+    if (cur_seg != no_seg
+        && p >= segs[cur_seg].mem
+        && p < segs[cur_seg].mem + segs[cur_seg].words
+    ) {
+        return cur_seg;
+    }
+
+    auto it = seg_by_addr.upper_bound(p);
+    assert(it != seg_by_addr.begin());
+    --it;
+    assert(p < it->first + segs[it->second].words);
+    return it->second;
+}
+
 /**
 @brief Given the pointer of the clause it finds a 32-bit offset for it
 
-Calculates the stack frame and the position of the pointer in the stack, and
-rerturns a 32-bit value that is a concatenation of these two
+Finds the segment of the pointer and the position of the pointer in the
+segment, and rerturns a 32-bit value that is a concatenation of these two
 */
 ClOffset ClauseAllocator::get_offset(const Clause* ptr) const
 {
-    return ((BASE_DATA_TYPE*)ptr - dataStart);
+    const BASE_DATA_TYPE* p = (const BASE_DATA_TYPE*)ptr;
+    const size_t at = find_segment(p);
+    assert(((p - segs[at].mem) & ((1ULL << offset_shift)-1)) == 0);
+    return ((ClOffset)at << CL_SEG_BITS) + (ClOffset)((p - segs[at].mem) >> offset_shift);
 }
 
 /**
@@ -165,8 +300,8 @@ ClOffset ClauseAllocator::get_offset(const Clause* ptr) const
 
 If clause was binary, it frees it in quite a normal way. If it isn't, then it
 needs to set the data in the Clause that it has been freed, and updates the
-stack it belongs to such that the stack can now that its effectively used size
-is smaller
+segment it belongs to such that the segment can now that its effectively used
+size is smaller
 
 NOTE: The size of claues can change. Therefore, currentlyUsedSizes can in fact
 be incorrect, since it was incremented by the ORIGINAL size of the clause, but
@@ -175,61 +310,86 @@ of the clause. Therefore, the "currentlyUsedSizes" is an overestimation!!
 */
 void ClauseAllocator::clauseFree(Clause* cl)
 {
+    clauseFree(get_offset(cl));
+}
+
+void ClauseAllocator::clauseFree(ClOffset offset)
+{
+    Clause* cl = ptr(offset);
     assert(!cl->freed());
     cl->setFreed();
     uint64_t est_num_cl = cl->size();
     est_num_cl = std::max(est_num_cl, (uint64_t)3); //we sometimes allow gauss to allocate 3-long clauses
     uint64_t bytes_freed = sizeof(Clause) + est_num_cl*sizeof(Lit);
     uint64_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
+    elems_freed = round_to_unit(elems_freed);
+
+    Segment& seg = segs[segs[offset >> CL_SEG_BITS].head];
+    elems_freed = std::min(elems_freed, seg.live);
+    seg.live -= elems_freed;
     currentlyUsedSize -= elems_freed;
+    if (seg.live_cls > 0) {
+        seg.live_cls--;
+        live_cls--;
+    }
 
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
     VALGRIND_MAKE_MEM_UNDEFINED(((char*)cl)+sizeof(Clause), cl->size()*sizeof(Lit));
     #endif
 }
 
-void ClauseAllocator::clauseFree(ClOffset offset)
+bool ClauseAllocator::is_evacuating(const ClOffset offset) const
 {
-    Clause* cl = ptr(offset);
-    clauseFree(cl);
+    return segs[segs[offset >> CL_SEG_BITS].head].evacuating;
+}
+
+Clause* ClauseAllocator::evac_ptr(const ClOffset offset) const
+{
+    assert(is_evacuating(offset));
+    return (Clause*)(seg_start[offset >> CL_SEG_BITS]
+        + ((uint64_t)(offset & CL_SEG_MASK) << evac_shift));
+}
+
+ClOffset ClauseAllocator::new_offset_of(const Clause* old) const
+{
+    assert(old->reloced);
+    ClOffset new_offset = (*old)[0].toInt();
+    #ifdef LARGE_OFFSETS
+    new_offset += ((uint64_t)(*old)[1].toInt())<<32;
+    #endif
+    return new_offset;
 }
 
-ClOffset ClauseAllocator::move_cl(
-    ClOffset* newDataStart
-    , ClOffset*& new_ptr
-    , Clause* old
-) const {
+ClOffset ClauseAllocator::move_cl(Clause* old)
+{
+    assert(!old->reloced);
+    void* new_ptr = allocEnough(old->size());
     uint64_t bytesNeeded = sizeof(Clause) + old->size()*sizeof(Lit);
     uint64_t sizeNeeded = bytesNeeded/sizeof(BASE_DATA_TYPE) + (bool)(bytesNeeded % sizeof(BASE_DATA_TYPE));
     memcpy(new_ptr, old, sizeNeeded*sizeof(BASE_DATA_TYPE));
 
-    ClOffset new_offset = new_ptr-newDataStart;
+    ClOffset new_offset = get_offset((Clause*)new_ptr);
+    assert(!is_evacuating(new_offset));
     (*old)[0] = Lit::toLit(new_offset & 0xFFFFFFFF);
     #ifdef LARGE_OFFSETS
     (*old)[1] = Lit::toLit((new_offset>>32) & 0xFFFFFFFF);
     #endif
     old->reloced = true;
 
-    new_ptr += sizeNeeded;
     return new_offset;
 }
 
-void ClauseAllocator::move_one_watchlist(
-    watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr)
+void ClauseAllocator::move_one_watchlist(watch_subarray& ws)
 {
     for(Watched& w: ws) {
-        if (w.isClause()) {
-            Clause* old = ptr(w.get_offset());
+        if (w.isClause() && is_evacuating(w.get_offset())) {
+            Clause* old = evac_ptr(w.get_offset());
             assert(!old->freed());
             Lit blocked = w.getBlockedLit();
             if (old->reloced) {
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                w = Watched(new_offset, blocked);
+                w = Watched(new_offset_of(old), blocked);
             } else {
-                ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
+                ClOffset new_offset = move_cl(old);
                 w = Watched(new_offset, blocked);
             }
         }
@@ -237,51 +397,97 @@ void ClauseAllocator::move_one_watchlist(
 }
 
 /**
-@brief If needed, compacts stacks, removing unused clauses
+@brief Selects the segments to be evacuated, most fragmented first
 
-Firstly, the algorithm determines if the number of useless slots is large or
-small compared to the problem size. If it is small, it does nothing. If it is
-large, then it allocates new stacks, copies the non-freed clauses to these new
-stacks, updates all pointers and offsets, and frees the original stacks.
+Unless forced, only segments with enough unused space are evacuated, most
+fragmented first, until SEG_EVACUATE_MAX_RATIO of the live data is reached.
 */
-void ClauseAllocator::consolidate(
-    Solver* solver
-    , const bool force
-    , bool lower_verb
+void ClauseAllocator::select_to_evacuate(
+    const bool force
+    , vector<size_t>& to_evac
 ) {
-    //If re-allocation is not really neccessary, don't do it
-    //Neccesities:
-    //1) There is too much memory allocated. Re-allocation will save space
-    //   Avoiding segfault (max is 16 outerOffsets, more than 10 is near)
-    //2) There is too much empty, unused space (>30%)
-    if (!force
-        && (float_div(currentlyUsedSize, size) > 0.8 || currentlyUsedSize < (100ULL*1000ULL))
-    ) {
-        if (solver->conf.verbosity >= 3
-            || (lower_verb && solver->conf.verbosity)
-        ) {
-            cout << "c Not consolidating memory." << endl;
+    vector<std::pair<double, size_t> > cands;
+    for(size_t i = 0; i < segs.size(); i++) {
+        const Segment& seg = segs[i];
+        if (seg.num_slots == 0) {
+            continue;
+        }
+        const double ratio = float_div(seg.live, seg.used);
+        if (force || ratio <= SEG_EVACUATE_RATIO) {
+            cands.push_back(std::make_pair(ratio, i));
         }
-        return;
     }
-    const double myTime = cpuTime();
+    std::sort(cands.begin(), cands.end());
+
+    const uint64_t max_move = std::max<uint64_t>(
+        seg_words(), currentlyUsedSize*SEG_EVACUATE_MAX_RATIO);
+    uint64_t will_move = 0;
+    to_evac.clear();
+    for(const auto& c: cands) {
+        const Segment& seg = segs[c.second];
+        if (!force && will_move > 0 && will_move + seg.live > max_move) {
+            break;
+        }
+        will_move += seg.live;
+        to_evac.push_back(c.second);
 
-    //Pointers that will be moved along
-    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(currentlyUsedSize*sizeof(BASE_DATA_TYPE));
-    BASE_DATA_TYPE * new_ptr = newDataStart;
+        //Evacuated clauses must go to a new segment
+        if (cur_seg == c.second) {
+            cur_seg = no_seg;
+        }
+    }
+}
 
-    assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
+/**
+@brief Marks the next batch of segments as evacuating, returns where it ends
 
-    vector<bool> visited(solver->watches.size(), 0);
+The batch is as large as the free slots can take in a copy of it, so that
+the old and new copy of all live clauses never have to fit at the same time.
+At least one segment is always marked.
+*/
+size_t ClauseAllocator::mark_batch(
+    const vector<size_t>& to_evac
+    , size_t at
+) {
+    //Re-alignment adds at most one old unit of padding per clause, the
+    //tail of the new segments may stay unused, and clauses longer than a
+    //segment are rounded up to whole slots
+    const uint64_t free_words = (MAX_SEG_SLOTS - slots_used)*seg_words();
+    const uint64_t slack = free_words/8 + seg_words();
+    const uint64_t max_words = free_words > slack ? free_words - slack : 0;
+    const uint64_t pad = (evac_shift == offset_shift) ? 0 : (1ULL << evac_shift);
+
+    uint64_t will_move = 0;
+    for(; at < to_evac.size(); at++) {
+        Segment& seg = segs[to_evac[at]];
+        uint64_t words = seg.live + seg.live_cls*pad;
+        if (seg.num_slots > 1) {
+            words += seg_words();
+        }
+        if (will_move > 0 && will_move + words > max_words) {
+            break;
+        }
+        will_move += words;
+        seg.evacuating = true;
+    }
+
+    return at;
+}
+
+/**
+@brief Moves the live clauses out of the evacuating segments and frees them
+*/
+void ClauseAllocator::evacuate_marked(Solver* solver)
+{
     for(auto& ws: solver->watches) {
-        move_one_watchlist(ws, newDataStart, new_ptr);
+        move_one_watchlist(ws);
     }
 
-    update_offsets(solver->longIrredCls, newDataStart, new_ptr);
+    update_offsets(solver->longIrredCls);
     for(auto& lredcls: solver->longRedCls) {
-        update_offsets(lredcls, newDataStart, new_ptr);
+        update_offsets(lredcls);
     }
-    update_offsets(solver->detached_xor_repr_cls, newDataStart, new_ptr);
+    update_offsets(solver->detached_xor_repr_cls);
 
     //Fix up propBy
     for (size_t i = 0; i < solver->nVars(); i++) {
@@ -292,26 +498,81 @@ void ClauseAllocator::consolidate(
                 && vdata.level != 0
                 && solver->value(i) != l_Undef
             ) {
-                Clause* old = ptr(vdata.reason.get_offset());
-                assert(!old->freed());
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                vdata.reason = PropBy(new_offset);
+                const ClOffset offset = vdata.reason.get_offset();
+                if (is_evacuating(offset)) {
+                    Clause* old = evac_ptr(offset);
+                    assert(!old->freed());
+                    vdata.reason = PropBy(new_offset_of(old));
+                }
             } else {
                 vdata.reason = PropBy();
             }
         }
     }
 
-    //Update sizes
+    //Free evacuated segments
+    for(size_t i = 0; i < segs.size(); i++) {
+        if (segs[i].num_slots > 0 && segs[i].evacuating) {
+            free_segment(i);
+        }
+    }
+}
+
+/**
+@brief If needed, compacts segments, removing unused clauses
+
+Firstly, the algorithm determines if the number of useless slots is large or
+small compared to the problem size. If it is small, it does nothing. If it is
+large, then it selects the segments to evacuate, copies their non-freed clauses
+to new segments, updates all pointers and offsets pointing to them, and frees
+the evacuated segments.
+*/
+void ClauseAllocator::consolidate(
+    Solver* solver
+    , const bool force
+    , bool lower_verb
+) {
+    //If re-allocation is not really neccessary, don't do it
+    //Neccesities:
+    //1) There is too much memory allocated. Re-allocation will save space
+    //   Avoiding segfault (max is 16 outerOffsets, more than 10 is near)
+    //2) There is too much empty, unused space (>30%)
+    //3) Offsets are about to run out, all clauses must be re-aligned
+    const bool grow_shift = near_limit();
+    if (!force
+        && !grow_shift
+        && (float_div(currentlyUsedSize, size) > 0.8 || currentlyUsedSize < (100ULL*1000ULL))
+    ) {
+        if (solver->conf.verbosity >= 3
+            || (lower_verb && solver->conf.verbosity)
+        ) {
+            cout << "c Not consolidating memory." << endl;
+        }
+        return;
+    }
+    const double myTime = cpuTime();
     const uint64_t old_size = size;
-    size = new_ptr-newDataStart;
-    capacity = currentlyUsedSize;
-    currentlyUsedSize = size;
-    free(dataStart);
-    dataStart = newDataStart;
+    const size_t old_num_segs = num_segments();
+    vector<size_t> to_evac;
+    select_to_evacuate(force || grow_shift, to_evac);
+    evac_shift = offset_shift;
+    if (grow_shift) {
+        //Everything is evacuated, new segments use the new alignment
+        offset_shift++;
+    }
+
+    assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
+
+    //Segments not yet in a batch are left alone, so when growing the shift
+    //they are still decoded with the old one
+    size_t at = 0;
+    size_t num_batches = 0;
+    while (at < to_evac.size()) {
+        at = mark_batch(to_evac, at);
+        evacuate_marked(solver);
+        num_batches++;
+    }
+    evac_shift = offset_shift;
 
     const double time_used = cpuTime() - myTime;
     if (solver->conf.verbosity >= 2
@@ -325,6 +586,9 @@ void ClauseAllocator::consolidate(
         cout << "c [mem] consolidate ";
         cout << " old-sz: " << print_value_kilo_mega(old_size*sizeof(BASE_DATA_TYPE))
         << " new-sz: " << print_value_kilo_mega(size*sizeof(BASE_DATA_TYPE))
+        << " segs evac: " << to_evac.size() << "/" << old_num_segs
+        << " batches: " << num_batches
+        << " offs shift: " << offset_shift
         << " new bits offs: " << std::fixed << std::setprecision(2) << log_2_size;
         cout << solver->conf.print_times(time_used)
         << endl;
@@ -338,31 +602,39 @@ void ClauseAllocator::consolidate(
     }
 }
 
-void ClauseAllocator::update_offsets(
-    vector<ClOffset>& offsets,
-    ClOffset* newDataStart,
-    ClOffset*& new_ptr
-) {
-
+void ClauseAllocator::update_offsets(vector<ClOffset>& offsets)
+{
     for(ClOffset& offs: offsets) {
-        Clause* old = ptr(offs);
+        if (!is_evacuating(offs)) {
+            continue;
+        }
+
+        Clause* old = evac_ptr(offs);
         if (!old->reloced) {
             assert(old->used_in_xor() && old->used_in_xor_full());
             assert(old->_xor_is_detached);
-            offs = move_cl(newDataStart, new_ptr, old);
+            offs = move_cl(old);
         } else {
-            offs = (*old)[0].toInt();
-            #ifdef LARGE_OFFSETS
-            offs += ((uint64_t)(*old)[1].toInt())<<32;
-            #endif
+            offs = new_offset_of(old);
         }
     }
 }
 
+size_t ClauseAllocator::num_segments() const
+{
+    size_t num = 0;
+    for(const Segment& seg: segs) {
+        num += seg.num_slots > 0;
+    }
+    return num;
+}
+
 size_t ClauseAllocator::mem_used() const
 {
     uint64_t mem = 0;
     mem += capacity*sizeof(BASE_DATA_TYPE);
+    mem += segs.capacity()*sizeof(Segment);
+    mem += seg_start.capacity()*sizeof(BASE_DATA_TYPE*);
 
     return mem;
 }
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "watched.h"
 #include "clause.h"
 #include "watcharray.h"
+#include "pagealloc.h"
 
 #include <stdlib.h>
 #include <map>
@@ -43,14 +44,31 @@ class PropEngine;
 using std::map;
 using std::vector;
 
+//A clause offset is the concatenation of the segment slot and the position
+//in the segment. A position is (1<<offset_shift) BASE_DATA_TYPE-s, so
+//a segment is (1<<(CL_SEG_BITS+offset_shift)) BASE_DATA_TYPE-s.
+#define CL_SEG_BITS 20
+#define CL_SEG_MASK ((1ULL << CL_SEG_BITS)-1)
+#define CL_MAX_OFFSET_SHIFT 8
+
 /**
 @brief Allocates memory for (xor) clauses
 
-This class allocates memory in large chunks, then distributes it to clauses when
-needed. When instructed, it consolidates the unused space (i.e. clauses free()-ed).
-Essentially, it is a stack-like allocator for clauses. It is useful to have
-this, because this way, we can address clauses according to their number,
-which is 32-bit, instead of their address, which might be 64-bit
+This class allocates memory in fixed-size segments, then distributes it to
+clauses when needed. Within a segment it is a stack-like allocator. Clauses
+are addressed by their offset, which is 32-bit, instead of their address, which
+might be 64-bit. Clauses longer than a segment get a run of consecutive
+segment slots backed by a single allocation.
+
+Clauses are aligned to (1<<offset_shift) BASE_DATA_TYPE-s, which lets the
+same 32-bit offsets address a larger arena at the price of some padding. The
+shift is increased during consolidation when the arena nears the limit of the
+current shift.
+
+When instructed, it consolidates the unused space (i.e. clauses free()-ed), but
+only evacuates the live clauses of the most fragmented segments. This way peak
+memory use and the time taken are bounded by the amount of data moved, not by
+the size of the whole clause database.
 */
 class ClauseAllocator {
     public:
@@ -81,8 +99,16 @@ class ClauseAllocator {
 
         inline Clause* ptr(const ClOffset offset) const
         {
-            return (Clause*)(&dataStart[offset]);
+            return (Clause*)(seg_start[offset >> CL_SEG_BITS]
+                + ((uint64_t)(offset & CL_SEG_MASK) << offset_shift));
+        }
+
+        void set_offset_shift(const uint32_t shift);
+        uint32_t get_offset_shift() const
+        {
+            return offset_shift;
         }
+        bool near_limit() const;
 
         void clauseFree(Clause* c);
         void clauseFree(ClOffset offset);
@@ -94,24 +120,61 @@ class ClauseAllocator {
         );
 
         size_t mem_used() const;
+        uint64_t live_bytes() const
+        {
+            return currentlyUsedSize*sizeof(BASE_DATA_TYPE);
+        }
+        size_t num_segments() const;
+        PageAlloc& get_pages()
+        {
+            return pages;
+        }
+        const PageAlloc& get_pages() const
+        {
+            return pages;
+        }
 
     private:
-        void update_offsets(
-            vector<ClOffset>& offsets,
-            ClOffset* newDataStart,
-            ClOffset*& new_ptr
-        );
-        void move_one_watchlist(
-            watch_subarray& ws, ClOffset* newDataStart, ClOffset*& new_ptr);
-
-        ClOffset move_cl(
-            ClOffset* newDataStart
-            , ClOffset*& new_ptr
-            , Clause* old
-        ) const;
-
-        BASE_DATA_TYPE* dataStart; ///<Stack starts at these positions
-        uint64_t size; ///<The number of BASE_DATA_TYPE datapieces currently used in each stack
+        struct Segment
+        {
+            BASE_DATA_TYPE* mem = NULL; ///<NULL if the slot is free
+            size_t head = 0; ///<Slot of the segment this slot belongs to
+            uint32_t num_slots = 0; ///<Non-zero only at the head slot
+            uint64_t words = 0; ///<Number of BASE_DATA_TYPE-s allocated
+            uint64_t used = 0; ///<Number of BASE_DATA_TYPE-s handed out
+            uint64_t live = 0; ///<Over-estimation of used minus freed
+            uint64_t live_cls = 0; ///<Number of clauses counted in live
+            bool evacuating = false;
+        };
+
+        void update_offsets(vector<ClOffset>& offsets);
+        void move_one_watchlist(watch_subarray& ws);
+        ClOffset move_cl(Clause* old);
+        ClOffset new_offset_of(const Clause* old) const;
+        Clause* evac_ptr(const ClOffset offset) const;
+        uint64_t seg_words() const;
+        uint64_t round_to_unit(const uint64_t words) const;
+        bool is_evacuating(const ClOffset offset) const;
+        size_t find_segment(const BASE_DATA_TYPE* p) const;
+        size_t open_segment(const uint64_t needed);
+        void free_segment(const size_t at);
+        void select_to_evacuate(const bool force, vector<size_t>& to_evac);
+        size_t mark_batch(const vector<size_t>& to_evac, size_t at);
+        void evacuate_marked(Solver* solver);
+
+        PageAlloc pages; ///<Backing memory of the segments
+
+        ///Start of memory for each segment slot, indexed by offset>>CL_SEG_BITS
+        vector<BASE_DATA_TYPE*> seg_start;
+        vector<Segment> segs;
+        map<const BASE_DATA_TYPE*, size_t> seg_by_addr;
+        size_t cur_seg; ///<Segment new clauses are put into
+        uint32_t offset_shift = 0;
+        uint32_t evac_shift = 0; ///<Shift of the segments being evacuated
+        size_t slots_used = 0; ///<Number of slots backed by a segment
+        uint64_t live_cls = 0; ///<Number of clauses not yet freed
+
+        uint64_t size; ///<The number of BASE_DATA_TYPE datapieces handed out in all segments
         /**
         @brief Clauses in the stack had this size when they were allocated
         This my NOT be their current size: the clauses may be shrinked during
@@ -101,6 +101,12 @@ public:
             conf = *_conf;
         }
         drat = new Drat;
+        cl_alloc.set_offset_shift(std::min<uint32_t>(conf.cl_offset_shift, CL_MAX_OFFSET_SHIFT));
+        cl_alloc.get_pages().set_huge_pages(
+            static_cast<HugePages>(std::min<uint32_t>(conf.huge_pages, 3)));
+        if (conf.watch_pool) {
+            watches.enable_pool(static_cast<HugePages>(std::min<uint32_t>(conf.huge_pages, 3)));
+        }
         assert(_must_interrupt_inter != NULL);
         must_interrupt_inter = _must_interrupt_inter;
         longRedCls.resize(3);
@@ -0,0 +1,72 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef __COMPILEDFOREST_H__
+#define __COMPILEDFOREST_H__
+
+#include <cstdint>
+
+namespace CMSat {
+
+/**
+@brief Tree ensemble compiled into tables by scripts/crystal/xgboost_codegen.py
+
+All trees are complete binary trees of the same depth, internal nodes in BFS
+order. A sample goes left if its feature is below the threshold, missing
+features go the default way. This makes evaluation a fixed number of steps
+without data-dependent branches.
+*/
+struct CompiledForest
+{
+    uint32_t num_trees;
+    uint32_t depth;
+    float base_score;
+    const uint16_t* feat;
+    const float* thr;
+    const uint8_t* def_left;
+    const float* leaf;
+
+    float predict(const float* row, const float missing) const
+    {
+        const uint32_t num_internal = (1U << depth) - 1;
+        const uint32_t num_leaves = 1U << depth;
+        float sum = base_score;
+        for(uint32_t t = 0; t < num_trees; t++) {
+            const uint32_t base = t*num_internal;
+            uint32_t i = 0;
+            for(uint32_t d = 0; d < depth; d++) {
+                const uint32_t at = base + i;
+                const float x = row[feat[at]];
+                const bool is_missing = (x == missing) | (x != x);
+                const uint32_t right = is_missing ? !def_left[at] : !(x < thr[at]);
+                i = 2*i + 1 + right;
+            }
+            sum += leaf[t*num_leaves + i - num_internal];
+        }
+        return sum;
+    }
+};
+
+}
+
+#endif //__COMPILEDFOREST_H__
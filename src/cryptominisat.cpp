@@ -25,6 +25,14 @@ THE SOFTWARE.
 #include "solver.h"
 #include "drat.h"
 #include "shareddata.h"
+#include "datasync.h"
+#include "eventtrace.h"
+#include "cubescheduler.h"
+#include "enumerator.h"
+#include "modelcounter.h"
+#ifdef USE_DISTRIBUTED
+#include "distcoordinator.h"
+#endif
 #include <fstream>
 
 #include <thread>
@@ -65,12 +73,14 @@ namespace CMSat {
 
             delete log; //this will also close the file
             delete shared_data;
+            delete trace_dump;
         }
         CMSatPrivateData(const CMSatPrivateData&) = delete;
         CMSatPrivateData& operator=(const CMSatPrivateData&) = delete;
 
         vector<Solver*> solvers;
         SharedData *shared_data = NULL;
+        TraceDumpRequest* trace_dump = NULL;
         int which_solved = 0;
         std::atomic<bool>* must_interrupt;
         bool must_interrupt_needs_delete = false;
@@ -93,6 +103,7 @@ namespace CMSat {
         uint64_t previous_sum_conflicts = 0;
         uint64_t previous_sum_propagations = 0;
         uint64_t previous_sum_decisions = 0;
+        SolverStats previous_stats;
         vector<double> cpu_times;
     };
 }
@@ -409,6 +420,10 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
         }
         data->solvers[i]->setConf(conf);
         data->solvers[i]->set_shared_data((SharedData*)data->shared_data);
+        data->solvers[i]->trace_dump = data->trace_dump;
+    }
+    if (data->trace_dump) {
+        data->trace_dump->set_num_threads(data->solvers.size());
     }
 }
 
@@ -611,6 +626,14 @@ DLL_PUBLIC void SATSolver::set_sampling_vars(vector<uint32_t>* sampl_vars)
     }
 }
 
+DLL_PUBLIC void SATSolver::set_extend_vars(vector<uint32_t>* vars)
+{
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.extend_vars = vars;
+    }
+}
+
 
 DLL_PUBLIC void SATSolver::set_verbosity(unsigned verbosity)
 {
@@ -714,6 +737,8 @@ struct OneThreadCalc
 
     void operator()()
     {
+        //Runs on the search thread itself, so its affinity is ours to set
+        data_for_thread.solvers[tid]->place_on_numa_node();
         if (print_thread_start_and_finish) {
             start_time = cpuTime();
             //data_for_thread.update_mutex->lock();
@@ -811,16 +836,28 @@ lbool calc(
     //Multi-thread from now on.
     DataForThread data_for_thread(data, assumptions);
     std::vector<std::thread> thds;
-    for(size_t i = 0
-        ; i < data->solvers.size()
-        ; i++
-    ) {
-        thds.push_back(thread(OneThreadCalc(data_for_thread, i, solve, only_sampling_solution)));
-    }
-    for(std::thread& thread : thds){
-        thread.join();
+    lbool real_ret;
+    if (solve && data->solvers[0]->conf.cube_and_conquer) {
+        for(size_t i = 0; i < data->solvers.size(); i++) {
+            thds.push_back(thread(OneThreadAddCls(data_for_thread, i)));
+        }
+        for(std::thread& thread : thds){
+            thread.join();
+        }
+        CubeScheduler scheduler(data->solvers, assumptions, only_sampling_solution);
+        real_ret = scheduler.solve(data->which_solved);
+    } else {
+        for(size_t i = 0
+            ; i < data->solvers.size()
+            ; i++
+        ) {
+            thds.push_back(thread(OneThreadCalc(data_for_thread, i, solve, only_sampling_solution)));
+        }
+        for(std::thread& thread : thds){
+            thread.join();
+        }
+        real_ret = *data_for_thread.ret;
     }
-    lbool real_ret = *data_for_thread.ret;
 
     //This does it for all of them, there is only one must-interrupt
     data_for_thread.solvers[0]->unset_must_interrupt_asap();
@@ -849,8 +886,18 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions, bool only_sa
     data->previous_sum_conflicts = get_sum_conflicts();
     data->previous_sum_propagations = get_sum_propagations();
     data->previous_sum_decisions = get_sum_decisions();
+    data->previous_stats = get_stats();
+
+    const lbool ret = calc(assumptions, true, data, only_sampling_solution);
 
-    return calc(assumptions, true, data, only_sampling_solution);
+    //UNSAT under assumptions is not an answer to the distributed problem
+    if (ret == l_True
+        || (ret == l_False && (assumptions == NULL || assumptions->empty()))
+    ) {
+        data->solvers[0]->datasync->dist_report_result(
+            ret, ret == l_True ? get_model() : vector<lbool>());
+    }
+    return ret;
 }
 
 DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions)
@@ -870,10 +917,137 @@ DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions)
     data->previous_sum_conflicts = get_sum_conflicts();
     data->previous_sum_propagations = get_sum_propagations();
     data->previous_sum_decisions = get_sum_decisions();
+    data->previous_stats = get_stats();
 
     return calc(assumptions, false, data);
 }
 
+DLL_PUBLIC lbool SATSolver::enumerate(
+    const std::function<bool(const vector<lbool>&)>& callback
+    , const vector<unsigned>* projection
+    , uint64_t max_models
+    , const vector<Lit>* assumptions
+) {
+    if (data->solvers.size() > 1) {
+        const char err[] = "ERROR: enumerate() can only be used with a single thread";
+        std::cerr << err << endl;
+        throw std::runtime_error(err);
+    }
+    Solver& s = *data->solvers[0];
+    if (s.drat->enabled() || s.conf.simulate_drat) {
+        const char err[] = "ERROR: enumerate() cannot be used with DRAT, the blocking clauses cannot be proven";
+        std::cerr << err << endl;
+        throw std::runtime_error(err);
+    }
+    if (data->promised_single_call
+        && data->num_solve_simplify_calls > 0
+    ) {
+        cout
+        << "ERROR: You promised to only call solve/simplify() once"
+        << "       by calling set_single_run(), but you violated it. Exiting."
+        << endl;
+        exit(-1);
+    }
+    data->num_solve_simplify_calls++;
+
+    //set information data (props, confl, dec)
+    data->previous_sum_conflicts = get_sum_conflicts();
+    data->previous_sum_propagations = get_sum_propagations();
+    data->previous_sum_decisions = get_sum_decisions();
+    data->previous_stats = get_stats();
+
+    data->must_interrupt->store(false, std::memory_order_relaxed);
+    if (data->timeout != std::numeric_limits<double>::max()) {
+        s.conf.maxTime = cpuTime() + data->timeout;
+    }
+    s.new_vars(data->vars_to_add);
+    data->vars_to_add = 0;
+
+    vector<uint32_t> vars;
+    if (projection) {
+        for(const unsigned v: *projection) {
+            if (v >= nVars()) {
+                const char err[] = "ERROR: enumerate() projection variable is larger than the number of variables";
+                std::cerr << err << endl;
+                throw std::runtime_error(err);
+            }
+            vars.push_back(v);
+        }
+    } else {
+        for(uint32_t v = 0; v < nVars(); v++) {
+            vars.push_back(v);
+        }
+    }
+
+    Enumerator enumerator(&s, vars, callback, max_models);
+    const lbool ret = enumerator.run(assumptions);
+    data->which_solved = 0;
+    data->okay = s.okay();
+    data->cpu_times[0] = cpuTime();
+    return ret;
+}
+
+DLL_PUBLIC lbool SATSolver::count_models(
+    std::string& count
+    , const vector<unsigned>* projection
+    , const vector<Lit>* assumptions
+) {
+    if (data->solvers.size() > 1) {
+        const char err[] = "ERROR: count_models() can only be used with a single thread";
+        std::cerr << err << endl;
+        throw std::runtime_error(err);
+    }
+    Solver& s = *data->solvers[0];
+    if (data->promised_single_call
+        && data->num_solve_simplify_calls > 0
+    ) {
+        cout
+        << "ERROR: You promised to only call solve/simplify() once"
+        << "       by calling set_single_run(), but you violated it. Exiting."
+        << endl;
+        exit(-1);
+    }
+    data->num_solve_simplify_calls++;
+
+    //set information data (props, confl, dec)
+    data->previous_sum_conflicts = get_sum_conflicts();
+    data->previous_sum_propagations = get_sum_propagations();
+    data->previous_sum_decisions = get_sum_decisions();
+    data->previous_stats = get_stats();
+
+    data->must_interrupt->store(false, std::memory_order_relaxed);
+    if (data->timeout != std::numeric_limits<double>::max()) {
+        s.conf.maxTime = cpuTime() + data->timeout;
+    }
+    s.new_vars(data->vars_to_add);
+    data->vars_to_add = 0;
+
+    vector<uint32_t> vars;
+    if (projection) {
+        for(const unsigned v: *projection) {
+            if (v >= nVars()) {
+                const char err[] = "ERROR: count_models() projection variable is larger than the number of variables";
+                std::cerr << err << endl;
+                throw std::runtime_error(err);
+            }
+            vars.push_back(v);
+        }
+    } else {
+        for(uint32_t v = 0; v < nVars(); v++) {
+            vars.push_back(v);
+        }
+    }
+
+    BigNum num;
+    ModelCounter counter(&s);
+    const lbool ret = counter.count(vars, assumptions, num);
+    count = ret == l_Undef ? std::string() : num.to_string();
+    data->which_solved = 0;
+    data->okay = s.okay();
+    data->cpu_times[0] = cpuTime();
+    return ret;
+}
+
 DLL_PUBLIC const vector< lbool >& SATSolver::get_model() const
 {
     return data->solvers[data->which_solved]->get_model();
@@ -1021,6 +1195,41 @@ void DLL_PUBLIC SATSolver::add_in_partial_solving_stats()
     data->interrupted = true;
 }
 
+DLL_PUBLIC bool SATSolver::dump_event_trace(std::string fname) const
+{
+    vector<const EventTrace*> traces;
+    for(const Solver* s: data->solvers) {
+        if (s->trace) {
+            traces.push_back(s->trace);
+        }
+    }
+    if (traces.empty()) {
+        return false;
+    }
+
+    return EventTrace::dump(traces, fname);
+}
+
+DLL_PUBLIC void SATSolver::set_event_trace_dump_file(std::string fname)
+{
+    if (!data->solvers[0]->trace) {
+        return;
+    }
+
+    delete data->trace_dump;
+    data->trace_dump = new TraceDumpRequest(fname, data->solvers.size());
+    for(Solver* s: data->solvers) {
+        s->trace_dump = data->trace_dump;
+    }
+}
+
+DLL_PUBLIC void SATSolver::request_event_trace_dump()
+{
+    if (data->trace_dump) {
+        data->trace_dump->request();
+    }
+}
+
 DLL_PUBLIC std::vector<Lit> SATSolver::get_zero_assigned_lits() const
 {
     return data->solvers[data->which_solved]->get_zero_assigned_lits();
@@ -1147,6 +1356,77 @@ DLL_PUBLIC uint64_t SATSolver::get_sum_decisions() const
     return total_decisions;
 }
 
+static ThreadStats thread_stats(const Solver* s)
+{
+    ThreadStats t;
+    t.conflicts = s->sumConflicts;
+    t.propagations = s->sumPropStats.propagations;
+    t.decisions = s->sumSearchStats.decisions;
+
+    const PhaseTimer& timer = s->phase_timer;
+    t.cpu_time = timer.cpu_time;
+    for(uint32_t i = 0; i < PhaseTimer::num_phases; i++) {
+        PhaseStats& p = t.phases[PhaseTimer::name((PhaseTimer::Phase)i)];
+        p.calls = timer.calls[i];
+        p.time = (double)timer.ns[i]/1e9;
+    }
+    for(const auto& tech: timer.techniques) {
+        PhaseStats& p = t.techniques[tech.first];
+        p.calls = tech.second.calls;
+        p.time = (double)tech.second.ns/1e9;
+    }
+
+    return t;
+}
+
+//mult is 1 to add, -1 to subtract
+static void add_stats(
+    std::map<std::string, PhaseStats>& to
+    , const std::map<std::string, PhaseStats>& from
+    , const int mult
+) {
+    for(const auto& p: from) {
+        PhaseStats& x = to[p.first];
+        x.calls += mult*(int64_t)p.second.calls;
+        x.time += mult*p.second.time;
+    }
+}
+
+static void add_stats(ThreadStats& to, const ThreadStats& from, const int mult)
+{
+    to.conflicts += mult*(int64_t)from.conflicts;
+    to.propagations += mult*(int64_t)from.propagations;
+    to.decisions += mult*(int64_t)from.decisions;
+    to.cpu_time += mult*from.cpu_time;
+    add_stats(to.phases, from.phases, mult);
+    add_stats(to.techniques, from.techniques, mult);
+}
+
+DLL_PUBLIC SolverStats SATSolver::get_stats() const
+{
+    SolverStats stats;
+    for(const Solver* s: data->solvers) {
+        stats.threads.push_back(thread_stats(s));
+        add_stats(stats.total, stats.threads.back(), 1);
+    }
+
+    return stats;
+}
+
+DLL_PUBLIC SolverStats SATSolver::get_last_stats() const
+{
+    SolverStats stats = get_stats();
+    const SolverStats& prev = data->previous_stats;
+    if (prev.threads.size() == stats.threads.size()) {
+        for(size_t i = 0; i < stats.threads.size(); i++) {
+            add_stats(stats.threads[i], prev.threads[i], -1);
+        }
+        add_stats(stats.total, prev.total, -1);
+    }
+
+    return stats;
+}
+
 DLL_PUBLIC uint64_t SATSolver::get_last_conflicts()
 {
     return get_sum_conflicts() - data->previous_sum_conflicts;
@@ -1366,6 +1646,32 @@ DLL_PUBLIC void SATSolver::set_xor_detach(bool val)
     }
 }
 
+DLL_PUBLIC void SATSolver::set_dist_worker(const std::string& host, unsigned port)
+{
+    for (size_t i = 0; i < data->solvers.size(); ++i) {
+        Solver& s = *data->solvers[i];
+        s.conf.dist_host = host;
+        s.conf.dist_port = port;
+    }
+}
+
+DLL_PUBLIC lbool SATSolver::run_dist_coordinator(
+    unsigned port
+    , unsigned num_workers
+    , std::vector<lbool>& model
+    , unsigned verbosity
+    , double timeout
+) {
+    #ifdef USE_DISTRIBUTED
+    DistCoordinator coord(port, num_workers, verbosity);
+    return coord.run(model, timeout);
+    #else
+    const char err[] = "ERROR: CryptoMiniSat was not compiled with distributed support";
+    std::cerr << err << endl;
+    throw std::runtime_error(err);
+    #endif
+}
+
 
 DLL_PUBLIC void SATSolver::set_yes_comphandler()
 {
@@ -0,0 +1,325 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "cubescheduler.h"
+#include "lookahead.h"
+#include "solver.h"
+#include "time_mem.h"
+
+#include <thread>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+CubeScheduler::CubeScheduler(
+    const vector<Solver*>& _solvers
+    , const vector<Lit>* _assumptions
+    , bool _only_sampling_solution
+) :
+    solvers(_solvers)
+    , only_sampling_solution(_only_sampling_solution)
+{
+    if (_assumptions) {
+        assumptions = *_assumptions;
+    }
+}
+
+uint32_t CubeScheduler::initial_depth() const
+{
+    const SolverConf& conf = solvers[0]->conf;
+    if (conf.cube_depth > 0) {
+        return conf.cube_depth;
+    }
+
+    //About 16 cubes per thread
+    return std::ceil(std::log2((double)solvers.size())) + 4;
+}
+
+lbool CubeScheduler::solve(int& which_solved)
+{
+    const double myTime = cpuTimeTotal();
+    Solver* s0 = solvers[0];
+    for(const Solver* s: solvers) {
+        orig_max_confl.push_back(s->conf.max_confl);
+        orig_max_time.push_back(s->conf.maxTime);
+    }
+
+    vector<vector<Lit>> cubes;
+    Lookahead lookahead(s0);
+    if (!lookahead.split(assumptions, initial_depth(), cubes)) {
+        //Refuted by lookahead, let the solver derive the final conflict
+        which_solved = 0;
+        return s0->solve_with_assumptions(&assumptions, only_sampling_solution);
+    }
+    units = lookahead.get_units();
+    conflict_all_assumps = lookahead.get_dropped();
+
+    queues.resize(solvers.size());
+    for(size_t i = 0; i < cubes.size(); i++) {
+        Cube cube;
+        cube.lits.assign(cubes[i].begin() + assumptions.size(), cubes[i].end());
+        queues[i % queues.size()].push_back(std::move(cube));
+    }
+    outstanding = cubes.size();
+    stats.initial_cubes = cubes.size();
+
+    vector<std::thread> thds;
+    for(size_t i = 0; i < solvers.size(); i++) {
+        thds.push_back(std::thread(&CubeScheduler::worker, this, i));
+    }
+    for(std::thread& thd: thds) {
+        thd.join();
+    }
+
+    if (all_refuted) {
+        set_final_conflict();
+    }
+    for(Solver* s: solvers) {
+        s->conf.max_confl = std::numeric_limits<long>::max();
+        s->conf.maxTime = std::numeric_limits<double>::max();
+    }
+
+    if (s0->conf.verbosity) {
+        cout << "c [cube] result: " << result
+        << " initial cubes: " << stats.initial_cubes
+        << " refuted: " << stats.refuted_cubes
+        << " resplits: " << stats.resplits
+        << " stolen: " << stats.stolen
+        << s0->conf.print_times(cpuTimeTotal() - myTime)
+        << endl;
+    }
+
+    which_solved = which;
+    return result;
+}
+
+void CubeScheduler::worker(size_t tid)
+{
+    Solver* s = solvers[tid];
+    for(const Lit lit: units) {
+        if (!s->add_clause_outer(vector<Lit>{lit})) {
+            finish(l_False, tid);
+            return;
+        }
+    }
+
+    Cube cube;
+    vector<Lit> assumps;
+    while(get_cube(tid, cube)) {
+        assumps = assumptions;
+        assumps.insert(assumps.end(), cube.lits.begin(), cube.lits.end());
+
+        //solve() resets the limits every time
+        s->conf.maxTime = orig_max_time[tid];
+        s->conf.max_confl = orig_max_confl[tid];
+        if (!cube.unlimited) {
+            const uint64_t limit = s->sumConflicts + s->conf.cube_confl_budget;
+            if (limit < (uint64_t)s->conf.max_confl) {
+                s->conf.max_confl = limit;
+            }
+        }
+
+        const lbool ret = s->solve_with_assumptions(&assumps, only_sampling_solution);
+        if (ret == l_True) {
+            finish(l_True, tid);
+            return;
+        }
+        if (ret == l_False) {
+            if (!s->okay() || !cube_touches_conflict(s, cube.lits)) {
+                //UNSAT without the cube
+                finish(l_False, tid);
+                return;
+            }
+            cube_refuted(tid, cube.lits, false);
+            continue;
+        }
+
+        if (s->must_interrupt_asap()
+            || cpuTime() > orig_max_time[tid]
+            || s->sumConflicts >= (uint64_t)orig_max_confl[tid]
+        ) {
+            finish(l_Undef, tid);
+            return;
+        }
+        resplit(tid, cube);
+    }
+}
+
+bool CubeScheduler::get_cube(size_t tid, Cube& cube)
+{
+    std::unique_lock<std::mutex> lock(mu);
+    while(true) {
+        if (done) {
+            return false;
+        }
+
+        if (!queues[tid].empty()) {
+            cube = std::move(queues[tid].back());
+            queues[tid].pop_back();
+            return true;
+        }
+
+        size_t victim = tid;
+        for(size_t i = 0; i < queues.size(); i++) {
+            if (queues[i].size() > queues[victim].size()) {
+                victim = i;
+            }
+        }
+        if (!queues[victim].empty()) {
+            cube = std::move(queues[victim].front());
+            queues[victim].pop_front();
+            stats.stolen++;
+            return true;
+        }
+
+        //Others may still re-split their cubes
+        if (outstanding == 0) {
+            return false;
+        }
+        cv.wait(lock);
+    }
+}
+
+bool CubeScheduler::cube_touches_conflict(
+    const Solver* s
+    , const vector<Lit>& cube
+) const {
+    for(const Lit lit: s->conflict) {
+        if (std::find(cube.begin(), cube.end(), ~lit) != cube.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CubeScheduler::cube_refuted(
+    size_t tid
+    , const vector<Lit>& cube
+    , bool dropped
+) {
+    std::lock_guard<std::mutex> lock(mu);
+    if (dropped) {
+        //Lookahead does not tell which assumptions were needed
+        conflict_all_assumps = true;
+    } else {
+        for(const Lit lit: solvers[tid]->conflict) {
+            if (std::find(cube.begin(), cube.end(), ~lit) == cube.end()
+                && std::find(assump_conflict.begin(), assump_conflict.end(), lit)
+                    == assump_conflict.end()
+            ) {
+                assump_conflict.push_back(lit);
+            }
+        }
+    }
+    stats.refuted_cubes++;
+
+    assert(outstanding > 0);
+    outstanding--;
+    if (outstanding == 0 && !done) {
+        done = true;
+        all_refuted = true;
+        result = l_False;
+        which = tid;
+    }
+    cv.notify_all();
+}
+
+void CubeScheduler::resplit(size_t tid, const Cube& cube)
+{
+    Solver* s = solvers[tid];
+    vector<Lit> prefix(assumptions);
+    prefix.insert(prefix.end(), cube.lits.begin(), cube.lits.end());
+
+    vector<vector<Lit>> cubes;
+    Lookahead lookahead(s);
+    const bool ok = lookahead.split(prefix, s->conf.cube_resplit_depth, cubes);
+    if (!s->okay()) {
+        finish(l_False, tid);
+        return;
+    }
+    if (!ok) {
+        cube_refuted(tid, cube.lits, true);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mu);
+    if (lookahead.get_dropped()) {
+        conflict_all_assumps = true;
+    }
+    if (cubes.size() == 1) {
+        //Nothing left to branch on, solve it without a budget
+        Cube again;
+        again.lits = cube.lits;
+        again.unlimited = true;
+        queues[tid].push_back(std::move(again));
+        return;
+    }
+
+    stats.resplits++;
+    outstanding += cubes.size() - 1;
+    for(const vector<Lit>& c: cubes) {
+        Cube sub;
+        sub.lits.assign(c.begin() + assumptions.size(), c.end());
+        queues[tid].push_back(std::move(sub));
+    }
+    cv.notify_all();
+}
+
+void CubeScheduler::finish(lbool res, size_t tid)
+{
+    std::lock_guard<std::mutex> lock(mu);
+    if (!done) {
+        done = true;
+        result = res;
+        which = tid;
+    }
+
+    //will interrupt all of them
+    solvers[0]->set_must_interrupt_asap();
+    cv.notify_all();
+}
+
+//Every cube got refuted, and cubes cover the whole search space
+void CubeScheduler::set_final_conflict()
+{
+    if (assumptions.empty()) {
+        for(Solver* s: solvers) {
+            s->ok = false;
+            s->conflict.clear();
+        }
+        return;
+    }
+
+    Solver* s = solvers[which];
+    if (conflict_all_assumps) {
+        s->conflict.clear();
+        for(const Lit lit: assumptions) {
+            s->conflict.push_back(~lit);
+        }
+    } else {
+        s->conflict = assump_conflict;
+    }
+}
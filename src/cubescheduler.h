@@ -0,0 +1,120 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __CUBESCHEDULER_H__
+#define __CUBESCHEDULER_H__
+
+#include "solvertypes.h"
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Cube-and-conquer over the solvers of a multi-threaded SATSolver
+
+The first solver splits the problem into cubes by lookahead (see Lookahead).
+Each solver then solves cubes as extra assumptions, sharing learnt units and
+binaries with the others through the usual SharedData. Every solver has its
+own deque of cubes: it takes from the back, and when it runs dry it steals
+from the front of the fullest deque. A cube that is not finished within
+conf.cube_confl_budget conflicts is split again by lookahead on the solver
+that worked on it, and the sub-cubes go to its own deque.
+
+All solvers must already contain all the clauses.
+*/
+class CubeScheduler
+{
+public:
+    CubeScheduler(
+        const vector<Solver*>& solvers
+        , const vector<Lit>* assumptions
+        , bool only_sampling_solution
+    );
+    CubeScheduler(const CubeScheduler&) = delete;
+    CubeScheduler& operator=(const CubeScheduler&) = delete;
+
+    //"which_solved" is set to the solver that holds the model or the final
+    //conflict
+    lbool solve(int& which_solved);
+
+    struct Stats
+    {
+        uint64_t initial_cubes = 0;
+        uint64_t refuted_cubes = 0;
+        uint64_t resplits = 0;
+        uint64_t stolen = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    struct Cube
+    {
+        vector<Lit> lits;
+        bool unlimited = false; //could not be split further
+    };
+    void worker(size_t tid);
+    bool get_cube(size_t tid, Cube& cube);
+    bool cube_touches_conflict(const Solver* s, const vector<Lit>& cube) const;
+    void cube_refuted(size_t tid, const vector<Lit>& cube, bool dropped);
+    void resplit(size_t tid, const Cube& cube);
+    void finish(lbool result, size_t tid);
+    void set_final_conflict();
+    uint32_t initial_depth() const;
+
+    const vector<Solver*>& solvers;
+    vector<Lit> assumptions;
+    const bool only_sampling_solution;
+    vector<long> orig_max_confl;
+    vector<double> orig_max_time;
+    vector<Lit> units;
+
+    //Protected by the mutex
+    std::mutex mu;
+    std::condition_variable cv;
+    vector<std::deque<Cube>> queues;
+    uint64_t outstanding = 0; //in the queues or being solved
+    bool done = false;
+    bool all_refuted = false;
+    lbool result = l_Undef;
+    int which = 0;
+    vector<Lit> assump_conflict; //union of the refutations' assumption parts
+    bool conflict_all_assumps = false;
+    Stats stats;
+};
+
+inline const CubeScheduler::Stats& CubeScheduler::get_stats() const
+{
+    return stats;
+}
+
+}
+
+#endif //__CUBESCHEDULER_H__
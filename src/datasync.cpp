@@ -24,29 +24,30 @@ THE SOFTWARE.
 #include "varreplacer.h"
 #include "solver.h"
 #include "shareddata.h"
+#include "eventtrace.h"
+#ifdef USE_DISTRIBUTED
+#include "distconn.h"
+#endif
 #include <iomanip>
 
 using namespace CMSat;
 
-DataSync::DataSync(Solver* _solver, SharedData* _sharedData, bool _is_mpi) :
+DataSync::DataSync(Solver* _solver, SharedData* _sharedData) :
     solver(_solver)
     , sharedData(_sharedData)
-    , is_mpi(_is_mpi)
     , seen(solver->seen)
     , toClear(solver->toClear)
 {
-#ifdef USE_MPI
-    if (is_mpi) {
-        int err;
-        err = MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
-        assert(err == MPI_SUCCESS);
+}
 
-        err = MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
-        assert(err == MPI_SUCCESS);
-        release_assert(!(mpiSize > 1 && mpiRank == 0));
-        assert(!(mpiSize > 1 && sharedData == NULL));
-    }
-#endif
+DataSync::~DataSync()
+{
+    close_dist();
+}
+
+bool DataSync::enabled()
+{
+    return sharedData != NULL || dist_wanted();
 }
 
 void DataSync::set_shared_data(SharedData* _sharedData)
@@ -56,7 +57,7 @@ void DataSync::set_shared_data(SharedData* _sharedData)
 
 void DataSync::new_var(const bool bva)
 {
-    if (!enabled())
+    if (sharedData == NULL)
         return;
 
     if (!bva) {
@@ -68,7 +69,7 @@ void DataSync::new_var(const bool bva)
 
 void DataSync::new_vars(size_t n)
 {
-    if (!enabled())
+    if (sharedData == NULL)
         return;
 
     syncFinish.insert(syncFinish.end(), 2*n, 0);
@@ -92,14 +93,20 @@ void DataSync::updateVars(
 
 bool DataSync::syncData()
 {
-    if (!enabled()
-        || lastSyncConf + solver->conf.sync_every_confl >= solver->sumConflicts
-    ) {
+    if (!enabled()) {
+        return true;
+    }
+    const bool shared_due = sharedData != NULL
+        && lastSyncConf + solver->conf.sync_every_confl < solver->sumConflicts;
+    const bool dist_due = dist_wanted()
+        && lastDistSyncConf + solver->conf.dist_sync_every_confl < solver->sumConflicts;
+    if (!shared_due && !dist_due) {
         return true;
     }
     numCalls++;
+    PhaseScope phase(solver->phase_timer, PhaseTimer::sync);
+    const uint64_t trace_start = solver->trace ? EventTrace::now() : 0;
 
-    assert(sharedData != NULL);
     assert(solver->decisionLevel() == 0);
 
     if (must_rebuild_bva_map) {
@@ -108,35 +115,32 @@ bool DataSync::syncData()
     }
 
     bool ok;
-    sharedData->unit_mutex.lock();
-    ok = shareUnitData();
-    sharedData->unit_mutex.unlock();
-    if (!ok) return false;
-
-    sharedData->bin_mutex.lock();
-    extend_bins_if_needed();
-    clear_set_binary_values();
-    ok = shareBinData();
-    sharedData->bin_mutex.unlock();
-    if (!ok) return false;
-
-    #ifdef USE_MPI
-    if (is_mpi && mpiSize > 1 && solver->conf.thread_num == 0) {
+    if (shared_due) {
         sharedData->unit_mutex.lock();
+        ok = shareUnitData();
+        sharedData->unit_mutex.unlock();
+        if (!ok) return false;
+
         sharedData->bin_mutex.lock();
-        ok = syncFromMPI();
-        if (ok && numCalls % 2 == 1) {
-            syncToMPI();
-        }
+        extend_bins_if_needed();
+        clear_set_binary_values();
+        ok = shareBinData();
+        sharedData->bin_mutex.unlock();
         if (!ok) return false;
+        lastSyncConf = solver->sumConflicts;
     }
 
-    if (is_mpi) {
-        getNeedToInterruptFromMPI();
+    if (dist_due) {
+        ok = syncFromDist();
+        if (!ok) return false;
+        syncToDist();
+        lastDistSyncConf = solver->sumConflicts;
     }
-    #endif
 
-    lastSyncConf = solver->sumConflicts;
+    if (solver->trace) {
+        solver->trace->span(TraceType::sync, "sync", trace_start
+            , solver->sumConflicts, numCalls);
+    }
 
     return true;
 }
@@ -387,198 +391,274 @@ void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
     if (lit1.toInt() > lit2.toInt()) {
         std::swap(lit1, lit2);
     }
-    newBinClauses.push_back(std::make_pair(lit1, lit2));
+    if (sharedData != NULL) {
+        newBinClauses.push_back(std::make_pair(lit1, lit2));
+    }
+    if (dist_wanted()) {
+        dist_out.push_back(2);
+        dist_out.push_back(1);
+        dist_out.push_back(lit1.toInt());
+        dist_out.push_back(lit2.toInt());
+        stats.sentDistCls++;
+    }
 }
 
-
 ///////////////////////////////////////
-// MPI
+// Distributed mode
 ///////////////////////////////////////
 
-#ifdef USE_MPI
-void DataSync::getNeedToInterruptFromMPI()
-{
-    int flag;
-    MPI_Status status;
-    int err = MPI_Iprobe(0, 1, MPI_COMM_WORLD, &flag, &status);
-    assert(err == MPI_SUCCESS);
-    if (flag == false) {
-        return;
-    }
+//How long a worker waits for the coordinator to come up (s)
+static const double dist_connect_timeout = 10.0;
 
-    char* buf = NULL;
-    err = MPI_Recv((unsigned*)buf, 0, MPI_UNSIGNED, 0, 1, MPI_COMM_WORLD, &status);
-    assert(err == MPI_SUCCESS);
-    solver->set_must_interrupt_asap();
+bool DataSync::dist_wanted() const
+{
+    return !dist_done
+        && solver->conf.thread_num == 0
+        && !solver->conf.dist_host.empty();
 }
 
-bool DataSync::syncFromMPI()
+void DataSync::signalNewLongClause(const vector<Lit>& cl, const uint32_t glue)
 {
-    int err;
-    MPI_Status status;
-    int flag;
-    int count;
-    uint32_t tmp = 0;
-
-    uint32_t thisMpiRecvUnitData = 0;
-    uint32_t thisMpiRecvBinData = 0;
-
-    err = MPI_Iprobe(0, 0, MPI_COMM_WORLD, &flag, &status);
-    assert(err == MPI_SUCCESS);
-    if (flag == false) return true;
-
-    err = MPI_Get_count(&status, MPI_UNSIGNED, &count);
-    assert(err == MPI_SUCCESS);
-    #ifdef VERBOSE_DEBUG_MPI_SENDRCV
-    std::cout << "-->> MPI " << mpiRank << " Received " << count << " uint32_t-s" << std::endl;
-    #endif
+    if (glue > solver->conf.dist_max_glue
+        || cl.size() > solver->conf.dist_max_size
+        || !dist_wanted()
+    ) {
+        return;
+    }
 
-    uint32_t* buf = new uint32_t[count];
-    err = MPI_Recv((unsigned*)buf, count, MPI_UNSIGNED, 0, 0, MPI_COMM_WORLD, &status);
-    assert(err == MPI_SUCCESS);
-
-    //Unit clauses
-    int at = 0;
-    assert(solver->nVars() == buf[at]);
-    at++;
-    for (uint32_t var = 0; var < solver->nVars(); var++, at++) {
-        const lbool otherVal = toLbool(buf[at]);
-        if (!sync_mpi_unit(otherVal, var, NULL, thisMpiRecvUnitData, tmp)) {
-            #ifdef VERBOSE_DEBUG_MPI_SENDRCV
-            std::cout << "-->> MPI " << mpiRank << " solver FALSE" << std::endl;
-            #endif
-            goto end;
-        }
+    if (must_rebuild_bva_map) {
+        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+        must_rebuild_bva_map = false;
     }
-    solver->ok = solver->propagate<true>().isNULL();
-    if (!solver->ok) goto end;
-    mpiRecvUnitData += thisMpiRecvUnitData;
-
-    //Binary clauses
-    assert(buf[at] == solver->nVars()*2);
-    at++;
-    for (uint32_t wsLit = 0; wsLit < solver->nVars()*2; wsLit++) {
-        Lit lit = ~Lit::toLit(wsLit);
-        uint32_t num = buf[at];
-        at++;
-        for (uint32_t i = 0; i < num; i++, at++) {
-            Lit otherLit = Lit::toLit(buf[at]);
-            addOneBinToOthers(lit, otherLit);
-            thisMpiRecvBinData++;
+
+    for(const Lit lit: cl) {
+        if (solver->varData[lit.var()].is_bva) {
+            return;
         }
     }
-    mpiRecvBinData += thisMpiRecvBinData;
 
-    end:
-    #ifdef VERBOSE_DEBUG_MPI_SENDRCV
-    std::cout << "-->> MPI " << mpiRank << " Received " << thisMpiRecvUnitData << " units" << std::endl;
-    std::cout << "-->> MPI " << mpiRank << " Received " << thisMpiRecvBinData << " bins" << std::endl;
-    std::cout << "-->> MPI " << mpiRank << " Received " << thisMpiRecvTriData << " tris" << std::endl;
-    #endif
+    dist_out.push_back(cl.size());
+    dist_out.push_back(glue);
+    for(Lit lit: cl) {
+        lit = solver->map_inter_to_outer(lit);
+        lit = map_outside_without_bva(lit);
+        dist_out.push_back(lit.toInt());
+    }
+    stats.sentDistCls++;
+}
 
-    delete[] buf;
-    return solver->ok;
+void DataSync::close_dist()
+{
+    #ifdef USE_DISTRIBUTED
+    delete dist;
+    #endif
+    dist = NULL;
 }
 
-void DataSync::syncToMPI()
+bool DataSync::connect_dist()
 {
-    int err;
-    if (mpiSendData != NULL) {
-        MPI_Status status;
-        err = MPI_Wait(&sendReq, &status);
-        assert(err == MPI_SUCCESS);
-        delete mpiSendData;
-        mpiSendData = NULL;
-    }
-
-    vector<uint32_t> data;
-    data.push_back((uint32_t)solver->nVars());
-    for (uint32_t var = 0; var < solver->nVars(); var++) {
-        data.push_back(toInt(solver->value(var)));
-    }
-
-    //Binary
-    uint32_t thisMpiSentBinData = 0;
-    data.push_back((uint32_t)solver->nVars()*2);
-    uint32_t wsLit = 0;
-    for(auto it = sharedData->bins.begin()
-        , end = sharedData->bins.end(); it != end; it++, wsLit++
-    ) {
-        //Lit lit1 = ~Lit::toLit(wsLit);
-        assert(it->data->size() >= syncMPIFinish[wsLit]);
-        uint32_t sizeToSend = it->data->size() - syncMPIFinish[wsLit];
-        data.push_back(sizeToSend);
-        for (uint32_t i = syncMPIFinish[wsLit]; i < it->data->size(); i++) {
-            data.push_back(it->data->at(i).toInt());
-            thisMpiSentBinData++;
+    #ifdef USE_DISTRIBUTED
+    dist = DistConn::connect_to(
+        solver->conf.dist_host, solver->conf.dist_port, dist_connect_timeout);
+    if (dist != NULL) {
+        dist->queue(DistMsg::hello, {dist_protocol_version, solver->nVarsOutside()});
+        if (dist->flush(true)) {
+            if (solver->conf.verbosity) {
+                cout << "c [dist] connected to coordinator "
+                << solver->conf.dist_host << ":" << solver->conf.dist_port << endl;
+            }
+            return true;
         }
-        syncMPIFinish[wsLit] = it->data->size();
+        close_dist();
     }
-    assert(wsLit == solver->nVars()*2);
-    mpiSentBinData += thisMpiSentBinData;
-
-    #ifdef VERBOSE_DEBUG_MPI_SENDRCV
-    std::cout << "-->> MPI " << mpiRank << " Sent " << data.size() << " uint32_t -s" << std::endl;
-    std::cout << "-->> MPI " << mpiRank << " Sent " << thisMpiSentBinData << " bins " << std::endl;
-    std::cout << "-->> MPI " << mpiRank << " Sent " << thisMpiSentTriData << " tris " << std::endl;
+    cout << "c WARNING: cannot connect to coordinator "
+    << solver->conf.dist_host << ":" << solver->conf.dist_port
+    << ", solving alone" << endl;
+    #else
+    cout << "c WARNING: compiled without distributed support, solving alone" << endl;
     #endif
 
-    mpiSendData = new uint32_t[data.size()];
-    std::copy(data.begin(), data.end(), mpiSendData);
-    err = MPI_Isend(mpiSendData, data.size(), MPI_UNSIGNED, 0, 0, MPI_COMM_WORLD, &sendReq);
-    assert(err == MPI_SUCCESS);
+    dist_done = true;
+    return false;
 }
 
-bool DataSync::sync_mpi_unit(
-    const lbool otherVal,
-    const uint32_t var,
-    SharedData* shared,
-    uint32_t& thisGotUnitData,
-    uint32_t& thisSentUnitData
-) {
-    Lit l = Lit(var, false);
-    Lit lit1 = solver->map_to_with_bva(l);
-    lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-    lit1 = solver->map_outer_to_inter(lit1);
-    const lbool thisVal = solver->value(lit1);
+void DataSync::dist_start()
+{
+    if (dist == NULL && dist_wanted()) {
+        connect_dist();
+    }
+}
 
-    if (thisVal == l_Undef && otherVal == l_Undef) {
+bool DataSync::syncFromDist()
+{
+    if (dist == NULL && !connect_dist()) {
         return true;
     }
-    if (thisVal != l_Undef && otherVal != l_Undef) {
-        if (thisVal != otherVal) {
-            solver->ok = false;
-            return false;
-        } else {
-            return true;
+
+    #ifdef USE_DISTRIBUTED
+    const uint64_t old_recv = stats.recvDistCls;
+    const bool alive = dist->receive();
+    DistMsg type;
+    while(solver->okay() && dist->next_msg(type, dist_payload)) {
+        switch(type) {
+            case DistMsg::welcome:
+                if (solver->conf.verbosity && dist_payload.size() == 2) {
+                    cout << "c [dist] joined as worker " << dist_payload[0]
+                    << " of " << dist_payload[1] << endl;
+                }
+                break;
+
+            case DistMsg::clauses:
+                for(size_t at = 0; at + 2 <= dist_payload.size(); ) {
+                    const uint32_t sz = dist_payload[at];
+                    if (sz == 0 || at + 2 + sz > dist_payload.size()) {
+                        break;
+                    }
+                    if (!add_dist_clause(&dist_payload[at+2], sz, dist_payload[at+1])) {
+                        break;
+                    }
+                    at += 2 + sz;
+                }
+                break;
+
+            case DistMsg::stop:
+                if (solver->conf.verbosity) {
+                    cout << "c [dist] coordinator says stop" << endl;
+                }
+                solver->set_must_interrupt_asap();
+                dist_done = true;
+                break;
+
+            default:
+                break;
         }
     }
 
-    if (otherVal != l_Undef) {
-        assert(thisVal == l_Undef);
-        Lit litToEnqueue = lit1 ^ (otherVal == l_False);
-        if (solver->varData[litToEnqueue.var()].removed != Removed::none) {
+    if (solver->conf.verbosity >= 3) {
+        cout << "c [dist] got clauses " << (stats.recvDistCls - old_recv) << endl;
+    }
+
+    if (!dist_wanted()) {
+        close_dist();
+    } else if (!alive) {
+        cout << "c WARNING: lost connection to coordinator, solving alone" << endl;
+        close_dist();
+        dist_done = true;
+    }
+    #endif
+
+    return solver->okay();
+}
+
+bool DataSync::add_dist_clause(const uint32_t* lits, const uint32_t sz, const uint32_t glue)
+{
+    dist_lits.clear();
+    for(uint32_t i = 0; i < sz; i++) {
+        Lit lit = Lit::toLit(lits[i]);
+        if (lit.var() >= solver->nVarsOutside()) {
             return true;
         }
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
 
-        solver->enqueue(litToEnqueue);
-        solver->ok = solver->propagate<false>().isNULL();
-        if (!solver->ok) {
-            return false;
+        //Eliminated variables are gone; the clause is still implied by
+        //the remaining ones, but we cannot express it
+        if (solver->varData[lit.var()].removed != Removed::none) {
+            return true;
+        }
+        dist_lits.push_back(lit);
+    }
+    stats.recvDistCls++;
+
+    ClauseStats cl_stats;
+    cl_stats.glue = std::max<uint32_t>(glue, 1);
+    Clause* cl = solver->add_clause_int(dist_lits, true, cl_stats, true, NULL, false);
+    if (cl != NULL) {
+        #ifndef FINAL_PREDICTOR
+        cl->stats.which_red_array = 2;
+        if (cl->stats.glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
+            cl->stats.which_red_array = 0;
+        } else if (cl->stats.glue <= solver->conf.glue_put_lev1_if_below_or_eq
+            && solver->conf.glue_put_lev1_if_below_or_eq != 0
+        ) {
+            cl->stats.which_red_array = 1;
         }
+        #else
+        cl->stats.which_red_array = 3;
+        #endif
+        solver->longRedCls[cl->stats.which_red_array].push_back(
+            solver->cl_alloc.get_offset(cl));
+    }
 
-        thisGotUnitData++;
-        return true;
+    return solver->okay();
+}
+
+void DataSync::syncToDist()
+{
+    if (dist == NULL) {
+        dist_out.clear();
+        return;
     }
 
-    if (shared != NULL && thisVal != l_Undef) {
-        assert(otherVal == l_Undef);
-        shared->value[var] = thisVal;
-        thisSentUnitData++;
-        return true;
+    #ifdef USE_DISTRIBUTED
+    //Units are collected here instead of being signalled one by one
+    if (dist_sent_unit.size() < solver->nVarsOutside()) {
+        dist_sent_unit.resize(solver->nVarsOutside(), 0);
+    }
+    for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
+        if (dist_sent_unit[var]) {
+            continue;
+        }
+        Lit lit = Lit(var, false);
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        const lbool val = solver->value(lit);
+        if (val == l_Undef) {
+            continue;
+        }
+        dist_out.push_back(1);
+        dist_out.push_back(1);
+        dist_out.push_back(Lit(var, val == l_False).toInt());
+        dist_sent_unit[var] = 1;
+        stats.sentDistCls++;
     }
 
-    return true;
+    if (!dist_out.empty()) {
+        dist->queue(DistMsg::clauses, dist_out);
+        dist_out.clear();
+    }
+    if (!dist->flush(false)) {
+        cout << "c WARNING: lost connection to coordinator, solving alone" << endl;
+        close_dist();
+        dist_done = true;
+    }
+    #endif
 }
 
-#endif
+void DataSync::dist_report_result(const lbool result, const vector<lbool>& model)
+{
+    if (result == l_Undef || !dist_wanted()) {
+        return;
+    }
+    if (dist == NULL && !connect_dist()) {
+        return;
+    }
+
+    #ifdef USE_DISTRIBUTED
+    dist_payload.clear();
+    dist_payload.push_back(toInt(result));
+    if (result == l_True) {
+        for(const lbool val: model) {
+            dist_payload.push_back(toInt(val));
+        }
+    }
+    dist->queue(DistMsg::result, dist_payload);
+    dist->flush(true);
+    #endif
+
+    //The coordinator stops everyone now, later solve() calls run alone
+    close_dist();
+    dist_done = true;
+}
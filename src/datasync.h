@@ -23,19 +23,18 @@ THE SOFTWARE.
 #include "solvertypes.h"
 #include "watched.h"
 #include "watcharray.h"
-#ifdef USE_MPI
-#include "mpi.h"
-#endif //USE_MPI
 
 
 namespace CMSat {
 
 class SharedData;
 class Solver;
+class DistConn;
 class DataSync
 {
     public:
-        DataSync(Solver* solver, SharedData* sharedData, bool is_mpi);
+        DataSync(Solver* solver, SharedData* sharedData);
+        ~DataSync();
         bool enabled();
         void set_shared_data(SharedData* sharedData);
         void new_var(const bool bva);
@@ -50,6 +49,11 @@ class DataSync
 
         template <class T> void signalNewBinClause(T& ps);
         void signalNewBinClause(Lit lit1, Lit lit2);
+        void signalNewLongClause(const vector<Lit>& cl, uint32_t glue);
+
+        //Distributed mode: connect to the coordinator, if any, and tell it the answer
+        void dist_start();
+        void dist_report_result(lbool result, const vector<lbool>& model);
 
         struct Stats
         {
@@ -57,6 +61,8 @@ class DataSync
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint64_t sentDistCls = 0;
+            uint64_t recvDistCls = 0;
         };
         const Stats& get_stats() const;
 
@@ -84,30 +90,20 @@ class DataSync
         SharedData* sharedData;
 
 
-        //MPI
-        bool is_mpi;
-        #ifdef USE_MPI
-        bool syncFromMPI();
-        void syncToMPI();
-        void getNeedToInterruptFromMPI();
-        bool sync_mpi_unit(
-            const lbool otherVal,
-            const uint32_t var,
-            SharedData* shared,
-            uint32_t& thisGotUnitData,
-            uint32_t& thisSentUnitData
-        );
-        vector<uint32_t> syncMPIFinish;
-        MPI_Request   sendReq;
-        uint32_t*     mpiSendData;
-
-        int           mpiRank = 0;
-        int           mpiSize = 0;
-        uint32_t      mpiRecvUnitData;
-        uint32_t      mpiRecvBinData;
-        uint32_t      mpiSentBinData;
-        #endif
-
+        //Distributed mode, see DistCoordinator
+        bool dist_wanted() const;
+        bool connect_dist();
+        bool syncFromDist();
+        void syncToDist();
+        bool add_dist_clause(const uint32_t* lits, uint32_t sz, uint32_t glue);
+        void close_dist();
+        DistConn* dist = NULL;
+        bool dist_done = false;
+        uint64_t lastDistSyncConf = 0;
+        vector<char> dist_sent_unit;
+        vector<uint32_t> dist_out;
+        vector<uint32_t> dist_payload;
+        vector<Lit> dist_lits;
 
         //misc
         uint32_t numCalls = 0;
@@ -125,9 +121,6 @@ inline const DataSync::Stats& DataSync::get_stats() const
 template <class T>
 inline void DataSync::signalNewBinClause(T& ps)
 {
-    if (sharedData == NULL) {
-        return;
-    }
     //assert(ps.size() == 2);
     signalNewBinClause(ps[0], ps[1]);
 }
@@ -138,9 +131,4 @@ inline Lit DataSync::map_outside_without_bva(const Lit lit) const
 
 }
 
-inline bool DataSync::enabled()
-{
-    return sharedData != NULL;
-}
-
 }
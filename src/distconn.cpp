@@ -0,0 +1,295 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "distconn.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+using namespace CMSat;
+
+#ifdef MSG_NOSIGNAL
+static const int send_flags = MSG_NOSIGNAL;
+#else
+static const int send_flags = 0;
+#endif
+
+//Anything larger is a corrupt stream, not a real message
+static const uint32_t max_payload_words = 1U << 28;
+
+static void set_socket_options(const int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    #ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+    #endif
+}
+
+static bool would_block(const int err)
+{
+    #if EAGAIN == EWOULDBLOCK
+    return err == EAGAIN;
+    #else
+    return err == EAGAIN || err == EWOULDBLOCK;
+    #endif
+}
+
+static void push_word(vector<unsigned char>& buf, const uint32_t w)
+{
+    const uint32_t n = htonl(w);
+    const unsigned char* p = (const unsigned char*)&n;
+    buf.insert(buf.end(), p, p+4);
+}
+
+static uint32_t read_word(const unsigned char* p)
+{
+    uint32_t n;
+    memcpy(&n, p, 4);
+    return ntohl(n);
+}
+
+DistConn::DistConn(int _fd) :
+    fd(_fd)
+{
+    set_socket_options(fd);
+}
+
+DistConn::~DistConn()
+{
+    close();
+}
+
+void DistConn::close()
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+DistConn* DistConn::connect_to(const string& host, const uint32_t port, const double timeout)
+{
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = NULL;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0) {
+        return NULL;
+    }
+
+    //The coordinator may be started after the workers
+    const auto start = std::chrono::steady_clock::now();
+    int fd = -1;
+    while(true) {
+        for(addrinfo* ai = res; ai != NULL && fd < 0; ai = ai->ai_next) {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            if (connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        const double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (fd >= 0 || elapsed >= timeout) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    freeaddrinfo(res);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    return new DistConn(fd);
+}
+
+int DistConn::listen_on(const uint32_t port, uint32_t& bound_port)
+{
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0
+        || listen(fd, 64) != 0
+    ) {
+        ::close(fd);
+        return -1;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(fd, (sockaddr*)&addr, &len);
+    bound_port = ntohs(addr.sin_port);
+
+    const int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    return fd;
+}
+
+DistConn* DistConn::accept_from(const int listen_fd)
+{
+    const int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return NULL;
+    }
+    return new DistConn(fd);
+}
+
+void DistConn::queue(const DistMsg type, const vector<uint32_t>& payload)
+{
+    out.reserve(out.size() + 8 + payload.size()*4);
+    push_word(out, (uint32_t)type);
+    push_word(out, payload.size());
+    for(const uint32_t w: payload) {
+        push_word(out, w);
+    }
+}
+
+bool DistConn::flush(const bool block)
+{
+    while(fd >= 0 && out_at < out.size()) {
+        const ssize_t n = send(fd, out.data() + out_at, out.size() - out_at, send_flags);
+        if (n > 0) {
+            out_at += n;
+            bytes_sent += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && would_block(errno)) {
+            if (!block) {
+                return true;
+            }
+            pollfd p;
+            p.fd = fd;
+            p.events = POLLOUT;
+            p.revents = 0;
+            poll(&p, 1, 1000);
+            continue;
+        }
+        close();
+        return false;
+    }
+
+    if (out_at == out.size()) {
+        out.clear();
+        out_at = 0;
+    }
+    return fd >= 0;
+}
+
+bool DistConn::receive()
+{
+    unsigned char buf[64*1024];
+    while(fd >= 0) {
+        const ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            in.insert(in.end(), buf, buf+n);
+            bytes_recv += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && would_block(errno)) {
+            return true;
+        }
+
+        //Orderly shutdown by the other side, or error
+        close();
+        return false;
+    }
+    return false;
+}
+
+bool DistConn::next_msg(DistMsg& type, vector<uint32_t>& payload)
+{
+    if (in.size() - in_at < 8) {
+        return false;
+    }
+    const unsigned char* p = in.data() + in_at;
+    const uint32_t num = read_word(p+4);
+    if (num > max_payload_words) {
+        close();
+        return false;
+    }
+    if (in.size() - in_at < 8 + (size_t)num*4) {
+        return false;
+    }
+
+    type = (DistMsg)read_word(p);
+    payload.resize(num);
+    for(uint32_t i = 0; i < num; i++) {
+        payload[i] = read_word(p + 8 + i*4);
+    }
+    in_at += 8 + (size_t)num*4;
+
+    //Compact the buffer once the consumed part dominates
+    if (in_at == in.size()) {
+        in.clear();
+        in_at = 0;
+    } else if (in_at > in.size()/2) {
+        in.erase(in.begin(), in.begin() + in_at);
+        in_at = 0;
+    }
+    return true;
+}
+
+bool DistConn::wait_readable(const double timeout) const
+{
+    if (fd < 0) {
+        return false;
+    }
+    pollfd p;
+    p.fd = fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    return poll(&p, 1, (int)(timeout*1000.0)) > 0;
+}
@@ -0,0 +1,114 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __DISTCONN_H__
+#define __DISTCONN_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace CMSat {
+
+using std::vector;
+using std::string;
+
+//Messages of the distributed mode. Every message is a header of two 32b
+//words (type, number of payload words) followed by the payload, all in
+//network byte order.
+enum class DistMsg : uint32_t {
+    hello = 1     //worker->coordinator: protocol version, number of variables
+    , welcome = 2 //coordinator->worker: worker ID, number of workers
+    , clauses = 3 //both ways: (size, glue, lits...)*, lits as Lit::toInt()
+    , result = 4  //worker->coordinator: toInt(lbool), then the model if SAT
+    , stop = 5    //coordinator->worker: stop solving
+};
+
+static const uint32_t dist_protocol_version = 1;
+
+/**
+@brief A non-blocking TCP connection that sends and receives DistMsg frames
+
+Outgoing messages are buffered by queue() and written by flush(), so neither
+side can deadlock by both writing to a full socket at the same time.
+*/
+class DistConn
+{
+public:
+    explicit DistConn(int fd);
+    ~DistConn();
+    DistConn(const DistConn&) = delete;
+    DistConn& operator=(const DistConn&) = delete;
+
+    //Retries until the coordinator accepts or timeout (s) passes. NULL on failure
+    static DistConn* connect_to(const string& host, uint32_t port, double timeout);
+    //Returns the listening socket or -1. Port 0 picks a free port
+    static int listen_on(uint32_t port, uint32_t& bound_port);
+    //Returns NULL if there is no pending connection
+    static DistConn* accept_from(int listen_fd);
+
+    void queue(DistMsg type, const vector<uint32_t>& payload);
+    //Writes as much as the socket takes. If "block", writes everything.
+    //Returns false if the connection is lost.
+    bool flush(bool block);
+    //Reads everything that has arrived, without blocking.
+    //Returns false if the connection is lost.
+    bool receive();
+    //Pops the next complete message, if any
+    bool next_msg(DistMsg& type, vector<uint32_t>& payload);
+    //Waits at most timeout (s) for data to arrive
+    bool wait_readable(double timeout) const;
+    void close();
+
+    int get_fd() const;
+    bool is_open() const;
+    bool has_output() const;
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_recv = 0;
+
+private:
+    int fd;
+    vector<unsigned char> out;
+    size_t out_at = 0;
+    vector<unsigned char> in;
+    size_t in_at = 0;
+};
+
+inline int DistConn::get_fd() const
+{
+    return fd;
+}
+
+inline bool DistConn::is_open() const
+{
+    return fd >= 0;
+}
+
+inline bool DistConn::has_output() const
+{
+    return out_at < out.size();
+}
+
+} //end namespace
+
+#endif //__DISTCONN_H__
@@ -0,0 +1,322 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "distcoordinator.h"
+
+#include <poll.h>
+#include <unistd.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+DistCoordinator::DistCoordinator(
+    const uint32_t _port
+    , const uint32_t _num_workers
+    , const uint32_t _verbosity
+) :
+    port(_port)
+    , num_workers(_num_workers)
+    , verbosity(_verbosity)
+{
+    listen_fd = DistConn::listen_on(_port, port);
+    if (listen_fd < 0) {
+        throw std::runtime_error(
+            "ERROR: distributed coordinator cannot listen on port "
+            + std::to_string(_port));
+    }
+    if (verbosity) {
+        cout << "c [dist] coordinator listening on port " << port
+        << " waiting for " << num_workers << " workers" << endl;
+    }
+}
+
+DistCoordinator::~DistCoordinator()
+{
+    for(Worker& w: workers) {
+        delete w.conn;
+    }
+    if (listen_fd >= 0) {
+        close(listen_fd);
+    }
+}
+
+void DistCoordinator::accept_workers()
+{
+    while(num_accepted < num_workers) {
+        DistConn* conn = DistConn::accept_from(listen_fd);
+        if (conn == NULL) {
+            return;
+        }
+        Worker w;
+        w.conn = conn;
+        w.id = num_accepted++;
+        w.joined = false;
+        workers.push_back(w);
+    }
+}
+
+void DistCoordinator::drop(Worker& w)
+{
+    if (verbosity) {
+        cout << "c [dist] worker " << w.id << " left" << endl;
+    }
+    stats.bytes_sent += w.conn->bytes_sent;
+    stats.bytes_recv += w.conn->bytes_recv;
+    delete w.conn;
+    w.conn = NULL;
+}
+
+bool DistCoordinator::handle_msg(
+    Worker& w
+    , const DistMsg type
+    , const vector<uint32_t>& payload
+    , lbool& result
+    , vector<lbool>& model
+) {
+    switch(type) {
+        case DistMsg::hello: {
+            if (w.joined
+                || payload.size() != 2
+                || payload[0] != dist_protocol_version
+                || (nvars != 0 && payload[1] != nvars)
+            ) {
+                cout << "c [dist] WARNING: rejecting worker " << w.id
+                << ", it has a different protocol version or problem" << endl;
+                return false;
+            }
+            if (nvars == 0) {
+                nvars = payload[1];
+                unit_val.resize(nvars, l_Undef);
+            }
+            w.joined = true;
+            w.conn->queue(DistMsg::welcome, {w.id, num_workers});
+            if (!history.empty()) {
+                w.conn->queue(DistMsg::clauses, history);
+            }
+            if (verbosity) {
+                cout << "c [dist] worker " << w.id << " joined, vars: " << nvars << endl;
+            }
+            return true;
+        }
+
+        case DistMsg::clauses:
+            return w.joined && relay(w, payload, result);
+
+        case DistMsg::result: {
+            if (!w.joined || payload.empty()) {
+                return false;
+            }
+            const lbool ret = toLbool(payload[0]);
+            if (ret == l_True) {
+                if (payload.size() != 1 + (size_t)nvars) {
+                    return false;
+                }
+                model.resize(nvars);
+                for(uint32_t i = 0; i < nvars; i++) {
+                    model[i] = toLbool(payload[1+i]);
+                }
+            }
+            if (ret != l_Undef) {
+                result = ret;
+                if (verbosity) {
+                    cout << "c [dist] worker " << w.id << " finished: "
+                    << (ret == l_True ? "SAT" : "UNSAT") << endl;
+                }
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool DistCoordinator::relay(const Worker& from, const vector<uint32_t>& payload, lbool& result)
+{
+    to_send.clear();
+    for(size_t at = 0; at < payload.size(); ) {
+        if (at + 2 > payload.size()) {
+            return false;
+        }
+        const uint32_t sz = payload[at];
+        if (sz == 0 || at + 2 + sz > payload.size()) {
+            return false;
+        }
+        for(uint32_t i = 0; i < sz; i++) {
+            if (payload[at+2+i] >= nvars*2) {
+                return false;
+            }
+        }
+        const uint32_t* lits = &payload[at+2];
+
+        bool keep = true;
+        bool remember = false;
+        if (sz == 1) {
+            const Lit lit = Lit::toLit(lits[0]);
+            const lbool val = boolToLBool(!lit.sign());
+            if (unit_val[lit.var()] == l_Undef) {
+                unit_val[lit.var()] = val;
+                stats.units++;
+                remember = true;
+            } else if (unit_val[lit.var()] == val) {
+                keep = false;
+            } else {
+                //All units are implied by the same formula
+                if (verbosity) {
+                    cout << "c [dist] workers derived opposite units, UNSAT" << endl;
+                }
+                result = l_False;
+                return true;
+            }
+        } else if (sz == 2) {
+            const uint64_t a = std::min(lits[0], lits[1]);
+            const uint64_t b = std::max(lits[0], lits[1]);
+            if (bins_seen.insert((a << 32) | b).second) {
+                stats.bins++;
+                remember = true;
+            } else {
+                keep = false;
+            }
+        } else {
+            stats.longs++;
+        }
+
+        if (keep) {
+            to_send.insert(to_send.end(), &payload[at], &payload[at] + 2 + sz);
+            if (remember) {
+                history.insert(history.end(), &payload[at], &payload[at] + 2 + sz);
+            }
+        } else {
+            stats.duplicates++;
+        }
+        at += 2 + sz;
+    }
+
+    if (to_send.empty()) {
+        return true;
+    }
+    for(Worker& w: workers) {
+        if (w.conn != NULL && w.joined && w.id != from.id) {
+            w.conn->queue(DistMsg::clauses, to_send);
+        }
+    }
+    return true;
+}
+
+void DistCoordinator::stop_all()
+{
+    for(Worker& w: workers) {
+        if (w.conn == NULL) {
+            continue;
+        }
+        w.conn->queue(DistMsg::stop, {});
+        w.conn->flush(true);
+        drop(w);
+    }
+    workers.clear();
+}
+
+lbool DistCoordinator::run(vector<lbool>& model, const double timeout)
+{
+    const auto start = std::chrono::steady_clock::now();
+    lbool result = l_Undef;
+    vector<pollfd> fds;
+    DistMsg type;
+    vector<uint32_t> payload;
+
+    while(result == l_Undef) {
+        const double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= timeout) {
+            if (verbosity) {
+                cout << "c [dist] timeout, stopping workers" << endl;
+            }
+            break;
+        }
+
+        fds.clear();
+        pollfd p;
+        p.fd = listen_fd;
+        p.events = POLLIN;
+        p.revents = 0;
+        fds.push_back(p);
+        for(const Worker& w: workers) {
+            p.fd = w.conn->get_fd();
+            p.events = POLLIN | (w.conn->has_output() ? POLLOUT : 0);
+            fds.push_back(p);
+        }
+        poll(fds.data(), fds.size(), 100);
+
+        accept_workers();
+        for(Worker& w: workers) {
+            //Messages that arrived before the worker left are still handled
+            const bool alive = w.conn->receive();
+            bool ok = true;
+            while(ok && result == l_Undef && w.conn->next_msg(type, payload)) {
+                ok = handle_msg(w, type, payload, result, model);
+            }
+            if ((!alive || !ok) && result == l_Undef) {
+                drop(w);
+            }
+        }
+        workers.erase(std::remove_if(workers.begin(), workers.end()
+            , [](const Worker& w) { return w.conn == NULL; }), workers.end());
+
+        for(Worker& w: workers) {
+            if (!w.conn->flush(false)) {
+                drop(w);
+            }
+        }
+        workers.erase(std::remove_if(workers.begin(), workers.end()
+            , [](const Worker& w) { return w.conn == NULL; }), workers.end());
+
+        if (num_accepted == num_workers && workers.empty()) {
+            if (verbosity) {
+                cout << "c [dist] all workers left without an answer" << endl;
+            }
+            break;
+        }
+    }
+
+    stop_all();
+    if (verbosity) {
+        print_stats();
+    }
+    return result;
+}
+
+void DistCoordinator::print_stats() const
+{
+    cout << "c [dist] relayed units: " << stats.units
+    << " bins: " << stats.bins
+    << " longs: " << stats.longs
+    << " duplicates dropped: " << stats.duplicates
+    << endl;
+    cout << "c [dist] MB sent: " << (double)stats.bytes_sent/(1024.0*1024.0)
+    << " MB received: " << (double)stats.bytes_recv/(1024.0*1024.0)
+    << endl;
+}
@@ -0,0 +1,115 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __DISTCOORDINATOR_H__
+#define __DISTCOORDINATOR_H__
+
+#include "cryptominisat5/solvertypesmini.h"
+#include "distconn.h"
+
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+
+/**
+@brief Coordinator of a distributed solve: relays clauses between workers
+
+Workers are normal solvers that connect over TCP (see DataSync). Units and
+binaries are deduplicated and remembered, so workers that join late get them
+too. Low-glue learnt clauses are only forwarded. The first definite answer
+of any worker stops all the others. The coordinator does not solve by itself.
+*/
+class DistCoordinator
+{
+public:
+    //Throws std::runtime_error if it cannot listen on the port
+    DistCoordinator(uint32_t port, uint32_t num_workers, uint32_t verbosity);
+    ~DistCoordinator();
+    DistCoordinator(const DistCoordinator&) = delete;
+    DistCoordinator& operator=(const DistCoordinator&) = delete;
+
+    uint32_t get_port() const;
+
+    //Relays until a worker finishes, all workers have left or timeout (s)
+    //passes. Stops all workers before returning.
+    lbool run(vector<lbool>& model, double timeout);
+    void print_stats() const;
+
+    struct Stats
+    {
+        uint64_t units = 0;
+        uint64_t bins = 0;
+        uint64_t longs = 0;
+        uint64_t duplicates = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t bytes_recv = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    struct Worker
+    {
+        DistConn* conn;
+        uint32_t id;
+        bool joined;
+    };
+    void accept_workers();
+    //Returns false if the worker must be dropped
+    bool handle_msg(Worker& w, DistMsg type, const vector<uint32_t>& payload
+        , lbool& result, vector<lbool>& model);
+    bool relay(const Worker& from, const vector<uint32_t>& payload, lbool& result);
+    void drop(Worker& w);
+    void stop_all();
+
+    int listen_fd = -1;
+    uint32_t port;
+    uint32_t num_workers;
+    uint32_t verbosity;
+    uint32_t num_accepted = 0;
+    uint32_t nvars = 0;
+    vector<Worker> workers;
+
+    //What late joiners get: every unit and binary so far
+    vector<uint32_t> history;
+    vector<lbool> unit_val;
+    std::unordered_set<uint64_t> bins_seen;
+    vector<uint32_t> to_send;
+    Stats stats;
+};
+
+inline uint32_t DistCoordinator::get_port() const
+{
+    return port;
+}
+
+inline const DistCoordinator::Stats& DistCoordinator::get_stats() const
+{
+    return stats;
+}
+
+} //end namespace
+
+#endif //__DISTCOORDINATOR_H__
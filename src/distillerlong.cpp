@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "sqlstats.h"
 
 #include <iomanip>
+#include <thread>
+#include <atomic>
 using namespace CMSat;
 using std::cout;
 using std::endl;
@@ -178,6 +180,182 @@ bool DistillerLong::go_through_clauses(
     return time_out;
 }
 
+//Clause at position X of 'cls' is at position X of the snapshot. The rest of
+//the propagating clauses come after. Tier 2 is left out, it's not worth the
+//memory.
+void DistillerLong::build_snapshot(
+    const vector<ClOffset>& cls
+    , PropSnapshot& snap
+) const {
+    snap.add_cls(cls);
+    const vector<ClOffset>* others[] = {
+        &solver->longIrredCls
+        , &solver->longRedCls[0]
+        , &solver->longRedCls[1]
+    };
+    for(const vector<ClOffset>* offs: others) {
+        if (offs != &cls) {
+            snap.add_cls(*offs);
+        }
+    }
+}
+
+void DistillerLong::distill_batch_par(
+    const PropSnapshot& snap
+    , vector<DistillWorker*>& workers
+    , const vector<uint32_t>& at
+    , vector<vector<Lit> >& new_cls
+    , vector<char>& shortened
+) {
+    new_cls.resize(at.size());
+    shortened.resize(at.size());
+    std::atomic<size_t> next(0);
+
+    auto work = [&](const size_t tid) {
+        if (workers[tid] == NULL) {
+            workers[tid] = new DistillWorker(snap);
+        }
+        DistillWorker& w = *workers[tid];
+        for(size_t k = next++; k < at.size(); k = next++) {
+            shortened[k] = w.distill(at[k], new_cls[k]);
+        }
+    };
+
+    vector<std::thread> thds;
+    for(size_t tid = 1; tid < workers.size(); tid++) {
+        thds.push_back(std::thread(work, tid));
+    }
+    work(0);
+    for(std::thread& t: thds) {
+        t.join();
+    }
+
+    //Work of all the threads counts towards the time limit
+    for(DistillWorker* w: workers) {
+        solver->propStats.bogoProps += w->bogoprops;
+        w->bogoprops = 0;
+    }
+}
+
+void DistillerLong::commit_distilled(
+    const ClOffset offset
+    , const vector<Lit>& new_cl
+    , vector<ClOffset>::iterator& j
+) {
+    Clause& cl = *solver->cl_alloc.ptr(offset);
+    runStats.numLitsRem += cl.size() - new_cl.size();
+    runStats.numClShorten++;
+
+    solver->detachClause(offset, false);
+    (*solver->drat) << deldelay << cl << fin;
+    const bool red = cl.red();
+    const ClauseStats stats = cl.stats;
+    solver->free_cl(offset);
+    Clause *cl2 = solver->add_clause_int(new_cl, red, stats);
+    (*solver->drat) << findelay;
+
+    if (cl2 != NULL) {
+        cl2->set_distilled(true);
+        *j++ = solver->cl_alloc.get_offset(cl2);
+    }
+}
+
+//Same as go_through_clauses(), but the clauses are vivified in batches by
+//multiple threads over a snapshot. Every new clause is a subset of its
+//original one, so the snapshot stays valid while committing earlier batches.
+bool DistillerLong::go_through_clauses_par(
+    vector<ClOffset>& cls
+) {
+    assert(solver->decisionLevel() == 0);
+    PropSnapshot snap(solver);
+    build_snapshot(cls, snap);
+    vector<DistillWorker*> workers(solver->conf.distill_threads, NULL);
+
+    bool time_out = false;
+    vector<ClOffset>::iterator i, j;
+    i = j = cls.begin();
+    while(i != cls.end()) {
+        if (time_out || !solver->ok) {
+            *j++ = *i++;
+            continue;
+        }
+
+        if ((int64_t)solver->propStats.bogoProps-(int64_t)oldBogoProps >= maxNumProps
+            || solver->must_interrupt_asap()
+        ) {
+            if (solver->conf.verbosity >= 3) {
+                cout
+                << "c Need to finish distillation -- ran out of prop (=allocated time)"
+                << endl;
+            }
+            runStats.timeOut++;
+            time_out = true;
+            continue;
+        }
+
+        //Collect batch
+        batch.clear();
+        batch_at.clear();
+        while(i != cls.end() && batch.size() < solver->conf.distill_par_batch) {
+            const ClOffset offset = *i;
+            const uint32_t at = i - cls.begin();
+            i++;
+
+            Clause& cl = *solver->cl_alloc.ptr(offset);
+            maxNumProps -= 5;
+            if ((cl.used_in_xor() && solver->conf.force_preserve_xors)
+                || cl.getdistilled()
+                || cl._xor_is_detached
+            ) {
+                *j++ = offset;
+                continue;
+            }
+            cl.set_distilled(true);
+            runStats.checkedClauses++;
+            assert(cl.size() > 2);
+
+            maxNumProps -= cl.size();
+            if (solver->satisfied_cl(cl)) {
+                solver->detachClause(cl);
+                solver->free_cl(&cl);
+                continue;
+            }
+            batch.push_back(offset);
+            batch_at.push_back(at);
+        }
+
+        distill_batch_par(snap, workers, batch_at, batch_new_cls, batch_shortened);
+
+        //Commit in clause order, so the result is independent of the threads
+        for(size_t k = 0; k < batch.size(); k++) {
+            if (!solver->ok || !batch_shortened[k]) {
+                *j++ = batch[k];
+                continue;
+            }
+            commit_distilled(batch[k], batch_new_cls[k], j);
+        }
+    }
+    cls.resize(cls.size()- (i-j));
+
+    if (solver->conf.verbosity >= 2) {
+        double mem = snap.mem_used();
+        for(const DistillWorker* w: workers) {
+            if (w) {
+                mem += w->mem_used();
+            }
+        }
+        cout << "c [distill-par] threads: " << workers.size()
+        << " snapshot cls: " << snap.num_cls()
+        << " mem: " << mem/(1024.0*1024.0) << " MB"
+        << endl;
+    }
+    for(DistillWorker* w: workers) {
+        delete w;
+    }
+
+    return time_out;
+}
+
 bool DistillerLong::distill_long_cls_all(
     vector<ClOffset>& offs
     , double time_mult
@@ -207,6 +385,10 @@ bool DistillerLong::distill_long_cls_all(
         maxNumProps *=2;
     }
     maxNumProps *= time_mult;
+    const bool par = solver->conf.distill_threads > 1;
+    if (par) {
+        maxNumProps *= solver->conf.distill_threads;
+    }
     orig_maxNumProps = maxNumProps;
 
     //stats setup
@@ -219,7 +401,12 @@ bool DistillerLong::distill_long_cls_all(
         , ClauseSizeSorterInv(solver->cl_alloc)
     );*/
 
-    bool time_out = go_through_clauses(offs);
+    bool time_out;
+    if (par) {
+        time_out = go_through_clauses_par(offs);
+    } else {
+        time_out = go_through_clauses(offs);
+    }
 
     const double time_used = cpuTime() - myTime;
     const double time_remain = float_div(
@@ -433,5 +620,10 @@ double DistillerLong::mem_used() const
 {
     double mem_used = sizeof(DistillerLong);
     mem_used += lits.size()*sizeof(Lit);
+    mem_used += batch.capacity()*sizeof(ClOffset);
+    mem_used += batch_at.capacity()*sizeof(uint32_t);
+    for(const auto& cl: batch_new_cls) {
+        mem_used += cl.capacity()*sizeof(Lit);
+    }
     return mem_used;
 }
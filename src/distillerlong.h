@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "solvertypes.h"
 #include "cloffset.h"
 #include "watcharray.h"
+#include "distillworker.h"
 
 namespace CMSat {
 
@@ -81,6 +82,22 @@ class DistillerLong {
         );
         bool distill_long_cls_all(vector<ClOffset>& offs, double time_mult);
         bool go_through_clauses(vector<ClOffset>& cls);
+
+        //Parallel distillation
+        bool go_through_clauses_par(vector<ClOffset>& cls);
+        void build_snapshot(const vector<ClOffset>& cls, PropSnapshot& snap) const;
+        void distill_batch_par(
+            const PropSnapshot& snap
+            , vector<DistillWorker*>& workers
+            , const vector<uint32_t>& batch_at
+            , vector<vector<Lit> >& new_cls
+            , vector<char>& shortened
+        );
+        void commit_distilled(
+            const ClOffset offset
+            , const vector<Lit>& new_cl
+            , vector<ClOffset>::iterator& j
+        );
         Solver* solver;
 
         //For distill
@@ -89,6 +106,12 @@ class DistillerLong {
         int64_t maxNumProps;
         int64_t orig_maxNumProps;
 
+        //For parallel distill
+        vector<ClOffset> batch;
+        vector<uint32_t> batch_at;
+        vector<vector<Lit> > batch_new_cls;
+        vector<char> batch_shortened;
+
         //Global status
         Stats runStats;
         Stats globalStats;
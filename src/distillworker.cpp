@@ -0,0 +1,60 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "distillworker.h"
+
+using namespace CMSat;
+
+DistillWorker::DistillWorker(const PropSnapshot& _snap) :
+    SnapshotProp(_snap)
+{}
+
+bool DistillWorker::distill(const uint32_t at, vector<Lit>& out)
+{
+    assert(decisionLevel() == 0);
+    out.clear();
+    const Lit* cl = snap.lits.data() + snap.start[at];
+    const uint32_t sz = snap.start[at+1] - snap.start[at];
+
+    //Same as the serial version: literals that become FALSE are removed,
+    //a literal that becomes TRUE or a conflict ends the clause
+    new_decision_level();
+    for(uint32_t i = 0; i < sz; i++) {
+        const Lit lit = cl[i];
+        const lbool val = value(lit);
+        if (val == l_False) {
+            continue;
+        }
+        out.push_back(lit);
+        if (val == l_True) {
+            break;
+        }
+
+        enqueue(~lit);
+        if (!propagate(at)) {
+            break;
+        }
+    }
+    cancel_until(0);
+
+    return out.size() < sz;
+}
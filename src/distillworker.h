@@ -0,0 +1,51 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __DISTILLWORKER_H__
+#define __DISTILLWORKER_H__
+
+#include <vector>
+#include "solvertypes.h"
+#include "snapshotprop.h"
+
+namespace CMSat {
+
+using std::vector;
+
+/**
+@brief Vivifies clauses of a PropSnapshot using a private trail
+
+The result only depends on the snapshot and the clause, not on the order in
+which clauses are distilled.
+*/
+class DistillWorker : public SnapshotProp
+{
+public:
+    explicit DistillWorker(const PropSnapshot& snap);
+
+    //Returns TRUE if the clause could be shortened, the new clause is in 'out'
+    bool distill(const uint32_t at, vector<Lit>& out);
+};
+
+} //end namespace
+
+#endif //__DISTILLWORKER_H__
@@ -0,0 +1,260 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "enumerator.h"
+#include "solver.h"
+#include "varreplacer.h"
+#include "time_mem.h"
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+Enumerator::Enumerator(
+    Solver* _solver
+    , const vector<uint32_t>& _projection
+    , const Callback& _callback
+    , uint64_t _max_models
+) :
+    solver(_solver)
+    , projection(_projection)
+    , callback(_callback)
+    , max_models(_max_models)
+{
+    vals.resize(projection.size());
+}
+
+lbool Enumerator::run(const vector<Lit>* assumptions)
+{
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    if (!solver->okay()) {
+        return l_False;
+    }
+    if (max_models == 0) {
+        return l_True;
+    }
+
+    //Re-add the projection vars if they have been eliminated, decomposed, etc.
+    vector<Lit> lits;
+    for(const uint32_t v: projection) {
+        lits.push_back(Lit(v, false));
+    }
+    solver->back_number_from_outside_to_outer(lits);
+    lits = solver->back_number_from_outside_to_outer_tmp;
+    outer_vars.clear();
+    for(const Lit l: lits) {
+        outer_vars.push_back(l.var());
+    }
+    if (!solver->addClauseHelper(lits)) {
+        return l_False;
+    }
+
+    //Projection vars must not be eliminated. Chronological backtracking
+    //would break the invariant that the lowest levels only hold decisions
+    //on the projection, so it is switched off
+    SolverConf& conf = solver->conf;
+    vector<uint32_t>* orig_sampling_vars = conf.sampling_vars;
+    const int orig_chrono = conf.diff_declev_for_chrono;
+    const long orig_max_confl = conf.max_confl;
+    const double orig_max_time = conf.maxTime;
+    conf.sampling_vars = &projection;
+    conf.diff_declev_for_chrono = -1;
+    solver->enumerator = this;
+
+    lbool status;
+    while(true) {
+        stopped = false;
+        conf.max_confl = orig_max_confl;
+        conf.maxTime = orig_max_time;
+        status = solver->solve_with_assumptions(assumptions, true);
+        if (status != l_True) {
+            break;
+        }
+
+        //Found outside of search(), e.g. by the lucky-phase checks
+        if (!stopped) {
+            stats.outside_search++;
+            const vector<lbool>& model = solver->get_model();
+            for(size_t i = 0; i < projection.size(); i++) {
+                vals[i] = model[projection[i]];
+            }
+            stats.models++;
+            stopped = !callback(vals) || stats.models >= max_models;
+        }
+
+        //The last model was reported but is not blocked yet
+        if (!ban_model(assumptions) || stopped) {
+            break;
+        }
+    }
+    if (stopped) {
+        status = l_True;
+    }
+
+    solver->enumerator = NULL;
+    conf.sampling_vars = orig_sampling_vars;
+    conf.diff_declev_for_chrono = orig_chrono;
+    stats.cpu_time += cpuTime() - myTime;
+    if (conf.verbosity) {
+        print_stats();
+    }
+
+    return status;
+}
+
+bool Enumerator::ban_model(const vector<Lit>* assumptions)
+{
+    const vector<lbool>& model = solver->get_model();
+    vector<Lit> ban;
+    for(const uint32_t v: projection) {
+        assert(model[v] != l_Undef);
+        ban.push_back(Lit(v, model[v] == l_True));
+    }
+    if (assumptions) {
+        for(const Lit l: *assumptions) {
+            ban.push_back(~l);
+        }
+    }
+
+    return solver->add_clause_outer(ban);
+}
+
+void Enumerator::start_search()
+{
+    //Numbering and replacements may have changed since the last search()
+    inter_lits.clear();
+    for(const uint32_t v: outer_vars) {
+        const Lit l = solver->varReplacer->get_lit_replaced_with_outer(Lit(v, false));
+        inter_lits.push_back(solver->map_outer_to_inter(l));
+    }
+    level_at.clear();
+}
+
+Lit Enumerator::pick_branch()
+{
+    //Levels above the assumptions are all made by this function while
+    //unset projection vars remain, so the projection vars before the
+    //position recorded when the current level was made are still set
+    const uint32_t level = solver->decisionLevel();
+    if (level_at.size() <= level) {
+        level_at.resize(level+1);
+    }
+    uint32_t at = level > solver->assumptions.size() ? level_at[level-1] : 0;
+    while(at < inter_lits.size() && solver->value(inter_lits[at]) != l_Undef) {
+        at++;
+    }
+    level_at[level] = at;
+    if (at == inter_lits.size()) {
+        return lit_Undef;
+    }
+
+    const uint32_t v = inter_lits[at].var();
+    return Lit(v, !solver->pick_polarity(v));
+}
+
+lbool Enumerator::found_model()
+{
+    for(size_t i = 0; i < inter_lits.size(); i++) {
+        vals[i] = solver->value(inter_lits[i]);
+    }
+    stats.models++;
+    if (!callback(vals) || stats.models >= max_models) {
+        stopped = true;
+        return l_True;
+    }
+
+    //The projection and the assumptions are implied by the decisions
+    //up to this level
+    uint32_t top = std::min<uint32_t>(
+        solver->assumptions.size(), solver->decisionLevel());
+    for(const Lit l: inter_lits) {
+        top = std::max(top, solver->varData[l.var()].level);
+    }
+
+    blocking.clear();
+    for(uint32_t level = top; level > 0; level--) {
+        const uint32_t at = solver->trail_lim[level-1];
+        if (at >= solver->trail.size()) {
+            continue;
+        }
+
+        //Levels of assumptions that were already set have no decision
+        const Lit d = solver->trail[at].lit;
+        if (solver->varData[d.var()].level == level
+            && solver->varData[d.var()].reason.isNULL()
+        ) {
+            blocking.push_back(~d);
+        }
+    }
+    stats.blocking_lits += blocking.size();
+
+    //All models have been found
+    if (blocking.empty()) {
+        return l_False;
+    }
+
+    //Highest level first, second highest second: backjump below the
+    //highest and propagate it from the clause
+    const uint32_t blevel = blocking.size() == 1 ?
+        0 : solver->varData[blocking[1].var()].level;
+    solver->cancelUntil(blevel);
+    switch(blocking.size()) {
+        case 1:
+            solver->enqueue<false>(blocking[0]);
+            break;
+
+        case 2:
+            solver->attach_bin_clause(blocking[0], blocking[1], false);
+            solver->enqueue<false>(blocking[0], blevel, PropBy(blocking[1], false));
+            break;
+
+        default:
+            Clause* cl = solver->cl_alloc.Clause_new(blocking
+            , solver->sumConflicts
+            #ifdef STATS_NEEDED
+            , 0
+            #endif
+            );
+            solver->attachClause(*cl);
+            const ClOffset offset = solver->cl_alloc.get_offset(cl);
+            solver->longIrredCls.push_back(offset);
+            solver->enqueue<false>(blocking[0], blevel, PropBy(offset));
+            break;
+    }
+
+    return l_Undef;
+}
+
+void Enumerator::print_stats() const
+{
+    cout << "c [enum] models: " << stats.models
+    << " avg blocking size: " << std::fixed << std::setprecision(2)
+    << ratio_for_stat(stats.blocking_lits, stats.models)
+    << " found outside search: " << stats.outside_search
+    << solver->conf.print_times(stats.cpu_time)
+    << endl;
+}
@@ -0,0 +1,105 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef __ENUMERATOR_H__
+#define __ENUMERATOR_H__
+
+#include "solvertypes.h"
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Enumerates the models of the problem projected to a set of variables
+
+Instead of banning each model and solving again from scratch, the search is
+kept running: the projection variables are branched on first, so when the
+assignment is complete the projection is implied by the decisions of the
+lowest levels. The negation of these decisions (and of the assumptions) is
+added as an irredundant blocking clause, the search backjumps to the second
+highest level of it and carries on with the trail below that level intact.
+*/
+class Enumerator
+{
+public:
+    typedef std::function<bool(const vector<lbool>&)> Callback;
+
+    //Projection is in the outside numbering
+    Enumerator(
+        Solver* solver
+        , const vector<uint32_t>& projection
+        , const Callback& callback
+        , uint64_t max_models
+    );
+
+    //Returns l_True if stopped by the callback or by max_models, l_False if
+    //all models have been enumerated, l_Undef if a limit was reached
+    lbool run(const vector<Lit>* assumptions);
+
+    //Called by the Searcher
+    void start_search();
+    Lit pick_branch();
+    lbool found_model();
+
+    struct Stats
+    {
+        uint64_t models = 0;
+        uint64_t blocking_lits = 0;
+        uint64_t outside_search = 0;
+        double cpu_time = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    bool ban_model(const vector<Lit>* assumptions);
+    void print_stats() const;
+
+    Solver* solver;
+    vector<uint32_t> projection; //also the sampling vars while running
+    const Callback& callback;
+    const uint64_t max_models;
+
+    vector<uint32_t> outer_vars;
+    vector<Lit> inter_lits; //representative of the projection vars
+    vector<uint32_t> level_at; //first unset projection var when deciding at level
+    vector<lbool> vals;
+    vector<Lit> blocking;
+    bool stopped = false;
+    Stats stats;
+};
+
+inline const Enumerator::Stats& Enumerator::get_stats() const
+{
+    return stats;
+}
+
+}
+
+#endif //__ENUMERATOR_H__
@@ -0,0 +1,198 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "eventtrace.h"
+
+#include <fstream>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+
+using namespace CMSat;
+using std::cerr;
+using std::endl;
+
+//File format, all little endian:
+//  "CMSTRACE" u32:version u32:num_threads
+//  per thread: u32:thread_num u32:num_names
+//              per name: u16:len bytes
+//              u64:num_events TraceEvent[num_events], oldest first
+static const char trace_magic[8] = {'C', 'M', 'S', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t trace_version = 1;
+
+EventTrace::EventTrace(uint32_t _thread_num, size_t num_events) :
+    thread_num(_thread_num)
+{
+    size_t sz = 1;
+    while(sz < num_events) {
+        sz *= 2;
+    }
+    events.resize(sz);
+    mask = sz-1;
+}
+
+uint16_t EventTrace::name_index(const string& name)
+{
+    std::map<string, uint16_t>::const_iterator it = name_to_index.find(name);
+    if (it != name_to_index.end()) {
+        return it->second;
+    }
+
+    const uint16_t at = names.size();
+    names.push_back(name);
+    name_to_index[name] = at;
+    return at;
+}
+
+void EventTrace::add(
+    TraceType type
+    , const string& name
+    , uint64_t start
+    , uint64_t dur
+    , uint64_t conflicts
+    , uint64_t arg
+) {
+    TraceEvent& ev = events[recorded & mask];
+    ev.start_ns = start;
+    ev.dur_ns = dur;
+    ev.conflicts = conflicts;
+    ev.arg = arg;
+    ev.name = name_index(name);
+    ev.type = (uint8_t)type;
+    memset(ev.pad, 0, sizeof(ev.pad));
+    recorded++;
+}
+
+void EventTrace::span(
+    TraceType type
+    , const string& name
+    , uint64_t start
+    , uint64_t conflicts
+    , uint64_t arg
+) {
+    const uint64_t end = now();
+    add(type, name, start, end - start, conflicts, arg);
+}
+
+void EventTrace::instant(
+    TraceType type
+    , const string& name
+    , uint64_t conflicts
+    , uint64_t arg
+) {
+    add(type, name, now(), 0, conflicts, arg);
+}
+
+template<class T>
+static void write_raw(std::ostream& out, const T& val)
+{
+    out.write((const char*)&val, sizeof(T));
+}
+
+void EventTrace::write(std::ostream& out) const
+{
+    write_raw(out, thread_num);
+    write_raw(out, (uint32_t)names.size());
+    for(const string& name: names) {
+        write_raw(out, (uint16_t)name.size());
+        out.write(name.data(), name.size());
+    }
+
+    const uint64_t num = std::min<uint64_t>(recorded, events.size());
+    write_raw(out, num);
+    for(uint64_t i = recorded - num; i < recorded; i++) {
+        write_raw(out, events[i & mask]);
+    }
+}
+
+bool EventTrace::dump(const vector<const EventTrace*>& traces, const string& fname)
+{
+    std::ofstream out(fname.c_str(), std::ios::binary);
+    if (!out) {
+        cerr << "ERROR: Cannot open event trace file '" << fname << "' for writing" << endl;
+        return false;
+    }
+
+    out.write(trace_magic, sizeof(trace_magic));
+    write_raw(out, trace_version);
+    write_raw(out, (uint32_t)traces.size());
+    for(const EventTrace* t: traces) {
+        t->write(out);
+    }
+
+    return (bool)out;
+}
+
+TraceDumpRequest::TraceDumpRequest(const string& _fname, size_t num_threads) :
+    requested(false)
+    , fname(_fname)
+    , snapshots(num_threads, NULL)
+{
+}
+
+TraceDumpRequest::~TraceDumpRequest()
+{
+    clear_snapshots();
+}
+
+void TraceDumpRequest::clear_snapshots()
+{
+    for(EventTrace*& t: snapshots) {
+        delete t;
+        t = NULL;
+    }
+    num_snapshots = 0;
+}
+
+void TraceDumpRequest::set_num_threads(size_t num_threads)
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    clear_snapshots();
+    snapshots.resize(num_threads, NULL);
+}
+
+void TraceDumpRequest::add_snapshot(const EventTrace& trace)
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    if (!pending()) {
+        //Another thread completed the dump meanwhile
+        return;
+    }
+    assert(trace.thread_num < snapshots.size());
+    if (snapshots[trace.thread_num] != NULL) {
+        return;
+    }
+
+    snapshots[trace.thread_num] = new EventTrace(trace);
+    num_snapshots++;
+    if (num_snapshots < snapshots.size()) {
+        return;
+    }
+
+    const vector<const EventTrace*> traces(snapshots.begin(), snapshots.end());
+    if (EventTrace::dump(traces, fname)) {
+        cerr << "c event trace written to " << fname << endl;
+    }
+    clear_snapshots();
+    requested.store(false, std::memory_order_relaxed);
+}
@@ -0,0 +1,159 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __EVENTTRACE_H__
+#define __EVENTTRACE_H__
+
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdint>
+#include <chrono>
+#include <iosfwd>
+#include <atomic>
+#include <mutex>
+
+namespace CMSat {
+
+using std::vector;
+using std::string;
+
+enum class TraceType : uint8_t {
+    restart = 0
+    , reducedb = 1
+    , inprocess = 2
+    , gauss_on = 3
+    , gauss_off = 4
+    , sls = 5
+    , sync = 6
+};
+
+//Fixed size so the dump is just the raw ring buffer
+struct TraceEvent
+{
+    uint64_t start_ns; ///<steady clock
+    uint64_t dur_ns; ///<0 for instant events
+    uint64_t conflicts; ///<sumConflicts at the end of the event
+    uint64_t arg; ///<bogoprops for inprocessing, matrix number for Gauss, etc.
+    uint16_t name; ///<index into the name table of the trace
+    uint8_t type;
+    uint8_t pad[5];
+};
+static_assert(sizeof(TraceEvent) == 40, "TraceEvent is dumped as-is, it must be packed");
+
+/**
+@brief Ring buffer of the last events of a solver thread
+
+Recording is a clock read and a 40-byte store, so it can stay enabled in
+production runs. Only the newest events are kept once the buffer is full.
+Convert the dump with scripts/trace/trace2json.py.
+*/
+class EventTrace
+{
+public:
+    EventTrace(uint32_t thread_num, size_t num_events);
+
+    static uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //Event that started at "start", which must come from now()
+    void span(
+        TraceType type
+        , const string& name
+        , uint64_t start
+        , uint64_t conflicts
+        , uint64_t arg = 0
+    );
+    void instant(
+        TraceType type
+        , const string& name
+        , uint64_t conflicts
+        , uint64_t arg = 0
+    );
+
+    uint64_t num_recorded() const;
+
+    //Writes the traces of all threads into one file
+    static bool dump(const vector<const EventTrace*>& traces, const string& fname);
+
+private:
+    void add(TraceType type, const string& name, uint64_t start, uint64_t dur, uint64_t conflicts, uint64_t arg);
+    uint16_t name_index(const string& name);
+    void write(std::ostream& out) const;
+
+    friend class TraceDumpRequest;
+
+    uint32_t thread_num;
+    vector<TraceEvent> events;
+    uint64_t mask;
+    uint64_t recorded = 0;
+    vector<string> names;
+    std::map<string, uint16_t> name_to_index;
+};
+
+/**
+@brief A dump of the traces asked for asynchronously, e.g. from a signal handler
+
+request() only sets a lock-free flag, so it is async-signal-safe. Each solver
+thread copies its own trace at its next restart, and the last one to do so
+writes the file. This way no trace is read while its thread records into it.
+*/
+class TraceDumpRequest
+{
+public:
+    TraceDumpRequest(const string& fname, size_t num_threads);
+    ~TraceDumpRequest();
+
+    void request()
+    {
+        requested.store(true, std::memory_order_relaxed);
+    }
+    bool pending() const
+    {
+        return requested.load(std::memory_order_relaxed);
+    }
+    void set_num_threads(size_t num_threads);
+
+    //Called by the solver threads when the trace is not being recorded into
+    void add_snapshot(const EventTrace& trace);
+
+private:
+    void clear_snapshots();
+
+    std::atomic<bool> requested;
+    const string fname;
+    std::mutex snapshot_mutex;
+    vector<EventTrace*> snapshots; ///<Indexed by thread number
+    size_t num_snapshots = 0;
+};
+
+inline uint64_t EventTrace::num_recorded() const
+{
+    return recorded;
+}
+
+}
+
+#endif //__EVENTTRACE_H__
@@ -83,7 +83,6 @@ EGaussian::~EGaussian() {
 
     delete cols_unset;
     delete cols_vals;
-    delete tmp_col;
     delete tmp_col2;
 }
 
@@ -255,6 +254,20 @@ void EGaussian::delete_gauss_watch_this_matrix()
     }
 }
 
+//Watch lists are kept sorted by matrix, so propagation can handle the
+//watches of one matrix as a single run
+void EGaussian::add_gwatch(const uint32_t var, const uint32_t row_n)
+{
+    vec<GaussWatched>& ws = solver->gwatches[var];
+    ws.push(GaussWatched(row_n, matrix_no));
+    uint32_t at = ws.size()-1;
+    while (at > 0 && ws[at-1].matrix_num > matrix_no) {
+        ws[at] = ws[at-1];
+        at--;
+    }
+    ws[at] = GaussWatched(row_n, matrix_no);
+}
+
 void EGaussian::clear_gwatches(const uint32_t var)
 {
     //if there is only one matrix, don't check, just empty it
@@ -294,6 +307,10 @@ bool EGaussian::full_init(bool& created) {
         return false;
     }
 
+    //A kept matrix, or one built in an earlier round below, only needs
+    //row updates for what got set during propagation
+    bool built = reused;
+    bool add_xors = true;
     while (do_again_gauss) {
         do_again_gauss = false;
 
@@ -301,14 +318,22 @@ bool EGaussian::full_init(bool& created) {
             return false;
         }
 
-        fill_matrix();
+        if (built) {
+            update_matrix(add_xors);
+        } else {
+            fill_matrix();
+        }
+        add_xors = false;
         before_init_density = get_density();
         if (num_rows == 0 || num_cols == 0) {
             created = false;
             return solver->okay();
         }
 
-        eliminate();
+        if (!built) {
+            eliminate();
+            built = true;
+        }
 
         // find some row already true false, and insert watch list
         gret ret = adjust_matrix();
@@ -337,10 +362,20 @@ bool EGaussian::full_init(bool& created) {
 #endif
 
     if (solver->conf.verbosity >= 2) {
-        cout << "c [gauss] initialised matrix " << matrix_no << endl;
+        cout << "c [gauss] initialised matrix " << matrix_no
+        << (reused ? " by row updates" : "") << endl;
+    }
+    if (reused) {
+        num_updated++;
+    } else {
+        num_built++;
+        rows_at_build = xorclauses.size();
     }
+    reused = false;
 
+    xor_reasons.clear();
     xor_reasons.resize(num_rows);
+    reason_mat.resize(num_rows, num_cols);
     uint32_t num_64b = num_cols/64+(bool)(num_cols%64);
     for(auto& x: tofree) {
         delete[] x;
@@ -348,7 +383,6 @@ bool EGaussian::full_init(bool& created) {
     tofree.clear();
     delete cols_unset;
     delete cols_vals;
-    delete tmp_col;
     delete tmp_col2;
 
     int64_t* x = new int64_t[num_64b+1];
@@ -359,17 +393,12 @@ bool EGaussian::full_init(bool& created) {
     tofree.push_back(x);
     cols_vals = new PackedRow(num_64b, x);
 
-    x = new int64_t[num_64b+1];
-    tofree.push_back(x);
-    tmp_col = new PackedRow(num_64b, x);
-
     x = new int64_t[num_64b+1];
     tofree.push_back(x);
     tmp_col2 = new PackedRow(num_64b, x);
 
     cols_vals->rhs() = 0;
     cols_unset->rhs() = 0;
-    tmp_col->rhs() = 0;
     tmp_col2->rhs() = 0;
     after_init_density = get_density();
 
@@ -430,6 +459,250 @@ void EGaussian::eliminate() {
     //print_matrix();
 }
 
+bool EGaussian::can_reuse_for(const vector<Xor>& xors) const
+{
+    if (rows_at_build == 0 || num_cols == 0) {
+        return false;
+    }
+
+    //The XORs must fit into the columns we have
+    vector<char> col_used(num_cols, 0);
+    uint32_t num_used = 0;
+    for(const Xor& x: xors) {
+        for(const uint32_t v: x) {
+            if (v >= var_to_col.size() || var_to_col[v] == unassigned_col) {
+                return false;
+            }
+            if (!col_used[var_to_col[v]]) {
+                col_used[var_to_col[v]] = 1;
+                num_used++;
+            }
+        }
+    }
+
+    //Variables in the rows must still be there, or be set, or be replaced
+    //by one that has a column
+    for(const uint32_t var: col_to_var) {
+        const Removed removed = solver->varData[var].removed;
+        if (removed == Removed::none) {
+            continue;
+        }
+        if (removed != Removed::replaced) {
+            return false;
+        }
+        const Lit repl = solver->varReplacer->get_lit_replaced_with(Lit(var, false));
+        if (solver->value(repl) == l_Undef
+            && (repl.var() >= var_to_col.size()
+                || var_to_col[repl.var()] == unassigned_col)
+        ) {
+            return false;
+        }
+    }
+
+    //Rebuild if it changed too much
+    const double ratio = solver->conf.gaussconf.rebuild_ratio;
+    if ((double)num_used < (double)num_cols*(1.0-ratio)
+        || (double)xors.size() > (double)rows_at_build*(1.0+ratio)
+    ) {
+        return false;
+    }
+
+    return true;
+}
+
+void EGaussian::reuse_for(const vector<Xor>& xors, const uint32_t _matrix_no)
+{
+    xorclauses = xors;
+    matrix_no = _matrix_no;
+    reused = true;
+}
+
+//Brings the echelon form up to date instead of filling and eliminating
+//from scratch. Only rows that changed are eliminated again.
+void EGaussian::update_matrix(const bool add_xors)
+{
+    assert(solver->decisionLevel() == 0);
+    const uint32_t old_rows = num_rows;
+    const uint32_t all_rows = old_rows + (add_xors ? xorclauses.size() : 0);
+    var_has_resp_row.resize(solver->nVars(), 0);
+
+    //XORs are reduced by the rows, most of them to zero
+    if (all_rows > old_rows) {
+        PackedMatrix old;
+        old = mat;
+        mat.resize(all_rows, num_cols);
+        for(uint32_t r = 0; r < old_rows; r++) {
+            mat[r] = old[r];
+        }
+        for(uint32_t i = 0; i < xorclauses.size(); i++) {
+            mat[old_rows+i].set(xorclauses[i], var_to_col, num_cols);
+        }
+    }
+    num_rows = all_rows;
+
+    vector<char> dirty(num_rows, 0);
+    for(uint32_t r = old_rows; r < num_rows; r++) {
+        dirty[r] = 1;
+    }
+    substitute_removed_vars(dirty);
+    eliminate_dirty_rows(dirty);
+
+    //Drop empty rows, except conflicting ones, adjust_matrix() finds those
+    uint32_t j = 0;
+    for(uint32_t r = 0; r < num_rows; r++) {
+        if (mat[r].isZero() && !mat[r].rhs()) {
+            continue;
+        }
+        if (r != j) {
+            mat[j] = mat[r];
+        }
+        j++;
+    }
+    num_rows = j;
+    mat.resizeNumRows(num_rows);
+
+    // reset
+    row_to_var_non_resp.clear();
+    delete_gauss_watch_this_matrix();
+    satisfied_xors.clear();
+    satisfied_xors.resize(num_rows, 0);
+}
+
+//Variables set or replaced since the rows were last updated are substituted.
+//Rows that lose their pivot, or get a new column, are marked dirty.
+void EGaussian::substitute_removed_vars(vector<char>& dirty)
+{
+    //Columns whose variable got assigned or replaced, and what replaces them
+    struct Subst {
+        uint32_t repl_col = unassigned_col;
+        lbool val = l_Undef;
+        bool sign = false;
+        bool was_resp = false;
+    };
+    vector<Subst> subst(num_cols);
+    const uint32_t num_64b = num_cols/64+(bool)(num_cols%64);
+    vector<int64_t> changed_mem(num_64b+1, 0);
+    PackedRow changed(num_64b, changed_mem.data());
+    bool any_changed = false;
+
+    for(uint32_t col = 0; col < num_cols; col++) {
+        const uint32_t var = col_to_var[col];
+        Lit repl = Lit(var, false);
+        if (solver->varData[var].removed == Removed::replaced) {
+            repl = solver->varReplacer->get_lit_replaced_with(repl);
+        }
+        const lbool val = solver->value(repl);
+        if (val == l_Undef && repl.var() == var) {
+            continue;
+        }
+
+        Subst& s = subst[col];
+        s.val = val;
+        s.sign = repl.sign();
+        s.was_resp = var_has_resp_row[var];
+        if (val == l_Undef) {
+            assert(repl.var() < var_to_col.size());
+            s.repl_col = var_to_col[repl.var()];
+            assert(s.repl_col != unassigned_col);
+        }
+        changed.setBit(col);
+        any_changed = true;
+        var_has_resp_row[var] = 0;
+    }
+    if (!any_changed) {
+        return;
+    }
+
+    vector<uint32_t> cols;
+    for(uint32_t r = 0; r < num_rows; r++) {
+        PackedRow row = mat[r];
+        row.get_cols_and(changed, cols);
+        for(const uint32_t col: cols) {
+            const Subst& s = subst[col];
+            row.clearBit(col);
+            if (s.val == l_Undef) {
+                //var = repl.var() ^ repl.sign()
+                if (row[s.repl_col]) {
+                    row.clearBit(s.repl_col);
+                } else {
+                    row.setBit(s.repl_col);
+                }
+                row.invert_rhs(s.sign);
+                dirty[r] = 1;
+            } else {
+                row.invert_rhs(s.val == l_True);
+                if (s.was_resp) {
+                    dirty[r] = 1;
+                }
+            }
+        }
+    }
+}
+
+void EGaussian::eliminate_dirty_rows(vector<char>& dirty)
+{
+    //Columns that have a responsible row, later the pivot columns
+    const uint32_t num_64b = num_cols/64+(bool)(num_cols%64);
+    vector<int64_t> piv_cols_mem(num_64b+1, 0);
+    PackedRow piv_cols(num_64b, piv_cols_mem.data());
+    for(uint32_t col = 0; col < num_cols; col++) {
+        if (var_has_resp_row[col_to_var[col]]) {
+            piv_cols.setBit(col);
+        }
+    }
+
+    vector<uint32_t> pivot_row(num_cols, unassigned_col);
+    vector<uint32_t> cols;
+    for(uint32_t r = 0; r < num_rows; r++) {
+        if (dirty[r]) {
+            continue;
+        }
+        mat[r].get_cols_and(piv_cols, cols);
+        if (cols.size() == 1 && pivot_row[cols[0]] == unassigned_col) {
+            pivot_row[cols[0]] = r;
+        } else {
+            dirty[r] = 1;
+        }
+    }
+    piv_cols.setZero();
+    for(uint32_t col = 0; col < num_cols; col++) {
+        const bool has_pivot = pivot_row[col] != unassigned_col;
+        var_has_resp_row[col_to_var[col]] = has_pivot;
+        if (has_pivot) {
+            piv_cols.setBit(col);
+        }
+    }
+
+    for(uint32_t r = 0; r < num_rows; r++) {
+        if (!dirty[r]) {
+            continue;
+        }
+
+        //Pivot rows have no other pivot column, so one pass reduces it
+        PackedRow row = mat[r];
+        row.get_cols_and(piv_cols, cols);
+        for(const uint32_t col: cols) {
+            row.xor_in(mat[pivot_row[col]]);
+            update_xored_rows++;
+        }
+
+        const uint32_t piv = row.first_one();
+        if (piv == std::numeric_limits<uint32_t>::max()) {
+            continue;
+        }
+
+        pivot_row[piv] = r;
+        piv_cols.setBit(piv);
+        var_has_resp_row[col_to_var[piv]] = 1;
+        for(uint32_t r2 = 0; r2 < num_rows; r2++) {
+            if (r2 != r && mat[r2][piv]) {
+                mat[r2].xor_in(row);
+                update_xored_rows++;
+            }
+        }
+    }
+}
+
 gret EGaussian::adjust_matrix()
 {
     assert(solver->decisionLevel() == 0);
@@ -492,6 +765,7 @@ gret EGaussian::adjust_matrix()
                 #endif
 
                 //adjusting
+                (*rowIt).rhs() = 0;
                 (*rowIt).setZero(); // reset this row all zero
                 row_to_var_non_resp.push_back(std::numeric_limits<uint32_t>::max());
                 var_has_resp_row[tmp_clause[0].var()] = 0;
@@ -530,11 +804,9 @@ gret EGaussian::adjust_matrix()
                 cout << "-> watch 1: resp var " << tmp_clause[0].var()+1 << "for row " << row_n << endl;
                 cout << "-> watch 2: non-resp var " << non_resp_var+1 << "for row " << row_n << endl;
                 #endif
-                solver->gwatches[tmp_clause[0].var()].push(
-                    GaussWatched(row_n, matrix_no)); // insert basic variable
+                add_gwatch(tmp_clause[0].var(), row_n); // insert basic variable
 
-                solver->gwatches[non_resp_var].push(
-                    GaussWatched(row_n, matrix_no)); // insert non-basic variable
+                add_gwatch(non_resp_var, row_n); // insert non-basic variable
                 row_to_var_non_resp.push_back(non_resp_var);               // record in this row non-basic variable
                 break;
         }
@@ -562,7 +834,7 @@ void EGaussian::delete_gausswatch(
         if (ws_t[tmpi].row_n == row_n
             && ws_t[tmpi].matrix_num == matrix_no
         ) {
-            ws_t[tmpi] = ws_t.last();
+            std::copy(ws_t.begin()+tmpi+1, ws_t.end(), ws_t.begin()+tmpi);
             ws_t.shrink(1);
             debug_find = true;
             break;
@@ -660,7 +932,6 @@ bool EGaussian::find_truths(
         col_to_var,
         var_has_resp_row,
         new_resp_var,
-        *tmp_col,
         *tmp_col2,
         *cols_vals,
         *cols_unset,
@@ -672,8 +943,7 @@ bool EGaussian::find_truths(
             find_truth_ret_confl++;
             *j++ = *i;
 
-            xor_reasons[row_n].must_recalc = true;
-            xor_reasons[row_n].propagated = lit_Undef;
+            save_reason(row_n, lit_Undef);
             gqd.confl = PropBy(matrix_no, row_n);
             gqd.ret = gauss_res::confl;
             #ifdef VERBOSE_DEBUG
@@ -698,8 +968,7 @@ bool EGaussian::find_truths(
             *j++ = *i;
 
 
-            xor_reasons[row_n].must_recalc = true;
-            xor_reasons[row_n].propagated = ret_lit_prop;
+            save_reason(row_n, ret_lit_prop);
             assert(solver->value(ret_lit_prop.var()) == l_Undef);
             if (gqd.currLevel == solver->decisionLevel()) {
                 solver->enqueue(ret_lit_prop, gqd.currLevel, PropBy(matrix_no, row_n));
@@ -752,7 +1021,7 @@ bool EGaussian::find_truths(
             #endif
             check_row_not_in_watch(new_resp_var, row_n);
             #endif
-            solver->gwatches[new_resp_var].push(GaussWatched(row_n, matrix_no));
+            add_gwatch(new_resp_var, row_n);
 
             if (was_resp_var) {
                 //it was the responsible one, so the newly watched var
@@ -929,7 +1198,6 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd) {
                     col_to_var,
                     var_has_resp_row,
                     new_non_resp_var,
-                    *tmp_col,
                     *tmp_col2,
                     *cols_vals,
                     *cols_unset,
@@ -945,14 +1213,12 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd) {
                         << "---> conflict during fixup"<< endl;
                         #endif
 
-                        solver->gwatches[p].push(
-                            GaussWatched(row_n, matrix_no));
+                        add_gwatch(p, row_n);
 
                         // update in this row non-basic variable
                         row_to_var_non_resp[row_n] = p;
 
-                        xor_reasons[row_n].must_recalc = true;
-                        xor_reasons[row_n].propagated = lit_Undef;
+                        save_reason(row_n, lit_Undef);
                         gqd.confl = PropBy(matrix_no, row_n);
                         gqd.ret = gauss_res::confl;
                         break;
@@ -969,7 +1235,7 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd) {
                             #ifdef SLOW_DEBUG
                             check_row_not_in_watch(p, row_n);
                             #endif
-                            solver->gwatches[p].push(GaussWatched(row_n, matrix_no));
+                            add_gwatch(p, row_n);
                             row_to_var_non_resp[row_n] = p;
                             break;
                         }
@@ -978,11 +1244,10 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd) {
                         #ifdef SLOW_DEBUG
                         check_row_not_in_watch(p, row_n);
                         #endif
-                        solver->gwatches[p].push(GaussWatched(row_n, matrix_no));
+                        add_gwatch(p, row_n);
                         row_to_var_non_resp[row_n] = p;
 
-                        xor_reasons[row_n].must_recalc = true;
-                        xor_reasons[row_n].propagated = ret_lit_prop;
+                        save_reason(row_n, ret_lit_prop);
                         assert(solver->value(ret_lit_prop.var()) == l_Undef);
                         if (gqd.currLevel == solver->decisionLevel()) {
                             solver->enqueue(ret_lit_prop, gqd.currLevel, PropBy(matrix_no, row_n));
@@ -1017,7 +1282,7 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd) {
                         #ifdef SLOW_DEBUG
                         check_row_not_in_watch(new_non_resp_var, row_n);
                         #endif
-                        solver->gwatches[new_non_resp_var].push(GaussWatched(row_n, matrix_no));
+                        add_gwatch(new_non_resp_var, row_n);
                         row_to_var_non_resp[row_n] = new_non_resp_var;
                         break;
 
@@ -1038,7 +1303,7 @@ void EGaussian::eliminate_col(uint32_t p, GaussQData& gqd) {
                         #ifdef SLOW_DEBUG
                         check_row_not_in_watch(p, row_n);
                         #endif
-                        solver->gwatches[p].push(GaussWatched(row_n, matrix_no));
+                        add_gwatch(p, row_n);
                         row_to_var_non_resp[row_n] = p;
 
                         #ifdef VERBOSE_DEBUG
@@ -1186,6 +1451,15 @@ void EGaussian::print_matrix_stats(uint32_t verbosity)
     << std::setw(5) << num_rows << " x "
     << std::setw(5) << num_cols << endl;
 
+    cout << pre << "built/updated: "
+    << num_built << " / " << num_updated
+    << " update xored rows: "
+    << print_value_kilo_mega(update_xored_rows, false) << endl;
+
+    cout << pre << "reasons built/reused: "
+    << print_value_kilo_mega(reasons_built, false) << " / "
+    << print_value_kilo_mega(reasons_reused, false) << endl;
+
     double density = get_density();
 
     if (verbosity >= 2) {
@@ -1202,24 +1476,37 @@ void EGaussian::print_matrix_stats(uint32_t verbosity)
     cout << std::setprecision(2);
 }
 
+//The row may be XOR-ed with other rows after it propagated, so the reason
+//is taken from the snapshot saved at propagation time. All its other
+//variables stay assigned while the reason is in use, so the literals are
+//only generated when conflict analysis asks for them.
+void EGaussian::save_reason(const uint32_t row_n, const Lit prop)
+{
+    reason_mat[row_n] = mat[row_n];
+    xor_reasons[row_n].must_recalc = true;
+    xor_reasons[row_n].propagated = prop;
+}
+
 vector<Lit>* EGaussian::get_reason(uint32_t row)
 {
-    if (!xor_reasons[row].must_recalc) {
-        return &(xor_reasons[row].reason);
+    XorReason& xr = xor_reasons[row];
+    if (!xr.must_recalc) {
+        reasons_reused++;
+        return &xr.reason;
     }
-    vector<Lit>& tofill = xor_reasons[row].reason;
-    tofill.clear();
+    reasons_built++;
+    xr.reason.clear();
 
-    mat[row].get_reason(
-        tofill,
+    reason_mat[row].get_reason(
+        xr.reason,
         solver->assigns,
         col_to_var,
         *cols_vals,
         *tmp_col2,
-        xor_reasons[row].propagated);
+        xr.propagated);
 
-    xor_reasons[row].must_recalc = false;
-    return &tofill;
+    xr.must_recalc = false;
+    return &xr.reason;
 }
 
 //////////////////
@@ -1307,10 +1594,14 @@ void EGaussian::check_no_prop_or_unsat_rows()
 void EGaussian::check_watchlist_sanity()
 {
     for(size_t i = 0; i < solver->nVars(); i++) {
-        for(auto w: solver->gwatches[i]) {
-            if (w.matrix_num == matrix_no) {
+        const auto& ws = solver->gwatches[i];
+        for(uint32_t k = 0; k < ws.size(); k++) {
+            if (ws[k].matrix_num == matrix_no) {
                 assert(i < var_to_col.size());
             }
+            if (k > 0) {
+                assert(ws[k-1].matrix_num <= ws[k].matrix_num);
+            }
         }
     }
 }
@@ -56,9 +56,9 @@ class Solver;
 
 struct XorReason
 {
-    bool must_recalc = true;
+    bool must_recalc = true; ///<Literals must be regenerated from the snapshot
     Lit propagated = lit_Undef;
-    vector<Lit> reason;
+    vector<Lit> reason; ///<Literal buffer, reused between propagations
 };
 
 class EGaussian {
@@ -98,6 +98,10 @@ class EGaussian {
     void check_watchlist_sanity();
     uint32_t get_matrix_no();
 
+    //Reuse of a matrix kept from an earlier init
+    bool can_reuse_for(const vector<Xor>& xors) const;
+    void reuse_for(const vector<Xor>& xors, const uint32_t matrix_no);
+
     vector<Xor> xorclauses;
 
   private:
@@ -105,6 +109,7 @@ class EGaussian {
 
     //Cleanup
     bool clean_xors();
+    void add_gwatch(const uint32_t var, const uint32_t row_n);
     void clear_gwatches(const uint32_t var);
     void delete_gauss_watch_this_matrix();
     void delete_gausswatch(const uint32_t  row_n);
@@ -119,6 +124,8 @@ class EGaussian {
 
     //Reason generation
     vector<XorReason> xor_reasons;
+    PackedMatrix reason_mat; ///<Rows as they were when they propagated
+    void save_reason(const uint32_t row_n, const Lit prop);
     vector<Lit> tmp_clause;
     uint32_t get_max_level(const GaussQData& gqd, const uint32_t row_n);
 
@@ -129,6 +136,13 @@ class EGaussian {
     gret adjust_matrix(); // adjust matrix, include watch, check row is zero, etc.
     double get_density();
 
+    //Row updates of a kept matrix
+    void update_matrix(const bool add_xors);
+    void substitute_removed_vars(vector<char>& dirty);
+    void eliminate_dirty_rows(vector<char>& dirty);
+    bool reused = false;
+    uint32_t rows_at_build = 0; ///<No. XORs the matrix was last fully built from
+
 
     ///////////////
     // stats
@@ -149,6 +163,11 @@ class EGaussian {
     uint64_t elim_ret_fnewwatch = 0;
     double before_init_density = 0;
     double after_init_density = 0;
+    uint32_t num_built = 0;
+    uint32_t num_updated = 0;
+    uint64_t update_xored_rows = 0;
+    uint64_t reasons_built = 0;
+    uint64_t reasons_reused = 0;
 
     ///////////////
     // Internal data
@@ -179,7 +198,6 @@ class EGaussian {
     //quick lookup
     PackedRow *cols_vals = NULL;
     PackedRow *cols_unset = NULL;
-    PackedRow *tmp_col = NULL;
     PackedRow *tmp_col2 = NULL;
     void update_cols_vals_set(const Lit lit1);
 
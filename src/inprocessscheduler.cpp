@@ -0,0 +1,275 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "inprocessscheduler.h"
+#include "solver.h"
+#include "sqlstats.h"
+#include "time_mem.h"
+
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+//Only the techniques that shrink the CNF are scheduled. The OCC-based
+//tokens are always executed as one batch, so they are accounted together.
+static const char* const scheduled_techniques[] = {
+    "scc-vrepl"
+    , "sub-impl"
+    , "intree-probe"
+    , "sub-str-cls-with-bin"
+    , "sub-cls-with-bin"
+    , "distill-cls"
+    , "str-impl"
+    , "occ"
+};
+
+InprocessCall& InprocessCall::operator+=(const InprocessCall& other)
+{
+    time_used += other.time_used;
+    bogoprops += other.bogoprops;
+    vars_removed += other.vars_removed;
+    cls_removed += other.cls_removed;
+    lits_removed += other.lits_removed;
+    units += other.units;
+
+    return *this;
+}
+
+uint64_t InprocessCall::yield() const
+{
+    return vars_removed + cls_removed + lits_removed + units;
+}
+
+InprocessScheduler::InprocessScheduler(Solver* _solver) :
+    solver(_solver)
+{
+    for(const char* name: scheduled_techniques) {
+        TechStats t;
+        t.name = name;
+        techs.push_back(t);
+    }
+}
+
+int InprocessScheduler::find_technique(const string& token) const
+{
+    for(size_t i = 0; i < techs.size(); i++) {
+        if (techs[i].name == token) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+InprocessScheduler::Snapshot InprocessScheduler::take_snapshot() const
+{
+    Snapshot s;
+    s.time = cpuTime();
+    s.bogoprops = solver->propStats.bogoProps + solver->propStats.otfHyperTime;
+    s.free_vars = solver->get_num_free_vars();
+
+    //Redundant clauses are not counted, removing them is not a simplification
+    const BinTriStats& binTri = solver->getBinTriStats();
+    s.cls = solver->longIrredCls.size() + binTri.irredBins;
+    s.lits = solver->litStats.irredLits + binTri.irredBins*2;
+    s.units = solver->trail_size();
+    s.orig_timeout_mult = solver->conf.global_timeout_multiplier;
+
+    return s;
+}
+
+bool InprocessScheduler::should_run(const int at)
+{
+    assert(at >= 0 && at < (int)techs.size());
+    TechStats& t = techs[at];
+    if (!solver->conf.do_inprocess_sched_adapt
+        || t.skip_rounds_left == 0
+    ) {
+        return true;
+    }
+
+    t.skipped++;
+    if (solver->conf.verbosity) {
+        cout << "c [sched] skipping unproductive '" << t.name << "'"
+        << " rounds left: " << t.skip_rounds_left
+        << endl;
+    }
+    return false;
+}
+
+void InprocessScheduler::start(const int at)
+{
+    assert(at >= 0 && at < (int)techs.size());
+    before = take_snapshot();
+    if (solver->conf.do_inprocess_sched_adapt) {
+        solver->conf.global_timeout_multiplier *= techs[at].budget_mult;
+    }
+}
+
+void InprocessScheduler::finish(const int at)
+{
+    assert(at >= 0 && at < (int)techs.size());
+    solver->conf.global_timeout_multiplier = before.orig_timeout_mult;
+    const Snapshot after = take_snapshot();
+
+    InprocessCall c;
+    c.time_used = after.time - before.time;
+    c.bogoprops = std::max<int64_t>(0, after.bogoprops - before.bogoprops);
+    c.units = std::max<int64_t>(0, after.units - before.units);
+    c.vars_removed = std::max<int64_t>(0,
+        before.free_vars - after.free_vars - (int64_t)c.units);
+    c.cls_removed = std::max<int64_t>(0, before.cls - after.cls);
+    c.lits_removed = std::max<int64_t>(0, before.lits - after.lits);
+
+    TechStats& t = techs[at];
+    t.calls++;
+    t.total += c;
+    t.this_round += c;
+    t.ran_this_round = true;
+
+    if (solver->sqlStats) {
+        solver->sqlStats->inprocess(solver, t.name, c, t.budget_mult);
+    }
+}
+
+void InprocessScheduler::end_round()
+{
+    rounds++;
+
+    //Yield per second, with a floor on time so very fast calls don't dominate
+    double sum_eff = 0;
+    uint32_t num_ran = 0;
+    for(const TechStats& t: techs) {
+        if (t.ran_this_round) {
+            sum_eff += (double)t.this_round.yield()/std::max(t.this_round.time_used, 0.001);
+            num_ran++;
+        }
+    }
+    const double avg_eff = num_ran == 0 ? 0 : sum_eff/(double)num_ran;
+
+    for(TechStats& t: techs) {
+        if (!t.ran_this_round) {
+            if (t.skip_rounds_left > 0) {
+                t.skip_rounds_left--;
+            }
+            continue;
+        }
+
+        if (t.this_round.yield() == 0) {
+            t.unproductive_in_a_row++;
+            if (t.unproductive_in_a_row >= solver->conf.inprocess_sched_unproductive_drop) {
+                t.skip_rounds_left = std::min<uint32_t>(
+                    1U << std::min<uint32_t>(t.backoff, 16)
+                    , solver->conf.inprocess_sched_max_skip);
+                t.backoff++;
+                t.unproductive_in_a_row = 0;
+            }
+        } else {
+            t.unproductive_in_a_row = 0;
+            t.backoff = 0;
+        }
+
+        //Move budget towards the techniques that produce more per unit of time
+        if (avg_eff > 0) {
+            const double eff = (double)t.this_round.yield()/std::max(t.this_round.time_used, 0.001);
+            const double ratio = std::max(eff/avg_eff, 0.25);
+            t.budget_mult *= std::sqrt(ratio);
+            t.budget_mult = std::max(t.budget_mult, solver->conf.inprocess_sched_min_mult);
+            t.budget_mult = std::min(t.budget_mult, solver->conf.inprocess_sched_max_mult);
+        }
+    }
+
+    if (solver->conf.verbosity >= 2) {
+        print_round_summary();
+    }
+
+    for(TechStats& t: techs) {
+        t.this_round = InprocessCall();
+        t.ran_this_round = false;
+    }
+}
+
+void InprocessScheduler::print_round_summary() const
+{
+    for(const TechStats& t: techs) {
+        if (!t.ran_this_round) {
+            continue;
+        }
+
+        cout << "c [sched] " << std::left << std::setw(21) << t.name << std::right
+        << " yield: " << std::setw(8) << t.this_round.yield()
+        << " T: " << std::fixed << std::setprecision(2) << std::setw(6)
+        << t.this_round.time_used
+        << " new budget mult: " << std::setprecision(2) << t.budget_mult
+        << " skip rounds: " << t.skip_rounds_left
+        << endl;
+    }
+}
+
+void InprocessScheduler::print_stats(const double cpu_time) const
+{
+    cout << "c -------- INPROCESS SCHEDULER STATS --------" << endl;
+    cout << "c [sched] rounds: " << rounds
+    << " adaptive: " << (solver->conf.do_inprocess_sched_adapt ? "Y" : "N") << endl;
+    cout
+    << "c " << std::left << std::setw(21) << "technique" << std::right
+    << std::setw(7) << "calls"
+    << std::setw(7) << "skip"
+    << std::setw(9) << "time"
+    << std::setw(7) << "%time"
+    << std::setw(9) << "Mbogo"
+    << std::setw(9) << "vars"
+    << std::setw(10) << "cls"
+    << std::setw(11) << "lits"
+    << std::setw(8) << "units"
+    << std::setw(7) << "mult"
+    << endl;
+
+    for(const TechStats& t: techs) {
+        cout
+        << "c " << std::left << std::setw(21) << t.name << std::right
+        << std::setw(7) << t.calls
+        << std::setw(7) << t.skipped
+        << std::fixed << std::setprecision(2)
+        << std::setw(9) << t.total.time_used
+        << std::setw(7) << stats_line_percent(t.total.time_used, cpu_time)
+        << std::setw(9) << (double)t.total.bogoprops/(1000.0*1000.0)
+        << std::setw(9) << t.total.vars_removed
+        << std::setw(10) << t.total.cls_removed
+        << std::setw(11) << t.total.lits_removed
+        << std::setw(8) << t.total.units
+        << std::setw(7) << t.budget_mult
+        << endl;
+    }
+    cout << "c -------- INPROCESS SCHEDULER STATS END --------" << endl;
+}
+
+double InprocessScheduler::mem_used() const
+{
+    double mem = sizeof(InprocessScheduler);
+    mem += techs.capacity()*sizeof(TechStats);
+    return mem;
+}
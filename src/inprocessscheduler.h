@@ -0,0 +1,118 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __INPROCESSSCHEDULER_H__
+#define __INPROCESSSCHEDULER_H__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+using std::string;
+
+class Solver;
+
+//Effort and yield of a single run of an inprocessing technique.
+//Clauses and literals are irredundant ones only.
+struct InprocessCall
+{
+    InprocessCall& operator+=(const InprocessCall& other);
+    uint64_t yield() const;
+
+    double time_used = 0.0;
+    uint64_t bogoprops = 0;
+    uint64_t vars_removed = 0;
+    uint64_t cls_removed = 0;
+    uint64_t lits_removed = 0;
+    uint64_t units = 0;
+};
+
+/**
+@brief Records cost/benefit of every inprocessing technique and re-allocates
+the time budgets of the techniques between simplification rounds
+
+Budgets are scaled through conf.global_timeout_multiplier, which every
+technique already uses to calculate its own time limit. Techniques that
+are unproductive multiple times in a row are skipped for an exponentially
+growing number of rounds.
+*/
+class InprocessScheduler
+{
+public:
+    explicit InprocessScheduler(Solver* solver);
+
+    //Returns the index of the technique, or -1 if not scheduled
+    int find_technique(const string& token) const;
+    bool should_run(const int at);
+    void start(const int at);
+    void finish(const int at);
+    void end_round();
+
+    void print_stats(const double cpu_time) const;
+    void print_round_summary() const;
+    double mem_used() const;
+
+    struct TechStats
+    {
+        string name;
+        InprocessCall total;
+        InprocessCall this_round;
+        uint64_t calls = 0;
+        uint64_t skipped = 0;
+        bool ran_this_round = false;
+        double budget_mult = 1.0;
+        uint32_t unproductive_in_a_row = 0;
+        uint32_t backoff = 0;
+        uint32_t skip_rounds_left = 0;
+    };
+    const vector<TechStats>& get_stats() const;
+
+private:
+    struct Snapshot
+    {
+        double time = 0.0;
+        int64_t bogoprops = 0;
+        int64_t free_vars = 0;
+        int64_t cls = 0;
+        int64_t lits = 0;
+        int64_t units = 0;
+        double orig_timeout_mult = 1.0;
+    };
+    Snapshot take_snapshot() const;
+
+    Solver* solver;
+    vector<TechStats> techs;
+    Snapshot before;
+    uint64_t rounds = 0;
+};
+
+inline const vector<InprocessScheduler::TechStats>& InprocessScheduler::get_stats() const
+{
+    return techs;
+}
+
+} //end namespace
+
+#endif //__INPROCESSSCHEDULER_H__
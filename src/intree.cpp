@@ -26,9 +26,12 @@ THE SOFTWARE.
 #include "clausecleaner.h"
 #include "sqlstats.h"
 #include "watchalgos.h"
+#include "intreeworker.h"
 
 #include <cmath>
 #include <cassert>
+#include <thread>
+#include <atomic>
 
 using namespace CMSat;
 
@@ -159,15 +162,22 @@ bool InTree::intree_probe()
         solver->conf.intree_time_limitM*1000ULL*1000ULL
         *solver->conf.global_timeout_multiplier;
     bogoprops_to_use = (double)bogoprops_to_use * std::pow((double)(numCalls+1), 0.3);
+    const bool par = solver->conf.intree_threads > 1;
+    if (par) {
+        bogoprops_to_use *= solver->conf.intree_threads;
+    }
     bogoprops_remain = bogoprops_to_use;
 
     fill_roots();
     randomize_roots();
 
     //Let's enqueue all ~root -s.
+    root_start.clear();
     for(Lit lit: roots) {
+        root_start.push_back(queue.size());
         enqueue(~lit, lit_Undef, false);
     }
+    root_start.push_back(queue.size());
 
     //clear seen
     for(QueueElem elem: queue) {
@@ -177,7 +187,11 @@ bool InTree::intree_probe()
     }
     const size_t orig_num_free_vars = solver->get_num_free_vars();
 
-    tree_look();
+    if (par) {
+        tree_look_par();
+    } else {
+        tree_look();
+    }
     unmark_all_bins();
 
     const double time_used = cpuTime() - myTime;
@@ -297,6 +311,124 @@ void InTree::tree_look()
     empty_failed_list();
 }
 
+void InTree::probe_batch_par(
+    const PropSnapshot& snap
+    , vector<InTreeWorker*>& workers
+    , const size_t from
+    , const size_t to
+) {
+    std::atomic<size_t> next(from);
+    const bool hyperbin = solver->conf.do_hyperbin_and_transred;
+
+    auto work = [&](const size_t tid) {
+        if (workers[tid] == NULL) {
+            workers[tid] = new InTreeWorker(snap);
+        }
+        InTreeWorker& w = *workers[tid];
+        for(size_t k = next++; k < to; k = next++) {
+            root_failed[k].clear();
+            root_hyperbins[k].clear();
+            w.probe(queue, root_start[k], root_start[k+1], hyperbin
+                , root_failed[k], root_hyperbins[k]);
+        }
+    };
+
+    vector<std::thread> thds;
+    for(size_t tid = 1; tid < workers.size(); tid++) {
+        thds.push_back(std::thread(work, tid));
+    }
+    work(0);
+    for(std::thread& t: thds) {
+        t.join();
+    }
+
+    for(InTreeWorker* w: workers) {
+        solver->propStats.bogoProps += w->bogoprops;
+        bogoprops_remain -= w->bogoprops;
+        w->bogoprops = 0;
+    }
+}
+
+//Applied in the order of the roots, so the result is independent of the
+//threads
+bool InTree::apply_batch_par(const size_t from, const size_t to)
+{
+    assert(solver->decisionLevel() == 0);
+    vector<Lit> bin(2);
+    for(size_t k = from; k < to; k++) {
+        failed.insert(failed.end(), root_failed[k].begin(), root_failed[k].end());
+        if (!empty_failed_list()) {
+            return false;
+        }
+
+        const vector<Lit>& hyp = root_hyperbins[k];
+        for(size_t i = 0; i < hyp.size(); i += 2) {
+            if (solver->value(hyp[i]) != l_Undef
+                || solver->value(hyp[i+1]) != l_Undef
+            ) {
+                continue;
+            }
+            bin[0] = hyp[i];
+            bin[1] = hyp[i+1];
+            solver->add_clause_int(bin, true);
+            hyperbin_added++;
+        }
+    }
+
+    return solver->okay();
+}
+
+//Same as tree_look(), but the trees are probed in batches by multiple threads
+//over a snapshot. Only failed literals and hyper-binaries are learnt, i.e.
+//the CNF only grows stronger, so the snapshot stays valid between batches.
+void InTree::tree_look_par()
+{
+    assert(failed.empty());
+    assert(solver->decisionLevel() == 0);
+    PropSnapshot snap(solver);
+    snap.add_cls(solver->longIrredCls);
+    snap.add_cls(solver->longRedCls[0]);
+    snap.add_cls(solver->longRedCls[1]);
+    vector<InTreeWorker*> workers(solver->conf.intree_threads, NULL);
+
+    const size_t num_roots = root_start.size()-1;
+    root_failed.resize(num_roots);
+    root_hyperbins.resize(num_roots);
+    const size_t batch_size = std::max<size_t>(num_roots/32, 100);
+    for(size_t from = 0; from < num_roots; from += batch_size) {
+        if (bogoprops_remain < 0
+            || solver->must_interrupt_asap()
+        ) {
+            break;
+        }
+
+        const size_t to = std::min(from + batch_size, num_roots);
+        probe_batch_par(snap, workers, from, to);
+        if (!apply_batch_par(from, to)) {
+            break;
+        }
+    }
+    queue.clear();
+
+    if (solver->conf.verbosity >= 2) {
+        double mem = snap.mem_used();
+        for(const InTreeWorker* w: workers) {
+            if (w) {
+                mem += w->mem_used();
+            }
+        }
+        cout << "c [intree-par] threads: " << workers.size()
+        << " roots: " << num_roots
+        << " mem: " << mem/(1024.0*1024.0) << " MB"
+        << endl;
+    }
+    for(InTreeWorker* w: workers) {
+        delete w;
+    }
+    root_failed.clear();
+    root_hyperbins.clear();
+}
+
 bool InTree::handle_lit_popped_from_queue(const Lit lit, const Lit other_lit, const bool red)
 {
     solver->new_decision_level();
@@ -455,5 +587,6 @@ double InTree::mem_used() const
     mem += reset_reason_stack.size()*sizeof(ResetReason);
     mem += queue.size()*sizeof(QueueElem);
     mem += depth_failed.size()*sizeof(char);
+    mem += root_start.capacity()*sizeof(size_t);
     return mem;
 }
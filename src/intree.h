@@ -20,9 +20,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ***********************************************/
 
+#ifndef __INTREE_H__
+#define __INTREE_H__
+
 #include "cloffset.h"
 #include "solvertypes.h"
 #include "propby.h"
+#include "snapshotprop.h"
 
 #include <vector>
 #include <deque>
@@ -32,6 +36,7 @@ using std::deque;
 namespace CMSat {
 
 class Solver;
+class InTreeWorker;
 
 class InTree
 {
@@ -82,6 +87,19 @@ private:
     void do_one();
     void tree_look();
 
+    //Parallel probing
+    void tree_look_par();
+    void probe_batch_par(
+        const PropSnapshot& snap
+        , vector<InTreeWorker*>& workers
+        , const size_t from
+        , const size_t to
+    );
+    bool apply_batch_par(const size_t from, const size_t to);
+    vector<size_t> root_start;
+    vector<vector<Lit> > root_failed;
+    vector<vector<Lit> > root_hyperbins;
+
     vector<Lit> roots;
     vector<Lit> failed;
     vector<ResetReason> reset_reason_stack;
@@ -114,3 +132,4 @@ inline std::ostream& operator<<(std::ostream& os, const InTree::QueueElem& elem)
 
 }
 
+#endif //__INTREE_H__
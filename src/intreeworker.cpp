@@ -0,0 +1,80 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "intreeworker.h"
+
+using namespace CMSat;
+
+InTreeWorker::InTreeWorker(const PropSnapshot& _snap) :
+    SnapshotProp(_snap)
+{}
+
+//Same as InTree::tree_look(), but hyper-binaries are made between the
+//probed literal and everything propagated at its level by a long clause.
+//The probed literal implies all of its ancestors, so these are all valid.
+void InTreeWorker::probe(
+    const deque<InTree::QueueElem>& queue
+    , const size_t from
+    , const size_t to
+    , const bool hyperbin
+    , vector<Lit>& failed
+    , vector<Lit>& hyperbins
+) {
+    assert(decisionLevel() == 0);
+    depth_failed.clear();
+    depth_failed.push_back(false);
+
+    for(size_t i = from; i < to; i++) {
+        const InTree::QueueElem& elem = queue[i];
+        if (elem.propagated == lit_Undef) {
+            assert(decisionLevel() > 0);
+            cancel_until(decisionLevel()-1);
+            depth_failed.pop_back();
+            continue;
+        }
+
+        const Lit lit = elem.propagated;
+        new_decision_level();
+        depth_failed.push_back(depth_failed.back());
+        if (value(lit) == l_False || depth_failed.back() == 1) {
+            failed.push_back(~lit);
+            continue;
+        }
+
+        if (value(lit) == l_Undef) {
+            const size_t trail_at = trail.size();
+            enqueue(lit);
+            if (!propagate()) {
+                depth_failed.back() = 1;
+                failed.push_back(~lit);
+            } else if (hyperbin) {
+                for(size_t at = trail_at+1; at < trail.size(); at++) {
+                    if (trail_long[at]) {
+                        hyperbins.push_back(~lit);
+                        hyperbins.push_back(trail[at]);
+                    }
+                }
+            }
+        }
+    }
+    assert(decisionLevel() == 0);
+}
@@ -1,5 +1,5 @@
 /******************************************
-Copyright (c) 2010, Mate Soos
+Copyright (c) 2016, Mate Soos
 
 Permission is hereby granted, free of charge, to any person obtaining a copy
 of this software and associated documentation files (the "Software"), to deal
@@ -20,51 +20,46 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ***********************************************/
 
-#ifndef DATASYNC_SERVER_H
-#define DATASYNC_SERVER_H
+#ifndef __INTREEWORKER_H__
+#define __INTREEWORKER_H__
 
 #include <vector>
-#include "mpi.h"
-
+#include <deque>
 #include "solvertypes.h"
-#include "shareddata.h"
+#include "snapshotprop.h"
+#include "intree.h"
 
 namespace CMSat {
 
-class DataSyncServer {
-    public:
-        DataSyncServer();
-        bool actAsServer();
-    private:
-        bool syncFromMPI();
-        void addOneBinToOthers(const Lit lit1, const Lit lit2);
-        void sendDataToAll();
-        void forwardNeedToInterrupt();
-
-        std::vector<uint32_t> syncMPIFinish;
-        std::vector<std::vector<Lit> > bins;
-        std::vector<lbool> value;
-
-        bool ok;
-
-        uint32_t *sendData;
-
-        std::vector<MPI_Request> sendRequests;
-        std::vector<bool> sendRequestsFinished;
-
-        std::vector<bool> alreadyInterrupted;
-        std::vector<bool> alreadySentInterrupt;
-        std::vector<MPI_Request> interruptRequests;
-        int numAlreadyInterrupted;
-
-        int mpiSize;
-        uint32_t nVars;
-        uint32_t recvBinData;
-        uint32_t sentBinData;
-        uint32_t numGotPacket;
-        uint32_t lastSendNumGotPacket;
+using std::vector;
+using std::deque;
+
+/**
+@brief Probes trees of the binary implication graph over a PropSnapshot
+
+The trees are in the format of InTree's queue. Every tree is probed on its
+own, so the result only depends on the snapshot and the tree.
+*/
+class InTreeWorker : public SnapshotProp
+{
+public:
+    explicit InTreeWorker(const PropSnapshot& snap);
+
+    //Probes queue[from..to). Hyper-binaries are put into 'hyperbins' as
+    //pairs of literals.
+    void probe(
+        const deque<InTree::QueueElem>& queue
+        , const size_t from
+        , const size_t to
+        , const bool hyperbin
+        , vector<Lit>& failed
+        , vector<Lit>& hyperbins
+    );
+
+private:
+    vector<char> depth_failed;
 };
 
-}
+} //end namespace
 
-#endif //DATASYNC_SERVER_H
+#endif //__INTREEWORKER_H__
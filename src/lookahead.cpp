@@ -0,0 +1,275 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "lookahead.h"
+#include "solver.h"
+#include "drat.h"
+#include "time_mem.h"
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+Lookahead::Lookahead(Solver* _solver) :
+    solver(_solver)
+{
+}
+
+bool Lookahead::split(
+    const vector<Lit>& prefix
+    , uint32_t depth
+    , vector<vector<Lit>>& cubes
+) {
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    if (!solver->okay()) {
+        return false;
+    }
+    solver->ok = solver->propagate<true>().isNULL();
+    if (!solver->ok) {
+        return false;
+    }
+
+    outer_to_without_bva = solver->build_outer_to_without_bva_map();
+    bogoprops_limit = solver->propStats.bogoProps
+        + (uint64_t)(solver->conf.cube_lookahead_time_limitM*1000ULL*1000ULL
+        *solver->conf.global_timeout_multiplier);
+
+    const size_t orig_cubes = cubes.size();
+    bool ret = enqueue_prefix(prefix);
+    if (ret) {
+        select_candidates();
+        vector<Lit> cube(prefix);
+        split_rec(depth, cube, cubes);
+        ret = solver->okay() && cubes.size() > orig_cubes;
+    } else {
+        stats.dropped++;
+    }
+    solver->cancelUntil<false, true>(0);
+
+    const double time_used = cpuTime() - myTime;
+    stats.cpu_time += time_used;
+    if (solver->conf.verbosity) {
+        cout << "c [lookahead] prefix: " << prefix.size()
+        << " cubes: " << (cubes.size() - orig_cubes)
+        << " failed: " << stats.failed
+        << " dropped: " << stats.dropped
+        << " probes: " << stats.probes
+        << solver->conf.print_times(time_used)
+        << endl;
+    }
+
+    return ret;
+}
+
+bool Lookahead::enqueue_prefix(const vector<Lit>& prefix)
+{
+    if (prefix.empty()) {
+        return true;
+    }
+
+    solver->new_decision_level();
+    solver->back_number_from_outside_to_outer(prefix);
+    for(const Lit outer: solver->back_number_from_outside_to_outer_tmp) {
+        const Lit lit = solver->map_outer_to_inter(outer);
+        //Eliminated variables are restored by solve(), they cannot be set here
+        if (solver->varData[lit.var()].removed != Removed::none) {
+            continue;
+        }
+        if (solver->value(lit) == l_False) {
+            return false;
+        }
+        if (solver->value(lit) == l_Undef) {
+            solver->enqueue<true>(lit);
+        }
+    }
+
+    return solver->propagate<true>().isNULL();
+}
+
+void Lookahead::select_candidates()
+{
+    vector<std::pair<uint64_t, uint32_t>> scored;
+    for(uint32_t v = 0; v < solver->nVars(); v++) {
+        if (solver->value(v) != l_Undef
+            || solver->varData[v].removed != Removed::none
+            || solver->varData[v].is_bva
+        ) {
+            continue;
+        }
+        const uint64_t pos = solver->watches[Lit(v, false)].size();
+        const uint64_t neg = solver->watches[Lit(v, true)].size();
+        scored.push_back(std::make_pair((pos+1)*(neg+1), v));
+    }
+
+    const size_t num = std::min<size_t>(scored.size(), solver->conf.cube_lookahead_vars);
+    std::partial_sort(scored.begin(), scored.begin() + num, scored.end()
+        , std::greater<std::pair<uint64_t, uint32_t>>());
+    candidates.clear();
+    for(size_t i = 0; i < num; i++) {
+        candidates.push_back(scored[i].second);
+    }
+}
+
+bool Lookahead::out_of_time() const
+{
+    return solver->propStats.bogoProps > bogoprops_limit
+        || solver->must_interrupt_asap();
+}
+
+bool Lookahead::probe(const Lit lit, uint64_t& props)
+{
+    stats.probes++;
+    solver->new_decision_level();
+    const size_t orig_trail = solver->trail_size();
+    solver->enqueue<true>(lit);
+    const bool ok = solver->propagate<true>().isNULL();
+    props = solver->trail_size() - orig_trail;
+    solver->cancelUntil<false, true>(solver->decisionLevel()-1);
+
+    return ok;
+}
+
+//"lit" is implied at the current level, because ~lit failed
+bool Lookahead::set_failed(const Lit lit)
+{
+    stats.failed++;
+    solver->enqueue<true>(lit);
+    if (solver->decisionLevel() == 0) {
+        *(solver->drat) << add << lit
+        #ifdef STATS_NEEDED
+        << 0
+        << solver->sumConflicts
+        #endif
+        << fin;
+        units.push_back(inter_to_outside(lit));
+        solver->ok = solver->propagate<true>().isNULL();
+        return solver->ok;
+    }
+
+    return solver->propagate<true>().isNULL();
+}
+
+Lit Lookahead::pick_branch()
+{
+    bool reselected = false;
+    while(true) {
+        Lit best = lit_Undef;
+        uint64_t best_score = 0;
+        bool timeout = false;
+        for(const uint32_t v: candidates) {
+            if (solver->value(v) != l_Undef) {
+                continue;
+            }
+            if (out_of_time()) {
+                timeout = true;
+                break;
+            }
+
+            uint64_t props_pos;
+            uint64_t props_neg;
+            if (!probe(Lit(v, false), props_pos)) {
+                if (!set_failed(Lit(v, true))) {
+                    return lit_Error;
+                }
+                continue;
+            }
+            if (!probe(Lit(v, true), props_neg)) {
+                if (!set_failed(Lit(v, false))) {
+                    return lit_Error;
+                }
+                continue;
+            }
+
+            const uint64_t score = (props_pos+1)*(props_neg+1);
+            if (best == lit_Undef || score > best_score) {
+                best_score = score;
+                best = Lit(v, props_pos < props_neg);
+            }
+        }
+
+        //A later failed literal may have set the best one
+        if (best != lit_Undef && solver->value(best) == l_Undef) {
+            return best;
+        }
+        if (timeout) {
+            return lit_Undef;
+        }
+        if (best != lit_Undef) {
+            continue;
+        }
+
+        //All candidates got set, pick new ones from what remains
+        if (reselected) {
+            return lit_Undef;
+        }
+        reselected = true;
+        select_candidates();
+    }
+}
+
+void Lookahead::split_rec(
+    uint32_t depth
+    , vector<Lit>& cube
+    , vector<vector<Lit>>& cubes
+) {
+    Lit best = lit_Undef;
+    if (depth > 0 && !out_of_time()) {
+        best = pick_branch();
+    }
+    if (best == lit_Error) {
+        stats.dropped++;
+        return;
+    }
+    if (best == lit_Undef) {
+        cubes.push_back(cube);
+        stats.cubes++;
+        return;
+    }
+
+    for(const Lit lit: {best, ~best}) {
+        solver->new_decision_level();
+        solver->enqueue<true>(lit);
+        if (solver->propagate<true>().isNULL()) {
+            cube.push_back(inter_to_outside(lit));
+            split_rec(depth-1, cube, cubes);
+            cube.pop_back();
+        } else {
+            stats.dropped++;
+        }
+        solver->cancelUntil<false, true>(solver->decisionLevel()-1);
+        if (!solver->okay()) {
+            return;
+        }
+    }
+}
+
+Lit Lookahead::inter_to_outside(const Lit lit) const
+{
+    const Lit outer = solver->map_inter_to_outer(lit);
+    const uint32_t var = outer_to_without_bva[outer.var()];
+    assert(var != var_Undef);
+    return Lit(var, outer.sign());
+}
@@ -0,0 +1,113 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __LOOKAHEAD_H__
+#define __LOOKAHEAD_H__
+
+#include "solvertypes.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Splits the search space into cubes by lookahead
+
+Candidate variables are pre-selected by their number of watches, then both
+polarities are probed as in the prober (see InTree) and the variable with the
+best march-like score (props(x)+1)*(props(~x)+1) is branched on. Failed
+literals found at the top level are enqueued as units. Cubes are built on a
+solver that is at decision level 0 and are in the outside numbering, so they
+can be used as assumptions on any solver of the same problem.
+*/
+class Lookahead
+{
+public:
+    explicit Lookahead(Solver* solver);
+
+    //Appends the cubes under "prefix" to "cubes", each a copy of "prefix"
+    //extended with at most "depth" literals. Cubes refuted by propagation
+    //are not returned. Returns false if the whole prefix is refuted, i.e.
+    //no cube is returned.
+    bool split(
+        const vector<Lit>& prefix
+        , uint32_t depth
+        , vector<vector<Lit>>& cubes
+    );
+
+    //Top-level units found, outside numbering
+    const vector<Lit>& get_units() const;
+
+    //True if some cube was dropped as refuted by lookahead
+    bool get_dropped() const;
+
+    struct Stats
+    {
+        uint64_t probes = 0;
+        uint64_t failed = 0;
+        uint64_t cubes = 0;
+        uint64_t dropped = 0;
+        double cpu_time = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    bool enqueue_prefix(const vector<Lit>& prefix);
+    void split_rec(uint32_t depth, vector<Lit>& cube, vector<vector<Lit>>& cubes);
+    Lit pick_branch();
+    bool set_failed(const Lit lit);
+    void select_candidates();
+    bool probe(const Lit lit, uint64_t& props);
+    Lit inter_to_outside(const Lit lit) const;
+    bool out_of_time() const;
+
+    Solver* solver;
+    vector<uint32_t> outer_to_without_bva;
+    vector<uint32_t> candidates;
+    vector<Lit> units;
+    uint64_t bogoprops_limit = 0;
+    Stats stats;
+};
+
+inline const vector<Lit>& Lookahead::get_units() const
+{
+    return units;
+}
+
+inline bool Lookahead::get_dropped() const
+{
+    return stats.dropped > 0;
+}
+
+inline const Lookahead::Stats& Lookahead::get_stats() const
+{
+    return stats;
+}
+
+}
+
+#endif //__LOOKAHEAD_H__
@@ -417,6 +417,8 @@ void Main::add_supported_options()
     #endif
     ("lev1usewithin", po::value(&conf.must_touch_lev1_within)->default_value(conf.must_touch_lev1_within)
         , "Learnt clause must be used in lev1 within this timeframe or be dropped to lev2")
+    ("reducedbthreads", po::value(&conf.reducedb_threads)->default_value(conf.reducedb_threads)
+        , "Number of threads used to extract sort keys and calculate predictions when cleaning the redundant clause database")
     ;
 
     po::options_description red_cl_dump_opts("Clause dumping after problem finishing");
@@ -443,6 +445,12 @@ void Main::add_supported_options()
         , "Search for given amount of solutions. Thanks to Jannis Harder for the decision-based banning idea")
     ("nobansol", po::bool_switch(&dont_ban_solutions)
         , "Don't ban the solution once it's found")
+    ("modelsout", po::value(&models_fname)
+        , "Enumerate the solutions (projected to the sampling vars, if given) without restarting the search and write them to this file in the binary format described in the README. Stops after --maxsol solutions if given")
+    ("count", po::bool_switch(&count_models)
+        , "Count the solutions exactly, projected to the sampling vars if given")
+    ("countcache", po::value(&conf.count_cache_mb)->default_value(conf.count_cache_mb)
+        , "Memory limit of the component cache of --count, in MB")
     ("debuglib", po::value<string>(&debugLib)
         , "Parse special comments to run solve/simplify during parsing of CNF")
     ;
@@ -505,6 +513,8 @@ void Main::add_supported_options()
         , "Carry out intree-based probing")
     ("intreemaxm", po::value(&conf.intree_time_limitM)->default_value(conf.intree_time_limitM)
       , "Time in mega-bogoprops to perform intree probing")
+    ("intreethreads", po::value(&conf.intree_threads)->default_value(conf.intree_threads)
+      , "Number of threads to perform intree probing with. If more than 1, trees are probed in batches on a snapshot of the CNF, without transitive reduction")
     ("otfhyper", po::value(&conf.do_hyperbin_and_transred)->default_value(conf.do_hyperbin_and_transred)
         , "Perform hyper-binary resolution during probing")
     ;
@@ -532,6 +542,16 @@ void Main::add_supported_options()
         , "Schedule for simplification during run")
     ("preschedule", po::value(&conf.simplify_schedule_startup)
         , "Schedule for simplification at startup")
+    ("schedadapt", po::value(&conf.do_inprocess_sched_adapt)->default_value(conf.do_inprocess_sched_adapt)
+        , "Re-allocate the time budgets of simplification techniques between rounds based on their measured cost/benefit, and skip the unproductive ones")
+    ("schedminmult", po::value(&conf.inprocess_sched_min_mult)->default_value(conf.inprocess_sched_min_mult)
+        , "Minimum time budget multiplier of a simplification technique when '--schedadapt' is on")
+    ("schedmaxmult", po::value(&conf.inprocess_sched_max_mult)->default_value(conf.inprocess_sched_max_mult)
+        , "Maximum time budget multiplier of a simplification technique when '--schedadapt' is on")
+    ("scheddropafter", po::value(&conf.inprocess_sched_unproductive_drop)->default_value(conf.inprocess_sched_unproductive_drop)
+        , "Skip a simplification technique after it was unproductive this many rounds in a row")
+    ("schedmaxskip", po::value(&conf.inprocess_sched_max_skip)->default_value(conf.inprocess_sched_max_skip)
+        , "Maximum number of rounds an unproductive simplification technique is skipped for")
 
     ("occsimp", po::value(&conf.perform_occur_based_simp)->default_value(conf.perform_occur_based_simp)
         , "Perform occurrence-list-based optimisations (variable elimination, subsumption, bounded variable addition...)")
@@ -629,10 +649,18 @@ void Main::add_supported_options()
         , "Maximum XOR size to find")
     ("xorfindtout", po::value(&conf.xor_finder_time_limitM)->default_value(conf.xor_finder_time_limitM)
         , "Time limit for finding XORs")
+    ("xorbucket", po::value(&conf.xor_find_buckets)->default_value(conf.xor_find_buckets)
+        , "Before the occurrence-based search, find the fully encoded XORs by grouping the clauses on the same variables")
+    ("xorfindthreads", po::value(&conf.xor_find_threads)->default_value(conf.xor_find_threads)
+        , "Number of threads to check the clause groups of --xorbucket with")
     ("varsperxorcut", po::value(&conf.xor_var_per_cut)->default_value(conf.xor_var_per_cut)
         , "Number of _real_ variables per XOR when cutting them. So 2 will have XORs of size 4 because 1 = connecting to previous, 1 = connecting to next, 2 in the midde. If the XOR is 4 long, it will be just one 4-long XOR, no connectors")
     ("maxxormat", po::value(&conf.maxXORMatrix)->default_value(conf.maxXORMatrix)
         , "Maximum matrix size (=num elements) that we should try to echelonize")
+    ("xordensity", po::value(&conf.xor_dense_density)->default_value(conf.xor_dense_density)
+        , "Top-level blocks of XORs at least this dense (ratio of non-zeros) are echelonized with M4RI if available, the rest with sparse elimination")
+    ("xorsparsetout", po::value(&conf.xor_sparse_gauss_time_limitM)->default_value(conf.xor_sparse_gauss_time_limitM)
+        , "Time limit for the sparse elimination of top-level blocks of XORs")
     ("forcepreservexors", po::value(&conf.force_preserve_xors)->default_value(conf.force_preserve_xors)
         , "Force preserving XORs when they have been found. Easier to make sure XORs are not lost through simplifiactions such as strenghtening")
 #ifdef USE_M4RI
@@ -648,6 +676,12 @@ void Main::add_supported_options()
     eqLitOpts.add_options()
     ("scc", po::value(&conf.doFindAndReplaceEqLits)->default_value(conf.doFindAndReplaceEqLits)
         , "Find equivalent literals through SCC and replace them")
+    ("sccincr", po::value(&conf.scc_incremental)->default_value(conf.scc_incremental)
+        , "Only search for SCCs that are reachable from binary clauses added since the last SCC search")
+    ("sccthreads", po::value(&conf.scc_threads)->default_value(conf.scc_threads)
+        , "Number of threads to find SCCs and to replace equivalent literals in long clauses with")
+    ("sccparmincls", po::value(&conf.scc_par_min_cls)->default_value(conf.scc_par_min_cls)
+        , "Replace equivalent literals in parallel only in clause lists at least this long")
     ;
 
     po::options_description gateOptions("Gate-related options");
@@ -708,6 +742,14 @@ void Main::add_supported_options()
         , "Where to put the SQLite database")
     ("sqlitedboverwrite", po::value(&conf.sql_overwrite_file)->default_value(conf.sql_overwrite_file)
         , "Overwrite the SQLite database file if it exists")
+    ("sqlasync", po::value(&conf.sql_async)->default_value(conf.sql_async)
+        , "Write to the SQLite database from a background thread, in large transactions")
+    ("sqlqueue", po::value(&conf.sql_queue_rows)->default_value(conf.sql_queue_rows)
+        , "Number of rows that can wait for the background SQLite writer")
+    ("sqlbatch", po::value(&conf.sql_batch_rows)->default_value(conf.sql_batch_rows)
+        , "Number of rows the background SQLite writer puts into one transaction")
+    ("sqldrop", po::value(&conf.sql_drop_when_full)->default_value(conf.sql_drop_when_full)
+        , "When the queue of the background SQLite writer is full, drop per-clause and per-variable rows instead of waiting for the writer")
     ("cldatadumpratio", po::value(&conf.dump_individual_cldata_ratio)->default_value(conf.dump_individual_cldata_ratio)
         , "Only dump this ratio of clauses' data, randomly selected. Since machine learning doesn't need that much data, this can reduce the data you have to deal with.")
     ("cllockdatagen", po::value(&conf.lock_for_data_gen_ratio)->default_value(conf.lock_for_data_gen_ratio)
@@ -728,6 +770,10 @@ void Main::add_supported_options()
         , "Print restart status lines at least every N conflicts")
     ("dumpresult", po::value(&resultFilename)
         , "Write solution(s) to this file")
+    ("trace", po::value(&conf.trace_events)->default_value(conf.trace_events)
+        , "Keep the last N search events (restarts, reduceDB, inprocessing, etc.) of every thread. Written at exit, on Ctrl+C and at the first restart after SIGUSR1. 0 = off")
+    ("tracefile", po::value(&trace_filename)->default_value(trace_filename)
+        , "Write the event trace to this file. Convert it with scripts/trace/trace2json.py")
     ;
 
     po::options_description componentOptions("Component options");
@@ -756,6 +802,10 @@ void Main::add_supported_options()
         , "Minimum number of conflicts between OTF distill")
     ("distilltier1ratio", po::value(&conf.distill_red_tier1_ratio)->default_value(conf.distill_red_tier1_ratio)
         , "How much of tier 1 to distill")
+    ("distillthreads", po::value(&conf.distill_threads)->default_value(conf.distill_threads)
+        , "Number of threads to vivify long clauses with. If more than 1, clauses are vivified in batches on a snapshot of the CNF and the shortened clauses are committed after each batch")
+    ("distillparbatch", po::value(&conf.distill_par_batch)->default_value(conf.distill_par_batch)
+        , "Number of clauses vivified by the threads between two commits")
     ;
 
     po::options_description mem_save_opts("Memory saving options");
@@ -768,6 +818,14 @@ void Main::add_supported_options()
         , "Treat all 'renumber' strategies as 'must-renumber'")
     ("fullwatchconseveryn", po::value(&conf.full_watch_consolidate_every_n_confl)->default_value(conf.full_watch_consolidate_every_n_confl)
         , "Consolidate watchlists fully once every N conflicts. Scheduled during simplification rounds.")
+    ("cloffsetshift", po::value(&conf.cl_offset_shift)->default_value(conf.cl_offset_shift)
+        , "Align clauses to 2^N words so 32-bit clause offsets can address 2^N times more memory. Increased automatically when the clause memory nears the limit.")
+    ("hugepages", po::value(&conf.huge_pages)->default_value(conf.huge_pages)
+        , "Back clause memory with huge pages. 0 = no, 1 = transparent huge pages, 2 = 2MB hugetlb pages, 3 = 1GB hugetlb pages. Hugetlb falls back to transparent if no pages are reserved.")
+    ("numa", po::value(&conf.numa_place)->default_value(conf.numa_place)
+        , "With more than one thread, pin every search thread to a NUMA node, round-robin, and allocate its clause and watchlist memory there. A single solver runs on the caller's thread and is left unpinned.")
+    ("watchpool", po::value(&conf.watch_pool)->default_value(conf.watch_pool)
+        , "Allocate the watchlists from one pooled slab with power-of-two size classes instead of malloc-ing each. Compacted in literal order during consolidation. Uses the huge page setting of --hugepages.")
     ;
 
     po::options_description miscOptions("Misc options");
@@ -785,12 +843,46 @@ void Main::add_supported_options()
         , "Find cardinality constraints")
     ;
 
+    po::options_description distOptions("Distributed options");
+    distOptions.add_options()
+    ("distcoord", po::value(&dist_coord_workers)->default_value(dist_coord_workers)
+        , "Act as the coordinator of this many workers: relay their clauses, stop them and print the first answer. Reads no CNF")
+    ("distport", po::value(&conf.dist_port)->default_value(conf.dist_port)
+        , "TCP port of the coordinator")
+    ("distworker", po::value(&conf.dist_host)->default_value(conf.dist_host)
+        , "Solve as a worker of the coordinator running on this host. Give every worker a different '--random'")
+    ("distsync", po::value(&conf.dist_sync_every_confl)->default_value(conf.dist_sync_every_confl)
+        , "Exchange clauses with the coordinator every N conflicts")
+    ("distglue", po::value(&conf.dist_max_glue)->default_value(conf.dist_max_glue)
+        , "Share learnt clauses with at most this glue")
+    ("distsize", po::value(&conf.dist_max_size)->default_value(conf.dist_max_size)
+        , "Share learnt clauses with at most this many literals")
+    ;
+
+    po::options_description cubeOptions("Cube-and-conquer options");
+    cubeOptions.add_options()
+    ("cubes", po::value(&conf.cube_and_conquer)->default_value(conf.cube_and_conquer)
+        , "With more than one thread, split the problem into cubes by lookahead and solve the cubes in parallel instead of racing the threads")
+    ("cubedepth", po::value(&conf.cube_depth)->default_value(conf.cube_depth)
+        , "Number of lookahead decisions in the initial cubes. 0 means about 16 cubes per thread")
+    ("cubeconfl", po::value(&conf.cube_confl_budget)->default_value(conf.cube_confl_budget)
+        , "Split a cube again if it is not solved within this many conflicts")
+    ("cuberesplit", po::value(&conf.cube_resplit_depth)->default_value(conf.cube_resplit_depth)
+        , "Number of lookahead decisions when a cube is split again")
+    ("cubecands", po::value(&conf.cube_lookahead_vars)->default_value(conf.cube_lookahead_vars)
+        , "Number of candidate variables to probe for each split")
+    ("cubetimeout", po::value(&conf.cube_lookahead_time_limitM)->default_value(conf.cube_lookahead_time_limitM)
+        , "Timeout (in bogoprop Millions) of one lookahead splitting")
+    ;
+
     po::options_description reconfOptions("Reconf options");
     reconfOptions.add_options()
     ("reconfat", po::value(&conf.reconfigure_at)->default_value(conf.reconfigure_at)
         , "Reconfigure after this many simplifications")
     ("reconf", po::value(&conf.reconfigure_val)->default_value(conf.reconfigure_val)
-        , "Reconfigure after some time to this solver configuration [3,4,6,7,12,13,14,15,16]")
+        , "Reconfigure after some time to this solver configuration [3,4,6,7,12,13,14,15,16]. 100 means choose the configuration from the SatZilla features of the CNF")
+    ("szthreads", po::value(&conf.satzilla_threads)->default_value(conf.satzilla_threads)
+        , "Number of threads used to calculate the SatZilla features")
     ;
 
     hiddenOptions.add_options()
@@ -854,6 +946,10 @@ void Main::add_supported_options()
         , "If set, verbosity for XOR detach code is upped, ignoring normal verbosity")
     ("gaussusefulcutoff", po::value(&conf.gaussconf.min_usefulness_cutoff)->default_value(conf.gaussconf.min_usefulness_cutoff)
         , "Turn off Gauss if less than this many usefulenss ratio is recorded")
+    ("keepmatrices", po::value(&conf.gaussconf.keep_matrices)->default_value(conf.gaussconf.keep_matrices)
+        , "Keep the Gauss matrices across inprocessing and solve calls, and bring them up to date with row updates instead of rebuilding them")
+    ("matrixrebuild", po::value(&conf.gaussconf.rebuild_ratio)->default_value(conf.gaussconf.rebuild_ratio)
+        , "Rebuild a kept matrix instead of updating it if this ratio of its columns is no longer used, or this ratio of its rows would be new")
     ;
 #endif //USE_GAUSS
 
@@ -898,6 +994,8 @@ void Main::add_supported_options()
     .add(gaussOptions)
     #endif
     .add(distillOptions)
+    .add(distOptions)
+    .add(cubeOptions)
     .add(reconfOptions)
     .add(miscOptions)
     ;
@@ -1378,8 +1476,16 @@ void Main::dump_red_file()
 
 int Main::solve()
 {
+    if (dist_coord_workers > 0) {
+        return run_dist_coordinator();
+    }
+
     solver = new SATSolver((void*)&conf);
     solverToInterrupt = solver;
+    if (conf.trace_events) {
+        traceDumpFname = trace_filename;
+        solver->set_event_trace_dump_file(trace_filename);
+    }
     if (dratf) {
         solver->set_drat(dratf, clause_ID_needed);
     }
@@ -1437,7 +1543,14 @@ int Main::solve()
         delete tmp;
     }
 
-    lbool ret = multi_solutions();
+    lbool ret;
+    if (count_models) {
+        ret = count_solutions();
+    } else if (!models_fname.empty()) {
+        ret = enumerate_solutions();
+    } else {
+        ret = multi_solutions();
+    }
 
     if (conf.preprocess != 1) {
         if (ret == l_Undef && conf.verbosity) {
@@ -1452,6 +1565,9 @@ int Main::solve()
             dump_red_file();
         }
     }
+    if (!traceDumpFname.empty()) {
+        solver->dump_event_trace(traceDumpFname);
+    }
     printResultFunc(&cout, false, ret);
     if (resultfile) {
         printResultFunc(resultfile, true, ret);
@@ -1460,6 +1576,33 @@ int Main::solve()
     return correctReturnValue(ret);
 }
 
+int Main::run_dist_coordinator()
+{
+    vector<lbool> model;
+    lbool ret;
+    try {
+        ret = SATSolver::run_dist_coordinator(
+            conf.dist_port, dist_coord_workers, model, conf.verbosity
+            , vm.count("maxtime") ? maxtime : 1e30);
+    } catch (std::runtime_error& e) {
+        cerr << e.what() << endl;
+        std::exit(-1);
+    }
+
+    if (ret == l_True) {
+        cout << "s SATISFIABLE" << endl;
+        if (printResult) {
+            print_model(model, &cout);
+        }
+    } else if (ret == l_False) {
+        cout << "s UNSATISFIABLE" << endl;
+    } else {
+        cout << "s INDETERMINATE" << endl;
+    }
+
+    return correctReturnValue(ret);
+}
+
 lbool Main::multi_solutions()
 {
     if (max_nr_of_solutions == 1
@@ -1501,6 +1644,86 @@ lbool Main::multi_solutions()
     return ret;
 }
 
+lbool Main::enumerate_solutions()
+{
+    if (dratf || num_threads > 1) {
+        std::cerr << "ERROR: --modelsout can only be used single-threaded and without DRAT" << endl;
+        std::exit(-1);
+    }
+
+    std::ofstream out(models_fname.c_str(), std::ios::binary);
+    if (!out) {
+        std::cerr << "ERROR: Cannot open file '" << models_fname << "' for writing" << endl;
+        std::exit(-1);
+    }
+
+    vector<uint32_t> vars = sampling_vars;
+    if (vars.empty()) {
+        for (uint32_t var = 0; var < solver->nVars(); var++) {
+            vars.push_back(var);
+        }
+    }
+
+    //Header: magic, version, number of vars, the vars. Then each model
+    //as a bitset of the vars' values, LSB first, padded to a byte
+    const uint32_t header[2] = {1, (uint32_t)vars.size()};
+    out.write("CMSMODEL", 8);
+    out.write((const char*)header, sizeof(header));
+    out.write((const char*)vars.data(), vars.size()*sizeof(uint32_t));
+
+    vector<char> packed((vars.size()+7)/8);
+    uint64_t num_found = 0;
+    const uint64_t max_models = vm["maxsol"].defaulted() ?
+        std::numeric_limits<uint64_t>::max() : max_nr_of_solutions;
+    lbool ret = solver->enumerate(
+        [&](const vector<lbool>& vals) {
+            std::fill(packed.begin(), packed.end(), 0);
+            for(size_t i = 0; i < vals.size(); i++) {
+                if (vals[i] == l_True) {
+                    packed[i/8] |= 1 << (i%8);
+                }
+            }
+            out.write(packed.data(), packed.size());
+            num_found++;
+            return true;
+        }
+        , &vars, max_models, &assumps);
+
+    out.close();
+    if (!out) {
+        std::cerr << "ERROR: Failed writing file '" << models_fname << "'" << endl;
+        std::exit(-1);
+    }
+    cout << "c Number of solutions found: " << num_found << endl;
+
+    //The models are in the file
+    if (num_found > 0) {
+        printResult = false;
+        ret = l_True;
+    }
+    return ret;
+}
+
+lbool Main::count_solutions()
+{
+    if (dratf || num_threads > 1 || !models_fname.empty()) {
+        std::cerr << "ERROR: --count can only be used single-threaded, without DRAT and without --modelsout" << endl;
+        std::exit(-1);
+    }
+
+    std::string count;
+    const lbool ret = solver->count_models(
+        count, sampling_vars.empty() ? NULL : &sampling_vars, &assumps);
+    if (ret != l_Undef) {
+        cout << "c s type " << (sampling_vars.empty() ? "mc" : "pmc") << endl;
+        cout << "c s exact arb int " << count << endl;
+    }
+
+    //There is no single model to print
+    printResult = false;
+    return ret;
+}
+
 void Main::ban_found_solution()
 {
     vector<Lit> lits;
@@ -99,6 +99,9 @@ class Main: public MainCommon
         void printVersionInfo();
         int correctReturnValue(const lbool ret) const;
         lbool multi_solutions();
+        lbool enumerate_solutions();
+        lbool count_solutions();
+        int run_dist_coordinator();
         void dump_red_file();
         void ban_found_solution();
 
@@ -109,8 +112,12 @@ class Main: public MainCommon
         string commandLine;
         uint32_t max_nr_of_solutions = 1;
         bool dont_ban_solutions = false;
+        string models_fname;
+        bool count_models = false;
         int sql = 0;
         string sqlite_filename;
+        string trace_filename = "cmsat-trace.bin";
+        unsigned dist_coord_workers = 0;
         double maxtime;
         uint64_t maxconfl;
 
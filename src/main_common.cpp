@@ -54,14 +54,19 @@ void MainCommon::handle_drat_option()
 }
 
 uint32_t MainCommon::print_model(CMSat::SATSolver* solver, std::ostream* os, std::vector<uint32_t>* only)
+{
+    return print_model(solver->get_model(), os, only);
+}
+
+uint32_t MainCommon::print_model(const std::vector<CMSat::lbool>& model, std::ostream* os, std::vector<uint32_t>* only)
 {
     *os << "v ";
     size_t line_size = 2;
     size_t num_undef = 0;
 
     auto fun = [&](uint32_t var) {
-        if (solver->get_model()[var] != CMSat::l_Undef) {
-            const bool value_is_positive = (solver->get_model()[var] == CMSat::l_True);
+        if (model[var] != CMSat::l_Undef) {
+            const bool value_is_positive = (model[var] == CMSat::l_True);
             const size_t this_var_size = std::ceil(std::log10(var+1)) + 1 + !value_is_positive;
             line_size += this_var_size;
             if (line_size > 80) {
@@ -75,7 +80,7 @@ uint32_t MainCommon::print_model(CMSat::SATSolver* solver, std::ostream* os, std
     };
 
     if (only == NULL) {
-        for (uint32_t var = 0; var < solver->nVars(); var++) {
+        for (uint32_t var = 0; var < model.size(); var++) {
             fun(var);
         }
     } else {
@@ -35,6 +35,9 @@ public:
     uint32_t print_model(CMSat::SATSolver* solver,
                          std::ostream* os,
                          std::vector<uint32_t>* only = NULL);
+    uint32_t print_model(const std::vector<CMSat::lbool>& model,
+                         std::ostream* os,
+                         std::vector<uint32_t>* only = NULL);
     void handle_drat_option();
 
     string dratfilname;
@@ -43,6 +43,9 @@ int main(int argc, char** argv)
         main.parseCommandLine();
 
         signal(SIGINT, SIGINT_handler);
+        #if !defined (_MSC_VER)
+        signal(SIGUSR1, SIGUSR1_handler);
+        #endif
         ret = main.solve();
     } catch (CMSat::TooManyVarsError& e) {
         std::cerr << "ERROR! Variable requested is far too large" << std::endl;
@@ -0,0 +1,783 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "modelcounter.h"
+#include "solver.h"
+#include "compfinder.h"
+#include "varreplacer.h"
+#include "time_mem.h"
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+const uint32_t ModelCounter::no_cl;
+
+ModelCounter::ModelCounter(Solver* _solver) :
+    solver(_solver)
+{
+}
+
+lbool ModelCounter::count(
+    const vector<uint32_t>& projection
+    , const vector<Lit>* assumptions
+    , BigNum& result
+) {
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    result = BigNum(0);
+    if (!prepare(projection, assumptions)) {
+        return l_False;
+    }
+
+    //Clauses are cleaned by the component finder, so run it first
+    CompFinder finder(solver);
+    finder.find_components();
+    if (!copy_clauses()) {
+        stats.cpu_time += cpuTime() - myTime;
+        return l_False;
+    }
+
+    result = BigNum(1);
+    vector<uint32_t> all_vars;
+    if (!finder.getTimedOut()) {
+        stats.root_components = finder.getNumComps();
+        for(const auto& it: finder.getReverseTable()) {
+            BigNum sub;
+            count_split(it.second, sub);
+            if (interrupted || sub.is_zero()) {
+                result = BigNum(0);
+                break;
+            }
+            result *= sub;
+        }
+    } else {
+        //No root split, count all vars in one go
+        for(uint32_t v = 0; v < num_vars; v++) {
+            if (!occ[v].empty()) {
+                all_vars.push_back(v);
+            }
+        }
+        count_split(all_vars, result);
+    }
+
+    //Projection vars in no clause at all
+    uint32_t free_proj = 0;
+    for(uint32_t v = 0; v < num_vars; v++) {
+        free_proj += is_proj[v] && assigns[v] == l_Undef && occ[v].empty();
+    }
+    result <<= free_proj;
+
+    stats.cpu_time += cpuTime() - myTime;
+    if (solver->conf.verbosity) {
+        print_stats();
+    }
+    if (interrupted) {
+        result = BigNum(0);
+        return l_Undef;
+    }
+    return result.is_zero() ? l_False : l_True;
+}
+
+bool ModelCounter::prepare(
+    const vector<uint32_t>& projection
+    , const vector<Lit>* assumptions
+) {
+    if (!solver->okay()) {
+        return false;
+    }
+
+    //Re-add the projection and assumption vars if they have been
+    //eliminated, decomposed, etc.
+    vector<Lit> proj_lits;
+    for(const uint32_t v: projection) {
+        proj_lits.push_back(Lit(v, false));
+    }
+    solver->back_number_from_outside_to_outer(proj_lits);
+    proj_lits = solver->back_number_from_outside_to_outer_tmp;
+    vector<Lit> assump_lits;
+    if (assumptions) {
+        solver->back_number_from_outside_to_outer(*assumptions);
+        assump_lits = solver->back_number_from_outside_to_outer_tmp;
+    }
+    vector<Lit> tmp(proj_lits);
+    if (!solver->addClauseHelper(tmp)) {
+        return false;
+    }
+    tmp = assump_lits;
+    if (!solver->addClauseHelper(tmp)) {
+        return false;
+    }
+
+    //Only vars outside the projection may be eliminated, just like for
+    //approximate counting
+    SolverConf& conf = solver->conf;
+    vector<uint32_t> sampling(projection);
+    vector<uint32_t>* orig_sampling_vars = conf.sampling_vars;
+    conf.sampling_vars = &sampling;
+    const lbool ret = solver->simplify_with_assumptions(assumptions);
+    conf.sampling_vars = orig_sampling_vars;
+    if (ret == l_False || !solver->okay()) {
+        return false;
+    }
+    #ifdef USE_GAUSS
+    if (solver->detached_xor_clauses
+        && !solver->fully_undo_xor_detach()
+    ) {
+        return false;
+    }
+    #endif
+
+    num_vars = solver->nVars();
+    is_proj.assign(num_vars, 0);
+    for(const Lit l: proj_lits) {
+        const Lit rep = solver->varReplacer->get_lit_replaced_with_outer(l);
+        const Lit inter = solver->map_outer_to_inter(rep);
+        if (solver->value(inter) != l_Undef) {
+            continue;
+        }
+        assert(inter.var() < num_vars);
+        is_proj[inter.var()] = 1;
+    }
+
+    assumps.clear();
+    for(const Lit l: assump_lits) {
+        const Lit rep = solver->varReplacer->get_lit_replaced_with_outer(l);
+        const Lit inter = solver->map_outer_to_inter(rep);
+        if (solver->value(inter) == l_False) {
+            return false;
+        }
+        if (solver->value(inter) == l_Undef) {
+            assert(inter.var() < num_vars);
+            assumps.push_back(inter);
+        }
+    }
+
+    return true;
+}
+
+bool ModelCounter::copy_clauses()
+{
+    assigns.assign(num_vars, l_Undef);
+    level.assign(num_vars, 0);
+    reason.assign(num_vars, no_cl);
+    phase.assign(num_vars, 0);
+    activity.assign(num_vars, 0);
+    seen.assign(num_vars, 0);
+    var_stamp.assign(num_vars, 0);
+    comp_occ.assign(num_vars, 0);
+    occ.assign(num_vars, vector<uint32_t>());
+    watches.assign(num_vars*2, vector<uint32_t>());
+    cls.clear();
+    learnts.clear();
+    trail.clear();
+    trail_lim.clear();
+    qhead = 0;
+
+    //Values fixed in the solver. These vars are in no clause any more
+    for(uint32_t v = 0; v < num_vars; v++) {
+        assigns[v] = solver->value(v);
+    }
+
+    vector<Lit> lits;
+    for(const ClOffset offs: solver->longIrredCls) {
+        const Clause& cl = *solver->cl_alloc.ptr(offs);
+        lits.assign(cl.begin(), cl.end());
+        add_clause(lits);
+    }
+    for(uint32_t i = 0; i < num_vars*2; i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: solver->watches[lit]) {
+            if (w.isBin() && !w.red() && lit < w.lit2()) {
+                lits.clear();
+                lits.push_back(lit);
+                lits.push_back(w.lit2());
+                add_clause(lits);
+            }
+        }
+    }
+    num_irred = cls.size();
+    cl_stamp.assign(num_irred, 0);
+
+    for(const Lit l: assumps) {
+        if (value(l) == l_False) {
+            return false;
+        }
+        if (value(l) == l_Undef) {
+            enqueue(l, no_cl);
+        }
+    }
+    return propagate() == no_cl;
+}
+
+void ModelCounter::add_clause(const vector<Lit>& lits)
+{
+    assert(lits.size() >= 2);
+    const uint32_t id = cls.size();
+    cls.push_back(lits);
+    watches[lits[0].toInt()].push_back(id);
+    watches[lits[1].toInt()].push_back(id);
+    for(const Lit l: lits) {
+        occ[l.var()].push_back(id);
+    }
+}
+
+void ModelCounter::enqueue(const Lit lit, const uint32_t cl)
+{
+    assert(value(lit) == l_Undef);
+    const uint32_t v = lit.var();
+    assigns[v] = boolToLBool(!lit.sign());
+    level[v] = trail_lim.size();
+    reason[v] = cl;
+    trail.push_back(lit);
+}
+
+void ModelCounter::new_level()
+{
+    trail_lim.push_back(trail.size());
+}
+
+void ModelCounter::backtrack(const uint32_t lev)
+{
+    if (trail_lim.size() <= lev) {
+        return;
+    }
+    backtrack_trail(trail_lim[lev]);
+    trail_lim.resize(lev);
+}
+
+void ModelCounter::backtrack_trail(const size_t trail_size)
+{
+    for(size_t i = trail.size(); i > trail_size; i--) {
+        const uint32_t v = trail[i-1].var();
+        phase[v] = assigns[v] == l_True;
+        assigns[v] = l_Undef;
+        reason[v] = no_cl;
+    }
+    trail.resize(trail_size);
+    qhead = trail.size();
+}
+
+//Watches of a literal are visited once it becomes false. The
+//propagated literal of a reason clause is always its first one
+uint32_t ModelCounter::propagate()
+{
+    while(qhead < trail.size()) {
+        const Lit false_lit = ~trail[qhead++];
+        vector<uint32_t>& ws = watches[false_lit.toInt()];
+        size_t j = 0;
+        for(size_t i = 0; i < ws.size(); i++) {
+            const uint32_t id = ws[i];
+            vector<Lit>& c = cls[id];
+
+            //Removed learnt clause, drop the watch
+            if (c.empty()) {
+                continue;
+            }
+            if (c[0] == false_lit) {
+                std::swap(c[0], c[1]);
+            }
+            assert(c[1] == false_lit);
+            if (value(c[0]) == l_True) {
+                ws[j++] = id;
+                continue;
+            }
+
+            bool moved = false;
+            for(size_t k = 2; k < c.size(); k++) {
+                if (value(c[k]) != l_False) {
+                    std::swap(c[1], c[k]);
+                    watches[c[1].toInt()].push_back(id);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+
+            ws[j++] = id;
+            if (value(c[0]) == l_False) {
+                for(i++; i < ws.size(); i++) {
+                    ws[j++] = ws[i];
+                }
+                ws.resize(j);
+                qhead = trail.size();
+                return id;
+            }
+            enqueue(c[0], id);
+        }
+        ws.resize(j);
+    }
+
+    return no_cl;
+}
+
+//First UIP learning. Fills "learnt" with the asserting literal first and
+//the highest of the rest second, returns the backjump level
+uint32_t ModelCounter::analyze(uint32_t confl)
+{
+    const uint32_t dec_level = trail_lim.size();
+    learnt.clear();
+    learnt.push_back(lit_Undef);
+    int path = 0;
+    Lit p = lit_Undef;
+    size_t index = trail.size();
+    do {
+        assert(confl != no_cl);
+        for(const Lit q: cls[confl]) {
+            const uint32_t v = q.var();
+            if (q == p || seen[v] || level[v] == 0) {
+                continue;
+            }
+            seen[v] = 1;
+            bump(v);
+            if (level[v] >= dec_level) {
+                path++;
+            } else {
+                learnt.push_back(q);
+            }
+        }
+        while(!seen[trail[--index].var()]);
+        p = trail[index];
+        confl = reason[p.var()];
+        seen[p.var()] = 0;
+        path--;
+    } while(path > 0);
+    learnt[0] = ~p;
+
+    //Drop the literals implied by the others through their reasons
+    removed.clear();
+    size_t j = 1;
+    for(size_t i = 1; i < learnt.size(); i++) {
+        const uint32_t r = reason[learnt[i].var()];
+        bool redundant = r != no_cl;
+        if (redundant) {
+            for(const Lit q: cls[r]) {
+                if (q.var() != learnt[i].var() && !seen[q.var()] && level[q.var()] > 0) {
+                    redundant = false;
+                    break;
+                }
+            }
+        }
+        if (redundant) {
+            removed.push_back(learnt[i].var());
+        } else {
+            learnt[j++] = learnt[i];
+        }
+    }
+    learnt.resize(j);
+    for(const uint32_t v: removed) {
+        seen[v] = 0;
+    }
+
+    uint32_t bj = 0;
+    for(size_t i = 1; i < learnt.size(); i++) {
+        seen[learnt[i].var()] = 0;
+        if (level[learnt[i].var()] > bj) {
+            bj = level[learnt[i].var()];
+            std::swap(learnt[1], learnt[i]);
+        }
+    }
+    var_inc *= 1.0/0.95;
+    return bj;
+}
+
+uint32_t ModelCounter::add_learnt()
+{
+    if (learnts.size() >= max_learnts) {
+        reduce_learnts();
+    }
+
+    const uint32_t id = cls.size();
+    cls.push_back(learnt);
+    learnts.push_back(id);
+    if (learnt.size() > 1) {
+        watches[learnt[0].toInt()].push_back(id);
+        watches[learnt[1].toInt()].push_back(id);
+    }
+    return id;
+}
+
+//Removes the older half of the learnt clauses that are not reasons.
+//Their watches are dropped lazily by propagate()
+void ModelCounter::reduce_learnts()
+{
+    size_t j = 0;
+    const size_t to_remove = learnts.size()/2;
+    for(size_t i = 0; i < learnts.size(); i++) {
+        const uint32_t id = learnts[i];
+        vector<Lit>& c = cls[id];
+        const bool locked = reason[c[0].var()] == id && value(c[0]) == l_True;
+        if (i >= to_remove || locked || c.size() <= 2) {
+            learnts[j++] = id;
+            continue;
+        }
+        vector<Lit>().swap(c);
+    }
+    learnts.resize(j);
+    max_learnts += max_learnts/10;
+}
+
+void ModelCounter::bump(const uint32_t var)
+{
+    activity[var] += var_inc;
+    if (activity[var] > 1e100) {
+        for(double& act: activity) {
+            act *= 1e-100;
+        }
+        var_inc *= 1e-100;
+    }
+}
+
+bool ModelCounter::out_of_time()
+{
+    steps++;
+    if ((steps & 0xff) == 0
+        && (cpuTime() > solver->conf.maxTime || solver->must_interrupt_asap())
+    ) {
+        interrupted = true;
+    }
+    return interrupted;
+}
+
+//Collects the unassigned vars and the unsatisfied original clauses
+//reachable from "start". Uses the current stamp
+void ModelCounter::find_comp(const uint32_t start, Comp& comp)
+{
+    var_stamp[start] = stamp;
+    comp.vars.push_back(start);
+    for(size_t at = 0; at < comp.vars.size(); at++) {
+        const uint32_t v = comp.vars[at];
+        comp.has_proj |= is_proj[v];
+        for(const uint32_t id: occ[v]) {
+            if (cl_stamp[id] == stamp) {
+                continue;
+            }
+            cl_stamp[id] = stamp;
+
+            const vector<Lit>& c = cls[id];
+            bool sat = false;
+            for(const Lit l: c) {
+                if (value(l) == l_True) {
+                    sat = true;
+                    break;
+                }
+            }
+            if (sat) {
+                continue;
+            }
+            comp.cls.push_back(id);
+            for(const Lit l: c) {
+                if (value(l) == l_Undef && var_stamp[l.var()] != stamp) {
+                    var_stamp[l.var()] = stamp;
+                    comp.vars.push_back(l.var());
+                }
+            }
+        }
+    }
+}
+
+//Counts the unassigned vars of "vars" under the current assignment,
+//as the product of the counts of their components
+void ModelCounter::count_split(const vector<uint32_t>& vars, BigNum& out)
+{
+    out = BigNum(1);
+    if (out_of_time()) {
+        return;
+    }
+
+    stamp++;
+    vector<Comp> comps;
+    uint32_t free_proj = 0;
+    for(const uint32_t v: vars) {
+        if (assigns[v] != l_Undef || var_stamp[v] == stamp) {
+            continue;
+        }
+        comps.push_back(Comp());
+        find_comp(v, comps.back());
+        if (comps.back().cls.empty()) {
+            free_proj += is_proj[v];
+            comps.pop_back();
+        }
+    }
+
+    //Cheap satisfiability checks first, then the smaller components
+    std::sort(comps.begin(), comps.end(),
+        [](const Comp& a, const Comp& b) {
+            if (a.has_proj != b.has_proj) {
+                return !a.has_proj;
+            }
+            return a.vars.size() < b.vars.size();
+        }
+    );
+
+    const uint64_t mark = next_cache_id;
+    for(const Comp& comp: comps) {
+        stats.components++;
+        BigNum sub;
+        count_comp(comp, sub);
+        if (interrupted) {
+            return;
+        }
+        if (sub.is_zero()) {
+            out = BigNum(0);
+            cache_remove_since(mark);
+            return;
+        }
+        out *= sub;
+    }
+    out <<= free_proj;
+}
+
+void ModelCounter::count_comp(const Comp& comp, BigNum& out)
+{
+    vector<uint32_t> k = make_key(comp);
+    stats.cache_lookups++;
+    auto it = cache.find(k);
+    if (it != cache.end()) {
+        stats.cache_hits++;
+        it->second.last_used = ++cache_time;
+        out = it->second.count;
+        return;
+    }
+
+    //Nothing to count, only satisfiability matters
+    if (!comp.has_proj) {
+        stats.sat_checks++;
+        out = BigNum(sat_check(comp) ? 1 : 0);
+        if (!interrupted && !out.is_zero()) {
+            cache_store(k, out);
+        }
+        return;
+    }
+
+    //Occurrences in the unsatisfied clauses of the component
+    for(const uint32_t id: comp.cls) {
+        for(const Lit l: cls[id]) {
+            comp_occ[l.var()] += value(l) == l_Undef;
+        }
+    }
+    uint32_t best = var_Undef;
+    double best_score = -1;
+    for(const uint32_t v: comp.vars) {
+        const double score = activity[v] + comp_occ[v];
+        comp_occ[v] = 0;
+        if (!is_proj[v]) {
+            continue;
+        }
+        if (score > best_score) {
+            best_score = score;
+            best = v;
+        }
+    }
+    assert(best != var_Undef && assigns[best] == l_Undef);
+
+    out = BigNum(0);
+    const bool first = phase[best];
+    for(int i = 0; i < 2; i++) {
+        const Lit lit(best, (i == 0) ? !first : first);
+        new_level();
+        enqueue(lit, no_cl);
+        stats.decisions++;
+        const uint32_t confl = propagate();
+        if (confl != no_cl) {
+            stats.conflicts++;
+            analyze(confl);
+            add_learnt();
+        } else {
+            BigNum sub;
+            count_split(comp.vars, sub);
+            out += sub;
+        }
+        backtrack(trail_lim.size()-1);
+        if (interrupted) {
+            return;
+        }
+    }
+
+    if (!out.is_zero()) {
+        cache_store(k, out);
+    }
+}
+
+//CDCL over the vars of the component. Decisions and learning stay above
+//the level it is called at, which is restored on return
+bool ModelCounter::sat_check(const Comp& comp)
+{
+    const uint32_t base = trail_lim.size();
+    const size_t base_trail = trail.size();
+    bool sat = false;
+    while(!out_of_time()) {
+        const uint32_t confl = propagate();
+        if (confl != no_cl) {
+            stats.conflicts++;
+            if (trail_lim.size() <= base) {
+                if (base > 0) {
+                    analyze(confl);
+                    add_learnt();
+                }
+                break;
+            }
+            const uint32_t bj = analyze(confl);
+            backtrack(std::max(bj, base));
+            enqueue(learnt[0], add_learnt());
+            continue;
+        }
+
+        uint32_t best = var_Undef;
+        double best_act = -1;
+        for(const uint32_t v: comp.vars) {
+            if (assigns[v] == l_Undef && activity[v] > best_act) {
+                best_act = activity[v];
+                best = v;
+            }
+        }
+        if (best == var_Undef) {
+            sat = true;
+            break;
+        }
+        new_level();
+        enqueue(Lit(best, !phase[best]), no_cl);
+        stats.decisions++;
+    }
+
+    backtrack(base);
+    backtrack_trail(base_trail);
+    return sat;
+}
+
+size_t ModelCounter::KeyHash::operator()(const vector<uint32_t>& k) const
+{
+    uint64_t h = 14695981039346656037ULL;
+    for(const uint32_t x: k) {
+        h ^= x;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+//Sorted vars, a separator, then the sorted ids of the unsatisfied
+//clauses. Together they determine the residual formula of the component
+vector<uint32_t> ModelCounter::make_key(const Comp& comp) const
+{
+    vector<uint32_t> k(comp.vars);
+    std::sort(k.begin(), k.end());
+    k.push_back(std::numeric_limits<uint32_t>::max());
+    const size_t at = k.size();
+    k.insert(k.end(), comp.cls.begin(), comp.cls.end());
+    std::sort(k.begin() + at, k.end());
+    return k;
+}
+
+size_t ModelCounter::entry_mem(const Cache::value_type& entry) const
+{
+    return entry.first.capacity()*sizeof(uint32_t)
+        + entry.second.count.mem_used()
+        + sizeof(Cache::value_type) + 2*sizeof(void*)
+        + sizeof(Cache::value_type*); //its slot in cache_by_id
+}
+
+void ModelCounter::cache_store(vector<uint32_t>& k, const BigNum& count)
+{
+    CacheEntry entry;
+    entry.count = count;
+    entry.last_used = ++cache_time;
+    entry.id = next_cache_id;
+    auto ret = cache.insert(std::make_pair(std::move(k), entry));
+    if (!ret.second) {
+        return;
+    }
+    next_cache_id++;
+    cache_by_id.push_back(&*ret.first);
+    cache_mem += entry_mem(*ret.first);
+
+    if (cache_mem > solver->conf.count_cache_mb*1024ULL*1024ULL) {
+        cache_evict();
+    }
+}
+
+//Least recently used half goes
+void ModelCounter::cache_evict()
+{
+    vector<uint64_t> times;
+    times.reserve(cache.size());
+    for(const auto& entry: cache) {
+        times.push_back(entry.second.last_used);
+    }
+    std::nth_element(times.begin(), times.begin() + times.size()/2, times.end());
+    const uint64_t limit = times[times.size()/2];
+
+    //Keep cache_by_id to the live entries, so it stays within the limit too
+    size_t j = 0;
+    for(Cache::value_type* entry: cache_by_id) {
+        if (entry->second.last_used >= limit) {
+            cache_by_id[j++] = entry;
+        }
+    }
+    cache_by_id.resize(j);
+
+    for(auto it = cache.begin(); it != cache.end();) {
+        if (it->second.last_used < limit) {
+            cache_mem -= entry_mem(*it);
+            stats.cache_evicted++;
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+//Counts cached since "id" may be too low: a sibling component turned out
+//unsatisfiable, so learnt clauses could have pruned them unsoundly
+void ModelCounter::cache_remove_since(const uint64_t id)
+{
+    while(!cache_by_id.empty() && cache_by_id.back()->second.id >= id) {
+        Cache::value_type* entry = cache_by_id.back();
+        cache_by_id.pop_back();
+        cache_mem -= entry_mem(*entry);
+        stats.cache_polluted++;
+        cache.erase(entry->first);
+    }
+}
+
+void ModelCounter::print_stats() const
+{
+    cout << "c [count] root comps: " << stats.root_components
+    << " comps: " << stats.components
+    << " decisions: " << stats.decisions
+    << " conflicts: " << stats.conflicts
+    << " sat checks: " << stats.sat_checks
+    << endl;
+
+    cout << "c [count] cache hit rate: " << std::fixed << std::setprecision(2)
+    << stats_line_percent(stats.cache_hits, stats.cache_lookups) << "%"
+    << " evicted: " << stats.cache_evicted
+    << " polluted: " << stats.cache_polluted
+    << " size: " << cache_mem/(1024*1024) << "MB"
+    << solver->conf.print_times(stats.cpu_time)
+    << endl;
+}
@@ -0,0 +1,189 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef __MODELCOUNTER_H__
+#define __MODELCOUNTER_H__
+
+#include "solvertypes.h"
+#include "bignum.h"
+
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Exact projected model counter
+
+The problem is first simplified with the projection set as the sampling
+vars, so BVE and the other techniques only remove vars that are not
+projected. The irredundant clauses left are then counted by DPLL with
+component decomposition: the root components come from CompFinder, deeper
+ones are found after each decision on a projection var. Counts of
+components are kept in a hashed cache, bounded by conf.count_cache_mb.
+Components without projection vars only need a satisfiability check,
+which is done by CDCL. Learnt clauses are used for propagation everywhere
+but are not part of the components.
+
+Learnt clauses can cross components, so once a component turns out to be
+unsatisfiable, the counts cached for its siblings since the split may be
+too low and are removed, as in sharpSAT.
+*/
+class ModelCounter
+{
+public:
+    explicit ModelCounter(Solver* solver);
+
+    //Projection and assumptions are in the outside numbering. Returns
+    //l_Undef if interrupted or out of time
+    lbool count(
+        const vector<uint32_t>& projection
+        , const vector<Lit>* assumptions
+        , BigNum& result
+    );
+
+    struct Stats
+    {
+        uint64_t decisions = 0;
+        uint64_t conflicts = 0;
+        uint64_t sat_checks = 0;
+        uint64_t components = 0;
+        uint64_t cache_hits = 0;
+        uint64_t cache_lookups = 0;
+        uint64_t cache_evicted = 0;
+        uint64_t cache_polluted = 0;
+        uint32_t root_components = 0;
+        double cpu_time = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    static const uint32_t no_cl = std::numeric_limits<uint32_t>::max();
+
+    struct Comp
+    {
+        vector<uint32_t> vars;
+        vector<uint32_t> cls;
+        bool has_proj = false;
+    };
+
+    //Setup
+    bool prepare(const vector<uint32_t>& projection, const vector<Lit>* assumptions);
+    bool copy_clauses();
+    void add_clause(const vector<Lit>& lits);
+    void print_stats() const;
+
+    //Propagation and learning
+    lbool value(const Lit lit) const;
+    void enqueue(const Lit lit, const uint32_t cl);
+    void new_level();
+    void backtrack(const uint32_t lev);
+    void backtrack_trail(const size_t trail_size);
+    uint32_t propagate();
+    uint32_t analyze(uint32_t confl);
+    uint32_t add_learnt();
+    void reduce_learnts();
+    void bump(const uint32_t var);
+
+    //Counting
+    void count_split(const vector<uint32_t>& vars, BigNum& out);
+    void count_comp(const Comp& comp, BigNum& out);
+    bool sat_check(const Comp& comp);
+    void find_comp(const uint32_t start, Comp& comp);
+    bool out_of_time();
+
+    //Cache
+    struct KeyHash
+    {
+        size_t operator()(const vector<uint32_t>& k) const;
+    };
+    struct CacheEntry
+    {
+        BigNum count;
+        uint64_t last_used;
+        uint64_t id;
+    };
+    typedef std::unordered_map<vector<uint32_t>, CacheEntry, KeyHash> Cache;
+    vector<uint32_t> make_key(const Comp& comp) const;
+    void cache_store(vector<uint32_t>& k, const BigNum& count);
+    void cache_evict();
+    void cache_remove_since(const uint64_t id);
+    size_t entry_mem(const Cache::value_type& entry) const;
+    Cache cache;
+    vector<Cache::value_type*> cache_by_id; ///<Live entries, in increasing id
+    uint64_t next_cache_id = 0;
+    size_t cache_mem = 0;
+    uint64_t cache_time = 0;
+
+    Solver* solver;
+    uint32_t num_vars = 0;
+    vector<Lit> assumps;
+    vector<vector<Lit>> cls;
+    uint32_t num_irred = 0;
+    vector<uint32_t> learnts;
+    size_t max_learnts = 2000;
+    vector<vector<uint32_t>> watches;
+    vector<vector<uint32_t>> occ;
+    vector<char> is_proj;
+
+    vector<lbool> assigns;
+    vector<uint32_t> level;
+    vector<uint32_t> reason;
+    vector<char> phase;
+    vector<double> activity;
+    double var_inc = 1.0;
+    vector<Lit> trail;
+    vector<uint32_t> trail_lim;
+    size_t qhead = 0;
+
+    vector<char> seen;
+    vector<Lit> learnt;
+    vector<uint32_t> removed;
+    vector<uint64_t> var_stamp;
+    vector<uint64_t> cl_stamp;
+    vector<uint32_t> comp_occ;
+    uint64_t stamp = 0;
+    uint64_t steps = 0;
+    bool interrupted = false;
+    Stats stats;
+};
+
+inline const ModelCounter::Stats& ModelCounter::get_stats() const
+{
+    return stats;
+}
+
+inline lbool ModelCounter::value(const Lit lit) const
+{
+    return assigns[lit.var()] ^ lit.sign();
+}
+
+}
+
+#endif //__MODELCOUNTER_H__
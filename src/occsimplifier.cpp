@@ -55,10 +55,7 @@ THE SOFTWARE.
 #include "xorfinder.h"
 #include "bva.h"
 #include "trim.h"
-
-#ifdef USE_M4RI
 #include "toplevelgauss.h"
-#endif
 
 //#define VERBOSE_DEBUG
 #ifdef VERBOSE_DEBUG
@@ -98,11 +95,7 @@ OccSimplifier::OccSimplifier(Solver* _solver):
     , blockedMapBuilt(false)
 {
     bva = new BVA(solver, this);
-    topLevelGauss = new TopLevelGaussAbst;
-    #ifdef USE_M4RI
-    delete topLevelGauss;
     topLevelGauss = new TopLevelGauss(solver);
-    #endif
     sub_str = new SubsumeStrengthen(this, solver);
 
     if (solver->conf.doGateFind) {
@@ -228,49 +221,142 @@ void OccSimplifier::extend_model(SolutionExtender* extender)
     //go through in reverse order
     vector<Lit> lits;
     for (int i = (int)blockedClauses.size()-1; i >= 0; i--) {
-        BlockedClauses* it = &blockedClauses[i];
-        if (it->toRemove) {
+        if (blockedClauses[i].toRemove) {
             continue;
         }
+        extend_blocked(extender, blockedClauses[i], lits);
+    }
+    if (solver->conf.verbosity >= 2) {
+        cout << "c [extend] Extended " << blockedClauses.size() << " var-elim clauses" << endl;
+    }
+}
 
-        Lit blockedOn = solver->varReplacer->get_lit_replaced_with_outer(it->at(0, blkcls));
-        size_t at = 1;
-        bool satisfied = false;
-        lits.clear();
-        while(at < it->size()) {
-            //built clause, reached marker, "lits" is now valid
-            if (it->at(at, blkcls) == lit_Undef) {
-                if (!satisfied) {
-                    bool var_set = extender->addClause(lits, blockedOn.var());
-
-                    #ifndef DEBUG_VARELIM
-                    //all should be satisfied in fact
-                    //no need to go any further
-                    if (var_set) {
-                        break;
-                    }
-                    #endif
+void OccSimplifier::extend_blocked(
+    SolutionExtender* extender
+    , const BlockedClauses& blocked
+    , vector<Lit>& lits
+) {
+    Lit blockedOn = solver->varReplacer->get_lit_replaced_with_outer(blocked.at(0, blkcls));
+    size_t at = 1;
+    bool satisfied = false;
+    lits.clear();
+    while(at < blocked.size()) {
+        //built clause, reached marker, "lits" is now valid
+        if (blocked.at(at, blkcls) == lit_Undef) {
+            if (!satisfied) {
+                bool var_set = extender->addClause(lits, blockedOn.var());
+
+                #ifndef DEBUG_VARELIM
+                //all should be satisfied in fact
+                //no need to go any further
+                if (var_set) {
+                    break;
                 }
-                satisfied = false;
-                lits.clear();
+                #endif
+            }
+            satisfied = false;
+            lits.clear();
 
-            //Building clause, "lits" is not yet valid
-            } else if (!satisfied) {
-                Lit l = it->at(at, blkcls);
-                l = solver->varReplacer->get_lit_replaced_with_outer(l);
-                lits.push_back(l);
+        //Building clause, "lits" is not yet valid
+        } else if (!satisfied) {
+            Lit l = blocked.at(at, blkcls);
+            l = solver->varReplacer->get_lit_replaced_with_outer(l);
+            lits.push_back(l);
 
-                //Blocked clause can be skipped, it's satisfied
-                if (solver->model_value(l) == l_True) {
-                    satisfied = true;
-                }
+            //Blocked clause can be skipped, it's satisfied
+            if (solver->model_value(l) == l_True) {
+                satisfied = true;
             }
-            at++;
         }
-        extender->dummyBlocked(blockedOn.var());
+        at++;
+    }
+    extender->dummyBlocked(blockedOn.var());
+}
+
+void OccSimplifier::update_blocked_deps()
+{
+    if (blk_deps_start.empty()) {
+        blk_deps_start.push_back(0);
+    }
+    if (blk_deps_seen.size() < solver->nVarsOuter()) {
+        blk_deps_seen.resize(solver->nVarsOuter(), 0);
+    }
+
+    for(size_t i = blk_deps_start.size()-1; i < blockedClauses.size(); i++) {
+        const BlockedClauses& blocked = blockedClauses[i];
+        const uint32_t blockedOn = blocked.at(0, blkcls).var();
+        for(uint64_t at = 1; at < blocked.size(); at++) {
+            const Lit l = blocked.at(at, blkcls);
+            if (l == lit_Undef
+                || l.var() == blockedOn
+                || blk_deps_seen[l.var()]
+            ) {
+                continue;
+            }
+            blk_deps_seen[l.var()] = 1;
+            blk_deps.push_back(l.var());
+        }
+        for(uint64_t k = blk_deps_start.back(); k < blk_deps.size(); k++) {
+            blk_deps_seen[blk_deps[k]] = 0;
+        }
+        blk_deps_start.push_back(blk_deps.size());
+    }
+}
+
+//Variables in the clauses of an entry were eliminated later than the entry's
+//variable, or not at all. So replaying the entries reachable from
+//"outer_vars" in reverse order gives them the same values as extend_model()
+void OccSimplifier::extend_model_for(
+    SolutionExtender* extender
+    , const vector<uint32_t>& outer_vars
+) {
+    if (!blockedMapBuilt) {
+        buildBlockedMap();
+    }
+    update_blocked_deps();
+
+    vector<uint32_t> todo;
+    vector<uint32_t> seen_vars;
+    vector<uint32_t> entries;
+    for(const uint32_t var: outer_vars) {
+        todo.push_back(solver->varReplacer->get_var_replaced_with_outer(var));
+    }
+    while(!todo.empty()) {
+        const uint32_t var = todo.back();
+        todo.pop_back();
+        if (blk_deps_seen[var]) {
+            continue;
+        }
+        blk_deps_seen[var] = 1;
+        seen_vars.push_back(var);
+
+        if (var >= blk_var_to_cls.size()) {
+            continue;
+        }
+        const uint32_t at = blk_var_to_cls[var];
+        if (at == std::numeric_limits<uint32_t>::max()
+            || blockedClauses[at].toRemove
+        ) {
+            continue;
+        }
+        entries.push_back(at);
+        for(uint64_t k = blk_deps_start[at]; k < blk_deps_start[at+1]; k++) {
+            todo.push_back(solver->varReplacer->get_var_replaced_with_outer(blk_deps[k]));
+        }
+    }
+    for(const uint32_t var: seen_vars) {
+        blk_deps_seen[var] = 0;
+    }
+
+    std::sort(entries.begin(), entries.end(), std::greater<uint32_t>());
+    vector<Lit> lits;
+    for(const uint32_t at: entries) {
+        extend_blocked(extender, blockedClauses[at], lits);
     }
     if (solver->conf.verbosity >= 2) {
-        cout << "c [extend] Extended " << blockedClauses.size() << " var-elim clauses" << endl;
+        cout << "c [extend] Extended " << entries.size()
+        << " of " << blockedClauses.size() << " var-elim clauses for "
+        << outer_vars.size() << " vars" << endl;
     }
 }
 
@@ -1355,7 +1441,6 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
             if (solver->conf.doFindXors) {
                 XorFinder finder(this, solver);
                 finder.find_xors();
-                #ifdef USE_M4RI
                 if (topLevelGauss != NULL) {
                     auto xors = solver->xorclauses;
                     assert(solver->okay());
@@ -1371,7 +1456,6 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
                         }
                     }
                 }
-                #endif
                 runStats.xorTime += finder.get_stats().findTime;
             } else {
                 //TODO this is something VERY fishy
@@ -2181,6 +2265,10 @@ void OccSimplifier::cleanBlockedClauses()
     blkcls.resize(j_blkcls);
     blockedClauses.resize(blockedClauses.size()-(i-j));
     can_remove_blocked_clauses = false;
+    if (i != j) {
+        blk_deps.clear();
+        blk_deps_start.clear();
+    }
 }
 
 void OccSimplifier::rem_cls_from_watch_due_to_varelim(
@@ -3158,6 +3246,9 @@ size_t OccSimplifier::mem_used() const
     b += blockedClauses.capacity()*sizeof(BlockedClauses);
     b += blkcls.capacity()*sizeof(Lit);
     b += blk_var_to_cls.size()*sizeof(uint32_t);
+    b += blk_deps.capacity()*sizeof(uint32_t);
+    b += blk_deps_start.capacity()*sizeof(uint64_t);
+    b += blk_deps_seen.capacity();
     b += velim_order.mem_used();
     b += varElimComplexity.capacity()*sizeof(int)*2;
     b += elim_calc_need_update.mem_used();
@@ -3335,6 +3426,8 @@ void OccSimplifier::load_state(SimpleInFile& f)
 
     blockedMapBuilt = false;
     buildBlockedMap();
+    blk_deps.clear();
+    blk_deps_start.clear();
 
     //Sanity check
     for(size_t i = 0; i < solver->nVars(); i++) {
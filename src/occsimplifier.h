@@ -224,6 +224,8 @@ public:
     //UnElimination
     void print_blocked_clauses_reverse() const;
     void extend_model(SolutionExtender* extender);
+    //Only replays the blocked clauses the given (outer) variables depend on
+    void extend_model_for(SolutionExtender* extender, const vector<uint32_t>& outer_vars);
     uint32_t get_num_elimed_vars() const
     {
         return bvestats_global.numVarsElimed;
@@ -556,6 +558,19 @@ private:
     void buildBlockedMap();
     void cleanBlockedClauses();
     bool can_remove_blocked_clauses = false;
+    void extend_blocked(
+        SolutionExtender* extender
+        , const BlockedClauses& blocked
+        , vector<Lit>& lits
+    );
+
+    //Dependency index of blockedClauses: the other variables (outer) of
+    //the clauses of each entry. Appended to lazily, cleared when
+    //blockedClauses is compacted.
+    vector<uint32_t> blk_deps;
+    vector<uint64_t> blk_deps_start; ///<one more than the entries indexed
+    vector<uint8_t> blk_deps_seen;
+    void update_blocked_deps();
 
     //validity checking
     void sanityCheckElimedVars();
@@ -61,10 +61,13 @@ uint32_t PackedRow::find_watchVar(
     non_resp_var = std::numeric_limits<uint32_t>::max();
     tmp_clause.clear();
 
-    for(int i = 0; i < size*64; i++) {
-        if (this->operator[](i)){
+    for (int i = 0; i < size; i++) {
+        uint64_t tmp = mp[i];
+        while (tmp != 0) {
+            const uint32_t col = i*64 + scan_fwd_64b(tmp)-1;
+            tmp &= tmp-1;
             popcnt++;
-            uint32_t var = col_to_var[i];
+            uint32_t var = col_to_var[col];
             tmp_clause.push_back(Lit(var, false));
 
             if (!var_has_resp_row[var]) {
@@ -82,6 +85,28 @@ uint32_t PackedRow::find_watchVar(
     return popcnt;
 }
 
+void PackedRow::get_cols_and(const PackedRow& mask, vector<uint32_t>& cols) const
+{
+    cols.clear();
+    for (int i = 0; i < size; i++) {
+        uint64_t tmp = mp[i] & mask.mp[i];
+        while (tmp != 0) {
+            cols.push_back(i*64 + scan_fwd_64b(tmp)-1);
+            tmp &= tmp-1;
+        }
+    }
+}
+
+uint32_t PackedRow::first_one() const
+{
+    for (int i = 0; i < size; i++) {
+        if (mp[i]) {
+            return i*64 + scan_fwd_64b(mp[i])-1;
+        }
+    }
+    return std::numeric_limits<uint32_t>::max();
+}
+
 void PackedRow::get_reason(
     vector<Lit>& tmp_clause,
     const vector<lbool>& assigns,
@@ -126,12 +151,42 @@ void PackedRow::get_reason(
     #endif
 }
 
+//Goes through the unassigned columns of one word of the row. Stops when
+//there are at least two of them and one has no responsible row.
+inline bool PackedRow::scan_unset_word(
+    uint64_t word,
+    const uint32_t at_col,
+    const vector<uint32_t>& col_to_var,
+    const vector<char>& var_has_resp_row,
+    uint32_t& pop,
+    uint32_t& first_col,
+    uint32_t& new_resp_var
+) {
+    while (word != 0) {
+        const uint32_t col = at_col + scan_fwd_64b(word)-1;
+        word &= word-1;
+        if (pop++ == 0) {
+            first_col = col;
+        }
+
+        const uint32_t var = col_to_var[col];
+        if (new_resp_var == std::numeric_limits<uint32_t>::max()
+            && !var_has_resp_row[var]
+        ) {
+            new_resp_var = var;
+        }
+        if (pop >= 2 && new_resp_var != std::numeric_limits<uint32_t>::max()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 gret PackedRow::propGause(
     const vector<lbool>& assigns,
     const vector<uint32_t>& col_to_var,
     vector<char> &var_has_resp_row,
     uint32_t& new_resp_var,
-    PackedRow& tmp_col,
     PackedRow& tmp_col2,
     PackedRow& cols_vals,
     PackedRow& cols_unset,
@@ -139,47 +194,46 @@ gret PackedRow::propGause(
 ) {
     //cout << "start" << endl;
     //cout << "line: " << *this << endl;
-    uint32_t pop = tmp_col.set_and_until_popcnt_atleast2(*this, cols_unset);
     #ifdef VERBOSE_DEBUG
-    cout << "POP in GausE: " << pop << " row: " << endl;
+    cout << "propGause row: " << endl;
     cout << *this << endl;
     cout << " cols_unset: " << endl;
     cout << cols_unset << endl;
     #endif
 
-    //Find new watch
-    if (pop >= 2) {
-        for (int i = 0; i < size; i++) if (tmp_col.mp[i]) {
-            int64_t tmp = tmp_col.mp[i];
-            unsigned long at;
-            at = scan_fwd_64b(tmp);
-            int extra = 0;
-            while (at != 0) {
-                uint32_t col = extra + at-1 + i*64;
-                #ifdef SLOW_DEBUG
-                assert(tmp_col[col] == 1);
-                #endif
-                const uint32_t var = col_to_var[col];
-
-                #ifdef SLOW_DEBUG
-                const lbool val = assigns[var];
-                assert(val == l_Undef);
-                #endif
-
-                // found new non-basic variable, let's watch it
-                if (!var_has_resp_row[var]) {
-                    new_resp_var = var;
-                    return gret::nothing_fnewwatch;
-                }
-
-                extra += at;
-                if (extra == 64)
-                    break;
-
-                tmp >>= at;
-                at = scan_fwd_64b(tmp);
+    //Find new watch: the row is AND-ed with cols_unset four words at a
+    //time, and blocks with no unassigned column are skipped with one test.
+    //The fixed-width inner loop can be turned into vector ops by the compiler.
+    uint32_t pop = 0;
+    uint32_t first_col = std::numeric_limits<uint32_t>::max();
+    new_resp_var = std::numeric_limits<uint32_t>::max();
+    int i = 0;
+    for (; i+4 <= size; i += 4) {
+        uint64_t w[4];
+        uint64_t any = 0;
+        for (int k = 0; k < 4; k++) {
+            w[k] = (uint64_t)(mp[i+k] & cols_unset.mp[i+k]);
+            any |= w[k];
+        }
+        if (any == 0) {
+            continue;
+        }
+        for (int k = 0; k < 4; k++) {
+            if (scan_unset_word(w[k], (i+k)*64, col_to_var, var_has_resp_row
+                , pop, first_col, new_resp_var)
+            ) {
+                return gret::nothing_fnewwatch;
             }
         }
+    }
+    for (; i < size; i++) {
+        if (scan_unset_word(mp[i] & cols_unset.mp[i], i*64, col_to_var
+            , var_has_resp_row, pop, first_col, new_resp_var)
+        ) {
+            return gret::nothing_fnewwatch;
+        }
+    }
+    if (pop >= 2) {
         assert(false && "Should have found a new watch!");
     }
 
@@ -189,20 +243,13 @@ gret PackedRow::propGause(
 
     //Lazy prop
     if (pop == 1) {
-        for (int i = 0; i < size; i++) if (tmp_col.mp[i]) {
-            int at = scan_fwd_64b(tmp_col.mp[i]);
-
-            // found prop
-            uint32_t col = at-1 + i*64;
-            #ifdef SLOW_DEBUG
-            assert(tmp_col[col] == 1);
-            #endif
-            const uint32_t var = col_to_var[col];
-            assert(assigns[var] == l_Undef);
-            ret_lit_prop = Lit(var, !(pop_t % 2));
-            return gret::prop;
-        }
-        assert(false && "Should have found the propagating literal!");
+        #ifdef SLOW_DEBUG
+        assert(cols_unset[first_col] == 1);
+        #endif
+        const uint32_t var = col_to_var[first_col];
+        assert(assigns[var] == l_Undef);
+        ret_lit_prop = Lit(var, !(pop_t % 2));
+        return gret::prop;
     }
 
     //Only SAT & UNSAT left.
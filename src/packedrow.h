@@ -131,23 +131,6 @@ public:
         }
     }
 
-    uint32_t set_and_until_popcnt_atleast2(const PackedRow& a, const PackedRow& b)
-    {
-        #ifdef DEBUG_ROW
-        assert(size > 0);
-        assert(b.size > 0);
-        assert(b.size == size);
-        #endif
-
-        uint32_t pop = 0;
-        for (int i = 0; i < size && pop < 2; i++) {
-            *(mp + i) = *(a.mp + i) & *(b.mp + i);
-            pop += __builtin_popcountll((uint64_t)*(mp + i));
-        }
-
-        return pop;
-    }
-
     void xor_in(const PackedRow& b)
     {
         #ifdef DEBUG_ROW
@@ -267,7 +250,6 @@ public:
         const vector<uint32_t>& col_to_var,
         vector<char> &var_has_resp_row,
         uint32_t& new_resp_var,
-        PackedRow& tmp_col,
         PackedRow& tmp_col2,
         PackedRow& cols_vals,
         PackedRow& cols_unset,
@@ -286,7 +268,23 @@ public:
     uint32_t popcnt() const;
     uint32_t popcnt_at_least_2() const;
 
+    //Columns set both in this row and in "mask", lowest first
+    void get_cols_and(const PackedRow& mask, vector<uint32_t>& cols) const;
+
+    //Lowest set column, or max() if the row is zero
+    uint32_t first_one() const;
+
 private:
+    static bool scan_unset_word(
+        uint64_t word,
+        const uint32_t at_col,
+        const vector<uint32_t>& col_to_var,
+        const vector<char>& var_has_resp_row,
+        uint32_t& pop,
+        uint32_t& first_col,
+        uint32_t& new_resp_var
+    );
+
     friend class PackedMatrix;
     friend class EGaussian;
     friend std::ostream& operator << (std::ostream& os, const PackedRow& m);
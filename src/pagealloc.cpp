@@ -0,0 +1,308 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "pagealloc.h"
+
+#include <cstdlib>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <new>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace CMSat;
+using std::string;
+
+#if defined(__linux__)
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+#define CMS_MPOL_PREFERRED 1
+#endif
+
+static const size_t page_2m = 2ULL*1024ULL*1024ULL;
+static const size_t page_1g = 1024ULL*1024ULL*1024ULL;
+
+static size_t round_up(const size_t bytes, const size_t unit)
+{
+    return (bytes + unit - 1) & ~(unit - 1);
+}
+
+PageAlloc::~PageAlloc()
+{
+    while(!blocks.empty()) {
+        dealloc(blocks.begin()->first);
+    }
+}
+
+void PageAlloc::set_huge_pages(const HugePages _mode)
+{
+    mode = _mode;
+}
+
+void PageAlloc::set_numa_node(const int node)
+{
+    numa_node = node;
+}
+
+void PageAlloc::account(const Block& b, const int64_t sign)
+{
+    const size_t bytes = b.bytes;
+    auto upd = [&](uint64_t& val) {
+        if (sign > 0) {
+            val += bytes;
+        } else {
+            assert(val >= bytes);
+            val -= bytes;
+        }
+    };
+
+    switch(b.kind) {
+        case Kind::malloced:
+            upd(stats.malloced);
+            break;
+        case Kind::mapped:
+            upd(stats.mapped);
+            if (b.advised) {
+                upd(stats.transparent);
+            }
+            break;
+        case Kind::huge_2m:
+            upd(stats.mapped);
+            upd(stats.huge_2m);
+            break;
+        case Kind::huge_1g:
+            upd(stats.mapped);
+            upd(stats.huge_1g);
+            break;
+    }
+    if (b.numa) {
+        upd(stats.numa_bound);
+    }
+}
+
+#if defined(__linux__)
+void* PageAlloc::map_hugetlb(const size_t bytes, const Kind kind)
+{
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB
+        | (kind == Kind::huge_1g ? MAP_HUGE_1GB : MAP_HUGE_2MB);
+    void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (p == MAP_FAILED) {
+        //No huge pages reserved by the admin, most likely
+        stats.hugetlb_failed++;
+        return NULL;
+    }
+    return p;
+}
+
+//Maps more than needed so the start can be aligned to a 2MB page
+void* PageAlloc::map_transparent(const size_t bytes)
+{
+    const size_t to_map = bytes + page_2m;
+    char* p = (char*)mmap(NULL, to_map, PROT_READ | PROT_WRITE
+        , MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+
+    char* aligned = (char*)round_up((size_t)p, page_2m);
+    if (aligned != p) {
+        munmap(p, aligned-p);
+    }
+    const size_t tail = (p + to_map) - (aligned + bytes);
+    if (tail > 0) {
+        munmap(aligned + bytes, tail);
+    }
+    if (mode != HugePages::none) {
+        madvise(aligned, bytes, MADV_HUGEPAGE);
+    }
+    return aligned;
+}
+
+bool PageAlloc::bind_to_node(void* p, const size_t bytes)
+{
+    if (numa_node < 0 || numa_node >= (int)(sizeof(unsigned long)*8)) {
+        return false;
+    }
+    const unsigned long mask = 1UL << numa_node;
+    return syscall(SYS_mbind, p, bytes, CMS_MPOL_PREFERRED, &mask, sizeof(mask)*8, 0) == 0;
+}
+#endif
+
+void* PageAlloc::alloc(const size_t bytes)
+{
+    stats.num_allocs++;
+    void* p = NULL;
+    Block b;
+    b.bytes = bytes;
+    b.kind = Kind::malloced;
+    b.advised = false;
+    b.numa = false;
+
+    #if defined(__linux__)
+    if (mode == HugePages::huge_1g && bytes >= page_1g/2) {
+        b.bytes = round_up(bytes, page_1g);
+        b.kind = Kind::huge_1g;
+        p = map_hugetlb(b.bytes, b.kind);
+    }
+    if (p == NULL
+        && (mode == HugePages::huge_2m || mode == HugePages::huge_1g)
+    ) {
+        b.bytes = round_up(bytes, page_2m);
+        b.kind = Kind::huge_2m;
+        p = map_hugetlb(b.bytes, b.kind);
+    }
+    if (p == NULL
+        && (mode != HugePages::none || numa_node >= 0)
+    ) {
+        b.bytes = round_up(bytes, page_2m);
+        b.kind = Kind::mapped;
+        p = map_transparent(b.bytes);
+    }
+    if (p != NULL) {
+        b.advised = (b.kind == Kind::mapped && mode != HugePages::none);
+        b.numa = bind_to_node(p, b.bytes);
+    }
+    #endif
+
+    if (p == NULL) {
+        b.bytes = bytes;
+        b.kind = Kind::malloced;
+        p = malloc(bytes);
+        if (p == NULL) {
+            return NULL;
+        }
+    }
+
+    blocks[p] = b;
+    account(b, 1);
+    return p;
+}
+
+void PageAlloc::dealloc(void* p)
+{
+    if (p == NULL) {
+        return;
+    }
+    auto it = blocks.find(p);
+    assert(it != blocks.end());
+    const Block b = it->second;
+    blocks.erase(it);
+    account(b, -1);
+
+    if (b.kind == Kind::malloced) {
+        free(p);
+        return;
+    }
+    #if defined(__linux__)
+    munmap(p, b.bytes);
+    #else
+    assert(false);
+    #endif
+}
+
+int CMSat::num_numa_nodes()
+{
+    #if defined(__linux__)
+    int num = 0;
+    while(true) {
+        std::ifstream f("/sys/devices/system/node/node" + std::to_string(num) + "/cpulist");
+        if (!f) {
+            break;
+        }
+        num++;
+    }
+    return std::max(num, 1);
+    #else
+    return 1;
+    #endif
+}
+
+bool CMSat::bind_thread_to_numa_node(const int node)
+{
+    #if defined(__linux__)
+    std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    string list;
+    if (!f || !std::getline(f, list)) {
+        return false;
+    }
+
+    //Format is e.g. "0-3,8-11"
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    std::stringstream ss(list);
+    string range;
+    bool any = false;
+    while(std::getline(ss, range, ',')) {
+        int from;
+        int to;
+        const int num = sscanf(range.c_str(), "%d-%d", &from, &to);
+        if (num == 1) {
+            to = from;
+        } else if (num != 2) {
+            continue;
+        }
+        for(int i = from; i <= to && i < CPU_SETSIZE; i++) {
+            CPU_SET(i, &set);
+            any = true;
+        }
+    }
+    if (!any) {
+        return false;
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    #else
+    (void)node;
+    return false;
+    #endif
+}
+
+uint64_t CMSat::process_anon_huge_bytes()
+{
+    #if defined(__linux__)
+    std::ifstream f("/proc/self/smaps_rollup");
+    string line;
+    while(std::getline(f, line)) {
+        unsigned long long kb;
+        if (sscanf(line.c_str(), "AnonHugePages: %llu kB", &kb) == 1) {
+            return kb*1024ULL;
+        }
+    }
+    #endif
+    return 0;
+}
@@ -0,0 +1,112 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __PAGEALLOC_H__
+#define __PAGEALLOC_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+
+namespace CMSat {
+
+using std::map;
+
+enum class HugePages {
+    none = 0 ///<plain malloc
+    , transparent = 1 ///<mmap, madvise(MADV_HUGEPAGE)
+    , huge_2m = 2 ///<MAP_HUGETLB with 2MB pages, transparent if not available
+    , huge_1g = 3 ///<MAP_HUGETLB with 1GB pages, transparent if not available
+};
+
+struct PageStats
+{
+    uint64_t num_allocs = 0;
+    uint64_t malloced = 0;
+    uint64_t mapped = 0;
+    uint64_t transparent = 0;
+    uint64_t huge_2m = 0;
+    uint64_t huge_1g = 0;
+    uint64_t numa_bound = 0;
+    uint64_t hugetlb_failed = 0;
+};
+
+/**
+@brief Allocates large blocks of memory, optionally backed by huge pages and
+bound to a NUMA node
+
+Only available on Linux, elsewhere everything falls back to malloc.
+*/
+class PageAlloc
+{
+public:
+    ~PageAlloc();
+    void set_huge_pages(const HugePages mode);
+    void set_numa_node(const int node);
+    int get_numa_node() const;
+
+    void* alloc(const size_t bytes);
+    void dealloc(void* p);
+    const PageStats& get_stats() const;
+
+private:
+    enum class Kind {malloced, mapped, huge_2m, huge_1g};
+    struct Block
+    {
+        size_t bytes;
+        Kind kind;
+        bool advised; ///<madvise()-d for transparent huge pages
+        bool numa; ///<bound to a NUMA node
+    };
+    void* map_hugetlb(const size_t bytes, const Kind kind);
+    void* map_transparent(const size_t bytes);
+    bool bind_to_node(void* p, const size_t bytes);
+    void account(const Block& b, const int64_t sign);
+
+    HugePages mode = HugePages::none;
+    int numa_node = -1;
+    map<void*, Block> blocks;
+    PageStats stats;
+};
+
+inline const PageStats& PageAlloc::get_stats() const
+{
+    return stats;
+}
+
+inline int PageAlloc::get_numa_node() const
+{
+    return numa_node;
+}
+
+//Returns the number of NUMA nodes, 1 if unknown
+int num_numa_nodes();
+
+//Binds the calling thread to the CPUs of the node. Returns false on failure.
+bool bind_thread_to_numa_node(const int node);
+
+//Bytes in transparent huge pages of the whole process, 0 if unknown
+uint64_t process_anon_huge_bytes();
+
+} //end namespace
+
+#endif //__PAGEALLOC_H__
@@ -0,0 +1,93 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "phasetimer.h"
+#include "solvertypes.h"
+
+#include <cassert>
+
+using namespace CMSat;
+
+const char* PhaseTimer::name(const Phase p)
+{
+    switch(p) {
+        case search: return "search";
+        case propagate: return "propagate";
+        case analyze: return "analyze";
+        case minimize: return "minimize";
+        case gauss: return "gauss";
+        case reducedb: return "reducedb";
+        case inprocess: return "inprocess";
+        case sync: return "sync";
+        case num_phases: break;
+    }
+
+    return "unknown";
+}
+
+void PhaseTimer::start(const double cpu)
+{
+    running++;
+    if (running > 1) {
+        return;
+    }
+
+    cur = search;
+    last = now();
+    start_cpu_time = cpu;
+}
+
+void PhaseTimer::stop(const double cpu)
+{
+    assert(running > 0);
+    running--;
+    if (running > 0) {
+        return;
+    }
+
+    charge();
+    cpu_time += cpu - start_cpu_time;
+}
+
+void PhaseTimer::add_technique(const string& technique, const uint64_t start)
+{
+    Stat& s = techniques[technique];
+    s.calls++;
+    s.ns += now() - start;
+}
+
+void PhaseTimer::print_stats() const
+{
+    uint64_t total = 0;
+    for(uint32_t i = 0; i < num_phases; i++) {
+        total += ns[i];
+    }
+
+    for(uint32_t i = 0; i < num_phases; i++) {
+        print_stats_line(string("c phase ") + name((Phase)i) + " time"
+            , (double)ns[i]/1e9
+            , stats_line_percent(ns[i], total)
+            , "% wall time"
+        );
+    }
+}
@@ -0,0 +1,144 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef __PHASETIMER_H__
+#define __PHASETIMER_H__
+
+#include <string>
+#include <map>
+#include <cstdint>
+#include <chrono>
+
+namespace CMSat {
+
+using std::string;
+
+/**
+@brief Wall-clock time and number of entries of the phases of one solver thread
+
+Phases are exclusive: entering a phase charges the time since the last switch
+to the phase being left, so a conflict analysed inside Gauss-Jordan
+elimination counts as "analyze" and not as "gauss". Everything that is not
+inside a named phase (decisions, restarts, backtracking) is "search".
+Switching costs one read of the monotonic clock.
+
+Inprocessing techniques are additionally timed one by one, inclusive of
+whatever they call, in "techniques".
+*/
+class PhaseTimer
+{
+public:
+    enum Phase : uint8_t {
+        search = 0
+        , propagate
+        , analyze
+        , minimize
+        , gauss
+        , reducedb
+        , inprocess
+        , sync
+        , num_phases
+    };
+    static const char* name(const Phase p);
+
+    static uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //Called on entry/exit of solve() and simplify(), may nest
+    void start(const double cpu_time);
+    void stop(const double cpu_time);
+
+    //Returns the phase to pass to leave()
+    Phase enter(const Phase p)
+    {
+        const Phase prev = cur;
+        if (running) {
+            charge();
+            calls[p]++;
+            cur = p;
+        }
+        return prev;
+    }
+
+    void leave(const Phase prev)
+    {
+        if (running) {
+            charge();
+            cur = prev;
+        }
+    }
+
+    void add_technique(const string& technique, const uint64_t start);
+    void print_stats() const;
+
+    struct Stat {
+        uint64_t calls = 0;
+        uint64_t ns = 0;
+    };
+    uint64_t calls[num_phases] = {};
+    uint64_t ns[num_phases] = {};
+    std::map<string, Stat> techniques;
+    double cpu_time = 0.0;
+
+private:
+    void charge()
+    {
+        const uint64_t n = now();
+        ns[cur] += n - last;
+        last = n;
+    }
+
+    uint32_t running = 0;
+    Phase cur = search;
+    uint64_t last = 0;
+    double start_cpu_time = 0.0;
+};
+
+//Enters a phase for the lifetime of the object
+class PhaseScope
+{
+public:
+    PhaseScope(PhaseTimer& _timer, const PhaseTimer::Phase p) :
+        timer(_timer)
+        , prev(timer.enter(p))
+    {}
+
+    ~PhaseScope()
+    {
+        timer.leave(prev);
+    }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    PhaseTimer& timer;
+    const PhaseTimer::Phase prev;
+};
+
+}
+
+#endif //__PHASETIMER_H__
@@ -519,6 +519,10 @@ void PropEngine::updateVars(
     for(Trail& t: trail) {
         t.lit = lit_Undef;
     }
+
+    //Variable numbers changed, SCC must search everything next time
+    bins_since_scc.clear();
+    bins_since_scc_overflow = true;
 }
 
 void PropEngine::print_trail()
@@ -117,6 +117,11 @@ public:
     }
     bool propagate_occur();
     PropStats propStats;
+
+    //Literals of the binary clauses attached since the last SCC search,
+    //so the search can be incremental. Overflow means all must be searched.
+    vector<Lit> bins_since_scc;
+    bool bins_since_scc_overflow = true;
     template<bool update_bogoprops = true>
     void enqueue(const Lit p, const uint32_t level, const PropBy from = PropBy());
     template<bool update_bogoprops = true>
@@ -526,6 +531,16 @@ inline void PropEngine::attach_bin_clause(
 
     watches[lit1].push(Watched(lit2, red));
     watches[lit2].push(Watched(lit1, red));
+
+    if (!bins_since_scc_overflow) {
+        if (bins_since_scc.size() >= nVars()*2) {
+            bins_since_scc_overflow = true;
+            bins_since_scc.clear();
+        } else {
+            bins_since_scc.push_back(lit1);
+            bins_since_scc.push_back(lit2);
+        }
+    }
 }
 
 } //end namespace
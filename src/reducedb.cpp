@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "solver.h"
 #include "solverconf.h"
 #include "sqlstats.h"
+#include "chunkedthreads.h"
 #ifdef FINAL_PREDICTOR
 #include "cl_predictors.h"
 #endif
@@ -32,100 +33,22 @@ THE SOFTWARE.
 
 #include <functional>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 
 using namespace CMSat;
 
-struct SortRedClsGlue
-{
-    explicit SortRedClsGlue(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.glue < y->stats.glue;
-    }
-};
-
-struct SortRedClsSize
-{
-    explicit SortRedClsSize(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->size() < y->size();
-    }
-};
-
-struct SortRedClsAct
-{
-    explicit SortRedClsAct(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.activity > y->stats.activity;
-    }
-};
-#ifdef FINAL_PREDICTOR
-struct SortRedClsPredShort
-{
-    explicit SortRedClsPredShort(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
+//Below this many clauses per thread it's not worth starting threads
+static const size_t min_cls_per_thread = 20000;
 
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.pred_short_use > y->stats.pred_short_use;
-    }
-};
-
-struct SortRedClsPredLong
-{
-    explicit SortRedClsPredLong(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.pred_long_use > y->stats.pred_long_use;
-    }
-};
-
-struct SortRedClsPredForever
+//Maps a float to a key where smaller key means larger float
+static inline uint32_t float_desc_key(const float f)
 {
-    explicit SortRedClsPredForever(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.pred_forever_use > y->stats.pred_forever_use;
-    }
-};
-#endif
-
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const uint32_t asc = (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+    return ~asc;
+}
 
 ReduceDB::ReduceDB(Solver* _solver) :
     solver(_solver)
@@ -139,36 +62,60 @@ ReduceDB::~ReduceDB()
     #endif
 }
 
-void ReduceDB::sort_red_cls(ClauseClean clean_type)
+uint32_t ReduceDB::num_threads_for(const size_t num) const
 {
-    #ifdef VERBOSE_DEBUG
-    cout << "Before sort" << endl;
-    uint64_t i = 0;
-    for(const auto& x: solver->longRedCls[2]) {
-        const ClOffset offset = x;
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        cout << i << " offset: " << offset << " cl->stats.last_touched: " << cl->stats.last_touched
-        << " act:" << std::setprecision(9) << cl->stats.activity
-        << " which_red_array:" << cl->stats.which_red_array << endl
-        << " -- cl:" << *cl << " tern:" << cl->is_ternary_resolvent
-        << endl;
-    }
-    #endif
+    return threads_for_chunks(num, solver->conf.reducedb_threads, min_cls_per_thread);
+}
 
-    switch (clean_type) {
-        case ClauseClean::glue : {
-            std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(), SortRedClsGlue(solver->cl_alloc));
-            break;
+//Fills sort_keys with the keys of the clauses for which get_key() returns
+//true. The order of the keys is the order of the clauses in "cls".
+template<class KeyFunc>
+void ReduceDB::extract_keys(const vector<ClOffset>& cls, KeyFunc get_key)
+{
+    const uint32_t num_threads = num_threads_for(cls.size());
+    thread_sort_keys.resize(num_threads);
+    run_chunks(cls.size(), num_threads, [&](const size_t start, const size_t end, const uint32_t t) {
+        vector<ClSortKey>& keys = thread_sort_keys[t];
+        keys.clear();
+        for(size_t i = start; i < end; i++) {
+            const ClOffset offset = cls[i];
+            const Clause* cl = solver->cl_alloc.ptr(offset);
+            uint32_t key;
+            if (get_key(cl, offset, key)) {
+                keys.push_back(ClSortKey(key, offset));
+            }
         }
+    });
 
-        case ClauseClean::activity : {
-            std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(), SortRedClsAct(solver->cl_alloc));
-            break;
-        }
+    if (num_threads == 1) {
+        sort_keys.swap(thread_sort_keys[0]);
+        return;
+    }
+    sort_keys.clear();
+    for(const vector<ClSortKey>& keys: thread_sort_keys) {
+        sort_keys.insert(sort_keys.end(), keys.begin(), keys.end());
+    }
+}
 
-        default: {
-            assert(false && "Unknown cleaning type");
-        }
+//Moves the "num" best keys to the front of sort_keys, in no particular order
+void ReduceDB::select_best_keys(const size_t num)
+{
+    if (num < sort_keys.size()) {
+        std::nth_element(sort_keys.begin(), sort_keys.begin()+num, sort_keys.end());
+    }
+}
+
+void ReduceDB::sort_by_activity(vector<ClOffset>& cls)
+{
+    extract_keys(cls, [](const Clause* cl, const ClOffset, uint32_t& key) -> bool {
+        key = float_desc_key(cl->stats.activity);
+        return true;
+    });
+    std::sort(sort_keys.begin(), sort_keys.end());
+
+    assert(sort_keys.size() == cls.size());
+    for(size_t i = 0; i < sort_keys.size(); i++) {
+        cls[i] = sort_keys[i].offset;
     }
 }
 
@@ -192,8 +139,7 @@ void ReduceDB::handle_lev2()
         if (keep_num == 0) {
             continue;
         }
-        sort_red_cls(static_cast<ClauseClean>(keep_type));
-        mark_top_N_clauses(keep_num);
+        mark_top_N_clauses(static_cast<ClauseClean>(keep_type), keep_num);
     }
     assert(delayed_clause_free.empty());
     cl_marked = 0;
@@ -255,7 +201,7 @@ void ReduceDB::dump_sql_cl_data(
         }
     }
 
-    std::sort(all_learnt.begin(), all_learnt.end(), SortRedClsAct(solver->cl_alloc));
+    sort_by_activity(all_learnt);
     for(size_t i = 0; i < all_learnt.size(); i++) {
         ClOffset offs = all_learnt[i];
         Clause* cl = solver->cl_alloc.ptr(offs);
@@ -374,6 +320,150 @@ void ReduceDB::handle_lev1()
 }
 
 #ifdef FINAL_PREDICTOR
+//Fills the features of the clause at position "rank" of "num" clauses
+//ordered by activity
+void ReduceDB::set_up_pred_row(
+    const size_t row
+    , const Clause* cl
+    , const size_t rank
+    , const size_t num
+) {
+    const uint32_t act_ranking_top_10 = \
+        std::ceil((double)rank/((double)num/10.0))+1;
+    double act_ranking_rel = (double)rank/(double)num;
+
+    int64_t last_touched_diff =
+        (int64_t)solver->sumConflicts-(int64_t)cl->stats.last_touched;
+    #ifdef EXTENDED_FEATURES
+    int64_t rdb1_last_touched_diff =
+        (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
+    #endif
+
+    predictors->set_up_row(
+        row,
+        cl,
+        solver->sumConflicts,
+        last_touched_diff,
+        #ifdef EXTENDED_FEATURES
+        rdb1_last_touched_diff,
+        #endif
+        act_ranking_rel,
+        act_ranking_top_10);
+}
+
+//Clauses in "cls" must be ordered by activity
+void ReduceDB::predict_rank_ordered(
+    const vector<ClOffset>& cls
+    , const predict_type pred_type
+) {
+    predictors->start_batch(cls.size());
+    run_chunks(cls.size(), num_threads_for(cls.size())
+        , [&](const size_t start, const size_t end, const uint32_t) {
+        for(size_t i = start; i < end; i++) {
+            set_up_pred_row(i, solver->cl_alloc.ptr(cls[i]), i, cls.size());
+        }
+    });
+
+    vector<float>& out = pred_out[pred_type];
+    out.resize(cls.size());
+    predictors->predict_batch(
+        num_threads_for(cls.size()),
+        NULL,
+        pred_type == predict_type::long_pred ? out.data() : NULL,
+        pred_type == predict_type::forever_pred ? out.data() : NULL);
+
+    for(size_t i = 0; i < cls.size(); i++) {
+        Clause* cl = solver->cl_alloc.ptr(cls[i]);
+        if (pred_type == predict_type::forever_pred) {
+            cl->stats.pred_forever_use = out[i];
+        } else {
+            assert(pred_type == predict_type::long_pred);
+            cl->stats.pred_long_use = out[i];
+        }
+    }
+}
+
+//Clauses in lev2 must be ordered by activity
+void ReduceDB::predict_lev2_all()
+{
+    const vector<ClOffset>& cls = solver->longRedCls[2];
+
+    //Only clauses that have been through a cleaning already are predicted
+    pred_rows.clear();
+    for(size_t i = 0; i < cls.size(); i++) {
+        const Clause* cl = solver->cl_alloc.ptr(cls[i]);
+        assert(cl->stats.which_red_array != 0);
+        if (cl->stats.dump_no > 0) {
+            assert(cl->stats.last_touched <= (int64_t)solver->sumConflicts);
+            #ifdef EXTENDED_FEATURES
+            assert(cl->stats.rdb1_last_touched <= (int64_t)solver->sumConflicts-10000);
+            #endif
+            pred_rows.push_back(i);
+        }
+    }
+
+    predictors->start_batch(pred_rows.size());
+    run_chunks(pred_rows.size(), num_threads_for(pred_rows.size())
+        , [&](const size_t start, const size_t end, const uint32_t) {
+        for(size_t row = start; row < end; row++) {
+            const size_t i = pred_rows[row];
+            set_up_pred_row(row, solver->cl_alloc.ptr(cls[i]), i, cls.size());
+        }
+    });
+    for(vector<float>& out: pred_out) {
+        out.resize(pred_rows.size());
+    }
+    predictors->predict_batch(
+        num_threads_for(pred_rows.size()),
+        pred_out[short_pred].data(),
+        pred_out[long_pred].data(),
+        pred_out[forever_pred].data());
+
+    size_t row = 0;
+    for(size_t i = 0; i < cls.size(); i++) {
+        Clause* cl = solver->cl_alloc.ptr(cls[i]);
+        if (row < pred_rows.size() && pred_rows[row] == i) {
+            cl->stats.pred_short_use = pred_out[short_pred][row];
+            cl->stats.pred_long_use = pred_out[long_pred][row];
+            cl->stats.pred_forever_use = pred_out[forever_pred][row];
+            row++;
+        } else {
+            cl->stats.pred_short_use = 0;
+            cl->stats.pred_long_use = 0;
+            cl->stats.pred_forever_use= 0;
+        }
+
+        cl->stats.dump_no++;
+        #ifdef EXTENDED_FEATURES
+        cl->stats.rdb1_act_ranking_rel = (double)i/(double)cls.size();
+        cl->stats.rdb1_last_touched = cl->stats.last_touched;
+        #endif
+        cl->stats.rdb1_propagations_made = cl->stats.propagations_made;
+        cl->stats.reset_rdb_stats();
+    }
+}
+
+//Moves the "keep" clauses with the highest prediction to the front of "cls".
+//Returns the number of clauses moved to the front.
+size_t ReduceDB::select_top_pred(
+    vector<ClOffset>& cls
+    , float ClauseStats::* pred
+    , const size_t keep
+) {
+    extract_keys(cls, [&](const Clause* cl, const ClOffset, uint32_t& key) -> bool {
+        key = float_desc_key(cl->stats.*pred);
+        return true;
+    });
+    const size_t num = std::min(keep, sort_keys.size());
+    select_best_keys(num);
+
+    assert(sort_keys.size() == cls.size());
+    for(size_t i = 0; i < sort_keys.size(); i++) {
+        cls[i] = sort_keys[i].offset;
+    }
+    return num;
+}
+
 void ReduceDB::handle_lev2_predictor()
 {
     num_times_lev3_called++;
@@ -393,58 +483,8 @@ void ReduceDB::handle_lev2_predictor()
     uint32_t tot_dumpno = 0;
     size_t origsize = solver->longRedCls[2].size();
 
-    std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(),
-              SortRedClsAct(solver->cl_alloc));
-
-    for(size_t i = 0
-        ; i < solver->longRedCls[2].size()
-        ; i++
-    ) {
-        const ClOffset offset = solver->longRedCls[2][i];
-        Clause* cl = solver->cl_alloc.ptr(offset);
-
-        if (cl->stats.which_red_array == 0) {
-            assert(false);
-        }
-        const uint32_t act_ranking_top_10 = \
-            std::ceil((double)i/((double)solver->longRedCls[2].size()/10.0))+1;
-        double act_ranking_rel = (double)i/(double)solver->longRedCls[2].size();
-
-        cl->stats.pred_short_use = 0;
-        cl->stats.pred_long_use = 0;
-        cl->stats.pred_forever_use= 0;
-        if (cl->stats.dump_no > 0) {
-            assert(cl->stats.last_touched <= (int64_t)solver->sumConflicts);
-            int64_t last_touched_diff =
-                (int64_t)solver->sumConflicts-(int64_t)cl->stats.last_touched;
-            #ifdef EXTENDED_FEATURES
-            assert(cl->stats.rdb1_last_touched <= (int64_t)solver->sumConflicts-10000);
-            int64_t rdb1_last_touched_diff =
-                (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
-            #endif
-
-            predictors->predict(
-                cl,
-                solver->sumConflicts,
-                last_touched_diff,
-                #ifdef EXTENDED_FEATURES
-                rdb1_last_touched_diff,
-                #endif
-                act_ranking_rel,
-                act_ranking_top_10,
-                cl->stats.pred_short_use,
-                cl->stats.pred_long_use,
-                cl->stats.pred_forever_use
-            );
-        }
-        cl->stats.dump_no++;
-        #ifdef EXTENDED_FEATURES
-        cl->stats.rdb1_act_ranking_rel = act_ranking_rel;
-        cl->stats.rdb1_last_touched = cl->stats.last_touched;
-        #endif
-        cl->stats.rdb1_propagations_made = cl->stats.propagations_made;
-        cl->stats.reset_rdb_stats();
-    }
+    sort_by_activity(solver->longRedCls[2]);
+    predict_lev2_all();
 
     if (solver->conf.verbosity >= 1) {
         double predTime = cpuTime() - myTime;
@@ -454,8 +494,8 @@ void ReduceDB::handle_lev2_predictor()
 
     uint32_t marked_forever = 0;
     uint32_t keep_forever = 300 * solver->conf.pred_forever_chunk_mult;
-    std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(),
-              SortRedClsPredForever(solver->cl_alloc));
+    keep_forever = select_top_pred(solver->longRedCls[2],
+        &ClauseStats::pred_forever_use, keep_forever);
     size_t j = 0;
     for(uint32_t i = 0; i < solver->longRedCls[2].size(); i ++) {
         const ClOffset offset = solver->longRedCls[2][i];
@@ -473,8 +513,8 @@ void ReduceDB::handle_lev2_predictor()
 
     uint32_t marked_long = 0;
     uint32_t keep_long = 2000 * solver->conf.pred_long_chunk_mult;
-    std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(),
-              SortRedClsPredLong(solver->cl_alloc));
+    keep_long = select_top_pred(solver->longRedCls[2],
+        &ClauseStats::pred_long_use, keep_long);
 
     j = 0;
     for(uint32_t i = 0; i < solver->longRedCls[2].size(); i ++) {
@@ -490,32 +530,33 @@ void ReduceDB::handle_lev2_predictor()
     }
     solver->longRedCls[2].resize(j);
 
+    //Locked and newly added clauses are always kept, of the rest
+    //we keep the ones with the best short prediction
     deleted = 0;
-    uint32_t keep_short = 15000 * solver->conf.pred_short_size_mult;
-    std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(),
-              SortRedClsPredShort(solver->cl_alloc));
-
+    const uint32_t keep_short = 15000 * solver->conf.pred_short_size_mult;
     j = 0;
+    sort_keys.clear();
     for(uint32_t i = 0; i < solver->longRedCls[2].size(); i ++) {
         const ClOffset offset = solver->longRedCls[2][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
-//         cout << "Short pred use: " << cl->stats.pred_short_use << endl;
         tot_dumpno += cl->stats.dump_no-1;
 
-        if (solver->clause_locked(*cl, offset)) {
+        const bool locked = solver->clause_locked(*cl, offset);
+        if (locked) {
             kept_locked++;
         }
-
-        if (i < keep_short
-            || solver->clause_locked(*cl, offset)
-            || cl->stats.dump_no == 1
-        ) {
-            if (solver->clause_locked(*cl, offset)
-                || cl->stats.dump_no == 1)
-            {
-                keep_short++;
-            }
-            solver->longRedCls[2][j++] =solver->longRedCls[2][i];
+        if (locked || cl->stats.dump_no == 1) {
+            solver->longRedCls[2][j++] = offset;
+        } else {
+            sort_keys.push_back(ClSortKey(float_desc_key(cl->stats.pred_short_use), offset));
+        }
+    }
+    select_best_keys(keep_short);
+    for(size_t i = 0; i < sort_keys.size(); i++) {
+        const ClOffset offset = sort_keys[i].offset;
+        Clause* cl = solver->cl_alloc.ptr(offset);
+        if (i < keep_short) {
+            solver->longRedCls[2][j++] = offset;
         } else {
             deleted++;
             solver->watches.smudge((*cl)[0]);
@@ -535,43 +576,12 @@ void ReduceDB::handle_lev2_predictor()
         (double)solver->conf.pred_forever_size_mult;
     if (num_times_lev3_called % 12 == 11) {
         //Recalc pred_forever_use
-        std::sort(solver->longRedCls[0].begin(), solver->longRedCls[0].end(),
-              SortRedClsAct(solver->cl_alloc));
-
-        for(size_t i = 0
-            ; i < solver->longRedCls[0].size()
-            ; i++
-        ) {
-            const ClOffset offset = solver->longRedCls[0][i];
-            Clause* cl = solver->cl_alloc.ptr(offset);
-
-            const uint32_t act_ranking_top_10 = \
-                std::ceil((double)i/((double)solver->longRedCls[0].size()/10.0))+1;
-            double act_ranking_rel = (double)i/(double)solver->longRedCls[0].size();
-
-            int64_t last_touched_diff =
-                (int64_t)solver->sumConflicts-(int64_t)cl->stats.last_touched;
-            #ifdef EXTENDED_FEATURES
-            int64_t rdb1_last_touched_diff =
-                (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
-            #endif
-
-            cl->stats.pred_forever_use = predictors->predict(
-                predict_type::forever_pred,
-                cl,
-                solver->sumConflicts,
-                last_touched_diff,
-                #ifdef EXTENDED_FEATURES
-                rdb1_last_touched_diff,
-                #endif
-                act_ranking_rel,
-                act_ranking_top_10);
-        }
+        sort_by_activity(solver->longRedCls[0]);
+        predict_rank_ordered(solver->longRedCls[0], predict_type::forever_pred);
 
         //Clean up FOREVER, move to LONG
-        keep_forever = orig_keep_forever;
-        std::sort(solver->longRedCls[0].begin(), solver->longRedCls[0].end(),
-              SortRedClsPredForever(solver->cl_alloc));
+        keep_forever = select_top_pred(solver->longRedCls[0],
+            &ClauseStats::pred_forever_use, orig_keep_forever);
         j = 0;
         for(uint32_t i = 0; i < solver->longRedCls[0].size(); i ++) {
             const ClOffset offset = solver->longRedCls[0][i];
@@ -591,43 +601,12 @@ void ReduceDB::handle_lev2_predictor()
     //Deal with LONG once in a while
     if (num_times_lev3_called % 5 == 4) {
         //Recalc pred_long_use
-        std::sort(solver->longRedCls[1].begin(), solver->longRedCls[1].end(),
-              SortRedClsAct(solver->cl_alloc));
-
-        for(size_t i = 0
-            ; i < solver->longRedCls[1].size()
-            ; i++
-        ) {
-            const ClOffset offset = solver->longRedCls[1][i];
-            Clause* cl = solver->cl_alloc.ptr(offset);
-
-            const uint32_t act_ranking_top_10 = \
-                std::ceil((double)i/((double)solver->longRedCls[1].size()/10.0))+1;
-            double act_ranking_rel = (double)i/(double)solver->longRedCls[1].size();
-
-            int64_t last_touched_diff =
-                (int64_t)solver->sumConflicts-(int64_t)cl->stats.last_touched;
-            #ifdef EXTENDED_FEATURES
-            int64_t rdb1_last_touched_diff =
-                (int64_t)solver->sumConflicts-10000-(int64_t)cl->stats.rdb1_last_touched;
-            #endif
-
-            cl->stats.pred_long_use = predictors->predict(
-                predict_type::long_pred,
-                cl,
-                solver->sumConflicts,
-                last_touched_diff,
-                #ifdef EXTENDED_FEATURES
-                rdb1_last_touched_diff,
-                #endif
-                act_ranking_rel,
-                act_ranking_top_10);
-        }
+        sort_by_activity(solver->longRedCls[1]);
+        predict_rank_ordered(solver->longRedCls[1], predict_type::long_pred);
 
         //Clean up LONG, move to SHORT
-        std::sort(solver->longRedCls[1].begin(), solver->longRedCls[1].end(),
-              SortRedClsPredLong(solver->cl_alloc));
-        keep_long = 15000 * solver->conf.pred_long_size_mult;
+        keep_long = select_top_pred(solver->longRedCls[1],
+            &ClauseStats::pred_long_use, 15000 * solver->conf.pred_long_size_mult);
         j = 0;
         for(uint32_t i = 0; i < solver->longRedCls[1].size(); i ++) {
             const ClOffset offset = solver->longRedCls[1][i];
@@ -687,47 +666,58 @@ void ReduceDB::handle_lev2_predictor()
 }
 #endif
 
-void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
+//Marks the best "keep_num" clauses in lev2 that are not yet marked and would
+//otherwise be removed. Only these take part in the selection.
+void ReduceDB::mark_top_N_clauses(ClauseClean clean_type, const uint64_t keep_num)
 {
     #ifdef VERBOSE_DEBUG
     cout << "Marking top N clauses " << keep_num << endl;
     #endif
 
-    size_t marked = 0;
-    for(size_t i = 0
-        ; i < solver->longRedCls[2].size() && marked < keep_num
-        ; i++
-    ) {
-        const ClOffset offset = solver->longRedCls[2][i];
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        #ifdef VERBOSE_DEBUG
-        cout << "offset: " << offset << " cl->stats.last_touched: " << cl->stats.last_touched
-        << " act:" << std::setprecision(9) << cl->stats.activity
-        << " which_red_array:" << cl->stats.which_red_array << endl
-        << " -- cl:" << *cl << " tern:" << cl->is_ternary_resolvent
-        << endl;
-        #endif
+    auto can_mark = [&](const Clause* cl, const ClOffset offset) -> bool {
+        return !cl->used_in_xor()
+            && cl->stats.ttl == 0
+            && cl->stats.which_red_array == 2
+            && !cl->stats.marked_clause
+            && !solver->clause_locked(*cl, offset);
+    };
 
-        if (cl->used_in_xor()
-            || cl->stats.ttl > 0
-            || solver->clause_locked(*cl, offset)
-            || cl->stats.which_red_array != 2
-        ) {
-            //no need to mark, skip
-            #ifdef VERBOSE_DEBUG
-            cout << "Not marking Skipping "<< endl;
-            #endif
-            continue;
+    switch (clean_type) {
+        case ClauseClean::glue : {
+            extract_keys(solver->longRedCls[2],
+                [&](const Clause* cl, const ClOffset offset, uint32_t& key) -> bool {
+                    key = cl->stats.glue;
+                    return can_mark(cl, offset);
+            });
+            break;
         }
 
-        if (!cl->stats.marked_clause) {
-            marked++;
-            cl->stats.marked_clause = true;
-            #ifdef VERBOSE_DEBUG
-            cout << "Not marking Skipping "<< endl;
-            #endif
+        case ClauseClean::activity : {
+            extract_keys(solver->longRedCls[2],
+                [&](const Clause* cl, const ClOffset offset, uint32_t& key) -> bool {
+                    key = float_desc_key(cl->stats.activity);
+                    return can_mark(cl, offset);
+            });
+            break;
+        }
+
+        default: {
+            assert(false && "Unknown cleaning type");
         }
     }
+
+    const size_t marked = std::min<uint64_t>(keep_num, sort_keys.size());
+    select_best_keys(marked);
+    for(size_t i = 0; i < marked; i++) {
+        Clause* cl = solver->cl_alloc.ptr(sort_keys[i].offset);
+        #ifdef VERBOSE_DEBUG
+        cout << "marking offset: " << sort_keys[i].offset
+        << " act:" << std::setprecision(9) << cl->stats.activity
+        << " glue:" << cl->stats.glue
+        << " -- cl:" << *cl << endl;
+        #endif
+        cl->stats.marked_clause = true;
+    }
 }
 
 bool ReduceDB::cl_needs_removal(const Clause* cl, const ClOffset offset) const
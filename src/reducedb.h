@@ -25,6 +25,11 @@ THE SOFTWARE.
 
 #include "clauseallocator.h"
 
+#include <vector>
+#ifdef FINAL_PREDICTOR
+#include "cl_predictors.h"
+#endif
+
 namespace CMSat {
 
 class Solver;
@@ -62,11 +67,46 @@ private:
     bool cl_needs_removal(const Clause* cl, const ClOffset offset) const;
     void remove_cl_from_lev2();
 
-    void sort_red_cls(ClauseClean clean_type);
-    void mark_top_N_clauses(const uint64_t keep_num);
+    void mark_top_N_clauses(ClauseClean clean_type, const uint64_t keep_num);
+
+    //Sort key of a clause, extracted once so that selection does not have to
+    //dereference every clause through cl_alloc. Smaller key is better, ties
+    //are broken on the offset so the result is independent of thread count.
+    struct ClSortKey
+    {
+        ClSortKey() {}
+        ClSortKey(const uint32_t _key, const ClOffset _offset) :
+            key(_key)
+            , offset(_offset)
+        {}
+
+        bool operator<(const ClSortKey& other) const
+        {
+            if (key != other.key) {
+                return key < other.key;
+            }
+            return offset < other.offset;
+        }
+
+        uint32_t key;
+        ClOffset offset;
+    };
+    vector<ClSortKey> sort_keys;
+    vector<vector<ClSortKey> > thread_sort_keys;
+
+    uint32_t num_threads_for(const size_t num) const;
+    template<class KeyFunc> void extract_keys(const vector<ClOffset>& cls, KeyFunc get_key);
+    void select_best_keys(const size_t num);
+    void sort_by_activity(vector<ClOffset>& cls);
 
     #ifdef FINAL_PREDICTOR
+    size_t select_top_pred(vector<ClOffset>& cls, float ClauseStats::* pred, const size_t keep);
+    void set_up_pred_row(const size_t row, const Clause* cl, const size_t rank, const size_t num);
+    void predict_rank_ordered(const vector<ClOffset>& cls, const predict_type pred_type);
+    void predict_lev2_all();
     ClPredictors* predictors = NULL;
+    vector<uint32_t> pred_rows; ///<position in the clause list of the predicted rows
+    vector<float> pred_out[3];
     uint32_t num_times_lev3_called = 0;
     #endif
 };
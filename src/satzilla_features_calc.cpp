@@ -23,235 +23,217 @@ THE SOFTWARE.
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 #include "solver.h"
 #include "sqlstats.h"
 #include "satzilla_features_calc.h"
+#include "chunkedthreads.h"
 
 using std::vector;
 using namespace CMSat;
 
-template<class Function, class Function2>
-void SatZillaFeaturesCalc::for_one_clause(
-    const Watched& cl
-    , const Lit lit
-    ,  Function func_each_cl
-    ,  Function2 func_each_lit
-) const {
-    unsigned neg_vars = 0;
-    unsigned pos_vars = 0;
-    unsigned size = 0;
-
-    switch (cl.getType()) {
-        case CMSat::watch_binary_t: {
-            if (cl.red()) {
-                //only irred cls
-                break;
-            }
-            if (lit > cl.lit2()) {
-                //only count once
-                break;
-            }
-
-            pos_vars += !lit.sign();
-            pos_vars += !cl.lit2().sign();
-            size = 2;
-            neg_vars = size - pos_vars;
-            func_each_cl(size, pos_vars, neg_vars);
-            func_each_lit(lit, size, pos_vars, neg_vars);
-            func_each_lit(cl.lit2(), size, pos_vars, neg_vars);
-            break;
-        }
-
-        case CMSat::watch_clause_t: {
-            const Clause& clause = *solver->cl_alloc.ptr(cl.get_offset());
-            if (clause.red()) {
-                //only irred cls
-                break;
-            }
-            if (clause[0] < clause[1]) {
-                //only count once
-                break;
-            }
-
-            for (const Lit cl_lit : clause) {
-                pos_vars += !cl_lit.sign();
-            }
-            size = clause.size();
-            neg_vars = size - pos_vars;
-            func_each_cl(size, pos_vars, neg_vars);
-            for (const Lit cl_lit : clause) {
-                func_each_lit(cl_lit, size, pos_vars, neg_vars);
-            }
-            break;
-        }
+//Below this many clauses per thread it's not worth starting threads
+static const size_t min_cls_per_thread = 50000;
 
-        case CMSat::watch_idx_t: {
-             // This should never be here
-            assert(false);
-            exit(-1);
-            break;
-        }
-    }
+void SatZillaFeaturesCalc::Moments::add(const double x)
+{
+    num++;
+    sum += x;
+    sumsq += x*x;
+    min = std::min(min, x);
+    max = std::max(max, x);
 }
 
-template<class Function, class Function2>
-void SatZillaFeaturesCalc::for_all_clauses(Function func_each_cl, Function2 func_each_lit) const
+void SatZillaFeaturesCalc::Moments::add(const Moments& other)
 {
-    for (size_t i = 0; i < solver->nVars() * 2; i++) {
-        Lit lit = Lit::toLit(i);
-        for (const Watched & w : solver->watches[lit]) {
-            for_one_clause(w, lit, func_each_cl, func_each_lit);
-        }
-    }
+    num += other.num;
+    sum += other.sum;
+    sumsq += other.sumsq;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
 }
 
-void SatZillaFeaturesCalc::fill_vars_cls()
+double SatZillaFeaturesCalc::Moments::mean(const double div) const
 {
-    satzilla_feat.numVars = solver->get_num_free_vars();
-    satzilla_feat.numClauses = solver->longIrredCls.size() + solver->binTri.irredBins;
-    myVars.resize(solver->nVars());
-
-    auto func_each_cl = [&](unsigned /*size*/, unsigned pos_vars, unsigned /*neg_vars*/) -> bool {
-        if (pos_vars <= 1 ) {
-            satzilla_feat.horn += 1;
-            return true;
-        }
-        return false;
-    };
-    auto func_each_lit = [&](Lit lit, unsigned /*size*/, unsigned pos_vars, unsigned /*neg_vars*/) -> void {
-        if (pos_vars <= 1 ) {
-            myVars[lit.var()].horn++;
-        }
-
-        if (!lit.sign()) {
-            myVars[lit.var()].numPos++;
-        }
-        myVars[lit.var()].size++;
-    };
-    for_all_clauses(func_each_cl, func_each_lit);
+    return sum/div;
 }
 
-void SatZillaFeaturesCalc::calculate_clause_stats()
+//Sum of (mean - scale*x)^2 over all values x
+double SatZillaFeaturesCalc::Moments::sum_sq_diff(const double m, const double scale) const
 {
-    auto empty_func = [](const Lit, unsigned /*size*/, unsigned /*pos_vars*/, unsigned /*neg_vars*/) -> void {};
-    auto func_each_cl = [&](unsigned size, unsigned pos_vars, unsigned /*neg_vars*/) -> void {
-        if (size == 0 ) {
-            return;
-        }
-
-        double _size = (double)size / (double)satzilla_feat.numVars;
-        satzilla_feat.vcg_cls_min = std::min(satzilla_feat.vcg_cls_min, _size);
-        satzilla_feat.vcg_cls_max = std::max(satzilla_feat.vcg_cls_max, _size);
-        satzilla_feat.vcg_cls_mean += _size;
-
-        double _pnr = 0.5 + ((2.0 * (double)pos_vars - (double)size) / (2.0 * (double)size));
-        satzilla_feat.pnr_cls_min = std::min(satzilla_feat.pnr_cls_min, _pnr);
-        satzilla_feat.pnr_cls_max = std::max(satzilla_feat.pnr_cls_max, _pnr);
-        satzilla_feat.pnr_cls_mean += _pnr;
-    };
-    for_all_clauses(func_each_cl, empty_func);
-
-    satzilla_feat.vcg_cls_mean /= (double)satzilla_feat.numClauses;
-    satzilla_feat.pnr_cls_mean /= (double)satzilla_feat.numClauses;
-    satzilla_feat.horn /= (double)satzilla_feat.numClauses;
-    satzilla_feat.binary = float_div(solver->binTri.irredBins, satzilla_feat.numClauses);
+    const double ret = (double)num*m*m - 2.0*m*scale*sum + scale*scale*sumsq;
+    return std::max(ret, 0.0);
+}
 
-    satzilla_feat.vcg_cls_spread = satzilla_feat.vcg_cls_max - satzilla_feat.vcg_cls_min;
-    satzilla_feat.pnr_cls_spread = satzilla_feat.pnr_cls_max - satzilla_feat.pnr_cls_min;
+bool SatZillaFeaturesCalc::CNFKey::operator==(const CNFKey& other) const
+{
+    return num_simplify == other.num_simplify
+        && num_solve_calls == other.num_solve_calls
+        && num_vars == other.num_vars
+        && num_free_vars == other.num_free_vars
+        && long_irred == other.long_irred
+        && irred_bins == other.irred_bins
+        && irred_lits == other.irred_lits;
 }
 
-void SatZillaFeaturesCalc::calculate_variable_stats()
+//The irredundant CNF only changes during simplification and between solve()
+//calls, both are counted
+SatZillaFeaturesCalc::CNFKey SatZillaFeaturesCalc::get_cnf_key() const
 {
-    if (satzilla_feat.numVars == 0)
-        return;
+    CNFKey key;
+    key.num_simplify = solver->get_solve_stats().num_simplify;
+    key.num_solve_calls = solver->get_solve_stats().num_solve_calls;
+    key.num_vars = solver->nVars();
+    key.num_free_vars = solver->get_num_free_vars();
+    key.long_irred = solver->longIrredCls.size();
+    key.irred_bins = solver->binTri.irredBins;
+    key.irred_lits = solver->litStats.irredLits;
+    return key;
+}
 
-    for ( int vv = 0; vv < (int)myVars.size(); vv++ ) {
-        if ( myVars[vv].size == 0 ) {
-            continue;
-        }
+uint32_t SatZillaFeaturesCalc::num_threads_for(const size_t num) const
+{
+    return threads_for_chunks(num, solver->conf.satzilla_threads, min_cls_per_thread);
+}
 
-        double _size = myVars[vv].size / (double)satzilla_feat.numClauses;
-        satzilla_feat.vcg_var_min = std::min(satzilla_feat.vcg_var_min, _size);
-        satzilla_feat.vcg_var_max = std::max(satzilla_feat.vcg_var_max, _size);
-        satzilla_feat.vcg_var_mean += _size;
-
-        double _pnr = 0.5 + ((2.0 * myVars[vv].numPos - myVars[vv].size)
-                             / (2.0 * myVars[vv].size));
-        satzilla_feat.pnr_var_min = std::min(satzilla_feat.pnr_var_min, _pnr);
-        satzilla_feat.pnr_var_max = std::max(satzilla_feat.pnr_var_max, _pnr);
-        satzilla_feat.pnr_var_mean += _pnr;
-
-        double _horn = myVars[vv].horn / (double)satzilla_feat.numClauses;
-        satzilla_feat.horn_min = std::min(satzilla_feat.horn_min, _horn);
-        satzilla_feat.horn_max = std::max(satzilla_feat.horn_max, _horn);
-        satzilla_feat.horn_mean += _horn;
+void SatZillaFeaturesCalc::add_clause(
+    ClStats& st
+    , vector<VARIABLE>& vars
+    , const Lit* lits
+    , const uint32_t size
+) const {
+    unsigned pos_vars = 0;
+    for(uint32_t i = 0; i < size; i++) {
+        pos_vars += !lits[i].sign();
     }
 
-    if (satzilla_feat.vcg_var_mean > 0) {
-        satzilla_feat.vcg_var_mean /= (double)satzilla_feat.numVars;
-    }
-    if (satzilla_feat.pnr_var_mean > 0) {
-        satzilla_feat.pnr_var_mean /= (double)satzilla_feat.numVars;
+    const bool horn = pos_vars <= 1;
+    st.horn += horn;
+    st.size.add(size);
+    st.pnr.add(0.5 + ((2.0 * (double)pos_vars - (double)size) / (2.0 * (double)size)));
+    for(uint32_t i = 0; i < size; i++) {
+        VARIABLE& v = vars[lits[i].var()];
+        v.horn += horn;
+        v.numPos += !lits[i].sign();
+        v.size++;
     }
-    if (satzilla_feat.horn_mean > 0) {
-        satzilla_feat.horn_mean /= (double)satzilla_feat.numVars;
-    }
-
-    satzilla_feat.vcg_var_spread = satzilla_feat.vcg_var_max - satzilla_feat.vcg_var_min;
-    satzilla_feat.pnr_var_spread = satzilla_feat.pnr_var_max - satzilla_feat.pnr_var_min;
-    satzilla_feat.horn_spread = satzilla_feat.horn_max - satzilla_feat.horn_min;
 }
 
-void SatZillaFeaturesCalc::calculate_extra_clause_stats()
+//Irredundant binary clauses are taken from the watchlists, long ones from
+//longIrredCls. Every thread counts the variables in its own array.
+void SatZillaFeaturesCalc::calculate_clause_stats()
 {
-    auto empty_func = [](const Lit, unsigned /*size*/, unsigned /*pos_vars*/, unsigned /*neg_vars*/) -> void {};
-    auto each_clause = [&](unsigned size, unsigned pos_vars, unsigned /*neg_vars*/) -> void {
-        if ( size == 0 ) {
-            return;
-        }
+    const size_t num_lits = solver->nVars()*2;
+    const vector<ClOffset>& long_cls = solver->longIrredCls;
+    const uint32_t num_threads = num_threads_for(long_cls.size() + solver->binTri.irredBins);
 
-        double _size = (double)size / (double)satzilla_feat.numVars;
-        satzilla_feat.vcg_cls_std += (satzilla_feat.vcg_cls_mean - _size) * (satzilla_feat.vcg_cls_mean - _size);
-
-        double _pnr = 0.5 + ((2.0 * (double)pos_vars - (double)size) / (2.0 * (double)size));
-        satzilla_feat.pnr_cls_std += (satzilla_feat.pnr_cls_mean - _pnr) * (satzilla_feat.pnr_cls_mean - _pnr);
-    };
-    for_all_clauses(each_clause, empty_func);
+    myVars.clear();
+    myVars.resize(solver->nVars());
+    thread_vars.resize(num_threads-1);
+    for(vector<VARIABLE>& vars: thread_vars) {
+        vars.clear();
+        vars.resize(solver->nVars());
+    }
+    vector<ClStats> thread_st(num_threads);
+
+    run_chunks(num_lits + long_cls.size(), num_threads,
+        [&](const size_t start, const size_t end, const uint32_t t) {
+        vector<VARIABLE>& vars = (t == 0) ? myVars : thread_vars[t-1];
+        ClStats& st = thread_st[t];
+        for(size_t i = start; i < end; i++) {
+            if (i < num_lits) {
+                const Lit lit = Lit::toLit(i);
+                for(const Watched& w: solver->watches[lit]) {
+                    //only irred cls, and only count once
+                    if (!w.isBin() || w.red() || lit > w.lit2()) {
+                        continue;
+                    }
+                    const Lit lits[2] = {lit, w.lit2()};
+                    add_clause(st, vars, lits, 2);
+                }
+            } else {
+                const Clause& cl = *solver->cl_alloc.ptr(long_cls[i-num_lits]);
+                assert(!cl.red());
+                add_clause(st, vars, cl.begin(), cl.size());
+            }
+        }
+    });
 
-    if ( satzilla_feat.vcg_cls_std > satzilla_feat.eps && satzilla_feat.vcg_cls_mean > satzilla_feat.eps ) {
-        satzilla_feat.vcg_cls_std = std::sqrt(satzilla_feat.vcg_cls_std / (double)satzilla_feat.numClauses) / satzilla_feat.vcg_cls_mean;
-    } else {
-        satzilla_feat.vcg_cls_std = 0;
+    cl_stats = thread_st[0];
+    for(uint32_t t = 1; t < num_threads; t++) {
+        cl_stats.horn += thread_st[t].horn;
+        cl_stats.size.add(thread_st[t].size);
+        cl_stats.pnr.add(thread_st[t].pnr);
     }
-    if ( satzilla_feat.pnr_cls_std > satzilla_feat.eps && satzilla_feat.pnr_cls_mean > satzilla_feat.eps ) {
-        satzilla_feat.pnr_cls_std = std::sqrt(satzilla_feat.pnr_cls_std / (double)satzilla_feat.numClauses) / satzilla_feat.pnr_cls_mean;
-    } else {
-        satzilla_feat.pnr_cls_std = 0;
+    if (num_threads > 1) {
+        run_chunks(myVars.size(), num_threads,
+            [&](const size_t start, const size_t end, const uint32_t) {
+            for(const vector<VARIABLE>& vars: thread_vars) {
+                for(size_t v = start; v < end; v++) {
+                    myVars[v].numPos += vars[v].numPos;
+                    myVars[v].size += vars[v].size;
+                    myVars[v].horn += vars[v].horn;
+                }
+            }
+        });
     }
 }
 
-void SatZillaFeaturesCalc::calculate_extra_var_stats()
+void SatZillaFeaturesCalc::calculate_variable_stats()
 {
-    if (satzilla_feat.numVars == 0)
-        return;
-
-    for ( int vv = 0; vv < (int)myVars.size(); vv++ ) {
-        if ( myVars[vv].size == 0 ) {
-            continue;
+    const double num_cls = satzilla_feat.numClauses;
+    const uint32_t num_threads = num_threads_for(myVars.size());
+    vector<VarStats> thread_st(num_threads);
+    run_chunks(myVars.size(), num_threads,
+        [&](const size_t start, const size_t end, const uint32_t t) {
+        VarStats& st = thread_st[t];
+        for(size_t vv = start; vv < end; vv++) {
+            const VARIABLE& v = myVars[vv];
+            if (v.size == 0) {
+                continue;
+            }
+            st.num_vars++;
+            st.size.add(v.size / num_cls);
+            st.pnr.add(0.5 + ((2.0 * v.numPos - v.size) / (2.0 * v.size)));
+            st.horn.add(v.horn / num_cls);
         }
+    });
+
+    VarStats st = thread_st[0];
+    for(uint32_t t = 1; t < num_threads; t++) {
+        st.num_vars += thread_st[t].num_vars;
+        st.size.add(thread_st[t].size);
+        st.pnr.add(thread_st[t].pnr);
+        st.horn.add(thread_st[t].horn);
+    }
 
-        double _size = myVars[vv].size / (double)satzilla_feat.numClauses;
-        satzilla_feat.vcg_var_std += (satzilla_feat.vcg_var_mean - _size) * (satzilla_feat.vcg_var_mean - _size);
+    satzilla_feat.numVars = st.num_vars;
+    if (satzilla_feat.numVars == 0 || satzilla_feat.numClauses == 0) {
+        return;
+    }
+    satzilla_feat.var_cl_ratio = (double)satzilla_feat.numVars/ (double)satzilla_feat.numClauses;
+    const double num_vars = satzilla_feat.numVars;
+
+    satzilla_feat.vcg_var_min = st.size.min;
+    satzilla_feat.vcg_var_max = st.size.max;
+    satzilla_feat.vcg_var_mean = st.size.mean(num_vars);
+    satzilla_feat.pnr_var_min = st.pnr.min;
+    satzilla_feat.pnr_var_max = st.pnr.max;
+    satzilla_feat.pnr_var_mean = st.pnr.mean(num_vars);
+    satzilla_feat.horn_min = st.horn.min;
+    satzilla_feat.horn_max = st.horn.max;
+    satzilla_feat.horn_mean = st.horn.mean(num_vars);
 
-        double _pnr = 0.5 + ((2.0 * myVars[vv].numPos - myVars[vv].size) / (2.0 * myVars[vv].size));
-        satzilla_feat.pnr_var_std += (satzilla_feat.pnr_var_mean - _pnr) * (satzilla_feat.pnr_var_mean - _pnr);
+    satzilla_feat.vcg_var_spread = satzilla_feat.vcg_var_max - satzilla_feat.vcg_var_min;
+    satzilla_feat.pnr_var_spread = satzilla_feat.pnr_var_max - satzilla_feat.pnr_var_min;
+    satzilla_feat.horn_spread = satzilla_feat.horn_max - satzilla_feat.horn_min;
 
-        double _horn = myVars[vv].horn / (double)satzilla_feat.numClauses;
-        satzilla_feat.horn_std += (satzilla_feat.horn_mean - _horn) * (satzilla_feat.horn_mean - _horn);
-    }
+    satzilla_feat.vcg_var_std = st.size.sum_sq_diff(satzilla_feat.vcg_var_mean, 1.0);
+    satzilla_feat.pnr_var_std = st.pnr.sum_sq_diff(satzilla_feat.pnr_var_mean, 1.0);
+    satzilla_feat.horn_std = st.horn.sum_sq_diff(satzilla_feat.horn_mean, 1.0);
     if ( satzilla_feat.vcg_var_std > satzilla_feat.eps && satzilla_feat.vcg_var_mean > satzilla_feat.eps ) {
-        satzilla_feat.vcg_var_std = std::sqrt(satzilla_feat.vcg_var_std / (double)satzilla_feat.numVars) / satzilla_feat.vcg_var_mean;
+        satzilla_feat.vcg_var_std = std::sqrt(satzilla_feat.vcg_var_std / num_vars) / satzilla_feat.vcg_var_mean;
     } else {
         satzilla_feat.vcg_var_std = 0;
     }
@@ -259,71 +241,105 @@ void SatZillaFeaturesCalc::calculate_extra_var_stats()
     if ( satzilla_feat.pnr_var_std > satzilla_feat.eps && satzilla_feat.pnr_var_mean > satzilla_feat.eps
         && satzilla_feat.pnr_var_mean != 0
     ) {
-        satzilla_feat.pnr_var_std = std::sqrt(satzilla_feat.pnr_var_std / (double)satzilla_feat.numVars) / satzilla_feat.pnr_var_mean;
+        satzilla_feat.pnr_var_std = std::sqrt(satzilla_feat.pnr_var_std / num_vars) / satzilla_feat.pnr_var_mean;
     } else {
         satzilla_feat.pnr_var_std = 0;
     }
 
-    if ( satzilla_feat.horn_std / (double)satzilla_feat.numVars > satzilla_feat.eps && satzilla_feat.horn_mean > satzilla_feat.eps
+    if ( satzilla_feat.horn_std / num_vars > satzilla_feat.eps && satzilla_feat.horn_mean > satzilla_feat.eps
         && satzilla_feat.horn_mean != 0
     ) {
-        satzilla_feat.horn_std = std::sqrt(satzilla_feat.horn_std / (double)satzilla_feat.numVars) / satzilla_feat.horn_mean;
+        satzilla_feat.horn_std = std::sqrt(satzilla_feat.horn_std / num_vars) / satzilla_feat.horn_mean;
     } else {
         satzilla_feat.horn_std = 0;
     }
 }
 
+//Needs numVars, i.e. calculate_variable_stats() must be called first
+void SatZillaFeaturesCalc::finish_clause_stats()
+{
+    const double num_cls = satzilla_feat.numClauses;
+    const double scale = 1.0/satzilla_feat.numVars;
+    const Moments& size = cl_stats.size;
+    const Moments& pnr = cl_stats.pnr;
+
+    if (size.num > 0) {
+        satzilla_feat.vcg_cls_min = size.min * scale;
+        satzilla_feat.vcg_cls_max = size.max * scale;
+        satzilla_feat.pnr_cls_min = pnr.min;
+        satzilla_feat.pnr_cls_max = pnr.max;
+    }
+    satzilla_feat.vcg_cls_mean = size.sum * scale / num_cls;
+    satzilla_feat.pnr_cls_mean = pnr.mean(num_cls);
+    satzilla_feat.horn = (double)cl_stats.horn / num_cls;
+    satzilla_feat.binary = float_div(solver->binTri.irredBins, satzilla_feat.numClauses);
+
+    satzilla_feat.vcg_cls_spread = satzilla_feat.vcg_cls_max - satzilla_feat.vcg_cls_min;
+    satzilla_feat.pnr_cls_spread = satzilla_feat.pnr_cls_max - satzilla_feat.pnr_cls_min;
+
+    satzilla_feat.vcg_cls_std = size.sum_sq_diff(satzilla_feat.vcg_cls_mean, scale);
+    satzilla_feat.pnr_cls_std = pnr.sum_sq_diff(satzilla_feat.pnr_cls_mean, 1.0);
+    if ( satzilla_feat.vcg_cls_std > satzilla_feat.eps && satzilla_feat.vcg_cls_mean > satzilla_feat.eps ) {
+        satzilla_feat.vcg_cls_std = std::sqrt(satzilla_feat.vcg_cls_std / num_cls) / satzilla_feat.vcg_cls_mean;
+    } else {
+        satzilla_feat.vcg_cls_std = 0;
+    }
+    if ( satzilla_feat.pnr_cls_std > satzilla_feat.eps && satzilla_feat.pnr_cls_mean > satzilla_feat.eps ) {
+        satzilla_feat.pnr_cls_std = std::sqrt(satzilla_feat.pnr_cls_std / num_cls) / satzilla_feat.pnr_cls_mean;
+    } else {
+        satzilla_feat.pnr_cls_std = 0;
+    }
+}
+
 void SatZillaFeaturesCalc::calculate_cl_distributions(
     const vector<ClOffset>& clauses
     , struct SatZillaFeatures::Distrib& distrib_data
-) {
+) const {
     if (clauses.empty()) {
         return;
     }
 
-    double glue_mean = 0;
-    double glue_var = 0;
-
-    double size_mean = 0;
-    double size_var = 0;
-
-    double activity_mean = 0;
-    double activity_var = 0;
+    struct DistribStats {
+        Moments size;
+        Moments glue;
+        Moments activity;
+        double red_activity = 0;
+    };
 
-    //Calculate means
-    double cla_inc = solver->get_cla_inc();
-    for(ClOffset off: clauses)
-    {
-        const Clause& cl = *solver->cl_alloc.ptr(off);
-        size_mean += cl.size();
-        glue_mean += cl.stats.glue;
-        if (cl.red()) {
-            activity_mean += (double)cl.stats.activity/cla_inc;
+    const double cla_inc = solver->get_cla_inc();
+    const uint32_t num_threads = num_threads_for(clauses.size());
+    vector<DistribStats> thread_st(num_threads);
+    run_chunks(clauses.size(), num_threads,
+        [&](const size_t start, const size_t end, const uint32_t t) {
+        DistribStats& st = thread_st[t];
+        for(size_t i = start; i < end; i++) {
+            const Clause& cl = *solver->cl_alloc.ptr(clauses[i]);
+            const double act = (double)cl.stats.activity/cla_inc;
+            st.size.add(cl.size());
+            st.glue.add(cl.stats.glue);
+            st.activity.add(act);
+            if (cl.red()) {
+                st.red_activity += act;
+            }
         }
+    });
+
+    DistribStats st = thread_st[0];
+    for(uint32_t t = 1; t < num_threads; t++) {
+        st.size.add(thread_st[t].size);
+        st.glue.add(thread_st[t].glue);
+        st.activity.add(thread_st[t].activity);
+        st.red_activity += thread_st[t].red_activity;
     }
-    size_mean /= clauses.size();
-    glue_mean /= clauses.size();
-    activity_mean /= clauses.size();
-
-    //Calculate variances
-    for(ClOffset off: clauses)
-    {
-        const Clause& cl = *solver->cl_alloc.ptr(off);
-        size_var += std::pow(size_mean-cl.size(), 2);
-        glue_var += std::pow(glue_mean-cl.stats.glue, 2);
-        activity_var += std::pow(activity_mean-(double)cl.stats.activity/cla_inc, 2);
-    }
-    size_var /= clauses.size();
-    glue_var /= clauses.size();
-    activity_var /= clauses.size();
-
-    //Assign calculated values
-    distrib_data.glue_distr_mean = glue_mean;
-    distrib_data.glue_distr_var = glue_var;
-    distrib_data.size_distr_mean = size_mean;
-    distrib_data.size_distr_var = size_var;
-    distrib_data.activity_distr_mean = activity_mean;
-    distrib_data.activity_distr_var = activity_var;
+
+    //The mean of the activity is over the redundant clauses only
+    const double n = clauses.size();
+    distrib_data.size_distr_mean = st.size.mean(n);
+    distrib_data.size_distr_var = st.size.sum_sq_diff(distrib_data.size_distr_mean, 1.0)/n;
+    distrib_data.glue_distr_mean = st.glue.mean(n);
+    distrib_data.glue_distr_var = st.glue.sum_sq_diff(distrib_data.glue_distr_mean, 1.0)/n;
+    distrib_data.activity_distr_mean = st.red_activity/n;
+    distrib_data.activity_distr_var = st.activity.sum_sq_diff(distrib_data.activity_distr_mean, 1.0)/n;
 }
 
 void SatZillaFeaturesCalc::normalise_values()
@@ -357,37 +373,40 @@ void SatZillaFeaturesCalc::normalise_values()
 SatZillaFeatures SatZillaFeaturesCalc::extract()
 {
     double start_time = cpuTime();
-    fill_vars_cls();
+    const CNFKey key = get_cnf_key();
+    const bool cached = irred_feat_valid && key == irred_feat_key;
 
-    satzilla_feat.numVars = 0;
-    for ( int vv = 0; vv < (int)myVars.size(); vv++ ) {
-        if ( myVars[vv].size > 0 ) {
-            satzilla_feat.numVars++;
-        }
-    }
-    if (satzilla_feat.numVars > 0 && satzilla_feat.numClauses > 0) {
-        satzilla_feat.var_cl_ratio = (double)satzilla_feat.numVars/ (double)satzilla_feat.numClauses;
-    }
-
-    if (satzilla_feat.numClauses > 0 && satzilla_feat.numVars > 0) {
+    if (cached) {
+        satzilla_feat = irred_feat;
+    } else {
+        satzilla_feat = SatZillaFeatures();
+        satzilla_feat.numClauses = solver->longIrredCls.size() + solver->binTri.irredBins;
         calculate_clause_stats();
         calculate_variable_stats();
-
-        calculate_extra_clause_stats();
-        calculate_extra_var_stats();
-
-        if (!solver->longRedCls[0].empty()) {
-            calculate_cl_distributions(solver->longRedCls[0], satzilla_feat.red_cl_distrib);
-        }
-        if (!solver->longIrredCls.empty()) {
-            calculate_cl_distributions(solver->longIrredCls, satzilla_feat.irred_cl_distrib);
+        if (satzilla_feat.numClauses > 0 && satzilla_feat.numVars > 0) {
+            finish_clause_stats();
+            if (!solver->longIrredCls.empty()) {
+                calculate_cl_distributions(solver->longIrredCls, satzilla_feat.irred_cl_distrib);
+            }
         }
+        irred_feat = satzilla_feat;
+        irred_feat_key = key;
+        irred_feat_valid = true;
+    }
+
+    //The redundant clauses change all the time
+    if (satzilla_feat.numClauses > 0
+        && satzilla_feat.numVars > 0
+        && !solver->longRedCls[0].empty()
+    ) {
+        calculate_cl_distributions(solver->longRedCls[0], satzilla_feat.red_cl_distrib);
     }
     normalise_values();
 
     double time_used = cpuTime() - start_time;
     if (solver->conf.verbosity) {
-        cout << "c [szfeat] satzilla features extracted "
+        cout << "c [szfeat] satzilla features extracted"
+        << (cached ? " (irred cached)" : "")
         << solver->conf.print_times(time_used)
         << endl;
     }
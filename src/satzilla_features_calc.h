@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include <vector>
 #include <limits>
 #include <utility>
+#include <cstdint>
 #include "satzilla_features.h"
 #include "cloffset.h"
 #include "watched.h"
@@ -37,6 +38,13 @@ namespace CMSat {
 
 class Solver;
 
+/**
+@brief Calculates the SatZilla features of the CNF
+
+The clauses and the variables are walked once each, split into partitions
+that are processed in parallel. The features of the irredundant CNF are
+cached and only recalculated if the irredundant CNF may have changed.
+*/
 struct SatZillaFeaturesCalc {
 public:
     SatZillaFeaturesCalc(const Solver* _solver) :
@@ -45,36 +53,75 @@ public:
     SatZillaFeatures extract();
 
 private:
-    void fill_vars_cls();
-    void calculate_clause_stats();
-    void calculate_variable_stats();
-    void calculate_extra_var_stats();
-    void calculate_extra_clause_stats();
-    void normalise_values();
-    void calculate_cl_distributions(
-        const vector<ClOffset>& clauses
-        , struct SatZillaFeatures::Distrib& distrib_data
-    );
+    //Sums of a value and its square, so the std can be had in one pass
+    struct Moments {
+        uint64_t num = 0;
+        double sum = 0;
+        double sumsq = 0;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
 
+        void add(const double x);
+        void add(const Moments& other);
+        double mean(const double div) const;
+        double sum_sq_diff(const double mean, const double scale) const;
+    };
+
+    //Partial results of one partition of the clauses
+    struct ClStats {
+        uint64_t horn = 0;
+        Moments size;
+        Moments pnr;
+    };
+
+    //Partial results of one partition of the variables
+    struct VarStats {
+        uint64_t num_vars = 0;
+        Moments size;
+        Moments pnr;
+        Moments horn;
+    };
 
-    const Solver* solver;
-    template<class Function, class Function2>
-    void for_one_clause(
-        const Watched& cl
-        , const Lit lit
-        ,  Function func
-        ,  Function2 func_each_lit
-    ) const;
-    template<class Function, class Function2>
-    void for_all_clauses(Function for_each_clause,  Function2 func_each_lit) const;
     struct VARIABLE {
         int numPos = 0;
         int size = 0;
         int horn = 0;
     };
 
+    //Identifies the irredundant CNF the cached features were calculated on
+    struct CNFKey {
+        uint32_t num_simplify = 0;
+        uint32_t num_solve_calls = 0;
+        uint64_t num_vars = 0;
+        uint64_t num_free_vars = 0;
+        uint64_t long_irred = 0;
+        uint64_t irred_bins = 0;
+        uint64_t irred_lits = 0;
+        bool operator==(const CNFKey& other) const;
+    };
+    CNFKey get_cnf_key() const;
+
+    uint32_t num_threads_for(const size_t num) const;
+
+    void add_clause(ClStats& st, vector<VARIABLE>& vars, const Lit* lits, const uint32_t size) const;
+    void calculate_clause_stats();
+    void calculate_variable_stats();
+    void finish_clause_stats();
+    void calculate_cl_distributions(
+        const vector<ClOffset>& clauses
+        , struct SatZillaFeatures::Distrib& distrib_data
+    ) const;
+    void normalise_values();
+
+    const Solver* solver;
+    ClStats cl_stats;
     vector<VARIABLE> myVars;
+    vector<vector<VARIABLE> > thread_vars;
     SatZillaFeatures satzilla_feat;
+
+    bool irred_feat_valid = false;
+    CNFKey irred_feat_key;
+    SatZillaFeatures irred_feat;
 };
 
 } //end namespace
@@ -20,733 +20,472 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ***********************************************/
 
+// Generated by scripts/reconf/tocpp.py, do not edit
+
 #include "satzilla_features.h"
+#include "satzilla_features_to_reconf.h"
 #include <iostream>
 using std::cout;
 using std::endl;
 
 namespace CMSat {
 
-double get_score0(const SatZillaFeatures& satzilla_feat, const int verb);
-double get_score4(const SatZillaFeatures& satzilla_feat, const int verb);
-double get_score6(const SatZillaFeatures& satzilla_feat, const int verb);
-double get_score7(const SatZillaFeatures& satzilla_feat, const int verb);
-double get_score12(const SatZillaFeatures& satzilla_feat, const int verb);
-double get_score16(const SatZillaFeatures& satzilla_feat, const int verb);
-double get_score17(const SatZillaFeatures& satzilla_feat, const int verb);
-
-int get_reconf_from_satzilla_features(const SatZillaFeatures& satzilla_feat, const int verb)
-{
-	double best_score = 0.0;
-	int best_val = 0;
-	double score;
-
-
-	score = get_score0(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 0 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 0;
-	}
-
-
-	score = get_score4(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 4 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 4;
-	}
-
-
-	score = get_score6(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 6 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 6;
-	}
-
-
-	score = get_score7(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 7 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 7;
-	}
-
-
-	score = get_score12(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 12 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 12;
-	}
-
-
-	score = get_score16(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 16 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 16;
-	}
-
-
-	score = get_score17(satzilla_feat, verb);
-	if (verb >= 2)
-		cout << "c Score for reconf 17 is " << score << endl;
-	if (best_score < score) {
-		best_score = score;
-		best_val = 17;
-	}
-
-
-	if (verb >= 2)
-		cout << "c Winning reconf is " << best_val << endl;
-	return best_val;
-}
-
-
-
-double get_score0(const SatZillaFeatures& satzilla_feat, const int verb)
-{
-	double default_val = 1.00;
-
-	double total_plus = 0.0;
-	double total_neg = 0.0;
-	if ((satzilla_feat.confl_per_restart < 330.10001))
-	{
-		total_plus += 0.615;
-	}
-	if ((satzilla_feat.vcg_cls_min < 0.00000) &&
-		(satzilla_feat.pnr_var_max > 0.60000) &&
-		(satzilla_feat.pnr_cls_std > 3.10000) &&
-		(satzilla_feat.confl_per_restart > 181.80000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var < 0.30000) &&
-		(satzilla_feat.red_cl_distrib.activity_distr_var < 87161348000.00000))
-	{
-		total_neg += 0.920;
-	}
-	if ((satzilla_feat.numClauses > 24521.00000) &&
-		(satzilla_feat.trail_depth_delta_max < 135198.00000) &&
-		(satzilla_feat.confl_per_restart > 330.10001))
-	{
-		total_neg += 0.952;
-	}
-	if ((satzilla_feat.horn > 0.00000) &&
-		(satzilla_feat.pnr_var_mean > 0.40000) &&
-		(satzilla_feat.pnr_var_std > 0.50000) &&
-		(satzilla_feat.confl_size_max > 108.00000) &&
-		(satzilla_feat.trail_depth_delta_max < 208897.00000) &&
-		(satzilla_feat.irred_cl_distrib.activity_distr_var < 595761410.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.30000))
-	{
-		total_neg += 0.952;
-	}
-	if ((satzilla_feat.binary > 0.10000) &&
-		(satzilla_feat.vcg_cls_std < 3.70000) &&
-		(satzilla_feat.pnr_var_mean > 0.40000) &&
-		(satzilla_feat.avg_confl_size > 15.30000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.irred_cl_distrib.activity_distr_var < 130750880.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.40000))
-	{
-		total_neg += 0.923;
-	}
-	if ((satzilla_feat.vcg_cls_std < 0.40000) &&
-		(satzilla_feat.confl_size_min > 1.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.30000))
-	{
-		total_neg += 0.800;
-	}
-	if ((satzilla_feat.vcg_var_std < 1.30000) &&
-		(satzilla_feat.pnr_cls_mean > 0.50000))
-	{
-		total_neg += 0.889;
-	}
-	if ((satzilla_feat.numClauses > 3631149.00000) &&
-		(satzilla_feat.branch_depth_min > 18.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var < 0.30000))
-	{
-		total_neg += 0.857;
-	}
-	if ((satzilla_feat.pnr_var_mean > 0.30000) &&
-		(satzilla_feat.confl_size_max > 4843.00000) &&
-		(satzilla_feat.branch_depth_min > 18.00000))
-	{
-		total_neg += 0.857;
-	}
-	if ((satzilla_feat.avg_confl_size < 15.30000))
-	{
-		total_plus += 0.718;
-	}
-	if ((satzilla_feat.horn < 0.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.30000))
-	{
-		total_plus += 0.875;
-	}
-	// num_rules: 11
-	// rule_no: 11
-	// default is: +
-
-	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
-	}
-	return total_plus - total_neg;
-}
-
-
-double get_score4(const SatZillaFeatures& satzilla_feat, const int verb)
-{
-	double default_val = 1.00;
-
-	double total_plus = 0.0;
-	double total_neg = 0.0;
-	if ((satzilla_feat.confl_size_max > 101.00000))
-	{
-		total_plus += 0.581;
-	}
-	if ((satzilla_feat.branch_depth_max < 133.00000))
-	{
-		total_neg += 0.651;
-	}
-	if ((satzilla_feat.irred_cl_distrib.glue_distr_mean > 940.00000) &&
-		(satzilla_feat.irred_cl_distrib.glue_distr_var > 22169.50000))
-	{
-		total_neg += 0.971;
-	}
-	if ((satzilla_feat.vcg_var_max > 0.00000) &&
-		(satzilla_feat.pnr_cls_mean < 0.60000) &&
-		(satzilla_feat.confl_size_max > 101.00000) &&
-		(satzilla_feat.confl_size_max < 303.00000))
-	{
-		total_plus += 0.947;
-	}
-	if ((satzilla_feat.vcg_var_std < 0.30000) &&
-		(satzilla_feat.confl_size_max > 101.00000) &&
-		(satzilla_feat.decisions_per_conflict < 2.60000) &&
-		(satzilla_feat.irred_cl_distrib.glue_distr_mean > 998.40002))
-	{
-		total_plus += 0.864;
-	}
-	if ((satzilla_feat.numClauses > 252434.00000) &&
-		(satzilla_feat.binary < 0.10000) &&
-		(satzilla_feat.branch_depth_max > 408.00000) &&
-		(satzilla_feat.avg_branch_depth_delta < 8.40000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.30000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var < 0.40000))
-	{
-		total_neg += 0.917;
-	}
-	if ((satzilla_feat.branch_depth_max < 133.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.40000))
-	{
-		total_plus += 0.909;
-	}
-	if ((satzilla_feat.confl_size_max < 572.00000) &&
-		(satzilla_feat.irred_cl_distrib.glue_distr_var > 22169.50000))
-	{
-		total_neg += 0.962;
-	}
-	if ((satzilla_feat.binary < 0.10000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var > 5.30000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var > 0.30000))
-	{
-		total_neg += 0.947;
-	}
-	if ((satzilla_feat.binary > 0.20000) &&
-		(satzilla_feat.vcg_var_std < 0.30000) &&
-		(satzilla_feat.vcg_var_max < 0.00000) &&
-		(satzilla_feat.confl_size_max > 101.00000) &&
-		(satzilla_feat.decisions_per_conflict < 2.60000))
-	{
-		total_plus += 0.923;
-	}
-	if ((satzilla_feat.vcg_var_max > 0.00000) &&
-		(satzilla_feat.confl_size_max > 101.00000) &&
-		(satzilla_feat.confl_glue_max < 34.00000))
-	{
-		total_plus += 0.889;
-	}
-	if ((satzilla_feat.confl_size_max < 101.00000))
-	{
-		total_neg += 0.923;
-	}
-	// num_rules: 12
-	// rule_no: 12
-	// default is: +
-
-	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
-	}
-	return total_plus - total_neg;
-}
-
-
-double get_score6(const SatZillaFeatures& satzilla_feat, const int verb)
-{
-	double default_val = 1.00;
-
-	double total_plus = 0.0;
-	double total_neg = 0.0;
-	if ((satzilla_feat.vcg_cls_std < 8.30000))
-	{
-		total_plus += 0.576;
-	}
-	if ((satzilla_feat.vcg_cls_std > 8.30000))
-	{
-		total_neg += 0.889;
-	}
-	if ((satzilla_feat.pnr_var_mean > 0.40000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.avg_confl_glue < 16.20000) &&
-		(satzilla_feat.avg_branch_depth_delta > 1.30000) &&
-		(satzilla_feat.decisions_per_conflict < 2.90000))
-	{
-		total_neg += 0.917;
-	}
-	if ((satzilla_feat.avg_confl_size < 17.60000) &&
-		(satzilla_feat.decisions_per_conflict < 2.90000))
-	{
-		total_neg += 0.952;
-	}
-	if ((satzilla_feat.pnr_cls_max > 0.50000) &&
-		(satzilla_feat.decisions_per_conflict < 2.90000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean > 5.80000) &&
-		(satzilla_feat.red_cl_distrib.activity_distr_mean > 4804.10010))
-	{
-		total_neg += 0.950;
-	}
-	if ((satzilla_feat.binary > 0.20000) &&
-		(satzilla_feat.pnr_var_max > 0.90000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.avg_confl_glue < 16.20000) &&
-		(satzilla_feat.decisions_per_conflict < 2.90000))
-	{
-		total_neg += 0.944;
-	}
-	if ((satzilla_feat.decisions_per_conflict < 2.90000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 3.30000))
-	{
-		total_neg += 0.789;
-	}
-	if ((satzilla_feat.pnr_cls_mean > 0.50000) &&
-		(satzilla_feat.decisions_per_conflict > 2.90000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var > 4.90000))
-	{
-		total_neg += 0.875;
-	}
-	if ((satzilla_feat.avg_trail_depth_delta < 74.00000))
-	{
-		total_neg += 0.643;
-	}
-	if ((satzilla_feat.pnr_cls_mean < 0.50000) &&
-		(satzilla_feat.avg_confl_size > 16.40000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.avg_confl_glue < 12.40000) &&
-		(satzilla_feat.learnt_bins_per_confl < 0.00000) &&
-		(satzilla_feat.decisions_per_conflict > 2.90000))
-	{
-		total_plus += 0.953;
-	}
-	if ((satzilla_feat.avg_branch_depth > 1243.20000))
-	{
-		total_neg += 0.800;
-	}
-	if ((satzilla_feat.vcg_var_spread < 0.00000) &&
-		(satzilla_feat.confl_size_min > 1.00000) &&
-		(satzilla_feat.branch_depth_max < 32.00000))
-	{
-		total_neg += 0.867;
-	}
-	if ((satzilla_feat.avg_branch_depth_delta < 1.00000))
-	{
-		total_neg += 0.857;
-	}
-	if ((satzilla_feat.numClauses > 17097.00000) &&
-		(satzilla_feat.vcg_var_spread < 0.00000) &&
-		(satzilla_feat.pnr_var_max < 0.90000) &&
-		(satzilla_feat.pnr_cls_max > 0.50000))
-	{
-		total_neg += 0.857;
-	}
-	// num_rules: 14
-	// rule_no: 14
-	// default is: +
-
-	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
-	}
-	return total_plus - total_neg;
-}
-
-
-double get_score7(const SatZillaFeatures& satzilla_feat, const int verb)
+enum ReconfFeature {
+	reconf_feat_confl_per_restart = 0,
+	reconf_feat_vcg_cls_min = 1,
+	reconf_feat_pnr_var_max = 2,
+	reconf_feat_pnr_cls_std = 3,
+	reconf_feat_red_cl_distrib_glue_distr_var = 4,
+	reconf_feat_red_cl_distrib_activity_distr_var = 5,
+	reconf_feat_numClauses = 6,
+	reconf_feat_trail_depth_delta_max = 7,
+	reconf_feat_horn = 8,
+	reconf_feat_pnr_var_mean = 9,
+	reconf_feat_pnr_var_std = 10,
+	reconf_feat_confl_size_max = 11,
+	reconf_feat_irred_cl_distrib_activity_distr_var = 12,
+	reconf_feat_binary = 13,
+	reconf_feat_vcg_cls_std = 14,
+	reconf_feat_avg_confl_size = 15,
+	reconf_feat_confl_size_min = 16,
+	reconf_feat_vcg_var_std = 17,
+	reconf_feat_pnr_cls_mean = 18,
+	reconf_feat_branch_depth_min = 19,
+	reconf_feat_branch_depth_max = 20,
+	reconf_feat_irred_cl_distrib_glue_distr_mean = 21,
+	reconf_feat_irred_cl_distrib_glue_distr_var = 22,
+	reconf_feat_vcg_var_max = 23,
+	reconf_feat_decisions_per_conflict = 24,
+	reconf_feat_avg_branch_depth_delta = 25,
+	reconf_feat_irred_cl_distrib_size_distr_var = 26,
+	reconf_feat_confl_glue_max = 27,
+	reconf_feat_avg_confl_glue = 28,
+	reconf_feat_pnr_cls_max = 29,
+	reconf_feat_irred_cl_distrib_size_distr_mean = 30,
+	reconf_feat_red_cl_distrib_activity_distr_mean = 31,
+	reconf_feat_avg_trail_depth_delta = 32,
+	reconf_feat_learnt_bins_per_confl = 33,
+	reconf_feat_avg_branch_depth = 34,
+	reconf_feat_vcg_var_spread = 35,
+	reconf_feat_trail_depth_delta_min = 36,
+	reconf_feat_red_cl_distrib_size_distr_mean = 37,
+	reconf_feat_num = 38
+};
+
+struct ReconfCond {
+	int feat;
+	bool less;
+	double cut;
+};
+
+struct ReconfRule {
+	int first_cond;
+	int num_conds;
+	bool plus;
+	double confidence;
+};
+
+struct ReconfModel {
+	int reconf;
+	double default_val;
+	int first_rule;
+	int num_rules;
+};
+
+static constexpr ReconfCond reconf_conds[] = {
+	{reconf_feat_confl_per_restart, true, 330.10001},
+	{reconf_feat_vcg_cls_min, true, 0.00000},
+	{reconf_feat_pnr_var_max, false, 0.60000},
+	{reconf_feat_pnr_cls_std, false, 3.10000},
+	{reconf_feat_confl_per_restart, false, 181.80000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, true, 0.30000},
+	{reconf_feat_red_cl_distrib_activity_distr_var, true, 87161348000.00000},
+	{reconf_feat_numClauses, false, 24521.00000},
+	{reconf_feat_trail_depth_delta_max, true, 135198.00000},
+	{reconf_feat_confl_per_restart, false, 330.10001},
+	{reconf_feat_horn, false, 0.00000},
+	{reconf_feat_pnr_var_mean, false, 0.40000},
+	{reconf_feat_pnr_var_std, false, 0.50000},
+	{reconf_feat_confl_size_max, false, 108.00000},
+	{reconf_feat_trail_depth_delta_max, true, 208897.00000},
+	{reconf_feat_irred_cl_distrib_activity_distr_var, true, 595761410.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.30000},
+	{reconf_feat_binary, false, 0.10000},
+	{reconf_feat_vcg_cls_std, true, 3.70000},
+	{reconf_feat_pnr_var_mean, false, 0.40000},
+	{reconf_feat_avg_confl_size, false, 15.30000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_irred_cl_distrib_activity_distr_var, true, 130750880.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.40000},
+	{reconf_feat_vcg_cls_std, true, 0.40000},
+	{reconf_feat_confl_size_min, false, 1.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.30000},
+	{reconf_feat_vcg_var_std, true, 1.30000},
+	{reconf_feat_pnr_cls_mean, false, 0.50000},
+	{reconf_feat_numClauses, false, 3631149.00000},
+	{reconf_feat_branch_depth_min, false, 18.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, true, 0.30000},
+	{reconf_feat_pnr_var_mean, false, 0.30000},
+	{reconf_feat_confl_size_max, false, 4843.00000},
+	{reconf_feat_branch_depth_min, false, 18.00000},
+	{reconf_feat_avg_confl_size, true, 15.30000},
+	{reconf_feat_horn, true, 0.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.30000},
+	{reconf_feat_confl_size_max, false, 101.00000},
+	{reconf_feat_branch_depth_max, true, 133.00000},
+	{reconf_feat_irred_cl_distrib_glue_distr_mean, false, 940.00000},
+	{reconf_feat_irred_cl_distrib_glue_distr_var, false, 22169.50000},
+	{reconf_feat_vcg_var_max, false, 0.00000},
+	{reconf_feat_pnr_cls_mean, true, 0.60000},
+	{reconf_feat_confl_size_max, false, 101.00000},
+	{reconf_feat_confl_size_max, true, 303.00000},
+	{reconf_feat_vcg_var_std, true, 0.30000},
+	{reconf_feat_confl_size_max, false, 101.00000},
+	{reconf_feat_decisions_per_conflict, true, 2.60000},
+	{reconf_feat_irred_cl_distrib_glue_distr_mean, false, 998.40002},
+	{reconf_feat_numClauses, false, 252434.00000},
+	{reconf_feat_binary, true, 0.10000},
+	{reconf_feat_branch_depth_max, false, 408.00000},
+	{reconf_feat_avg_branch_depth_delta, true, 8.40000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.30000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, true, 0.40000},
+	{reconf_feat_branch_depth_max, true, 133.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.40000},
+	{reconf_feat_confl_size_max, true, 572.00000},
+	{reconf_feat_irred_cl_distrib_glue_distr_var, false, 22169.50000},
+	{reconf_feat_binary, true, 0.10000},
+	{reconf_feat_irred_cl_distrib_size_distr_var, false, 5.30000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, false, 0.30000},
+	{reconf_feat_binary, false, 0.20000},
+	{reconf_feat_vcg_var_std, true, 0.30000},
+	{reconf_feat_vcg_var_max, true, 0.00000},
+	{reconf_feat_confl_size_max, false, 101.00000},
+	{reconf_feat_decisions_per_conflict, true, 2.60000},
+	{reconf_feat_vcg_var_max, false, 0.00000},
+	{reconf_feat_confl_size_max, false, 101.00000},
+	{reconf_feat_confl_glue_max, true, 34.00000},
+	{reconf_feat_confl_size_max, true, 101.00000},
+	{reconf_feat_vcg_cls_std, true, 8.30000},
+	{reconf_feat_vcg_cls_std, false, 8.30000},
+	{reconf_feat_pnr_var_mean, false, 0.40000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_avg_confl_glue, true, 16.20000},
+	{reconf_feat_avg_branch_depth_delta, false, 1.30000},
+	{reconf_feat_decisions_per_conflict, true, 2.90000},
+	{reconf_feat_avg_confl_size, true, 17.60000},
+	{reconf_feat_decisions_per_conflict, true, 2.90000},
+	{reconf_feat_pnr_cls_max, false, 0.50000},
+	{reconf_feat_decisions_per_conflict, true, 2.90000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, false, 5.80000},
+	{reconf_feat_red_cl_distrib_activity_distr_mean, false, 4804.10010},
+	{reconf_feat_binary, false, 0.20000},
+	{reconf_feat_pnr_var_max, false, 0.90000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_avg_confl_glue, true, 16.20000},
+	{reconf_feat_decisions_per_conflict, true, 2.90000},
+	{reconf_feat_decisions_per_conflict, true, 2.90000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 3.30000},
+	{reconf_feat_pnr_cls_mean, false, 0.50000},
+	{reconf_feat_decisions_per_conflict, false, 2.90000},
+	{reconf_feat_irred_cl_distrib_size_distr_var, false, 4.90000},
+	{reconf_feat_avg_trail_depth_delta, true, 74.00000},
+	{reconf_feat_pnr_cls_mean, true, 0.50000},
+	{reconf_feat_avg_confl_size, false, 16.40000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_avg_confl_glue, true, 12.40000},
+	{reconf_feat_learnt_bins_per_confl, true, 0.00000},
+	{reconf_feat_decisions_per_conflict, false, 2.90000},
+	{reconf_feat_avg_branch_depth, false, 1243.20000},
+	{reconf_feat_vcg_var_spread, true, 0.00000},
+	{reconf_feat_confl_size_min, false, 1.00000},
+	{reconf_feat_branch_depth_max, true, 32.00000},
+	{reconf_feat_avg_branch_depth_delta, true, 1.00000},
+	{reconf_feat_numClauses, false, 17097.00000},
+	{reconf_feat_vcg_var_spread, true, 0.00000},
+	{reconf_feat_pnr_var_max, true, 0.90000},
+	{reconf_feat_pnr_cls_max, false, 0.50000},
+	{reconf_feat_confl_glue_max, false, 41.00000},
+	{reconf_feat_confl_glue_max, true, 41.00000},
+	{reconf_feat_binary, false, 0.30000},
+	{reconf_feat_branch_depth_max, true, 316.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 6.90000},
+	{reconf_feat_red_cl_distrib_activity_distr_var, false, 4041287700.00000},
+	{reconf_feat_vcg_cls_std, true, 10.60000},
+	{reconf_feat_irred_cl_distrib_glue_distr_mean, true, 945.70001},
+	{reconf_feat_avg_confl_size, false, 49.50000},
+	{reconf_feat_branch_depth_min, true, 22.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 6.90000},
+	{reconf_feat_binary, true, 0.30000},
+	{reconf_feat_vcg_var_std, true, 1.20000},
+	{reconf_feat_confl_size_max, false, 943.00000},
+	{reconf_feat_branch_depth_min, false, 2.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 4.60000},
+	{reconf_feat_vcg_var_std, true, 1.20000},
+	{reconf_feat_confl_glue_max, false, 41.00000},
+	{reconf_feat_branch_depth_min, true, 22.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 4.60000},
+	{reconf_feat_irred_cl_distrib_size_distr_var, false, 2.60000},
+	{reconf_feat_pnr_var_std, false, 0.50000},
+	{reconf_feat_confl_glue_max, false, 41.00000},
+	{reconf_feat_trail_depth_delta_min, false, 2.00000},
+	{reconf_feat_pnr_var_mean, false, 0.50000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 6.90000},
+	{reconf_feat_irred_cl_distrib_size_distr_var, false, 13.70000},
+	{reconf_feat_vcg_var_std, false, 1.20000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_avg_branch_depth, false, 124.60000},
+	{reconf_feat_branch_depth_min, true, 22.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 4.60000},
+	{reconf_feat_avg_confl_size, false, 144.80000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 6.90000},
+	{reconf_feat_red_cl_distrib_activity_distr_var, false, 4041287700.00000},
+	{reconf_feat_branch_depth_min, true, 2.00000},
+	{reconf_feat_vcg_var_spread, true, 0.00000},
+	{reconf_feat_pnr_var_std, true, 1.40000},
+	{reconf_feat_avg_confl_size, true, 60.00000},
+	{reconf_feat_branch_depth_max, true, 628.00000},
+	{reconf_feat_trail_depth_delta_max, true, 6774.00000},
+	{reconf_feat_confl_per_restart, true, 266.20001},
+	{reconf_feat_confl_per_restart, false, 194.00000},
+	{reconf_feat_binary, false, 0.10000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_confl_size_max, true, 6371.00000},
+	{reconf_feat_trail_depth_delta_max, false, 6774.00000},
+	{reconf_feat_pnr_var_std, false, 0.30000},
+	{reconf_feat_confl_size_max, false, 6371.00000},
+	{reconf_feat_avg_trail_depth_delta, true, 4679.60010},
+	{reconf_feat_irred_cl_distrib_glue_distr_var, true, 5139.60010},
+	{reconf_feat_confl_size_min, false, 1.00000},
+	{reconf_feat_avg_confl_glue, false, 10.80000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 16.80000},
+	{reconf_feat_binary, false, 0.20000},
+	{reconf_feat_trail_depth_delta_max, true, 6774.00000},
+	{reconf_feat_branch_depth_max, false, 42.00000},
+	{reconf_feat_trail_depth_delta_max, true, 6774.00000},
+	{reconf_feat_confl_per_restart, true, 194.00000},
+	{reconf_feat_vcg_var_spread, false, 0.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_var, false, 2.30000},
+	{reconf_feat_binary, true, 0.10000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 3.60000},
+	{reconf_feat_numClauses, false, 54199.00000},
+	{reconf_feat_avg_confl_size, false, 26.80000},
+	{reconf_feat_trail_depth_delta_max, true, 6774.00000},
+	{reconf_feat_pnr_var_std, false, 1.40000},
+	{reconf_feat_branch_depth_max, true, 42.00000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_confl_size_max, true, 6371.00000},
+	{reconf_feat_trail_depth_delta_max, false, 6774.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, false, 3.60000},
+	{reconf_feat_pnr_var_std, false, 0.30000},
+	{reconf_feat_avg_trail_depth_delta, false, 4679.60010},
+	{reconf_feat_avg_branch_depth, false, 18.60000},
+	{reconf_feat_binary, true, 0.40000},
+	{reconf_feat_vcg_var_std, true, 2.10000},
+	{reconf_feat_vcg_cls_std, false, 5.50000},
+	{reconf_feat_pnr_cls_std, true, 11.90000},
+	{reconf_feat_horn, false, 0.10000},
+	{reconf_feat_vcg_var_std, true, 2.20000},
+	{reconf_feat_confl_size_min, true, 1.00000},
+	{reconf_feat_confl_size_max, false, 149.00000},
+	{reconf_feat_avg_branch_depth, true, 178.30000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, true, 4.50000},
+	{reconf_feat_irred_cl_distrib_size_distr_var, true, 3.60000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, true, 0.40000},
+	{reconf_feat_red_cl_distrib_size_distr_mean, false, 5.20000},
+	{reconf_feat_vcg_var_std, false, 2.20000},
+	{reconf_feat_vcg_var_std, true, 3.30000},
+	{reconf_feat_avg_branch_depth, false, 18.60000},
+	{reconf_feat_avg_branch_depth, true, 181.89999},
+	{reconf_feat_confl_per_restart, true, 262.10001},
+	{reconf_feat_red_cl_distrib_glue_distr_var, true, 0.40000},
+	{reconf_feat_numClauses, true, 7548140.00000},
+	{reconf_feat_trail_depth_delta_max, false, 167286.00000},
+	{reconf_feat_vcg_var_std, true, 2.20000},
+	{reconf_feat_confl_size_max, false, 149.00000},
+	{reconf_feat_avg_branch_depth, false, 218.20000},
+	{reconf_feat_branch_depth_min, true, 101.00000},
+	{reconf_feat_red_cl_distrib_glue_distr_var, true, 0.40000},
+	{reconf_feat_numClauses, true, 108335.00000},
+	{reconf_feat_vcg_var_max, true, 0.00000},
+	{reconf_feat_irred_cl_distrib_size_distr_mean, false, 5.90000}
+};
+
+static constexpr ReconfRule reconf_rules[] = {
+	{0, 1, true, 0.615},
+	{1, 6, false, 0.920},
+	{7, 3, false, 0.952},
+	{10, 7, false, 0.952},
+	{17, 7, false, 0.923},
+	{24, 3, false, 0.800},
+	{27, 2, false, 0.889},
+	{29, 3, false, 0.857},
+	{32, 3, false, 0.857},
+	{35, 1, true, 0.718},
+	{36, 2, true, 0.875},
+	{38, 1, true, 0.581},
+	{39, 1, false, 0.651},
+	{40, 2, false, 0.971},
+	{42, 4, true, 0.947},
+	{46, 4, true, 0.864},
+	{50, 6, false, 0.917},
+	{56, 2, true, 0.909},
+	{58, 2, false, 0.962},
+	{60, 3, false, 0.947},
+	{63, 5, true, 0.923},
+	{68, 3, true, 0.889},
+	{71, 1, false, 0.923},
+	{72, 1, true, 0.576},
+	{73, 1, false, 0.889},
+	{74, 5, false, 0.917},
+	{79, 2, false, 0.952},
+	{81, 4, false, 0.950},
+	{85, 5, false, 0.944},
+	{90, 2, false, 0.789},
+	{92, 3, false, 0.875},
+	{95, 1, false, 0.643},
+	{96, 6, true, 0.953},
+	{102, 1, false, 0.800},
+	{103, 3, false, 0.867},
+	{106, 1, false, 0.857},
+	{107, 4, false, 0.857},
+	{111, 1, false, 0.755},
+	{112, 1, false, 0.943},
+	{113, 4, true, 0.923},
+	{117, 2, true, 0.917},
+	{119, 3, true, 0.909},
+	{122, 5, true, 0.889},
+	{127, 5, true, 0.800},
+	{132, 3, true, 0.889},
+	{135, 4, true, 0.857},
+	{139, 5, true, 0.800},
+	{144, 3, true, 0.857},
+	{147, 1, false, 0.947},
+	{148, 6, false, 0.923},
+	{154, 1, true, 0.490},
+	{155, 4, true, 0.964},
+	{159, 4, false, 0.938},
+	{163, 3, false, 0.778},
+	{166, 2, false, 0.783},
+	{168, 3, false, 0.915},
+	{171, 2, true, 0.800},
+	{173, 2, false, 0.846},
+	{175, 3, false, 0.909},
+	{178, 2, true, 0.833},
+	{180, 4, true, 0.843},
+	{184, 2, true, 0.846},
+	{186, 1, false, 0.625},
+	{187, 1, true, 0.498},
+	{188, 3, true, 0.939},
+	{191, 9, true, 0.893},
+	{200, 6, true, 0.941},
+	{206, 2, true, 0.826},
+	{208, 5, true, 0.889},
+	{213, 3, true, 0.950}
+};
+
+static constexpr ReconfModel reconf_models[] = {
+	{0, 1.00, 0, 11},
+	{4, 1.00, 11, 12},
+	{6, 1.00, 23, 14},
+	{7, 0.00, 37, 12},
+	{12, 1.00, 49, 13},
+	{16, 0.00, 62, 8}
+};
+
+static void get_reconf_features(const SatZillaFeatures& satzilla_feat, double* vals)
 {
-	double default_val = 0.00;
-
-	double total_plus = 0.0;
-	double total_neg = 0.0;
-	if ((satzilla_feat.confl_glue_max > 41.00000))
-	{
-		total_neg += 0.755;
-	}
-	if ((satzilla_feat.confl_glue_max < 41.00000))
-	{
-		total_neg += 0.943;
-	}
-	if ((satzilla_feat.binary > 0.30000) &&
-		(satzilla_feat.branch_depth_max < 316.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 6.90000) &&
-		(satzilla_feat.red_cl_distrib.activity_distr_var > 4041287700.00000))
-	{
-		total_plus += 0.923;
-	}
-	if ((satzilla_feat.vcg_cls_std < 10.60000) &&
-		(satzilla_feat.irred_cl_distrib.glue_distr_mean < 945.70001))
-	{
-		total_plus += 0.917;
-	}
-	if ((satzilla_feat.avg_confl_size > 49.50000) &&
-		(satzilla_feat.branch_depth_min < 22.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 6.90000))
-	{
-		total_plus += 0.909;
-	}
-	if ((satzilla_feat.binary < 0.30000) &&
-		(satzilla_feat.vcg_var_std < 1.20000) &&
-		(satzilla_feat.confl_size_max > 943.00000) &&
-		(satzilla_feat.branch_depth_min > 2.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.60000))
-	{
-		total_plus += 0.889;
-	}
-	if ((satzilla_feat.vcg_var_std < 1.20000) &&
-		(satzilla_feat.confl_glue_max > 41.00000) &&
-		(satzilla_feat.branch_depth_min < 22.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.60000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var > 2.60000))
-	{
-		total_plus += 0.800;
-	}
-	if ((satzilla_feat.pnr_var_std > 0.50000) &&
-		(satzilla_feat.confl_glue_max > 41.00000) &&
-		(satzilla_feat.trail_depth_delta_min > 2.00000))
-	{
-		total_plus += 0.889;
-	}
-	if ((satzilla_feat.pnr_var_mean > 0.50000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 6.90000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var > 13.70000))
-	{
-		total_plus += 0.857;
-	}
-	if ((satzilla_feat.vcg_var_std > 1.20000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.avg_branch_depth > 124.60000) &&
-		(satzilla_feat.branch_depth_min < 22.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.60000))
-	{
-		total_plus += 0.800;
-	}
-	if ((satzilla_feat.avg_confl_size > 144.80000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 6.90000) &&
-		(satzilla_feat.red_cl_distrib.activity_distr_var > 4041287700.00000))
-	{
-		total_plus += 0.857;
-	}
-	if ((satzilla_feat.branch_depth_min < 2.00000))
-	{
-		total_neg += 0.947;
-	}
-	// num_rules: 12
-	// rule_no: 12
-	// default is: -
-
-	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
-	}
-	return total_plus - total_neg;
-}
-
-
-double get_score12(const SatZillaFeatures& satzilla_feat, const int verb)
-{
-	double default_val = 1.00;
-
-	double total_plus = 0.0;
-	double total_neg = 0.0;
-	if ((satzilla_feat.vcg_var_spread < 0.00000) &&
-		(satzilla_feat.pnr_var_std < 1.40000) &&
-		(satzilla_feat.avg_confl_size < 60.00000) &&
-		(satzilla_feat.branch_depth_max < 628.00000) &&
-		(satzilla_feat.trail_depth_delta_max < 6774.00000) &&
-		(satzilla_feat.confl_per_restart < 266.20001))
-	{
-		total_neg += 0.923;
-	}
-	if ((satzilla_feat.confl_per_restart > 194.00000))
-	{
-		total_plus += 0.490;
-	}
-	if ((satzilla_feat.binary > 0.10000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.confl_size_max < 6371.00000) &&
-		(satzilla_feat.trail_depth_delta_max > 6774.00000))
-	{
-		total_plus += 0.964;
-	}
-	if ((satzilla_feat.pnr_var_std > 0.30000) &&
-		(satzilla_feat.confl_size_max > 6371.00000) &&
-		(satzilla_feat.avg_trail_depth_delta < 4679.60010) &&
-		(satzilla_feat.irred_cl_distrib.glue_distr_var < 5139.60010))
-	{
-		total_neg += 0.938;
-	}
-	if ((satzilla_feat.confl_size_min > 1.00000) &&
-		(satzilla_feat.avg_confl_glue > 10.80000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 16.80000))
-	{
-		total_neg += 0.778;
-	}
-	if ((satzilla_feat.binary > 0.20000) &&
-		(satzilla_feat.trail_depth_delta_max < 6774.00000))
-	{
-		total_neg += 0.783;
-	}
-	if ((satzilla_feat.branch_depth_max > 42.00000) &&
-		(satzilla_feat.trail_depth_delta_max < 6774.00000) &&
-		(satzilla_feat.confl_per_restart < 194.00000))
-	{
-		total_neg += 0.915;
-	}
-	if ((satzilla_feat.vcg_var_spread > 0.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var > 2.30000))
-	{
-		total_plus += 0.800;
-	}
-	if ((satzilla_feat.binary < 0.10000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 3.60000))
-	{
-		total_neg += 0.846;
-	}
-	if ((satzilla_feat.numClauses > 54199.00000) &&
-		(satzilla_feat.avg_confl_size > 26.80000) &&
-		(satzilla_feat.trail_depth_delta_max < 6774.00000))
-	{
-		total_neg += 0.909;
-	}
-	if ((satzilla_feat.pnr_var_std > 1.40000) &&
-		(satzilla_feat.branch_depth_max < 42.00000))
-	{
-		total_plus += 0.833;
-	}
-	if ((satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.confl_size_max < 6371.00000) &&
-		(satzilla_feat.trail_depth_delta_max > 6774.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean > 3.60000))
-	{
-		total_plus += 0.843;
-	}
-	if ((satzilla_feat.pnr_var_std > 0.30000) &&
-		(satzilla_feat.avg_trail_depth_delta > 4679.60010))
-	{
-		total_plus += 0.846;
-	}
-	// num_rules: 13
-	// rule_no: 13
-	// default is: +
-
-	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
-	}
-	return total_plus - total_neg;
+	vals[reconf_feat_confl_per_restart] = satzilla_feat.confl_per_restart;
+	vals[reconf_feat_vcg_cls_min] = satzilla_feat.vcg_cls_min;
+	vals[reconf_feat_pnr_var_max] = satzilla_feat.pnr_var_max;
+	vals[reconf_feat_pnr_cls_std] = satzilla_feat.pnr_cls_std;
+	vals[reconf_feat_red_cl_distrib_glue_distr_var] = satzilla_feat.red_cl_distrib.glue_distr_var;
+	vals[reconf_feat_red_cl_distrib_activity_distr_var] = satzilla_feat.red_cl_distrib.activity_distr_var;
+	vals[reconf_feat_numClauses] = satzilla_feat.numClauses;
+	vals[reconf_feat_trail_depth_delta_max] = satzilla_feat.trail_depth_delta_max;
+	vals[reconf_feat_horn] = satzilla_feat.horn;
+	vals[reconf_feat_pnr_var_mean] = satzilla_feat.pnr_var_mean;
+	vals[reconf_feat_pnr_var_std] = satzilla_feat.pnr_var_std;
+	vals[reconf_feat_confl_size_max] = satzilla_feat.confl_size_max;
+	vals[reconf_feat_irred_cl_distrib_activity_distr_var] = satzilla_feat.irred_cl_distrib.activity_distr_var;
+	vals[reconf_feat_binary] = satzilla_feat.binary;
+	vals[reconf_feat_vcg_cls_std] = satzilla_feat.vcg_cls_std;
+	vals[reconf_feat_avg_confl_size] = satzilla_feat.avg_confl_size;
+	vals[reconf_feat_confl_size_min] = satzilla_feat.confl_size_min;
+	vals[reconf_feat_vcg_var_std] = satzilla_feat.vcg_var_std;
+	vals[reconf_feat_pnr_cls_mean] = satzilla_feat.pnr_cls_mean;
+	vals[reconf_feat_branch_depth_min] = satzilla_feat.branch_depth_min;
+	vals[reconf_feat_branch_depth_max] = satzilla_feat.branch_depth_max;
+	vals[reconf_feat_irred_cl_distrib_glue_distr_mean] = satzilla_feat.irred_cl_distrib.glue_distr_mean;
+	vals[reconf_feat_irred_cl_distrib_glue_distr_var] = satzilla_feat.irred_cl_distrib.glue_distr_var;
+	vals[reconf_feat_vcg_var_max] = satzilla_feat.vcg_var_max;
+	vals[reconf_feat_decisions_per_conflict] = satzilla_feat.decisions_per_conflict;
+	vals[reconf_feat_avg_branch_depth_delta] = satzilla_feat.avg_branch_depth_delta;
+	vals[reconf_feat_irred_cl_distrib_size_distr_var] = satzilla_feat.irred_cl_distrib.size_distr_var;
+	vals[reconf_feat_confl_glue_max] = satzilla_feat.confl_glue_max;
+	vals[reconf_feat_avg_confl_glue] = satzilla_feat.avg_confl_glue;
+	vals[reconf_feat_pnr_cls_max] = satzilla_feat.pnr_cls_max;
+	vals[reconf_feat_irred_cl_distrib_size_distr_mean] = satzilla_feat.irred_cl_distrib.size_distr_mean;
+	vals[reconf_feat_red_cl_distrib_activity_distr_mean] = satzilla_feat.red_cl_distrib.activity_distr_mean;
+	vals[reconf_feat_avg_trail_depth_delta] = satzilla_feat.avg_trail_depth_delta;
+	vals[reconf_feat_learnt_bins_per_confl] = satzilla_feat.learnt_bins_per_confl;
+	vals[reconf_feat_avg_branch_depth] = satzilla_feat.avg_branch_depth;
+	vals[reconf_feat_vcg_var_spread] = satzilla_feat.vcg_var_spread;
+	vals[reconf_feat_trail_depth_delta_min] = satzilla_feat.trail_depth_delta_min;
+	vals[reconf_feat_red_cl_distrib_size_distr_mean] = satzilla_feat.red_cl_distrib.size_distr_mean;
 }
 
-
-double get_score16(const SatZillaFeatures& satzilla_feat, const int verb)
+static double get_score(const ReconfModel& model, const double* vals)
 {
-	double default_val = 0.00;
-
 	double total_plus = 0.0;
 	double total_neg = 0.0;
-	if ((satzilla_feat.avg_branch_depth > 18.60000))
-	{
-		total_neg += 0.625;
-	}
-	if ((satzilla_feat.binary < 0.40000))
-	{
-		total_plus += 0.498;
-	}
-	if ((satzilla_feat.vcg_var_std < 2.10000) &&
-		(satzilla_feat.vcg_cls_std > 5.50000) &&
-		(satzilla_feat.pnr_cls_std < 11.90000))
-	{
-		total_plus += 0.939;
-	}
-	if ((satzilla_feat.horn > 0.10000) &&
-		(satzilla_feat.vcg_var_std < 2.20000) &&
-		(satzilla_feat.confl_size_min < 1.00000) &&
-		(satzilla_feat.confl_size_max > 149.00000) &&
-		(satzilla_feat.avg_branch_depth < 178.30000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.50000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var < 3.60000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var < 0.40000) &&
-		(satzilla_feat.red_cl_distrib.size_distr_mean > 5.20000))
-	{
-		total_plus += 0.893;
+	for(int r = model.first_rule; r < model.first_rule + model.num_rules; r++) {
+		const ReconfRule& rule = reconf_rules[r];
+		bool fires = true;
+		for(int c = rule.first_cond; c < rule.first_cond + rule.num_conds; c++) {
+			const ReconfCond& cond = reconf_conds[c];
+			const double val = vals[cond.feat];
+			if (cond.less ? !(val < cond.cut) : !(val > cond.cut)) {
+				fires = false;
+				break;
+			}
+		}
+		if (!fires) {
+			continue;
+		}
+		if (rule.plus) {
+			total_plus += rule.confidence;
+		} else {
+			total_neg += rule.confidence;
+		}
 	}
-	if ((satzilla_feat.vcg_var_std > 2.20000) &&
-		(satzilla_feat.vcg_var_std < 3.30000) &&
-		(satzilla_feat.avg_branch_depth > 18.60000) &&
-		(satzilla_feat.avg_branch_depth < 181.89999) &&
-		(satzilla_feat.confl_per_restart < 262.10001) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var < 0.40000))
-	{
-		total_plus += 0.941;
-	}
-	if ((satzilla_feat.numClauses < 7548140.00000) &&
-		(satzilla_feat.trail_depth_delta_max > 167286.00000))
-	{
-		total_plus += 0.826;
-	}
-	if ((satzilla_feat.vcg_var_std < 2.20000) &&
-		(satzilla_feat.confl_size_max > 149.00000) &&
-		(satzilla_feat.avg_branch_depth > 218.20000) &&
-		(satzilla_feat.branch_depth_min < 101.00000) &&
-		(satzilla_feat.red_cl_distrib.glue_distr_var < 0.40000))
-	{
-		total_plus += 0.889;
-	}
-	if ((satzilla_feat.numClauses < 108335.00000) &&
-		(satzilla_feat.vcg_var_max < 0.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean > 5.90000))
-	{
-		total_plus += 0.950;
-	}
-	// num_rules: 8
-	// rule_no: 8
-	// default is: -
 
 	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
+		return model.default_val;
 	}
 	return total_plus - total_neg;
 }
 
-
-double get_score17(const SatZillaFeatures& satzilla_feat, const int verb)
+int get_reconf_from_satzilla_features(const SatZillaFeatures& satzilla_feat, const int verb)
 {
-	double default_val = 0.00;
+	double vals[reconf_feat_num];
+	get_reconf_features(satzilla_feat, vals);
 
-	double total_plus = 0.0;
-	double total_neg = 0.0;
-	if ((satzilla_feat.confl_size_max > 115.00000))
-	{
-		total_neg += 0.579;
-	}
-	if ((satzilla_feat.confl_size_max < 115.00000))
-	{
-		total_plus += 0.896;
-	}
-	if ((satzilla_feat.vcg_cls_std < 5.50000) &&
-		(satzilla_feat.branch_depth_min < 18.00000) &&
-		(satzilla_feat.confl_per_restart > 169.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.50000) &&
-		(satzilla_feat.red_cl_distrib.size_distr_var < 14.50000) &&
-		(satzilla_feat.red_cl_distrib.activity_distr_var < 131731750000.00000))
-	{
-		total_plus += 0.811;
-	}
-	if ((satzilla_feat.vcg_cls_std > 5.50000) &&
-		(satzilla_feat.avg_confl_size > 45.90000))
-	{
-		total_plus += 0.909;
-	}
-	if ((satzilla_feat.avg_branch_depth < 15.80000))
-	{
-		total_plus += 0.900;
-	}
-	if ((satzilla_feat.avg_trail_depth_delta > 5287.70020) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_var < 2.10000))
-	{
-		total_plus += 0.889;
-	}
-	if ((satzilla_feat.numClauses > 84464.00000) &&
-		(satzilla_feat.pnr_var_mean > 0.50000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean > 4.50000))
-	{
-		total_plus += 0.833;
-	}
-	if ((satzilla_feat.red_cl_distrib.activity_distr_var > 131731750000.00000))
-	{
-		total_plus += 0.722;
-	}
-	if ((satzilla_feat.horn > 0.60000) &&
-		(satzilla_feat.pnr_var_max < 0.50000) &&
-		(satzilla_feat.avg_branch_depth_delta < 2.00000))
-	{
-		total_plus += 0.909;
-	}
-	if ((satzilla_feat.pnr_var_std > 0.50000) &&
-		(satzilla_feat.branch_depth_min < 18.00000) &&
-		(satzilla_feat.confl_per_restart > 169.00000) &&
-		(satzilla_feat.confl_per_restart < 296.29999) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.50000) &&
-		(satzilla_feat.red_cl_distrib.activity_distr_var < 131731750000.00000))
-	{
-		total_plus += 0.944;
-	}
-	if ((satzilla_feat.pnr_var_std < 0.30000) &&
-		(satzilla_feat.pnr_var_max > 0.50000) &&
-		(satzilla_feat.branch_depth_min < 18.00000) &&
-		(satzilla_feat.avg_trail_depth_delta < 5287.70020) &&
-		(satzilla_feat.trail_depth_delta_min < 2.00000) &&
-		(satzilla_feat.confl_per_restart < 296.29999) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.50000))
-	{
-		total_plus += 0.857;
-	}
-	if ((satzilla_feat.trail_depth_delta_min > 2.00000) &&
-		(satzilla_feat.irred_cl_distrib.size_distr_mean < 4.50000))
-	{
-		total_plus += 0.769;
+	double best_score = 0.0;
+	int best_val = 0;
+	for(const ReconfModel& model: reconf_models) {
+		const double score = get_score(model, vals);
+		if (verb >= 2)
+			cout << "c Score for reconf " << model.reconf << " is " << score << endl;
+		if (best_score < score) {
+			best_score = score;
+			best_val = model.reconf;
+		}
 	}
-	// num_rules: 12
-	// rule_no: 12
-	// default is: -
 
-	if (total_plus == 0.0 && total_neg == 0.0) {
-		return default_val;
-	}
-	if (verb >= 2) {
-		//cout << "c plus: " << total_plus << " , neg: " << total_neg << endl;
-	}
-	return total_plus - total_neg;
+	if (verb >= 2)
+		cout << "c Winning reconf is " << best_val << endl;
+	return best_val;
 }
 
-
 } //end namespace
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "time_mem.h"
 #include "solver.h"
 #include "sqlstats.h"
+#include "sccfinderpar.h"
 
 using namespace CMSat;
 using std::cout;
@@ -48,6 +49,45 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     depth_warning_issued = false;
     const double myTime = cpuTime();
 
+    //Without new binaries no new SCC can form: SCCs found last time were
+    //all replaced. A new SCC must contain a new binary's implication.
+    const bool incremental = solver->conf.scc_incremental
+        && done_full
+        && !solver->bins_since_scc_overflow;
+    runStats.numIncremental = incremental;
+
+    if (solver->conf.scc_threads > 1) {
+        find_par(incremental);
+    } else if (incremental) {
+        find_incremental();
+    } else {
+        find_all();
+    }
+
+    done_full = !depth_warning_issued;
+    solver->bins_since_scc.clear();
+    solver->bins_since_scc_overflow = false;
+
+    //Update & print stats
+    runStats.cpu_time = cpuTime() - myTime;
+    runStats.foundXorsNew = binxors.size();
+    if (solver->conf.verbosity) {
+        if (solver->conf.verbosity >= 3)
+            runStats.print();
+        else
+            runStats.print_short(solver);
+    }
+    globalStats += runStats;
+
+    if (bogoprops_given) {
+        *bogoprops_given += runStats.bogoprops;
+    }
+
+    return solver->okay();
+}
+
+void SCCFinder::find_all()
+{
     globalIndex = 0;
     index.clear();
     index.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
@@ -71,23 +111,96 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
             assert(stack.empty());
         }
     }
+}
 
-    //Update & print stats
-    runStats.cpu_time = cpuTime() - myTime;
-    runStats.foundXorsNew = binxors.size();
-    if (solver->conf.verbosity) {
-        if (solver->conf.verbosity >= 3)
-            runStats.print();
-        else
-            runStats.print_short(solver);
+//Binary (a V b) is the implications ~a->b and ~b->a, so any new SCC
+//contains ~a or ~b, and a DFS from them finds it
+void SCCFinder::find_incremental()
+{
+    globalIndex = 0;
+    index.clear();
+    index.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
+    lowlink.clear();
+    lowlink.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
+    stackIndicator.clear();
+    stackIndicator.resize(solver->nVars()*2, false);
+    assert(stack.empty());
+
+    depth = 0;
+    for (const Lit lit: solver->bins_since_scc) {
+        const uint32_t vertex = (~lit).toInt();
+        if (solver->value(lit) != l_Undef) {
+            continue;
+        }
+        assert(depth == 0);
+        if (index[vertex] == std::numeric_limits<uint32_t>::max()) {
+            tarjan(vertex);
+            depth--;
+            assert(stack.empty());
+        }
     }
-    globalStats += runStats;
+}
 
-    if (bogoprops_given) {
-        *bogoprops_given += runStats.bogoprops;
+void SCCFinder::find_par(const bool incremental)
+{
+    vector<uint32_t> vertices;
+    if (!incremental) {
+        for (uint32_t vertex = 0; vertex < solver->nVars()*2; vertex++) {
+            const Lit lit = Lit::toLit(vertex);
+            if (solver->value(lit) == l_Undef
+                && solver->varData[lit.var()].removed == Removed::none
+            ) {
+                vertices.push_back(vertex);
+            }
+        }
+    } else {
+        //Everything reachable from the new implications
+        stackIndicator.clear();
+        stackIndicator.resize(solver->nVars()*2, false);
+        for (const Lit lit: solver->bins_since_scc) {
+            const Lit start = ~lit;
+            if (solver->value(start) == l_Undef
+                && solver->varData[start.var()].removed == Removed::none
+                && !stackIndicator[start.toInt()]
+            ) {
+                stackIndicator[start.toInt()] = true;
+                vertices.push_back(start.toInt());
+            }
+        }
+        for(size_t i = 0; i < vertices.size(); i++) {
+            watch_subarray_const ws = solver->watches[~Lit::toLit(vertices[i])];
+            runStats.bogoprops += ws.size()/4 + 1;
+            for(const Watched& w: ws) {
+                if (!w.isBin()) {
+                    continue;
+                }
+                const Lit lit = w.lit2();
+                if (solver->value(lit) == l_Undef
+                    && solver->varData[lit.var()].removed == Removed::none
+                    && !stackIndicator[lit.toInt()]
+                ) {
+                    stackIndicator[lit.toInt()] = true;
+                    vertices.push_back(lit.toInt());
+                }
+            }
+        }
+        for(const uint32_t vertex: vertices) {
+            stackIndicator[vertex] = false;
+        }
     }
 
-    return solver->okay();
+    SCCFinderPar par(solver, solver->conf.scc_threads);
+    vector<vector<uint32_t> > sccs;
+    par.find(vertices, sccs);
+    runStats.bogoprops += par.get_bogoprops();
+
+    //Literals are sorted, so every SCC is represented by its smallest
+    //literal, independently of the threads
+    for(const vector<uint32_t>& scc: sccs) {
+        tmp = scc;
+        runStats.bogoprops += 3;
+        add_bin_xor_in_tmp();
+    }
 }
 
 void SCCFinder::tarjan(const uint32_t vertex)
@@ -177,6 +290,7 @@ void SCCFinder::Stats::print_short(Solver* solver) const
     cout
     << "c [scc]"
     << " new: " << foundXorsNew
+    << " incr: " << (numIncremental ? "Y" : "N")
     << " BP " << bogoprops/(1000*1000) << "M";
     if (solver) {
         cout << solver->conf.print_times(cpu_time);
@@ -52,6 +52,7 @@ class SCCFinder {
             uint64_t foundXors = 0;
             uint64_t foundXorsNew = 0;
             uint64_t bogoprops = 0;
+            uint64_t numIncremental = 0;
 
             Stats& operator+=(const Stats& other)
             {
@@ -60,6 +61,7 @@ class SCCFinder {
                 foundXors += other.foundXors;
                 foundXorsNew += other.foundXorsNew;
                 bogoprops += other.bogoprops;
+                numIncremental += other.numIncremental;
 
                 return *this;
             }
@@ -90,6 +92,12 @@ class SCCFinder {
                     , "% of all found"
                 );
 
+                print_stats_line("c incremental"
+                    , numIncremental
+                    , stats_line_percent(numIncremental, numCalls)
+                    , "% of calls"
+                );
+
                 cout << "c ----- SCC STATS END --------" << endl;
             }
 
@@ -101,6 +109,9 @@ class SCCFinder {
         bool depth_warning_triggered() const;
 
     private:
+        void find_all();
+        void find_incremental();
+        void find_par(const bool incremental);
         void tarjan(const uint32_t vertex);
         bool depth_warning_issued;
         void doit(const Lit lit, const uint32_t vertex);
@@ -114,6 +125,8 @@ class SCCFinder {
         vector<char> stackIndicator;
         vector<uint32_t> tmp;
         uint32_t depth;
+        //Set once all vertices were searched, only then can we be incremental
+        bool done_full = false;
 
         Solver* solver;
         std::set<BinaryXor> binxors;
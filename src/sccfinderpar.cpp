@@ -0,0 +1,358 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "sccfinderpar.h"
+#include "solver.h"
+#include "watched.h"
+
+#include <thread>
+#include <algorithm>
+#include <limits>
+
+using namespace CMSat;
+
+SCCFinderPar::SCCFinderPar(
+    const Solver* _solver
+    , const uint32_t _num_threads
+    , const uint32_t _small_task
+) :
+    solver(_solver)
+    , num_threads(std::max<uint32_t>(_num_threads, 1))
+    , small_task(_small_task)
+    , label(_solver->nVars()*2)
+    , next_label(2)
+{
+}
+
+uint32_t SCCFinderPar::get_label(const uint32_t vertex) const
+{
+    return label[vertex].load(std::memory_order_relaxed);
+}
+
+void SCCFinderPar::set_label(const uint32_t vertex, const uint32_t lab)
+{
+    label[vertex].store(lab, std::memory_order_relaxed);
+}
+
+uint32_t SCCFinderPar::new_labels(const uint32_t num)
+{
+    const uint32_t at = next_label.fetch_add(num);
+    release_assert(at < std::numeric_limits<uint32_t>::max() - num);
+    return at;
+}
+
+template<class F>
+void SCCFinderPar::for_each_succ(const uint32_t vertex, ThreadData& td, F func) const
+{
+    watch_subarray_const ws = solver->watches[~Lit::toLit(vertex)];
+    td.bogoprops += ws.size()/4 + 1;
+    for(const Watched& w: ws) {
+        if (w.isBin() && !func(w.lit2().toInt())) {
+            return;
+        }
+    }
+}
+
+template<class F>
+void SCCFinderPar::for_each_pred(const uint32_t vertex, ThreadData& td, F func) const
+{
+    watch_subarray_const ws = solver->watches[Lit::toLit(vertex)];
+    td.bogoprops += ws.size()/4 + 1;
+    for(const Watched& w: ws) {
+        if (w.isBin() && !func((~w.lit2()).toInt())) {
+            return;
+        }
+    }
+}
+
+void SCCFinderPar::find(
+    const vector<uint32_t>& vertices
+    , vector<vector<uint32_t> >& sccs
+) {
+    for(const uint32_t v: vertices) {
+        set_label(v, 1);
+    }
+    Task all;
+    all.vertices = vertices;
+    all.label = 1;
+    tasks.push_back(all);
+    busy = 0;
+
+    vector<ThreadData> tds(num_threads);
+    vector<std::thread> thds;
+    for(uint32_t i = 1; i < num_threads; i++) {
+        thds.push_back(std::thread(&SCCFinderPar::worker, this, std::ref(tds[i])));
+    }
+    worker(tds[0]);
+    for(std::thread& t: thds) {
+        t.join();
+    }
+
+    sccs.clear();
+    for(ThreadData& td: tds) {
+        bogoprops += td.bogoprops;
+        for(vector<uint32_t>& scc: td.sccs) {
+            std::sort(scc.begin(), scc.end());
+            sccs.push_back(std::move(scc));
+        }
+    }
+    std::sort(sccs.begin(), sccs.end());
+}
+
+void SCCFinderPar::worker(ThreadData& td)
+{
+    vector<Task> new_tasks;
+    std::unique_lock<std::mutex> lock(task_mutex);
+    while(true) {
+        task_cv.wait(lock, [this]{ return !tasks.empty() || busy == 0; });
+        if (tasks.empty()) {
+            //Nothing queued and nobody working, so nothing will be queued
+            task_cv.notify_all();
+            return;
+        }
+
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        busy++;
+        lock.unlock();
+
+        new_tasks.clear();
+        process(task, new_tasks, td);
+
+        lock.lock();
+        for(Task& t: new_tasks) {
+            tasks.push_back(std::move(t));
+        }
+        busy--;
+        task_cv.notify_all();
+    }
+}
+
+void SCCFinderPar::process(Task& task, vector<Task>& new_tasks, ThreadData& td)
+{
+    if (task.vertices.size() > small_task) {
+        trim(task, td);
+    }
+
+    if (task.vertices.size() <= small_task) {
+        tarjan(task, td);
+    } else {
+        fw_bw(task, new_tasks, td);
+    }
+}
+
+//Vertices with no successor or no predecessor inside the task can only be
+//trivial SCCs
+void SCCFinderPar::trim(Task& task, ThreadData& td)
+{
+    const uint32_t lab = task.label;
+    auto in_task = [&](const uint32_t w) {
+        return get_label(w) == lab;
+    };
+
+    for(uint32_t pass = 0; pass < 3; pass++) {
+        size_t j = 0;
+        for(size_t i = 0; i < task.vertices.size(); i++) {
+            const uint32_t v = task.vertices[i];
+            bool has_succ = false;
+            for_each_succ(v, td, [&](const uint32_t w) {
+                has_succ = in_task(w);
+                return !has_succ;
+            });
+            bool has_pred = false;
+            if (has_succ) {
+                for_each_pred(v, td, [&](const uint32_t w) {
+                    has_pred = in_task(w);
+                    return !has_pred;
+                });
+            }
+
+            if (has_succ && has_pred) {
+                task.vertices[j++] = v;
+            } else {
+                set_label(v, 0);
+            }
+        }
+        const size_t removed = task.vertices.size() - j;
+        task.vertices.resize(j);
+        if (removed*20 < task.vertices.size()) {
+            break;
+        }
+    }
+}
+
+void SCCFinderPar::fw_bw(Task& task, vector<Task>& new_tasks, ThreadData& td)
+{
+    const uint32_t lab = task.label;
+    const uint32_t base = new_labels(3);
+    const uint32_t fw_lab = base;
+    const uint32_t bw_lab = base+1;
+    const uint32_t scc_lab = base+2;
+    const uint32_t pivot = task.vertices[0];
+
+    vector<uint32_t>& bfs = td.bfs;
+    bfs.clear();
+    set_label(pivot, fw_lab);
+    bfs.push_back(pivot);
+    for(size_t i = 0; i < bfs.size(); i++) {
+        for_each_succ(bfs[i], td, [&](const uint32_t w) {
+            if (get_label(w) == lab) {
+                set_label(w, fw_lab);
+                bfs.push_back(w);
+            }
+            return true;
+        });
+    }
+
+    bfs.clear();
+    set_label(pivot, scc_lab);
+    bfs.push_back(pivot);
+    for(size_t i = 0; i < bfs.size(); i++) {
+        for_each_pred(bfs[i], td, [&](const uint32_t w) {
+            const uint32_t l = get_label(w);
+            if (l == fw_lab) {
+                set_label(w, scc_lab);
+                bfs.push_back(w);
+            } else if (l == lab) {
+                set_label(w, bw_lab);
+                bfs.push_back(w);
+            }
+            return true;
+        });
+    }
+
+    Task parts[3];
+    parts[0].label = fw_lab;
+    parts[1].label = bw_lab;
+    parts[2].label = lab;
+    vector<uint32_t> scc;
+    for(const uint32_t v: task.vertices) {
+        const uint32_t l = get_label(v);
+        if (l == scc_lab) {
+            scc.push_back(v);
+            set_label(v, 0);
+        } else if (l == fw_lab) {
+            parts[0].vertices.push_back(v);
+        } else if (l == bw_lab) {
+            parts[1].vertices.push_back(v);
+        } else {
+            assert(l == lab);
+            parts[2].vertices.push_back(v);
+        }
+    }
+    if (scc.size() >= 2) {
+        td.sccs.push_back(std::move(scc));
+    }
+    for(Task& t: parts) {
+        if (!t.vertices.empty()) {
+            new_tasks.push_back(std::move(t));
+        }
+    }
+}
+
+//Iterative, so deep implication chains don't overflow the stack. Every vertex
+//gets its own label, which is also its index into the local arrays.
+void SCCFinderPar::tarjan(Task& task, ThreadData& td)
+{
+    const uint32_t n = task.vertices.size();
+    if (n < 2) {
+        for(const uint32_t v: task.vertices) {
+            set_label(v, 0);
+        }
+        return;
+    }
+    const uint32_t base = new_labels(n);
+    for(uint32_t i = 0; i < n; i++) {
+        set_label(task.vertices[i], base+i);
+    }
+
+    const uint32_t undef = std::numeric_limits<uint32_t>::max();
+    td.index.assign(n, undef);
+    td.lowlink.assign(n, undef);
+    td.on_stack.assign(n, 0);
+    td.stack.clear();
+    td.call_stack.clear();
+    uint32_t at_index = 0;
+
+    for(uint32_t root = 0; root < n; root++) {
+        if (td.index[root] != undef) {
+            continue;
+        }
+        td.index[root] = td.lowlink[root] = at_index++;
+        td.stack.push_back(root);
+        td.on_stack[root] = 1;
+        td.call_stack.push_back(std::make_pair(root, 0U));
+
+        while(!td.call_stack.empty()) {
+            const uint32_t v = td.call_stack.back().first;
+            uint32_t& at = td.call_stack.back().second;
+            watch_subarray_const ws = solver->watches[~Lit::toLit(task.vertices[v])];
+
+            bool recurse = false;
+            while(at < ws.size()) {
+                const Watched& w = ws[at++];
+                if (!w.isBin()) {
+                    continue;
+                }
+
+                //Wraps around for labels below 'base'
+                const uint32_t u = get_label(w.lit2().toInt()) - base;
+                if (u >= n) {
+                    continue;
+                }
+                if (td.index[u] == undef) {
+                    td.index[u] = td.lowlink[u] = at_index++;
+                    td.stack.push_back(u);
+                    td.on_stack[u] = 1;
+                    td.call_stack.push_back(std::make_pair(u, 0U));
+                    recurse = true;
+                    break;
+                } else if (td.on_stack[u]) {
+                    td.lowlink[v] = std::min(td.lowlink[v], td.index[u]);
+                }
+            }
+            if (recurse) {
+                continue;
+            }
+
+            td.bogoprops += ws.size()/4 + 1;
+            if (td.lowlink[v] == td.index[v]) {
+                vector<uint32_t> scc;
+                uint32_t u;
+                do {
+                    u = td.stack.back();
+                    td.stack.pop_back();
+                    td.on_stack[u] = 0;
+                    scc.push_back(task.vertices[u]);
+                } while(u != v);
+                if (scc.size() >= 2) {
+                    td.sccs.push_back(std::move(scc));
+                }
+            }
+            td.call_stack.pop_back();
+            if (!td.call_stack.empty()) {
+                const uint32_t parent = td.call_stack.back().first;
+                td.lowlink[parent] = std::min(td.lowlink[parent], td.lowlink[v]);
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __SCCFINDERPAR_H__
+#define __SCCFINDERPAR_H__
+
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::vector;
+using std::deque;
+
+class Solver;
+
+/**
+@brief Multi-threaded SCC search over the binary implication graph
+
+Forward-backward decomposition: the SCC of a pivot is the intersection of
+the vertices it reaches and the vertices reaching it. The remaining three
+parts contain no SCC crossing between them, so they are independent tasks
+for the threads. Small parts are finished with an iterative Tarjan.
+
+Every vertex carries the label of the task it belongs to, and a task only
+ever writes labels of its own vertices, so threads never write the same
+label. The predecessors of literal L are the negations of the successors of
+~L, so the reverse graph needs no extra memory.
+*/
+class SCCFinderPar
+{
+public:
+    SCCFinderPar(
+        const Solver* solver
+        , const uint32_t num_threads
+        , const uint32_t small_task = 16*1024
+    );
+
+    //'vertices' must be closed under successors. The non-trivial SCCs are
+    //returned sorted, each of them sorted.
+    void find(const vector<uint32_t>& vertices, vector<vector<uint32_t> >& sccs);
+    uint64_t get_bogoprops() const;
+
+private:
+    struct Task
+    {
+        vector<uint32_t> vertices;
+        uint32_t label;
+    };
+
+    struct ThreadData
+    {
+        vector<vector<uint32_t> > sccs;
+        uint64_t bogoprops = 0;
+
+        //For Tarjan
+        vector<uint32_t> index;
+        vector<uint32_t> lowlink;
+        vector<char> on_stack;
+        vector<uint32_t> stack;
+        vector<std::pair<uint32_t, uint32_t> > call_stack;
+        vector<uint32_t> bfs;
+    };
+
+    void worker(ThreadData& td);
+    void process(Task& task, vector<Task>& new_tasks, ThreadData& td);
+    void trim(Task& task, ThreadData& td);
+    void fw_bw(Task& task, vector<Task>& new_tasks, ThreadData& td);
+    void tarjan(Task& task, ThreadData& td);
+    uint32_t get_label(const uint32_t vertex) const;
+    void set_label(const uint32_t vertex, const uint32_t label);
+    uint32_t new_labels(const uint32_t num);
+
+    template<class F> void for_each_succ(const uint32_t vertex, ThreadData& td, F func) const;
+    template<class F> void for_each_pred(const uint32_t vertex, ThreadData& td, F func) const;
+
+    const Solver* solver;
+    const uint32_t num_threads;
+    //Tasks up to this size are done with Tarjan
+    const uint32_t small_task;
+    vector<std::atomic<uint32_t> > label;
+    std::atomic<uint32_t> next_label;
+
+    std::mutex task_mutex;
+    std::condition_variable task_cv;
+    deque<Task> tasks;
+    uint32_t busy = 0;
+    uint64_t bogoprops = 0;
+};
+
+inline uint64_t SCCFinderPar::get_bogoprops() const
+{
+    return bogoprops;
+}
+
+} //end namespace
+
+#endif //__SCCFINDERPAR_H__
@@ -43,6 +43,8 @@ THE SOFTWARE.
 #include "xorfinder.h"
 #include "vardistgen.h"
 #include "solvertypes.h"
+#include "eventtrace.h"
+#include "enumerator.h"
 #ifdef USE_GAUSS
 #include "gaussian.h"
 #endif
@@ -799,6 +801,7 @@ void Searcher::analyze_conflict(
     #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
     glue_before_minim = calc_glue(learnt_clause);
     #endif
+    const PhaseTimer::Phase prev_phase = phase_timer.enter(PhaseTimer::minimize);
     minimize_learnt_clause<update_bogoprops>();
     stats.litsRedFinal += learnt_clause.size();
 
@@ -821,6 +824,7 @@ void Searcher::analyze_conflict(
     ) {
         minimise_redundant_more_more(learnt_clause);
     }
+    phase_timer.leave(prev_phase);
 
     #ifdef STATS_NEEDED_BRANCH
     for(const Lit l: learnt_clause) {
@@ -1223,6 +1227,9 @@ void Searcher::check_need_gauss_jordan_disable()
         ) {
             gqd.engaus_disable = true;
             num_disabled++;
+            if (solver->trace) {
+                solver->trace->instant(TraceType::gauss_off, "matrix", sumConflicts, i);
+            }
         }
 
         gqd.reset();
@@ -1245,6 +1252,7 @@ lbool Searcher::search()
     check_order_heap_sanity();
     #endif
     const double myTime = cpuTime();
+    const uint64_t trace_start = solver->trace ? EventTrace::now() : 0;
 
     //Stats reset & update
     stats.numRestarts++;
@@ -1252,6 +1260,9 @@ lbool Searcher::search()
     hist.reset_glue_hist_size(conf.shortTermHistorySize);
 
     assert(solver->prop_at_head());
+    if (enumerator) {
+        enumerator->start_search();
+    }
 
     //Loop until restart or finish (SAT/UNSAT)
     PropBy confl;
@@ -1266,7 +1277,9 @@ lbool Searcher::search()
         #ifdef USE_GAUSS
         gqhead = qhead;
         #endif
+        const PhaseTimer::Phase prev_phase = phase_timer.enter(PhaseTimer::propagate);
         confl = propagate_any_order_fast();
+        phase_timer.leave(prev_phase);
 
         if (!confl.isNULL()) {
             update_branch_params();
@@ -1292,7 +1305,9 @@ lbool Searcher::search()
             assert(ok);
             #ifdef USE_GAUSS
             if (!all_matrices_disabled) {
+                const PhaseTimer::Phase prev_gauss = phase_timer.enter(PhaseTimer::gauss);
                 gauss_ret ret = gauss_jordan_elim();
+                phase_timer.leave(prev_gauss);
                 //cout << "ret: " << ret << " -- " << endl;
                 if (ret == gauss_ret::g_cont) {
                     //cout << "g_cont" << endl;
@@ -1315,6 +1330,10 @@ lbool Searcher::search()
             }
             reduce_db_if_needed();
             lbool dec_ret = new_decision<false>();
+            if (dec_ret == l_True && enumerator) {
+                //Block the model and carry on from the backjump level
+                dec_ret = enumerator->found_model();
+            }
             if (dec_ret != l_Undef) {
                 search_ret = dec_ret;
                 goto end;
@@ -1339,6 +1358,14 @@ lbool Searcher::search()
 
     end:
     dump_search_loop_stats(myTime);
+    if (solver->trace) {
+        solver->trace->span(TraceType::restart
+            , restart_type_to_short_string(params.rest_type)
+            , trace_start, sumConflicts, params.conflictsDoneThisRestart);
+        if (solver->trace_dump && solver->trace_dump->pending()) {
+            solver->trace_dump->add_snapshot(*solver->trace);
+        }
+    }
     return search_ret;
 }
 
@@ -1411,6 +1438,15 @@ lbool Searcher::new_decision()
         }
     }
 
+    if (next == lit_Undef && enumerator) {
+        // Projection vars come first when enumerating
+        next = enumerator->pick_branch();
+        if (next != lit_Undef) {
+            stats.decisions++;
+            sumDecisions++;
+        }
+    }
+
     if (next == lit_Undef) {
         // New variable decision:
         next = pickBranchLit();
@@ -1508,6 +1544,7 @@ void Searcher::attach_and_enqueue_learnt_clause(
         default:
             //Long learnt
             stats.learntLongs++;
+            solver->datasync->signalNewLongClause(learnt_clause, cl->stats.glue);
             solver->attachClause(*cl, enq);
             if (enq) enqueue(learnt_clause[0], level, PropBy(cl_alloc.get_offset(cl)));
             #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
@@ -1786,6 +1823,7 @@ Clause* Searcher::handle_last_confl(
 
 bool Searcher::handle_conflict(PropBy confl)
 {
+    PhaseScope phase(phase_timer, PhaseTimer::analyze);
     stats.conflStats.numConflicts++;
     hist.num_conflicts_this_restart++;
     sumConflicts++;
@@ -2075,20 +2113,34 @@ void Searcher::reset_temp_cl_num()
     cur_max_temp_red_lev2_cls = conf.max_temp_lev2_learnt_clauses;
 }
 
+//The argument of the event is the number of redundant clauses left
+void Searcher::trace_reducedb(const char* name, const uint64_t start)
+{
+    if (!solver->trace) {
+        return;
+    }
+
+    solver->trace->span(TraceType::reducedb, name, start, sumConflicts
+        , longRedCls[0].size() + longRedCls[1].size() + longRedCls[2].size());
+}
+
 void Searcher::reduce_db_if_needed()
 {
     #if defined(FINAL_PREDICTOR) || defined(STATS_NEEDED)
     if (conf.every_lev3_reduce != 0
         && sumConflicts >= next_lev3_reduce
     ) {
+        PhaseScope phase(phase_timer, PhaseTimer::reducedb);
         #ifdef STATS_NEEDED
         if (solver->sqlStats) {
             solver->reduceDB->dump_sql_cl_data(restart_type_to_short_string(params.rest_type));
         }
         #endif
         #ifdef FINAL_PREDICTOR
+        const uint64_t trace_start = solver->trace ? EventTrace::now() : 0;
         solver->reduceDB->handle_lev2_predictor();
         cl_alloc.consolidate(solver);
+        trace_reducedb("lev2-predictor", trace_start);
         #endif
         next_lev3_reduce = sumConflicts + conf.every_lev3_reduce;
     }
@@ -2098,21 +2150,30 @@ void Searcher::reduce_db_if_needed()
     if (conf.every_lev1_reduce != 0
         && sumConflicts >= next_lev1_reduce
     ) {
+        PhaseScope phase(phase_timer, PhaseTimer::reducedb);
+        const uint64_t trace_start = solver->trace ? EventTrace::now() : 0;
         solver->reduceDB->handle_lev1();
+        trace_reducedb("lev1", trace_start);
         next_lev1_reduce = sumConflicts + conf.every_lev1_reduce;
     }
 
     if (conf.every_lev2_reduce != 0) {
         if (sumConflicts >= next_lev2_reduce) {
+            PhaseScope phase(phase_timer, PhaseTimer::reducedb);
+            const uint64_t trace_start = solver->trace ? EventTrace::now() : 0;
             solver->reduceDB->handle_lev2();
             cl_alloc.consolidate(solver);
+            trace_reducedb("lev2", trace_start);
             next_lev2_reduce = sumConflicts + conf.every_lev2_reduce;
         }
     } else {
         if (longRedCls[2].size() > cur_max_temp_red_lev2_cls) {
+            PhaseScope phase(phase_timer, PhaseTimer::reducedb);
+            const uint64_t trace_start = solver->trace ? EventTrace::now() : 0;
             solver->reduceDB->handle_lev2();
             cur_max_temp_red_lev2_cls *= conf.inc_max_temp_lev2_red_cls;
             cl_alloc.consolidate(solver);
+            trace_reducedb("lev2", trace_start);
         }
     }
     #endif
@@ -3100,25 +3161,30 @@ Searcher::gauss_ret Searcher::gauss_jordan_elim()
         cout << "New GQHEAD: " << p << endl;
         #endif
 
-        for (; i != end; i++) {
-            if (gqueuedata[i->matrix_num].engaus_disable) {
-                //remove watch and continue
+        //The watches are sorted by matrix, go through them one matrix at a time
+        while (i != end && !confl_in_gauss) {
+            const uint32_t matrix_num = i->matrix_num;
+            GaussQData& gqd = gqueuedata[matrix_num];
+            if (gqd.engaus_disable) {
+                //remove watches and continue
+                while (i != end && i->matrix_num == matrix_num) {
+                    i++;
+                }
                 continue;
             }
 
-            gqueuedata[i->matrix_num].new_resp_var = std::numeric_limits<uint32_t>::max();
-            gqueuedata[i->matrix_num].new_resp_row = std::numeric_limits<uint32_t>::max();
-            gqueuedata[i->matrix_num].do_eliminate = false;
-            gqueuedata[i->matrix_num].currLevel = currLevel;
+            EGaussian* g = gmatrices[matrix_num];
+            gqd.currLevel = currLevel;
+            for (; i != end && i->matrix_num == matrix_num; i++) {
+                gqd.new_resp_var = std::numeric_limits<uint32_t>::max();
+                gqd.new_resp_row = std::numeric_limits<uint32_t>::max();
+                gqd.do_eliminate = false;
 
-            if (gmatrices[i->matrix_num]->find_truths(
-                i, j, p.var(), i->row_n, gqueuedata[i->matrix_num])
-            ) {
-                continue;
-            } else {
-                confl_in_gauss = true;
-                i++;
-                break;
+                if (!g->find_truths(i, j, p.var(), i->row_n, gqd)) {
+                    confl_in_gauss = true;
+                    i++;
+                    break;
+                }
             }
         }
 
@@ -3790,7 +3856,7 @@ ConflictData Searcher::find_conflict_level(PropBy& pb)
     } else {
         Lit* clause = NULL;
         uint32_t size = 0;
-        ClOffset offs;
+        ClOffset offs = CL_OFFSET_MAX;
         switch(pb.getType()) {
             case PropByType::clause_t: {
                 offs = pb.get_offset();
@@ -3880,7 +3946,9 @@ inline bool Searcher::check_order_heap_sanity() const
 }
 
 #ifdef USE_GAUSS
-void Searcher::clear_gauss_matrices()
+//If "keep" is set, the matrices are only taken down, and the next
+//find_and_init_all_matrices() can bring them up to date with row updates
+void Searcher::clear_gauss_matrices(const bool keep)
 {
     xor_clauses_updated = true;
     for(uint32_t i = 0; i < gqueuedata.size(); i++) {
@@ -3898,13 +3966,24 @@ void Searcher::clear_gauss_matrices()
         print_matrix_stats();
     }
     for(EGaussian* g: gmatrices) {
-        delete g;
+        if (keep && conf.gaussconf.keep_matrices) {
+            gmatrices_kept.push_back(g);
+        } else {
+            delete g;
+        }
     }
     for(auto& w: gwatches) {
         w.clear();
     }
     gmatrices.clear();
     gqueuedata.clear();
+
+    if (!keep) {
+        for(EGaussian* g: gmatrices_kept) {
+            delete g;
+        }
+        gmatrices_kept.clear();
+    }
 }
 
 void Searcher::print_matrix_stats()
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "simplefile.h"
 #include "searchstats.h"
 #include "gqueuedata.h"
+#include "phasetimer.h"
 
 #ifdef CMS_TESTING_ENABLED
 #include "gtest/gtest_prod.h"
@@ -47,6 +48,7 @@ class VarReplacer;
 class EGaussian;
 class DistillerLong;
 class ClusteringImp;
+class Enumerator;
 
 using std::string;
 using std::cout;
@@ -77,6 +79,7 @@ class Searcher : public HyperEngine
         );
         void finish_up_solve(lbool status);
         void reduce_db_if_needed();
+        void trace_reducedb(const char* name, const uint64_t start);
         void clean_clauses_if_needed();
         void check_calc_satzilla_features(bool force = false);
         void check_calc_vardist_features(bool force = false);
@@ -105,6 +108,7 @@ class Searcher : public HyperEngine
         uint64_t sumRestarts() const;
         const SearchHist& getHistory() const;
         void print_local_restart_budget();
+        PhaseTimer phase_timer;
 
         size_t hyper_bin_res_all(const bool check_for_set_values = true);
         std::pair<size_t, size_t> remove_useless_bins(bool except_marked = false);
@@ -144,13 +148,16 @@ class Searcher : public HyperEngine
 
         //Gauss
         #ifdef USE_GAUSS
-        void clear_gauss_matrices();
+        void clear_gauss_matrices(const bool keep = false);
         void print_matrix_stats();
         enum class gauss_ret {g_cont, g_nothing, g_false};
         gauss_ret gauss_jordan_elim();
         void check_need_gauss_jordan_disable();
         vector<EGaussian*> gmatrices;
         vector<GaussQData> gqueuedata;
+
+        ///Matrices taken down for inprocessing, for the next init to update
+        vector<EGaussian*> gmatrices_kept;
         #endif
 
         double get_cla_inc() const
@@ -217,6 +224,7 @@ class Searcher : public HyperEngine
 
     protected:
         Solver* solver;
+        Enumerator* enumerator = NULL; //set while enumerating models
         lbool search();
 
         ///////////////
@@ -385,6 +393,7 @@ class Searcher : public HyperEngine
 
 
         friend class Gaussian;
+        friend class Enumerator;
         friend class DistillerLong;
         #ifdef CMS_TESTING_ENABLED
         FRIEND_TEST(SearcherTest, pickpolar_rnd);
@@ -34,6 +34,7 @@ SATSolver* solverToInterrupt;
 int need_clean_exit;
 std::string redDumpFname;
 std::string irredDumpFname;
+std::string traceDumpFname;
 
 using std::cout;
 using std::endl;
@@ -43,7 +44,10 @@ void SIGINT_handler(int)
     SATSolver* solver = solverToInterrupt;
     cout << "c " << endl;
     std::cerr << "*** INTERRUPTED ***" << endl;
-    if (!redDumpFname.empty() || !irredDumpFname.empty() || need_clean_exit) {
+    //The event trace is written by main() once the threads have stopped
+    if (!redDumpFname.empty() || !irredDumpFname.empty()
+        || !traceDumpFname.empty() || need_clean_exit
+    ) {
         solver->interrupt_asap();
         std::cerr
         << "*** Please wait. We need to interrupt cleanly" << endl
@@ -67,3 +71,10 @@ void SIGINT_handler(int)
         #endif
     }
 }
+
+//Asks for an event trace dump and lets the solver continue. Only a flag is
+//set here, the solver threads write the trace at their next restart.
+void SIGUSR1_handler(int)
+{
+    solverToInterrupt->request_event_trace_dump();
+}
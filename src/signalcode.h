@@ -35,6 +35,8 @@ extern SATSolver* solverToInterrupt;
 extern int need_clean_exit;
 extern std::string redDumpFname;
 extern std::string irredDumpFname;
+extern std::string traceDumpFname;
 void SIGINT_handler(int);
+void SIGUSR1_handler(int);
 
 #endif //SIGNALCODE_H_
@@ -0,0 +1,210 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "snapshotprop.h"
+#include "solver.h"
+#include "watched.h"
+
+#include <algorithm>
+
+using namespace CMSat;
+
+PropSnapshot::PropSnapshot(const Solver* _solver) :
+    solver(_solver)
+    , watches(_solver->watches)
+{
+    start.push_back(0);
+    assigns.resize(solver->nVars());
+    for(uint32_t i = 0; i < solver->nVars(); i++) {
+        assigns[i] = solver->value(i);
+    }
+}
+
+void PropSnapshot::add_cls(const vector<ClOffset>& offs)
+{
+    for(const ClOffset offset: offs) {
+        const Clause& cl = *solver->cl_alloc.ptr(offset);
+        if (!cl._xor_is_detached) {
+            lits.insert(lits.end(), cl.begin(), cl.end());
+        }
+        start.push_back(lits.size());
+    }
+}
+
+double PropSnapshot::mem_used() const
+{
+    double mem = lits.capacity()*sizeof(Lit);
+    mem += start.capacity()*sizeof(uint32_t);
+    mem += assigns.capacity()*sizeof(lbool);
+    return mem;
+}
+
+SnapshotProp::SnapshotProp(const PropSnapshot& _snap) :
+    snap(_snap)
+    , lits(_snap.lits)
+    , assigns(_snap.assigns)
+{
+    watches.resize(assigns.size()*2);
+    for(uint32_t at = 0; at < snap.num_cls(); at++) {
+        Lit* cl = lits.data() + snap.start[at];
+        const uint32_t sz = snap.start[at+1] - snap.start[at];
+
+        //Move the non-false literals to the front. Satisfied clauses
+        //are never going to propagate, so they are not watched.
+        bool sat = false;
+        uint32_t j = 0;
+        for(uint32_t i = 0; i < sz; i++) {
+            const lbool val = value(cl[i]);
+            if (val == l_True) {
+                sat = true;
+                break;
+            }
+            if (val == l_Undef) {
+                std::swap(cl[i], cl[j++]);
+            }
+        }
+        if (sat || j < 2) {
+            continue;
+        }
+        watches[cl[0].toInt()].push_back(at);
+        watches[cl[1].toInt()].push_back(at);
+    }
+}
+
+void SnapshotProp::enqueue(const Lit lit, const bool long_reason)
+{
+    assert(value(lit) == l_Undef);
+    assigns[lit.var()] = boolToLBool(!lit.sign());
+    trail.push_back(lit);
+    trail_long.push_back(long_reason);
+}
+
+void SnapshotProp::new_decision_level()
+{
+    trail_lim.push_back(trail.size());
+}
+
+void SnapshotProp::cancel_until(const uint32_t level)
+{
+    if (decisionLevel() <= level) {
+        return;
+    }
+
+    const uint32_t until = trail_lim[level];
+    for(uint32_t i = until; i < trail.size(); i++) {
+        assigns[trail[i].var()] = l_Undef;
+    }
+    trail.resize(until);
+    trail_long.resize(until);
+    trail_lim.resize(level);
+    qhead = std::min<uint32_t>(qhead, until);
+}
+
+bool SnapshotProp::propagate(const uint32_t skip)
+{
+    while(qhead < trail.size()) {
+        const Lit p = trail[qhead++];
+        const Lit false_lit = ~p;
+
+        //Binary clauses, straight from the solver
+        watch_subarray_const ws_bin = snap.watches[false_lit];
+        bogoprops += ws_bin.size()/4 + 1;
+        for(const Watched& w: ws_bin) {
+            if (!w.isBin()) {
+                continue;
+            }
+            const lbool val = value(w.lit2());
+            if (val == l_False) {
+                qhead = trail.size();
+                return false;
+            }
+            if (val == l_Undef) {
+                enqueue(w.lit2());
+            }
+        }
+
+        //Long clauses, private watches
+        vector<uint32_t>& ws = watches[false_lit.toInt()];
+        bogoprops += ws.size()/4;
+        size_t i = 0;
+        size_t j = 0;
+        for(const size_t end = ws.size(); i < end; i++) {
+            const uint32_t at = ws[i];
+            if (at == skip) {
+                ws[j++] = at;
+                continue;
+            }
+
+            Lit* cl = lits.data() + snap.start[at];
+            const uint32_t sz = snap.start[at+1] - snap.start[at];
+            if (cl[0] == false_lit) {
+                std::swap(cl[0], cl[1]);
+            }
+            assert(cl[1] == false_lit);
+            if (value(cl[0]) == l_True) {
+                ws[j++] = at;
+                continue;
+            }
+
+            bool found = false;
+            for(uint32_t k = 2; k < sz; k++) {
+                if (value(cl[k]) != l_False) {
+                    std::swap(cl[1], cl[k]);
+                    watches[cl[1].toInt()].push_back(at);
+                    found = true;
+                    break;
+                }
+            }
+            bogoprops += 1;
+            if (found) {
+                continue;
+            }
+
+            ws[j++] = at;
+            if (value(cl[0]) == l_False) {
+                for(i++; i < end; i++) {
+                    ws[j++] = ws[i];
+                }
+                ws.resize(j);
+                qhead = trail.size();
+                return false;
+            }
+            enqueue(cl[0], true);
+        }
+        ws.resize(j);
+    }
+
+    return true;
+}
+
+double SnapshotProp::mem_used() const
+{
+    double mem = sizeof(SnapshotProp);
+    mem += lits.capacity()*sizeof(Lit);
+    mem += assigns.capacity()*sizeof(lbool);
+    mem += trail.capacity()*(sizeof(Lit)+sizeof(char));
+    mem += trail_lim.capacity()*sizeof(uint32_t);
+    for(const auto& ws: watches) {
+        mem += ws.capacity()*sizeof(uint32_t);
+    }
+    return mem;
+}
@@ -0,0 +1,114 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __SNAPSHOTPROP_H__
+#define __SNAPSHOTPROP_H__
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include "solvertypes.h"
+#include "cloffset.h"
+#include "watcharray.h"
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Read-only copy of long clauses and of the level-0 assignment
+
+Shared between threads that propagate over it in parallel. The binary
+clauses are read directly from the solver's watchlists, which must not change
+while the threads run.
+*/
+struct PropSnapshot
+{
+    explicit PropSnapshot(const Solver* solver);
+
+    //Clauses that are not attached are added empty, so clause number X of
+    //'offs' will always be at position (num_cls() before the call)+X
+    void add_cls(const vector<ClOffset>& offs);
+
+    uint32_t num_cls() const
+    {
+        return start.size()-1;
+    }
+
+    double mem_used() const;
+
+    const Solver* solver;
+    vector<Lit> lits;
+    vector<uint32_t> start;
+    vector<lbool> assigns;
+    const watch_array& watches;
+};
+
+/**
+@brief Unit propagation over a PropSnapshot with a private trail
+
+Every instance has its own copy of the literals, so it can keep its own
+two-watched-literal scheme over the snapshot.
+*/
+class SnapshotProp
+{
+public:
+    explicit SnapshotProp(const PropSnapshot& snap);
+
+    void enqueue(const Lit lit, const bool long_reason = false);
+    //Returns FALSE on conflict. Clause 'skip' is treated as not being there
+    bool propagate(const uint32_t skip = std::numeric_limits<uint32_t>::max());
+    void new_decision_level();
+    void cancel_until(const uint32_t level);
+
+    uint32_t decisionLevel() const
+    {
+        return trail_lim.size();
+    }
+
+    lbool value(const Lit lit) const
+    {
+        return assigns[lit.var()] ^ lit.sign();
+    }
+
+    double mem_used() const;
+    uint64_t bogoprops = 0;
+
+protected:
+    const PropSnapshot& snap;
+    vector<Lit> trail;
+    //Set if the literal on the trail was propagated by a long clause
+    vector<char> trail_long;
+    vector<uint32_t> trail_lim;
+
+private:
+    vector<Lit> lits;
+    vector<vector<uint32_t> > watches;
+    vector<lbool> assigns;
+    uint32_t qhead = 0;
+};
+
+} //end namespace
+
+#endif //__SNAPSHOTPROP_H__
@@ -82,6 +82,33 @@ void SolutionExtender::extend()
     solver->varReplacer->extend_model_set_undef();
 }
 
+void SolutionExtender::extend_vars(const vector<uint32_t>& outer_vars)
+{
+    if (solver->conf.verbosity >= 10) {
+        cout << "c Exteding solution to " << outer_vars.size()
+        << " vars -- SolutionExtender::extend_vars()" << endl;
+    }
+
+    if (simplifier) {
+        simplifier->extend_model_for(this, outer_vars);
+    }
+
+    for(const uint32_t var: outer_vars) {
+        const Lit rep = solver->varReplacer->get_lit_replaced_with_outer(Lit(var, false));
+        if (solver->model_value(rep.var()) == l_Undef
+            && ((rep.var() < solver->undef_must_set_vars.size()
+                    && solver->undef_must_set_vars[rep.var()])
+                || solver->varReplacer->var_is_replacing(rep.var()))
+        ) {
+            solver->model[rep.var()] = l_False;
+        }
+
+        if (rep.var() != var && solver->model_value(var) == l_Undef) {
+            solver->model[var] = solver->model[rep.var()] ^ rep.sign();
+        }
+    }
+}
+
 inline bool SolutionExtender::satisfied(const vector< Lit >& lits) const
 {
     for(const Lit lit: lits) {
@@ -41,6 +41,8 @@ class SolutionExtender
     public:
         SolutionExtender(Solver* _solver, OccSimplifier* simplifier);
         void extend();
+        //Only extends to these (outer) variables, see OccSimplifier::extend_model_for
+        void extend_vars(const vector<uint32_t>& outer_vars);
         bool addClause(const vector<Lit>& lits, const uint32_t blockedOn);
         void dummyBlocked(const uint32_t blockedOn);
 
@@ -56,6 +56,7 @@ THE SOFTWARE.
 #include "sccfinder.h"
 #include "intree.h"
 #include "satzilla_features_calc.h"
+#include "eventtrace.h"
 #include "GitSHA1.h"
 #include "satzilla_features_to_reconf.h"
 #include "trim.h"
@@ -68,6 +69,7 @@ THE SOFTWARE.
 #include "sls.h"
 #include "matrixfinder.h"
 #include "lucky.h"
+#include "inprocessscheduler.h"
 
 #ifdef USE_BREAKID
 #include "cms_breakid.h"
@@ -91,7 +93,7 @@ using std::endl;
 
 //#define DEBUG_IMPLICIT_PAIRS_TRIPLETS
 
-Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter, bool is_mpi) :
+Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter) :
     Searcher(_conf, this, _must_interrupt_inter)
 {
     sqlStats = NULL;
@@ -120,9 +122,14 @@ Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter
     if (conf.doStrSubImplicit) {
         subsumeImplicit = new SubsumeImplicit(this);
     }
-    datasync = new DataSync(this, NULL, is_mpi);
+    datasync = new DataSync(this, NULL);
     Searcher::solver = this;
     reduceDB = new ReduceDB(this);
+    inprocess_sched = new InprocessScheduler(this);
+    satzilla_calc = new SatZillaFeaturesCalc(this);
+    if (conf.trace_events) {
+        trace = new EventTrace(conf.thread_num, conf.trace_events);
+    }
 
     set_up_sql_writer();
     next_lev1_reduce = conf.every_lev1_reduce;
@@ -148,6 +155,9 @@ Solver::~Solver()
     delete subsumeImplicit;
     delete datasync;
     delete reduceDB;
+    delete inprocess_sched;
+    delete satzilla_calc;
+    delete trace;
 #ifdef USE_BREAKID
     delete breakid;
 #endif
@@ -1359,11 +1369,26 @@ void Solver::extend_solution(const bool only_sampling_solution)
         compHandler->addSavedState(model);
     }
 
-    if (!only_sampling_solution) {
+    if (only_sampling_solution || conf.extend_vars) {
+        vector<uint32_t> outer_vars;
+        const vector<uint32_t>& outside_vars =
+            only_sampling_solution ? *conf.sampling_vars : *conf.extend_vars;
+        for(const uint32_t var: outside_vars) {
+            if (get_num_bva_vars() > 0 || !fresh_solver) {
+                outer_vars.push_back(map_to_with_bva(var));
+            } else {
+                outer_vars.push_back(var);
+            }
+        }
+        for(const AssumptionPair& lit_pair: assumptions) {
+            outer_vars.push_back(lit_pair.lit_outer.var());
+        }
+
         SolutionExtender extender(this, occsimplifier);
-        extender.extend();
+        extender.extend_vars(outer_vars);
     } else {
-        varReplacer->extend_model_already_set();
+        SolutionExtender extender(this, occsimplifier);
+        extender.extend();
     }
 
     //map back without BVA
@@ -1524,6 +1549,7 @@ void Solver::check_and_upd_config_parameters()
 
 lbool Solver::simplify_problem_outside()
 {
+    phase_timer.start(cpuTime());
     #ifdef SLOW_DEBUG
     if (ok) {
         assert(check_order_heap_sanity());
@@ -1565,6 +1591,7 @@ lbool Solver::simplify_problem_outside()
     unfill_assumptions_set();
     assumptions.clear();
     conf.conf_needed = true;
+    phase_timer.stop(cpuTime());
     return status;
 }
 
@@ -1572,6 +1599,7 @@ lbool Solver::solve_with_assumptions(
     const vector<Lit>* _assumptions,
     const bool only_sampling_solution
 ) {
+    phase_timer.start(cpuTime());
     longest_trail_ever = 0; //reset: probably new clauses, changed assumptions
     fresh_solver = false;
     move_to_outside_assumps(_assumptions);
@@ -1587,6 +1615,7 @@ lbool Solver::solve_with_assumptions(
 
     solveStats.num_solve_calls++;
     check_and_upd_config_parameters();
+    datasync->dist_start();
 
     //Reset parameters
     luby_loop_num = 0;
@@ -1693,10 +1722,31 @@ lbool Solver::solve_with_assumptions(
     conf.conf_needed = true;
     assert(decisionLevel()== 0);
     assert(!ok || solver->prop_at_head());
+    phase_timer.stop(cpuTime());
 
     return status;
 }
 
+Solver::InprocessStart Solver::inprocess_start() const
+{
+    InprocessStart s;
+    s.time = PhaseTimer::now();
+    s.bogoprops = propStats.bogoProps + propStats.otfHyperTime;
+    return s;
+}
+
+void Solver::inprocess_finish(const string& name, const InprocessStart& start)
+{
+    phase_timer.add_technique(name, start.time);
+    if (!trace) {
+        return;
+    }
+
+    const uint64_t bogoprops = propStats.bogoProps + propStats.otfHyperTime;
+    trace->span(TraceType::inprocess, name, start.time, sumConflicts
+        , bogoprops - start.bogoprops);
+}
+
 void Solver::check_reconfigure()
 {
     if (nVars() > 2
@@ -1706,8 +1756,9 @@ void Solver::check_reconfigure()
         if (solveStats.num_simplify == conf.reconfigure_at &&
             !already_reconfigured
         ) {
-            check_calc_satzilla_features();
             if (conf.reconfigure_val == 100) {
+                //Must be calculated even if features are not collected
+                last_solve_satzilla_feature = calculate_satzilla_features();
                 conf.reconfigure_val = get_reconf_from_satzilla_features(last_solve_satzilla_feature, conf.verbosity);
             }
             if (conf.reconfigure_val != 0) {
@@ -2010,7 +2061,14 @@ lbool Solver::execute_inprocess_strategy(
                     cout << "c --> Executing OCC strategy token(s): '"
                     << occ_strategy_tokens << "'\n";
                 }
-                occsimplifier->simplify(startup, occ_strategy_tokens);
+                const int occ_at = inprocess_sched->find_technique("occ");
+                if (inprocess_sched->should_run(occ_at)) {
+                    const InprocessStart tstart = inprocess_start();
+                    inprocess_sched->start(occ_at);
+                    occsimplifier->simplify(startup, occ_strategy_tokens);
+                    inprocess_sched->finish(occ_at);
+                    inprocess_finish("occ", tstart);
+                }
             }
             occ_strategy_tokens.clear();
             if (sumConflicts >= (uint64_t)conf.max_confl
@@ -2027,10 +2085,20 @@ lbool Solver::execute_inprocess_strategy(
             #endif
         }
 
+        const int sched_at = inprocess_sched->find_technique(token);
+        if (sched_at != -1 && !inprocess_sched->should_run(sched_at)) {
+            continue;
+        }
+
         if (conf.verbosity && token.substr(0,3) != "occ" && token != "") {
             cout << "c --> Executing strategy token: " << token << '\n';
         }
 
+        const InprocessStart tstart = inprocess_start();
+        if (sched_at != -1) {
+            inprocess_sched->start(sched_at);
+        }
+
         if (token == "find-comps" &&
             conf.sampling_vars == NULL //no point finding, cannot be handled
         ) {
@@ -2073,7 +2141,12 @@ lbool Solver::execute_inprocess_strategy(
                 && solveStats.num_simplify % conf.sls_every_n == (conf.sls_every_n-1)
             ) {
                 SLS sls(this);
+                const InprocessStart sls_start = inprocess_start();
                 const lbool ret = sls.run(num_sls_called);
+                if (trace) {
+                    trace->span(TraceType::sls, "sls", sls_start.time
+                        , sumConflicts, num_sls_called);
+                }
                 num_sls_called++;
                 if (ret == l_True) {
                     return l_Undef;
@@ -2157,6 +2230,13 @@ lbool Solver::execute_inprocess_strategy(
             exit(-1);
         }
 
+        if (sched_at != -1) {
+            inprocess_sched->finish(sched_at);
+        }
+        if (token != "" && token.substr(0,3) != "occ") {
+            inprocess_finish(token, tstart);
+        }
+
         #ifdef SLOW_DEBUG
         check_stats();
         #endif
@@ -2191,6 +2271,7 @@ lbool Solver::simplify_problem(const bool startup)
     if (solveStats.num_simplify_this_solve_call >= conf.max_num_simplify_per_solve_call) {
         return l_Undef;
     }
+    PhaseScope phase(phase_timer, PhaseTimer::inprocess);
 
     lbool ret = l_Undef;
     if (!okay()) {
@@ -2203,7 +2284,7 @@ lbool Solver::simplify_problem(const bool startup)
     if (ret == l_Undef && !fully_undo_xor_detach()) {
         ret = l_False;
     }
-    clear_gauss_matrices();
+    clear_gauss_matrices(true);
     #endif
 
     if (conf.verbosity >= 6) {
@@ -2219,6 +2300,7 @@ lbool Solver::simplify_problem(const bool startup)
             ret = execute_inprocess_strategy(startup, conf.simplify_schedule_nonstartup);
         }
     }
+    inprocess_sched->end_round();
     assert(ret != l_True);
 
     //Free unused watch memory
@@ -2424,6 +2506,10 @@ void Solver::print_norm_stats(const double cpu_time, const double cpu_time_total
                     , stats_line_percent(dist_long_with_impl->get_stats().redWatchBased.cpu_time, cpu_time)
                     , "% time"
     );
+    inprocess_sched->print_stats(cpu_time);
+    if (conf.do_print_times) {
+        phase_timer.print_stats();
+    }
 
     if (conf.do_print_times) {
         print_stats_line("c Conflicts in UIP"
@@ -2519,6 +2605,10 @@ void Solver::print_full_restart_stat(const double cpu_time, const double cpu_tim
     if (conf.doStrSubImplicit) {
         subsumeImplicit->get_stats().print("");
     }
+    inprocess_sched->print_stats(cpu_time);
+    if (conf.do_print_times) {
+        phase_timer.print_stats();
+    }
 
     //Other stats
     if (conf.do_print_times) {
@@ -2552,9 +2642,97 @@ uint64_t Solver::print_watch_mem_used(const uint64_t rss_mem_used) const
         , "%"
     );
 
+    if (watches.get_pool()) {
+        const WatchPoolStats& st = watches.get_pool()->get_stats();
+        print_stats_line("c Watch pool used"
+            , st.used_bytes/(1024UL*1024UL)
+            , "MB"
+            , stats_line_percent(st.used_bytes, st.chunk_bytes)
+            , "% of slab"
+        );
+        print_stats_line("c Watch pool large lists"
+            , st.large_bytes/(1024UL*1024UL)
+            , "MB"
+        );
+        print_stats_line("c Watch pool relocations"
+            , st.relocations
+            , st.compactions
+            , "compactions"
+        );
+    }
+
     return alloc + array;
 }
 
+//Only informative, the memory is already accounted for by the users of the pages
+void Solver::print_page_stats(const uint64_t rss_mem_used) const
+{
+    const PageStats& st = cl_alloc.get_pages().get_stats();
+    print_stats_line("c Clause mem mmap-ed"
+        , st.mapped/(1024UL*1024UL)
+        , "MB"
+        , stats_line_percent(st.mapped, rss_mem_used)
+        , "%"
+    );
+    print_stats_line("c Clause mem THP advised"
+        , st.transparent/(1024UL*1024UL)
+        , "MB"
+        , stats_line_percent(st.transparent, st.mapped)
+        , "% of mmap"
+    );
+    print_stats_line("c Clause mem 2MB/1GB pages"
+        , (st.huge_2m + st.huge_1g)/(1024UL*1024UL)
+        , "MB"
+        , stats_line_percent(st.huge_2m + st.huge_1g, st.mapped)
+        , "% of mmap"
+    );
+    if (cl_alloc.get_pages().get_numa_node() >= 0) {
+        print_stats_line("c Clause mem NUMA-bound"
+            , st.numa_bound/(1024UL*1024UL)
+            , "MB"
+            , cl_alloc.get_pages().get_numa_node()
+            , "node"
+        );
+    }
+    if (st.hugetlb_failed > 0) {
+        print_stats_line("c Clause mem hugetlb failed"
+            , st.hugetlb_failed
+            , "times"
+        );
+    }
+
+    const uint64_t anon_huge = process_anon_huge_bytes();
+    print_stats_line("c Mem in THP (process)"
+        , anon_huge/(1024UL*1024UL)
+        , "MB"
+        , stats_line_percent(anon_huge, rss_mem_used)
+        , "%"
+    );
+}
+
+void Solver::place_on_numa_node()
+{
+    if (!conf.numa_place) {
+        return;
+    }
+
+    const int node = conf.thread_num % num_numa_nodes();
+    if (!bind_thread_to_numa_node(node)) {
+        if (conf.verbosity) {
+            cout << "c [numa] could not bind thread " << conf.thread_num
+            << " to node " << node << endl;
+        }
+        return;
+    }
+    cl_alloc.get_pages().set_numa_node(node);
+    if (watches.get_pool()) {
+        watches.get_pool()->get_pages().set_numa_node(node);
+    }
+    if (conf.verbosity >= 2) {
+        cout << "c [numa] thread " << conf.thread_num << " bound to node " << node << endl;
+    }
+}
+
 size_t Solver::mem_used() const
 {
     size_t mem = 0;
@@ -2584,6 +2762,7 @@ void Solver::print_mem_stats() const
     uint64_t account = 0;
 
     account += print_mem_used_longclauses(rss_mem_used);
+    print_page_stats(rss_mem_used);
     account += print_watch_mem_used(rss_mem_used);
 
     size_t mem = 0;
@@ -3122,6 +3301,11 @@ bool Solver::add_clause_outer(const vector<Lit>& lits, bool red)
     check_too_large_variable_number(lits);
     #endif
     back_number_from_outside_to_outer(lits);
+
+    //Large inputs may need a larger offset shift already while loading
+    if (cl_alloc.near_limit() && decisionLevel() == 0) {
+        cl_alloc.consolidate(this);
+    }
     return addClauseInt(back_number_from_outside_to_outer_tmp, red);
 }
 
@@ -3304,8 +3488,7 @@ uint32_t Solver::num_active_vars() const
 SatZillaFeatures Solver::calculate_satzilla_features()
 {
     latest_satzilla_feature_calc++;
-    SatZillaFeaturesCalc extract(this);
-    SatZillaFeatures satzilla_feat = extract.extract();
+    SatZillaFeatures satzilla_feat = satzilla_calc->extract();
     satzilla_feat.avg_confl_size = hist.conflSizeHistLT.avg();
     satzilla_feat.avg_confl_glue = hist.glueHistLT.avg();
     satzilla_feat.avg_num_resolutions = hist.numResolutionsHistLT.avg();
@@ -3869,9 +4052,10 @@ bool Solver::find_and_init_all_matrices()
     if (conf.verbosity >= 1) {
         cout << "c [find&init matx] performing matrix init" << endl;
     }
+    const double myTime = cpuTime();
 
     bool can_detach;
-    clear_gauss_matrices();
+    clear_gauss_matrices(true);
     gqhead = trail.size();
 
     /*Reattach needed in case we are coming in again, after adding new XORs
@@ -3887,6 +4071,7 @@ bool Solver::find_and_init_all_matrices()
     if (!ok) {
         return false;
     }
+    reuse_kept_matrices();
 
     if (!init_all_matrices()) {
         return false;
@@ -3952,10 +4137,36 @@ bool Solver::find_and_init_all_matrices()
     }
     #endif
 
+    if (conf.verbosity >= 1) {
+        cout << "c [find&init matx] matrices: " << gmatrices.size()
+        << conf.print_times(cpuTime() - myTime) << endl;
+    }
     xor_clauses_updated = false;
     return true;
 }
 
+//Matrices kept from the last init that can take the new XORs through row
+//updates replace the freshly found ones. The rest are dropped.
+void Solver::reuse_kept_matrices()
+{
+    for(uint32_t i = 0; i < gmatrices.size(); i++) {
+        for(EGaussian*& kept: gmatrices_kept) {
+            if (kept != NULL && kept->can_reuse_for(gmatrices[i]->xorclauses)) {
+                kept->reuse_for(gmatrices[i]->xorclauses, i);
+                delete gmatrices[i];
+                gmatrices[i] = kept;
+                kept = NULL;
+                break;
+            }
+        }
+    }
+
+    for(EGaussian* g: gmatrices_kept) {
+        delete g;
+    }
+    gmatrices_kept.clear();
+}
+
 bool Solver::init_all_matrices()
 {
     assert(ok);
@@ -3981,6 +4192,10 @@ bool Solver::init_all_matrices()
             }
             g = NULL;
         }
+        if (trace) {
+            trace->instant(created ? TraceType::gauss_on : TraceType::gauss_off
+                , "matrix", sumConflicts, i);
+        }
     }
 
     uint32_t j = 0;
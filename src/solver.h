@@ -66,6 +66,10 @@ class SharedData;
 class ReduceDB;
 class InTree;
 class BreakID;
+class InprocessScheduler;
+struct SatZillaFeaturesCalc;
+class EventTrace;
+class TraceDumpRequest;
 
 struct SolveStats
 {
@@ -78,8 +82,7 @@ class Solver : public Searcher
 {
     public:
         Solver(const SolverConf *_conf = NULL,
-               std::atomic<bool>* _must_interrupt_inter = NULL,
-               bool is_mpi = false);
+               std::atomic<bool>* _must_interrupt_inter = NULL);
         ~Solver() override;
 
         void add_sql_tag(const string& name, const string& val);
@@ -141,6 +144,8 @@ class Solver : public Searcher
         uint32_t num_active_vars() const;
         void print_mem_stats() const;
         uint64_t print_watch_mem_used(uint64_t totalMem) const;
+        void print_page_stats(uint64_t totalMem) const;
+        void place_on_numa_node();
         const SolveStats& get_solve_stats() const;
         const SearchStats& get_stats() const;
         void add_in_partial_solving_stats();
@@ -168,6 +173,10 @@ class Solver : public Searcher
         StrImplWImpl* dist_impl_with_impl = NULL;
         CompHandler*           compHandler = NULL;
         CardFinder*            card_finder = NULL;
+        InprocessScheduler*    inprocess_sched = NULL;
+        SatZillaFeaturesCalc*  satzilla_calc = NULL;
+        EventTrace*            trace = NULL;
+        TraceDumpRequest*      trace_dump = NULL; ///<Owned by SATSolver
 
         SearchStats sumSearchStats;
         PropStats sumPropStats;
@@ -260,6 +269,7 @@ class Solver : public Searcher
 
         #ifdef USE_GAUSS
         bool init_all_matrices();
+        void reuse_kept_matrices();
         void detach_xor_clauses(
             const set<uint32_t>& clash_vars_unused
         );
@@ -299,6 +309,9 @@ class Solver : public Searcher
 
     private:
         friend class ClauseDumper;
+        friend class Lookahead;
+        friend class Enumerator;
+        friend class ModelCounter;
         #ifdef CMS_TESTING_ENABLED
         FRIEND_TEST(SearcherTest, pickpolar_auto_not_changed_by_simp);
         #endif
@@ -319,6 +332,15 @@ class Solver : public Searcher
             , const bool sorted = false
         );
         void set_up_sql_writer();
+
+        //Per-technique time and event trace of inprocessing steps
+        struct InprocessStart {
+            uint64_t time = 0;
+            uint64_t bogoprops = 0;
+        };
+        InprocessStart inprocess_start() const;
+        void inprocess_finish(const string& name, const InprocessStart& start);
+
         vector<std::pair<string, string> > sql_tags;
 
         void check_and_upd_config_parameters();
@@ -87,6 +87,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , every_lev3_reduce(10000)
         #endif
         , must_touch_lev1_within(70000)
+        , reducedb_threads(1)
 
         , max_temp_lev2_learnt_clauses(30000) //only used if every_lev2_reduce==0
         , inc_max_temp_lev2_red_cls(1.0)      //only used if every_lev2_reduce==0
@@ -165,6 +166,10 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , dump_individual_restarts_and_clauses(true)
         , dump_individual_cldata_ratio(0.01)
         , sql_overwrite_file(0)
+        , sql_async(1)
+        , sql_queue_rows(16*1024)
+        , sql_batch_rows(20000)
+        , sql_drop_when_full(0)
         , lock_for_data_gen_ratio(0.1)
 
         //Var-elim
@@ -227,6 +232,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , doTransRed       (true)
         , intree_time_limitM(1200ULL)
         , intree_scc_varreplace_time_limitM(30ULL)
+        , intree_threads(1)
         , do_hyperbin_and_transred(true)
 
         //XOR
@@ -234,7 +240,11 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxXorToFind     (7)
         , maxXorToFindSlow (5)
         , maxXORMatrix     (400ULL)
+        , xor_dense_density(0.05)
+        , xor_sparse_gauss_time_limitM(100)
         , xor_finder_time_limitM(400)
+        , xor_find_buckets(true)
+        , xor_find_threads(1)
         , allow_elim_xor_vars(1)
         , xor_var_per_cut(2)
         , force_preserve_xors(false)
@@ -253,6 +263,9 @@ DLL_PUBLIC SolverConf::SolverConf() :
         //Var-replacer
         , doFindAndReplaceEqLits(true)
         , max_scc_depth (10000)
+        , scc_incremental(true)
+        , scc_threads(1)
+        , scc_par_min_cls(10000)
 
         //Iterative Alo Scheduling
         , simplify_at_startup(false)
@@ -314,6 +327,11 @@ DLL_PUBLIC SolverConf::SolverConf() :
             "intree-probe, "
             "must-renumber"
         )
+        , do_inprocess_sched_adapt(false)
+        , inprocess_sched_min_mult(0.25)
+        , inprocess_sched_max_mult(4.0)
+        , inprocess_sched_unproductive_drop(2)
+        , inprocess_sched_max_skip(16)
 
         //Occur based simplification
         , perform_occur_based_simp(true)
@@ -346,12 +364,18 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , distill_increase_conf_ratio(0.02)
         , distill_min_confl(10000)
         , distill_red_tier1_ratio(0.03)
+        , distill_threads(1)
+        , distill_par_batch(2000)
 
         //Memory savings
         , doRenumberVars   (true)
         , must_renumber    (false)
         , doSaveMem        (true)
         , full_watch_consolidate_every_n_confl (4ULL*1000ULL*1000ULL) //validated in run 8113323.wlm01
+        , cl_offset_shift(0) //grown automatically when the clause arena nears the limit
+        , huge_pages(0)
+        , numa_place(0)
+        , watch_pool(0)
 
         //Component finding
         , doCompHandler    (false)
@@ -381,6 +405,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Sampling
         , sampling_vars(NULL)
+        , extend_vars(NULL)
+        , count_cache_mb(2048)
 
         //Timeouts
         , orig_global_timeout_multiplier(3.0)
@@ -389,14 +415,29 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , global_multiplier_multiplier_max(3)
         , var_and_mem_out_mult(1.0)
 
-        //Multi-thread, MPI
+        //Multi-thread, distributed
         , sync_every_confl(20000)
         , thread_num(0)
+        , dist_host("")
+        , dist_port(5100)
+        , dist_sync_every_confl(2000)
+        , dist_max_glue(2)
+        , dist_max_size(30)
+
+        //Cube-and-conquer
+        , cube_and_conquer(false)
+        , cube_depth(0)
+        , cube_lookahead_vars(64)
+        , cube_confl_budget(20000)
+        , cube_resplit_depth(2)
+        , cube_lookahead_time_limitM(100)
 
         //misc
         , origSeed(0)
         , reconfigure_val(0)
         , reconfigure_at(2)
+        , satzilla_threads(1)
+        , trace_events(0)
         , preprocess(0)
         , simulate_drat(false)
         , saved_state_file("savedstate.dat")
@@ -209,6 +209,10 @@ class GaussConf
     bool doMatrixFind = true;
     uint32_t min_gauss_xor_clauses = 2;
     uint32_t max_gauss_xor_clauses = 500000;
+
+    //Matrix reuse across inprocessing and solve calls
+    bool keep_matrices = true;
+    double rebuild_ratio = 0.5; ///<Rebuild if this ratio of columns is unused, or of rows is new
 };
 
 class DLL_PUBLIC SolverConf
@@ -256,6 +260,7 @@ class DLL_PUBLIC SolverConf
         #endif
 
         uint32_t must_touch_lev1_within;
+        unsigned reducedb_threads;
         unsigned  max_temp_lev2_learnt_clauses;
         double    inc_max_temp_lev2_red_cls;
 
@@ -326,6 +331,10 @@ class DLL_PUBLIC SolverConf
         bool      dump_individual_restarts_and_clauses;
         double    dump_individual_cldata_ratio;
         int       sql_overwrite_file;
+        int       sql_async;
+        uint32_t  sql_queue_rows;
+        uint32_t  sql_batch_rows;
+        int       sql_drop_when_full;
         double    lock_for_data_gen_ratio;
 
         //Steps
@@ -388,6 +397,7 @@ class DLL_PUBLIC SolverConf
         int      doTransRed;   ///<carry out transitive reduction
         unsigned long long   intree_time_limitM;
         unsigned long long intree_scc_varreplace_time_limitM;
+        unsigned intree_threads;
         int       do_hyperbin_and_transred;
 
         //XORs
@@ -395,7 +405,11 @@ class DLL_PUBLIC SolverConf
         unsigned maxXorToFind;
         unsigned maxXorToFindSlow;
         uint64_t maxXORMatrix;
+        double   xor_dense_density; ///<Blocks at least this dense are echelonized with M4RI
+        long long xor_sparse_gauss_time_limitM;
         uint64_t xor_finder_time_limitM;
+        int      xor_find_buckets; ///<Find fully encoded XORs by grouping clauses first
+        unsigned xor_find_threads;
         int      allow_elim_xor_vars;
         unsigned xor_var_per_cut;
         int      force_preserve_xors;
@@ -414,6 +428,11 @@ class DLL_PUBLIC SolverConf
         //Var-replacement
         int doFindAndReplaceEqLits;
         int max_scc_depth;
+        int scc_incremental;
+        unsigned scc_threads;
+        //Starting a thread costs about as much as replacing the literals of
+        //10K clauses, smaller clause lists are replaced on one thread
+        unsigned scc_par_min_cls;
 
         //Iterative Alo Scheduling
         int      simplify_at_startup; //simplify at 1st startup (only)
@@ -428,6 +447,11 @@ class DLL_PUBLIC SolverConf
         string   simplify_schedule_startup;
         string   simplify_schedule_nonstartup;
         string   simplify_schedule_preproc;
+        int      do_inprocess_sched_adapt;
+        double   inprocess_sched_min_mult;
+        double   inprocess_sched_max_mult;
+        uint32_t inprocess_sched_unproductive_drop;
+        uint32_t inprocess_sched_max_skip;
 
         //Simplification
         int      perform_occur_based_simp;
@@ -460,12 +484,18 @@ class DLL_PUBLIC SolverConf
         double distill_increase_conf_ratio;
         long distill_min_confl;
         double distill_red_tier1_ratio;
+        unsigned distill_threads;
+        uint32_t distill_par_batch;
 
         //Memory savings
         int       doRenumberVars;
         int       must_renumber; ///< if set, all "renumber" is treated as a "must-renumber"
         int       doSaveMem;
         uint64_t  full_watch_consolidate_every_n_confl;
+        unsigned  cl_offset_shift;
+        unsigned  huge_pages;
+        int       numa_place;
+        int       watch_pool;
 
         //Component handling
         int       doCompHandler;
@@ -497,6 +527,8 @@ class DLL_PUBLIC SolverConf
 
         //Sampling
         std::vector<uint32_t>* sampling_vars;
+        std::vector<uint32_t>* extend_vars; //if set, models only have these
+        unsigned count_cache_mb; //component cache of the exact model counter
 
         //Timeouts
         double orig_global_timeout_multiplier;
@@ -505,14 +537,29 @@ class DLL_PUBLIC SolverConf
         double global_multiplier_multiplier_max;
         double var_and_mem_out_mult;
 
-        //Multi-thread, MPI
+        //Multi-thread, distributed
         unsigned long long sync_every_confl;
         unsigned thread_num;
+        std::string dist_host; //coordinator to connect to. Empty: not a worker
+        unsigned dist_port;
+        unsigned long long dist_sync_every_confl;
+        unsigned dist_max_glue;
+        unsigned dist_max_size;
+
+        //Cube-and-conquer
+        int      cube_and_conquer;
+        unsigned cube_depth; //0 means depth is picked from the number of threads
+        unsigned cube_lookahead_vars; //candidate variables probed per split
+        unsigned long long cube_confl_budget; //conflicts before a cube is re-split
+        unsigned cube_resplit_depth;
+        double   cube_lookahead_time_limitM;
 
         //Misc
         unsigned origSeed;
         unsigned reconfigure_val;
         unsigned reconfigure_at;
+        unsigned satzilla_threads;
+        unsigned trace_events;
         unsigned preprocess;
         int      simulate_drat;
         int      conf_needed = true;
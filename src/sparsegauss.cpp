@@ -0,0 +1,228 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "sparsegauss.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace CMSat;
+
+//Number of light rows looked at when choosing the next pivot
+static const size_t markowitz_cands = 4;
+
+SparseGauss::SparseGauss(const uint32_t num_cols) :
+    col_rows(num_cols)
+    , col_weight(num_cols, 0)
+{
+}
+
+void SparseGauss::add_row(const vector<uint32_t>& cols, const bool rhs)
+{
+    tmp = cols;
+    std::sort(tmp.begin(), tmp.end());
+
+    //x+x = 0
+    size_t j = 0;
+    for(size_t i = 0; i < tmp.size(); i++) {
+        if (i+1 < tmp.size() && tmp[i] == tmp[i+1]) {
+            i++;
+            continue;
+        }
+        tmp[j++] = tmp[i];
+    }
+    tmp.resize(j);
+
+    if (tmp.empty()) {
+        if (rhs) {
+            unsat = true;
+        }
+        return;
+    }
+
+    const uint32_t r = rows.size();
+    rows.push_back(Row());
+    rows.back().cols = tmp;
+    rows.back().rhs = rhs;
+    for(const uint32_t c: tmp) {
+        col_rows[c].push_back(r);
+        col_weight[c]++;
+    }
+    stats.nonzeros += tmp.size();
+}
+
+//Lightest column that is in some other row too. Columns only in this row
+//are kept free, pivoting on them would never combine the row with the
+//others, hiding the short rows these combinations give
+uint32_t SparseGauss::pick_pivot_col(const uint32_t r) const
+{
+    uint32_t best = rows[r].cols[0];
+    for(const uint32_t c: rows[r].cols) {
+        if (col_weight[best] == 1
+            || (col_weight[c] > 1 && col_weight[c] < col_weight[best])
+        ) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+void SparseGauss::remove_row(const uint32_t r)
+{
+    rows[r].cols.clear();
+    rows[r].rhs = false;
+    rows[r].removed = true;
+}
+
+void SparseGauss::xor_into(const uint32_t src, const uint32_t dst)
+{
+    const vector<uint32_t>& a = rows[src].cols;
+    const vector<uint32_t>& b = rows[dst].cols;
+    stats.row_xors++;
+    stats.work += a.size() + b.size();
+
+    tmp.clear();
+    size_t i = 0;
+    size_t j = 0;
+    while(i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && a[i] < b[j])) {
+            //New in dst
+            const uint32_t c = a[i++];
+            tmp.push_back(c);
+            col_weight[c]++;
+            col_rows[c].push_back(dst);
+            stats.fill_in++;
+        } else if (i == a.size() || b[j] < a[i]) {
+            tmp.push_back(b[j++]);
+        } else {
+            //Cancels out, col_rows[c] is cleaned up lazily
+            col_weight[a[i]]--;
+            i++;
+            j++;
+        }
+    }
+    rows[dst].cols.swap(tmp);
+    rows[dst].rhs ^= rows[src].rhs;
+
+    if (rows[dst].cols.empty()) {
+        if (rows[dst].rhs) {
+            unsat = true;
+        }
+        remove_row(dst);
+    } else if (!rows[dst].pivot) {
+        const size_t w = rows[dst].cols.size();
+        if (by_weight.size() <= w) {
+            by_weight.resize(w+1);
+        }
+        by_weight[w].push_back(dst);
+    }
+}
+
+bool SparseGauss::eliminate(int64_t work_limit)
+{
+    by_weight.clear();
+    for(uint32_t r = 0; r < rows.size(); r++) {
+        if (rows[r].pivot || rows[r].removed) {
+            continue;
+        }
+        const size_t w = rows[r].cols.size();
+        if (by_weight.size() <= w) {
+            by_weight.resize(w+1);
+        }
+        by_weight[w].push_back(r);
+    }
+
+    vector<uint32_t> cands;
+    while(!unsat) {
+        if (stats.work > work_limit) {
+            return false;
+        }
+
+        //Take the lightest few rows. Buckets may hold stale entries of
+        //rows that changed weight, or are already pivots
+        cands.clear();
+        for(size_t w = 1
+            ; w < by_weight.size() && cands.size() < markowitz_cands
+            ; w++
+        ) {
+            vector<uint32_t>& bucket = by_weight[w];
+            while(!bucket.empty() && cands.size() < markowitz_cands) {
+                const uint32_t r = bucket.back();
+                bucket.pop_back();
+                if (rows[r].pivot
+                    || rows[r].removed
+                    || rows[r].cols.size() != w
+                    || std::find(cands.begin(), cands.end(), r) != cands.end()
+                ) {
+                    continue;
+                }
+                cands.push_back(r);
+            }
+        }
+        if (cands.empty()) {
+            break;
+        }
+
+        //Markowitz: least (row weight-1)*(col weight-1)
+        uint32_t piv_row = cands[0];
+        uint32_t piv_col = pick_pivot_col(cands[0]);
+        uint64_t best = std::numeric_limits<uint64_t>::max();
+        for(const uint32_t r: cands) {
+            const uint32_t c = pick_pivot_col(r);
+            const uint64_t cost = (uint64_t)(rows[r].cols.size()-1)
+                * (uint64_t)(col_weight[c]-1);
+            if (cost < best) {
+                best = cost;
+                piv_row = r;
+                piv_col = c;
+            }
+        }
+        for(const uint32_t r: cands) {
+            if (r != piv_row) {
+                by_weight[rows[r].cols.size()].push_back(r);
+            }
+        }
+
+        //Remove the pivot column from every other row, pivot rows included
+        rows[piv_row].pivot = true;
+        stats.pivots++;
+        vector<uint32_t> in_col;
+        in_col.swap(col_rows[piv_col]);
+        for(const uint32_t r: in_col) {
+            if (r == piv_row
+                || rows[r].removed
+                || !std::binary_search(rows[r].cols.begin(), rows[r].cols.end(), piv_col)
+            ) {
+                continue;
+            }
+            xor_into(piv_row, r);
+            if (unsat) {
+                break;
+            }
+        }
+        col_rows[piv_col].clear();
+        col_rows[piv_col].push_back(piv_row);
+        col_weight[piv_col] = 1;
+    }
+
+    return true;
+}
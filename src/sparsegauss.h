@@ -0,0 +1,128 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __SPARSEGAUSS_H__
+#define __SPARSEGAUSS_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace CMSat {
+
+using std::vector;
+using std::size_t;
+
+/**
+@brief Gauss-Jordan elimination over GF(2) on sparse rows
+
+Rows are kept as sorted column lists, together with the rows each column
+is in. Pivots are picked with the Markowitz rule: among the lightest
+rows, the column minimising (row weight-1)*(column weight-1), which bounds
+the fill-in of eliminating it. The pivot column is then removed from every
+other row, so the result is in reduced row echelon form.
+
+Every row is a sum of the original rows at any point, so the rows can be
+used even if the work limit stopped the elimination early.
+*/
+class SparseGauss
+{
+public:
+    explicit SparseGauss(const uint32_t num_cols);
+
+    //Columns may be in any order, duplicates cancel out
+    void add_row(const vector<uint32_t>& cols, const bool rhs);
+
+    //Returns false if the work limit was hit
+    bool eliminate(int64_t work_limit);
+
+    //An empty row with rhs 1 was found, the system has no solution
+    bool inconsistent() const;
+
+    size_t num_rows() const;
+    const vector<uint32_t>& row(const size_t i) const;
+    bool rhs(const size_t i) const;
+
+    struct Stats
+    {
+        uint64_t pivots = 0;
+        uint64_t row_xors = 0;
+        uint64_t fill_in = 0;
+        uint64_t nonzeros = 0;
+        int64_t work = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    uint32_t pick_pivot_col(const uint32_t r) const;
+    void xor_into(const uint32_t src, const uint32_t dst);
+    void remove_row(const uint32_t r);
+
+    struct Row
+    {
+        vector<uint32_t> cols;
+        bool rhs = false;
+        bool pivot = false;
+        bool removed = false;
+    };
+    vector<Row> rows;
+
+    //Rows each column may be in. May contain rows that no longer have the
+    //column, these are dropped when the column is eliminated
+    vector<vector<uint32_t> > col_rows;
+    vector<uint32_t> col_weight;
+
+    //Non-pivot rows, bucketed by their weight
+    vector<vector<uint32_t> > by_weight;
+    vector<uint32_t> tmp;
+    bool unsat = false;
+    Stats stats;
+};
+
+inline bool SparseGauss::inconsistent() const
+{
+    return unsat;
+}
+
+inline size_t SparseGauss::num_rows() const
+{
+    return rows.size();
+}
+
+inline const vector<uint32_t>& SparseGauss::row(const size_t i) const
+{
+    return rows[i].cols;
+}
+
+inline bool SparseGauss::rhs(const size_t i) const
+{
+    return rows[i].rhs;
+}
+
+inline const SparseGauss::Stats& SparseGauss::get_stats() const
+{
+    return stats;
+}
+
+}
+
+#endif //__SPARSEGAUSS_H__
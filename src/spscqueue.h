@@ -0,0 +1,122 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __SPSCQUEUE_H__
+#define __SPSCQUEUE_H__
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace CMSat {
+
+using std::vector;
+
+/**
+@brief Lock-free, bounded queue between exactly one producer and one consumer thread
+
+The slots are allocated once and reused, so elements that own memory (e.g.
+vectors) keep their capacity between uses. The producer fills the slot
+returned by start_push() in place and publishes it with finish_push(). The
+consumer reads front() and releases the slot with pop().
+*/
+template<class T>
+class SPSCQueue
+{
+public:
+    //The capacity is rounded up to a power of two
+    explicit SPSCQueue(size_t min_capacity) :
+        head(0)
+        , tail(0)
+    {
+        size_t cap = 2;
+        while(cap < min_capacity) {
+            cap *= 2;
+        }
+        slots.resize(cap);
+        mask = cap-1;
+    }
+
+    //Producer only. Returns NULL if the queue is full.
+    T* start_push()
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == slots.size()) {
+            return NULL;
+        }
+        return &slots[h & mask];
+    }
+
+    //Producer only, publishes the slot returned by start_push()
+    void finish_push()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //Consumer only. Returns NULL if the queue is empty.
+    T* front()
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return NULL;
+        }
+        return &slots[t & mask];
+    }
+
+    //Consumer only, releases the slot returned by front()
+    void pop()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    //Exact only when called from the producer or the consumer while the
+    //other side is idle
+    size_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    vector<T> slots;
+    size_t mask;
+
+    //Only ever increase, the slot is at (index & mask).
+    //Padded apart so the two threads don't fight over the same cache line.
+    std::atomic<size_t> head;
+    char pad[64];
+    std::atomic<size_t> tail;
+};
+
+} //end namespace
+
+#endif //__SPSCQUEUE_H__
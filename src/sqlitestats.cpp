@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <string>
 #include <cmath>
 #include <time.h>
+#include <chrono>
 #include "constants.h"
 #include "reducedb.h"
 #include "sql_tablestructure.h"
@@ -38,9 +39,9 @@ THE SOFTWARE.
 #define bind_null_or_double(stmt,bindat,stucture,func) \
 { \
     if (stucture.num_data_elements() == 0) {\
-        sqlite3_bind_null(stmt, bindat); \
+        bind_null(stmt, bindat); \
     } else { \
-        sqlite3_bind_double(stmt, bindat, stucture.func()); \
+        bind_double(stmt, bindat, stucture.func()); \
     }\
     bindat++; \
 }
@@ -48,9 +49,9 @@ THE SOFTWARE.
 #define bind_null_or_int(stmt,bindat,stucture,func) \
 { \
     if (stucture.num_data_elements() == 0) {\
-        sqlite3_bind_null(stmt, bindat); \
+        bind_null(stmt, bindat); \
     } else { \
-        sqlite3_bind_int(stmt, bindat, stucture.func()); \
+        bind_int(stmt, bindat, stucture.func()); \
     }\
     bindat++; \
 }
@@ -58,9 +59,9 @@ THE SOFTWARE.
 #define bind_null_or_int64(stmt,bindat,stucture,func) \
 { \
     if (stucture.num_data_elements() == 0) {\
-        sqlite3_bind_null(stmt, bindat); \
+        bind_null(stmt, bindat); \
     } else { \
-        sqlite3_bind_int64(stmt, bindat, stucture.func()); \
+        bind_int64(stmt, bindat, stucture.func()); \
     }\
     bindat++; \
 }
@@ -90,6 +91,7 @@ const char* rst_dat_type_to_str(rst_dat_type type) {
 
 SQLiteStats::SQLiteStats(std::string _filename) :
         filename(_filename)
+        , writer_stop(false)
 {
 }
 
@@ -137,6 +139,8 @@ SQLiteStats::~SQLiteStats()
     if (!setup_ok)
         return;
 
+    stop_writer();
+
     //Free all the prepared statements
     del_prepared_stmt(stmtRst);
     del_prepared_stmt(stmtVarRst);
@@ -145,6 +149,7 @@ SQLiteStats::~SQLiteStats()
     del_prepared_stmt(stmtReduceDB);
     del_prepared_stmt(stmtTimePassed);
     del_prepared_stmt(stmtMemUsed);
+    del_prepared_stmt(stmtInprocess);
     del_prepared_stmt(stmt_clause_stats);
     del_prepared_stmt(stmt_delete_cl);
     del_prepared_stmt(stmt_var_data_picktime);
@@ -175,6 +180,7 @@ bool SQLiteStats::setup(const Solver* solver)
     addStartupData();
     init("timepassed", &stmtTimePassed);
     init("memused", &stmtMemUsed);
+    init("inprocess", &stmtInprocess);
     init("satzilla_features", &stmtFeat);
     init("clause_stats", &stmt_clause_stats);
     init("restart", &stmtRst);
@@ -189,6 +195,10 @@ bool SQLiteStats::setup(const Solver* solver)
     init("var_dist", &stmt_var_dist);
     #endif
 
+    if (solver->conf.sql_async) {
+        start_writer(solver);
+    }
+
     return true;
 }
 
@@ -236,8 +246,14 @@ bool SQLiteStats::connectServer(const Solver* solver)
     return true;
 }
 
+//The writer thread does its own batching, so these are only needed
+//when writing synchronously
 void SQLiteStats::begin_transaction()
 {
+    if (queue) {
+        return;
+    }
+
     if (sqlite3_exec(db, "BEGIN TRANSACTION", NULL, NULL, NULL)) {
         cerr << "ERROR: Beginning SQLITE transaction" << endl;
         cerr << "c " << sqlite3_errmsg(db) << endl;
@@ -247,6 +263,10 @@ void SQLiteStats::begin_transaction()
 
 void SQLiteStats::end_transaction()
 {
+    if (queue) {
+        return;
+    }
+
     if (sqlite3_exec(db, "END TRANSACTION", NULL, NULL, NULL)) {
         cerr << "ERROR: Beginning SQLITE transaction" << endl;
         cerr << "c " << sqlite3_errmsg(db) << endl;
@@ -286,12 +306,7 @@ void SQLiteStats::add_tag(const std::pair<string, string>& tag)
     << ", '" << tag.second << "'"
     << ");";
 
-    //Inserting element into solverruns to get unique ID
-    if (sqlite3_exec(db, ss.str().c_str(), NULL, NULL, NULL)) {
-        cerr << "SQLite: ERROR Couldn't insert into table 'tags'" << endl;
-        assert(false);
-        std::exit(-1);
-    }
+    exec_sql(ss.str(), "tags");
 }
 
 void SQLiteStats::addStartupData()
@@ -319,10 +334,7 @@ void SQLiteStats::finishup(const lbool status)
     << "'" << status << "'"
     << ");";
 
-    if (sqlite3_exec(db, ss.str().c_str(), NULL, NULL, NULL)) {
-        cerr << "ERROR Couldn't insert into table 'finishup'" << endl;
-        std::exit(-1);
-    }
+    exec_sql(ss.str(), "finishup");
 }
 
 void SQLiteStats::writeQuestionMarks(
@@ -343,6 +355,16 @@ void SQLiteStats::writeQuestionMarks(
 }
 
 void SQLiteStats::run_sqlite_step(sqlite3_stmt* stmt, const char* name)
+{
+    if (queue) {
+        queue_row(stmt, name);
+        return;
+    }
+
+    step_stmt(stmt, name);
+}
+
+void SQLiteStats::step_stmt(sqlite3_stmt* stmt, const char* name)
 {
     int rc = sqlite3_step(stmt);
     if (rc != SQLITE_DONE) {
@@ -358,7 +380,8 @@ void SQLiteStats::run_sqlite_step(sqlite3_stmt* stmt, const char* name)
     }
 
     if (sqlite3_reset(stmt)) {
-        cerr << "Error calling sqlite3_reset on cl_last_in_solver" << endl;
+        cerr << "Error calling sqlite3_reset on '"
+        << name << "'" << endl;
         std::exit(-1);
     }
 
@@ -369,6 +392,242 @@ void SQLiteStats::run_sqlite_step(sqlite3_stmt* stmt, const char* name)
     }
 }
 
+void SQLiteStats::exec_sql(const string& sql, const char* name)
+{
+    if (queue) {
+        staged.text = sql;
+        queue_row(NULL, name);
+        return;
+    }
+
+    if (sqlite3_exec(db, sql.c_str(), NULL, NULL, NULL)) {
+        cerr << "ERROR Couldn't insert into table '" << name << "' : "
+        << sqlite3_errmsg(db) << endl;
+        std::exit(-1);
+    }
+}
+
+SQLValue& SQLiteStats::staged_val(int at)
+{
+    assert(at >= 1);
+    if (staged.vals.size() < (size_t)at) {
+        staged.vals.resize(at);
+    }
+    return staged.vals[at-1];
+}
+
+void SQLiteStats::bind_null(sqlite3_stmt* stmt, int at)
+{
+    if (!queue) {
+        sqlite3_bind_null(stmt, at);
+        return;
+    }
+    staged_val(at).type = SQLValue::Type::null;
+}
+
+//Truncates to int, just like sqlite3_bind_int() does
+void SQLiteStats::bind_int(sqlite3_stmt* stmt, int at, int64_t val)
+{
+    if (!queue) {
+        sqlite3_bind_int(stmt, at, (int)val);
+        return;
+    }
+    SQLValue& v = staged_val(at);
+    v.type = SQLValue::Type::integer;
+    v.i = (int)val;
+}
+
+void SQLiteStats::bind_int64(sqlite3_stmt* stmt, int at, int64_t val)
+{
+    if (!queue) {
+        sqlite3_bind_int64(stmt, at, val);
+        return;
+    }
+    SQLValue& v = staged_val(at);
+    v.type = SQLValue::Type::integer;
+    v.i = val;
+}
+
+void SQLiteStats::bind_double(sqlite3_stmt* stmt, int at, double val)
+{
+    if (!queue) {
+        sqlite3_bind_double(stmt, at, val);
+        return;
+    }
+    SQLValue& v = staged_val(at);
+    v.type = SQLValue::Type::real;
+    v.d = val;
+}
+
+void SQLiteStats::bind_text(sqlite3_stmt* stmt, int at, const string& val)
+{
+    if (!queue) {
+        sqlite3_bind_text(stmt, at, val.c_str(), -1, NULL);
+        return;
+    }
+    SQLValue& v = staged_val(at);
+    v.type = SQLValue::Type::text;
+    staged.text = val;
+}
+
+void SQLiteStats::start_writer(const Solver* solver)
+{
+    assert(queue == NULL);
+    batch_rows = std::max<uint32_t>(1, solver->conf.sql_batch_rows);
+    drop_when_full = solver->conf.sql_drop_when_full;
+    verbosity = solver->conf.verbosity;
+    queue = new SPSCQueue<SQLRow>(std::max<uint32_t>(2, solver->conf.sql_queue_rows));
+    writer_stop = false;
+    writer = std::thread(&SQLiteStats::writer_thread, this);
+}
+
+void SQLiteStats::stop_writer()
+{
+    if (!queue) {
+        return;
+    }
+
+    writer_stop = true;
+    writer.join();
+    assert(queue->empty());
+    if (verbosity) {
+        print_writer_stats();
+    }
+    delete queue;
+    queue = NULL;
+}
+
+void SQLiteStats::print_writer_stats() const
+{
+    cout << "c [sql] rows written: " << writer_stats.rows_written
+    << " dropped: " << writer_stats.rows_dropped
+    << " waits for full queue: " << writer_stats.producer_waits
+    << " transactions: " << writer_stats.transactions
+    << endl;
+}
+
+//These tables have a row per clause or per variable. When the queue is full
+//they are sampled, everything else must be written.
+bool SQLiteStats::droppable(const sqlite3_stmt* stmt) const
+{
+    return stmt != NULL
+        && (stmt == stmt_clause_stats
+        || stmt == stmtReduceDB
+        || stmt == stmt_delete_cl
+        || stmt == stmt_var_data_picktime
+        || stmt == stmt_var_data_fintime
+        || stmt == stmt_dec_var_clid
+        || stmt == stmt_var_dist);
+}
+
+void SQLiteStats::queue_row(sqlite3_stmt* stmt, const char* name)
+{
+    SQLRow* row = queue->start_push();
+    if (row == NULL) {
+        if (drop_when_full && droppable(stmt)) {
+            writer_stats.rows_dropped++;
+            staged.vals.clear();
+            return;
+        }
+
+        writer_stats.producer_waits++;
+        while((row = queue->start_push()) == NULL) {
+            std::this_thread::yield();
+        }
+    }
+
+    //Swapping keeps the memory of both vectors for reuse
+    row->stmt = stmt;
+    row->name = name;
+    std::swap(row->vals, staged.vals);
+    std::swap(row->text, staged.text);
+    staged.vals.clear();
+    queue->finish_push();
+}
+
+void SQLiteStats::write_row(SQLRow& row)
+{
+    if (row.stmt == NULL) {
+        if (sqlite3_exec(db, row.text.c_str(), NULL, NULL, NULL)) {
+            cerr << "ERROR Couldn't insert into table '" << row.name << "' : "
+            << sqlite3_errmsg(db) << endl;
+            std::exit(-1);
+        }
+        return;
+    }
+
+    for(size_t i = 0; i < row.vals.size(); i++) {
+        const SQLValue& v = row.vals[i];
+        switch(v.type) {
+            case SQLValue::Type::null:
+                sqlite3_bind_null(row.stmt, i+1);
+                break;
+            case SQLValue::Type::integer:
+                sqlite3_bind_int64(row.stmt, i+1, v.i);
+                break;
+            case SQLValue::Type::real:
+                sqlite3_bind_double(row.stmt, i+1, v.d);
+                break;
+            case SQLValue::Type::text:
+                sqlite3_bind_text(row.stmt, i+1, row.text.c_str(), -1, NULL);
+                break;
+        }
+    }
+    step_stmt(row.stmt, row.name);
+}
+
+//Rows are written in transactions of batch_rows rows. A transaction is also
+//committed when no new rows arrived for a while, so the DB is never far behind.
+void SQLiteStats::writer_thread()
+{
+    bool in_transaction = false;
+    uint32_t rows_in_transaction = 0;
+    uint32_t idle_rounds = 0;
+    while(true) {
+        SQLRow* row = queue->front();
+        if (row == NULL) {
+            const bool stop = writer_stop;
+            if (in_transaction && (stop || idle_rounds >= 50)) {
+                exec_transaction_cmd("END TRANSACTION");
+                in_transaction = false;
+            }
+            //Rows pushed before the stop flag are guaranteed to be seen
+            if (stop && queue->front() == NULL) {
+                break;
+            }
+            idle_rounds++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        idle_rounds = 0;
+        if (!in_transaction) {
+            exec_transaction_cmd("BEGIN TRANSACTION");
+            in_transaction = true;
+            rows_in_transaction = 0;
+            writer_stats.transactions++;
+        }
+        write_row(*row);
+        queue->pop();
+        writer_stats.rows_written++;
+
+        rows_in_transaction++;
+        if (rows_in_transaction >= batch_rows) {
+            exec_transaction_cmd("END TRANSACTION");
+            in_transaction = false;
+        }
+    }
+}
+
+void SQLiteStats::exec_transaction_cmd(const char* cmd)
+{
+    if (sqlite3_exec(db, cmd, NULL, NULL, NULL)) {
+        cerr << "ERROR: executing SQLite '" << cmd << "'" << endl;
+        cerr << "c " << sqlite3_errmsg(db) << endl;
+        std::exit(-1);
+    }
+}
+
 
 void SQLiteStats::init(const char* name, sqlite3_stmt** stmt)
 {
@@ -410,16 +669,38 @@ void SQLiteStats::mem_used(
 ) {
     int bindAt = 1;
     //Position
-    sqlite3_bind_int64(stmtMemUsed, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtMemUsed, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtMemUsed, bindAt++, given_time);
+    bind_int64(stmtMemUsed, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmtMemUsed, bindAt++, solver->sumConflicts);
+    bind_double(stmtMemUsed, bindAt++, given_time);
     //memory stats
-    sqlite3_bind_text(stmtMemUsed, bindAt++, name.c_str(), -1, NULL);
-    sqlite3_bind_int(stmtMemUsed, bindAt++, mem_used_mb);
+    bind_text(stmtMemUsed, bindAt++, name);
+    bind_int(stmtMemUsed, bindAt++, mem_used_mb);
 
     run_sqlite_step(stmtMemUsed, "memused");
 }
 
+void SQLiteStats::inprocess(
+    const Solver* solver
+    , const string& name
+    , const InprocessCall& call
+    , double budget_mult
+) {
+    int bindAt = 1;
+    bind_int64(stmtInprocess, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmtInprocess, bindAt++, solver->sumConflicts);
+    bind_double(stmtInprocess, bindAt++, cpuTime());
+    bind_text(stmtInprocess, bindAt++, name);
+    bind_double(stmtInprocess, bindAt++, call.time_used);
+    bind_int64(stmtInprocess, bindAt++, call.bogoprops);
+    bind_int64(stmtInprocess, bindAt++, call.vars_removed);
+    bind_int64(stmtInprocess, bindAt++, call.cls_removed);
+    bind_int64(stmtInprocess, bindAt++, call.lits_removed);
+    bind_int64(stmtInprocess, bindAt++, call.units);
+    bind_double(stmtInprocess, bindAt++, budget_mult);
+
+    run_sqlite_step(stmtInprocess, "inprocess");
+}
+
 void SQLiteStats::time_passed(
     const Solver* solver
     , const string& name
@@ -429,13 +710,13 @@ void SQLiteStats::time_passed(
 ) {
 
     int bindAt = 1;
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, cpuTime());
-    sqlite3_bind_text(stmtTimePassed, bindAt++, name.c_str(), -1, NULL);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, time_passed);
-    sqlite3_bind_int(stmtTimePassed, bindAt++, time_out);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, percent_time_remain);
+    bind_int64(stmtTimePassed, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmtTimePassed, bindAt++, solver->sumConflicts);
+    bind_double(stmtTimePassed, bindAt++, cpuTime());
+    bind_text(stmtTimePassed, bindAt++, name);
+    bind_double(stmtTimePassed, bindAt++, time_passed);
+    bind_int(stmtTimePassed, bindAt++, time_out);
+    bind_double(stmtTimePassed, bindAt++, percent_time_remain);
 
     run_sqlite_step(stmtTimePassed, "timepassed");
 }
@@ -446,13 +727,13 @@ void SQLiteStats::time_passed_min(
     , double time_passed
 ) {
     int bindAt = 1;
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, cpuTime());
-    sqlite3_bind_text(stmtTimePassed, bindAt++, name.c_str(), -1, NULL);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, time_passed);
-    sqlite3_bind_null(stmtTimePassed, bindAt++);
-    sqlite3_bind_null(stmtTimePassed, bindAt++);
+    bind_int64(stmtTimePassed, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmtTimePassed, bindAt++, solver->sumConflicts);
+    bind_double(stmtTimePassed, bindAt++, cpuTime());
+    bind_text(stmtTimePassed, bindAt++, name);
+    bind_double(stmtTimePassed, bindAt++, time_passed);
+    bind_null(stmtTimePassed, bindAt++);
+    bind_null(stmtTimePassed, bindAt++);
 
     run_sqlite_step(stmtTimePassed, "time_passed_min");
 }
@@ -463,87 +744,87 @@ void SQLiteStats::satzilla_features(
     , const SatZillaFeatures& satzilla_feat
 ) {
     int bindAt = 1;
-    sqlite3_bind_int64(stmtFeat, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtFeat, bindAt++, search->sumRestarts());
-    sqlite3_bind_int64(stmtFeat, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int(stmtFeat, bindAt++, solver->latest_satzilla_feature_calc);
+    bind_int64(stmtFeat, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmtFeat, bindAt++, search->sumRestarts());
+    bind_int64(stmtFeat, bindAt++, solver->sumConflicts);
+    bind_int(stmtFeat, bindAt++, solver->latest_satzilla_feature_calc);
 
-    sqlite3_bind_int64(stmtFeat, bindAt++, (uint64_t)satzilla_feat.numVars);
-    sqlite3_bind_int64(stmtFeat, bindAt++, (uint64_t)satzilla_feat.numClauses);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.var_cl_ratio);
+    bind_int64(stmtFeat, bindAt++, (uint64_t)satzilla_feat.numVars);
+    bind_int64(stmtFeat, bindAt++, (uint64_t)satzilla_feat.numClauses);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.var_cl_ratio);
 
     //Clause distribution
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.binary);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.horn);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.horn_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.horn_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.horn_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.horn_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.horn_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_spread);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.binary);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.horn);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.horn_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.horn_std);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.horn_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.horn_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.horn_spread);
+
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_std);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_var_spread);
+
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_std);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.vcg_cls_spread);
+
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_std);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_var_spread);
+
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_std);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.pnr_cls_spread);
 
     //Conflict clauses
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.avg_confl_size);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.confl_size_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.confl_size_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.avg_confl_glue);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.confl_glue_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.confl_glue_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.avg_num_resolutions);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.num_resolutions_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.num_resolutions_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.learnt_bins_per_confl);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.avg_confl_size);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.confl_size_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.confl_size_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.avg_confl_glue);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.confl_glue_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.confl_glue_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.avg_num_resolutions);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.num_resolutions_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.num_resolutions_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.learnt_bins_per_confl);
 
     //Search
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.avg_branch_depth);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.branch_depth_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.branch_depth_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.avg_trail_depth_delta);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.trail_depth_delta_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.trail_depth_delta_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.avg_branch_depth_delta);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.props_per_confl);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.confl_per_restart);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.decisions_per_conflict);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.avg_branch_depth);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.branch_depth_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.branch_depth_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.avg_trail_depth_delta);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.trail_depth_delta_min);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.trail_depth_delta_max);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.avg_branch_depth_delta);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.props_per_confl);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.confl_per_restart);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.decisions_per_conflict);
 
     //red stats
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.glue_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.glue_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.size_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.size_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.activity_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.activity_distr_var);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.glue_distr_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.glue_distr_var);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.size_distr_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.size_distr_var);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.activity_distr_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.red_cl_distrib.activity_distr_var);
 
     //irred stats
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.glue_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.glue_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.size_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.size_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.activity_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.activity_distr_var);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.glue_distr_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.glue_distr_var);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.size_distr_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.size_distr_var);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.activity_distr_mean);
+    bind_double(stmtFeat, bindAt++, satzilla_feat.irred_cl_distrib.activity_distr_var);
 
     run_sqlite_step(stmtFeat, "satzilla_features");
 }
@@ -574,104 +855,104 @@ void SQLiteStats::restart(
     const BinTriStats& binTri = solver->getBinTriStats();
 
     int bindAt = 1;
-    sqlite3_bind_int64(stmt, bindAt++, restartID);
+    bind_int64(stmt, bindAt++, restartID);
     if (clauseID == -1) {
-        sqlite3_bind_null(stmt, bindAt++);
+        bind_null(stmt, bindAt++);
     } else {
-        sqlite3_bind_int64(stmt, bindAt++, clauseID);
+        bind_int64(stmt, bindAt++, clauseID);
     }
-    sqlite3_bind_int64(stmt, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmt, bindAt++, search->sumRestarts());
-    sqlite3_bind_int64(stmt, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int(stmt, bindAt++, searchHist.num_conflicts_this_restart);
-    sqlite3_bind_int(stmt, bindAt++, solver->latest_satzilla_feature_calc);
-    sqlite3_bind_double(stmt, bindAt++, cpuTime());
+    bind_int64(stmt, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmt, bindAt++, search->sumRestarts());
+    bind_int64(stmt, bindAt++, solver->sumConflicts);
+    bind_int(stmt, bindAt++, searchHist.num_conflicts_this_restart);
+    bind_int(stmt, bindAt++, solver->latest_satzilla_feature_calc);
+    bind_double(stmt, bindAt++, cpuTime());
 
 
-    sqlite3_bind_int64(stmt, bindAt++, binTri.irredBins);
-    sqlite3_bind_int64(stmt, bindAt++, solver->get_num_long_irred_cls());
-    sqlite3_bind_int64(stmt, bindAt++, binTri.redBins);
-    sqlite3_bind_int64(stmt, bindAt++, solver->get_num_long_red_cls());
+    bind_int64(stmt, bindAt++, binTri.irredBins);
+    bind_int64(stmt, bindAt++, solver->get_num_long_irred_cls());
+    bind_int64(stmt, bindAt++, binTri.redBins);
+    bind_int64(stmt, bindAt++, solver->get_num_long_red_cls());
 
-    sqlite3_bind_int64(stmt, bindAt++, solver->litStats.irredLits);
-    sqlite3_bind_int64(stmt, bindAt++, solver->litStats.redLits);
+    bind_int64(stmt, bindAt++, solver->litStats.irredLits);
+    bind_int64(stmt, bindAt++, solver->litStats.redLits);
 
     //Conflict stats
     bind_null_or_double(stmt, bindAt,   searchHist.glueHist.getLongtTerm(),avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.glueHist.getLongtTerm().var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.glueHist.getLongtTerm().var()));
     bind_null_or_double(stmt, bindAt,   searchHist.glueHist.getLongtTerm(),getMin);
     bind_null_or_double(stmt, bindAt,   searchHist.glueHist.getLongtTerm(),getMax);
 
     bind_null_or_double(stmt, bindAt,   searchHist.conflSizeHist, avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.conflSizeHist.var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.conflSizeHist.var()));
     bind_null_or_double(stmt, bindAt,   searchHist.conflSizeHist,getMin);
     bind_null_or_double(stmt, bindAt,   searchHist.conflSizeHist,getMax);
 
     bind_null_or_double(stmt, bindAt,   searchHist.numResolutionsHist, avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.numResolutionsHist.var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.numResolutionsHist.var()));
     bind_null_or_double(stmt, bindAt,   searchHist.numResolutionsHist,getMin);
     bind_null_or_double(stmt, bindAt,   searchHist.numResolutionsHist,getMax);
 
     //Search stats
     bind_null_or_double(stmt, bindAt,   searchHist.branchDepthHist,avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.branchDepthHist.var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.branchDepthHist.var()));
     bind_null_or_double(stmt, bindAt, searchHist.branchDepthHist,getMin);
     bind_null_or_double(stmt, bindAt, searchHist.branchDepthHist,getMax);
 
     bind_null_or_double(stmt, bindAt,   searchHist.branchDepthDeltaHist,avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.branchDepthDeltaHist.var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.branchDepthDeltaHist.var()));
     bind_null_or_double(stmt, bindAt,   searchHist.branchDepthDeltaHist,getMin);
     bind_null_or_double(stmt, bindAt,   searchHist.branchDepthDeltaHist,getMax);
 
     bind_null_or_double(stmt, bindAt, searchHist.trailDepthHist.getLongtTerm(),avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.trailDepthHist.getLongtTerm().var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.trailDepthHist.getLongtTerm().var()));
     bind_null_or_double(stmt, bindAt,   searchHist.trailDepthHist.getLongtTerm(),getMin);
     bind_null_or_double(stmt, bindAt,   searchHist.trailDepthHist.getLongtTerm(),getMax);
 
     bind_null_or_double(stmt, bindAt,   searchHist.trailDepthDeltaHist,avg);
-    sqlite3_bind_double(stmt, bindAt++, std:: sqrt(searchHist.trailDepthDeltaHist.var()));
+    bind_double(stmt, bindAt++, std:: sqrt(searchHist.trailDepthDeltaHist.var()));
     bind_null_or_double(stmt, bindAt,   searchHist.trailDepthDeltaHist,getMin);
     bind_null_or_double(stmt, bindAt,   searchHist.trailDepthDeltaHist,getMax);
 
     //Prop
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.propsBinIrred);
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.propsBinRed);
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.propsLongIrred);
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.propsLongRed);
+    bind_int64(stmt, bindAt++, thisPropStats.propsBinIrred);
+    bind_int64(stmt, bindAt++, thisPropStats.propsBinRed);
+    bind_int64(stmt, bindAt++, thisPropStats.propsLongIrred);
+    bind_int64(stmt, bindAt++, thisPropStats.propsLongRed);
 
     //Confl
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.conflStats.conflsBinIrred);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.conflStats.conflsBinRed);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.conflStats.conflsLongIrred);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.conflStats.conflsLongRed);
+    bind_int64(stmt, bindAt++, thisStats.conflStats.conflsBinIrred);
+    bind_int64(stmt, bindAt++, thisStats.conflStats.conflsBinRed);
+    bind_int64(stmt, bindAt++, thisStats.conflStats.conflsLongIrred);
+    bind_int64(stmt, bindAt++, thisStats.conflStats.conflsLongRed);
 
     //Red
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.learntUnits);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.learntBins);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.learntLongs);
+    bind_int64(stmt, bindAt++, thisStats.learntUnits);
+    bind_int64(stmt, bindAt++, thisStats.learntBins);
+    bind_int64(stmt, bindAt++, thisStats.learntLongs);
 
     //Resolv stats
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.resolvs.binIrred);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.resolvs.binRed);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.resolvs.longIrred);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.resolvs.longRed);
+    bind_int64(stmt, bindAt++, thisStats.resolvs.binIrred);
+    bind_int64(stmt, bindAt++, thisStats.resolvs.binRed);
+    bind_int64(stmt, bindAt++, thisStats.resolvs.longIrred);
+    bind_int64(stmt, bindAt++, thisStats.resolvs.longRed);
 
 
     //Var stats
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.propagations);
-    sqlite3_bind_int64(stmt, bindAt++, thisStats.decisions);
+    bind_int64(stmt, bindAt++, thisPropStats.propagations);
+    bind_int64(stmt, bindAt++, thisStats.decisions);
 
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.varFlipped);
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.varSetPos);
-    sqlite3_bind_int64(stmt, bindAt++, thisPropStats.varSetNeg);
-    sqlite3_bind_int64(stmt, bindAt++, solver->get_num_free_vars());
-    sqlite3_bind_int64(stmt, bindAt++, solver->varReplacer->get_num_replaced_vars());
-    sqlite3_bind_int64(stmt, bindAt++, solver->get_num_vars_elimed());
-    sqlite3_bind_int64(stmt, bindAt++, search->getTrailSize());
+    bind_int64(stmt, bindAt++, thisPropStats.varFlipped);
+    bind_int64(stmt, bindAt++, thisPropStats.varSetPos);
+    bind_int64(stmt, bindAt++, thisPropStats.varSetNeg);
+    bind_int64(stmt, bindAt++, solver->get_num_free_vars());
+    bind_int64(stmt, bindAt++, solver->varReplacer->get_num_replaced_vars());
+    bind_int64(stmt, bindAt++, solver->get_num_vars_elimed());
+    bind_int64(stmt, bindAt++, search->getTrailSize());
 
     //strategy
-    sqlite3_bind_int(stmt, bindAt++, branch_type_to_int(solver->branch_strategy));
-    sqlite3_bind_int(stmt, bindAt++, restart_type_to_int(rest_type));
+    bind_int(stmt, bindAt++, branch_type_to_int(solver->branch_strategy));
+    bind_int(stmt, bindAt++, restart_type_to_int(rest_type));
 
     run_sqlite_step(stmt, rst_dat_type_to_str(type));
 }
@@ -688,36 +969,36 @@ void SQLiteStats::reduceDB(
     assert(cl->stats.dump_no != std::numeric_limits<uint16_t>::max());
 
     int bindAt = 1;
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->sumRestarts());
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->latest_satzilla_feature_calc);
-    sqlite3_bind_text(stmtReduceDB, bindAt++, cur_restart_type.c_str(), -1, NULL);
-    sqlite3_bind_double(stmtReduceDB, bindAt++, cpuTime());
+    bind_int64(stmtReduceDB, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmtReduceDB, bindAt++, solver->sumRestarts());
+    bind_int64(stmtReduceDB, bindAt++, solver->sumConflicts);
+    bind_int64(stmtReduceDB, bindAt++, solver->latest_satzilla_feature_calc);
+    bind_text(stmtReduceDB, bindAt++, cur_restart_type);
+    bind_double(stmtReduceDB, bindAt++, cpuTime());
 
     //data
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.ID);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.dump_no);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.conflicts_made);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.propagations_made);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.sum_propagations_made);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.clause_looked_at);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.used_for_uip_creation);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.ID);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.dump_no);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.conflicts_made);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.propagations_made);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.sum_propagations_made);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.clause_looked_at);
+    bind_int64(stmtReduceDB, bindAt++, cl->stats.used_for_uip_creation);
 
     int64_t last_touched_diff = solver->sumConflicts-cl->stats.last_touched;
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, last_touched_diff);
-
-    sqlite3_bind_double(stmtReduceDB, bindAt++, (double)cl->stats.activity/(double)solver->get_cla_inc());
-    sqlite3_bind_int(stmtReduceDB, bindAt++, locked);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->used_in_xor());
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->stats.glue);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->size());
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->stats.ttl);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->is_ternary_resolvent);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, act_ranking_top_10);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, act_ranking);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, tot_cls_in_db);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->stats.sum_uip1_used);
+    bind_int64(stmtReduceDB, bindAt++, last_touched_diff);
+
+    bind_double(stmtReduceDB, bindAt++, (double)cl->stats.activity/(double)solver->get_cla_inc());
+    bind_int(stmtReduceDB, bindAt++, locked);
+    bind_int(stmtReduceDB, bindAt++, cl->used_in_xor());
+    bind_int(stmtReduceDB, bindAt++, cl->stats.glue);
+    bind_int(stmtReduceDB, bindAt++, cl->size());
+    bind_int(stmtReduceDB, bindAt++, cl->stats.ttl);
+    bind_int(stmtReduceDB, bindAt++, cl->is_ternary_resolvent);
+    bind_int(stmtReduceDB, bindAt++, act_ranking_top_10);
+    bind_int(stmtReduceDB, bindAt++, act_ranking);
+    bind_int(stmtReduceDB, bindAt++, tot_cls_in_db);
+    bind_int(stmtReduceDB, bindAt++, cl->stats.sum_uip1_used);
 
     run_sqlite_step(stmtReduceDB, "reduceDB");
 }
@@ -741,38 +1022,38 @@ void SQLiteStats::dump_clause_stats(
     uint32_t num_overlap_literals = antec_data.sum_size()-(antec_data.num()-1)-size;
 
     int bindAt = 1;
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->sumRestarts());
+    bind_int64(stmt_clause_stats, bindAt++, solver->get_solve_stats().num_simplify);
+    bind_int64(stmt_clause_stats, bindAt++, solver->sumRestarts());
     if (solver->sumRestarts() == 0) {
-        sqlite3_bind_int64(stmt_clause_stats, bindAt++, 0);
+        bind_int64(stmt_clause_stats, bindAt++, 0);
     } else {
-        sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->sumRestarts()-1);
-    }
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, solver->latest_satzilla_feature_calc);
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, clid);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, restartID);
-
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, orig_glue);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, glue_before_minim);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, size);
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, conflicts_this_restart);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, num_overlap_literals);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, antec_data.num());
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, antec_data.sum_size());
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, is_decision);
-
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, backtrack_level);
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, decision_level);
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.prev(1));
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.prev(2));
-    sqlite3_bind_int64 (stmt_clause_stats, bindAt++, trail_depth);
-    sqlite3_bind_text  (stmt_clause_stats, bindAt++,  restart_type.c_str(), -1, NULL);
-
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, antec_data.binIrred);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, antec_data.binRed);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, antec_data.longIrred);
-    sqlite3_bind_int   (stmt_clause_stats, bindAt++, antec_data.longRed);
+        bind_int64(stmt_clause_stats, bindAt++, solver->sumRestarts()-1);
+    }
+    bind_int64 (stmt_clause_stats, bindAt++, solver->sumConflicts);
+    bind_int   (stmt_clause_stats, bindAt++, solver->latest_satzilla_feature_calc);
+    bind_int64 (stmt_clause_stats, bindAt++, clid);
+    bind_int   (stmt_clause_stats, bindAt++, restartID);
+
+    bind_int   (stmt_clause_stats, bindAt++, orig_glue);
+    bind_int   (stmt_clause_stats, bindAt++, glue_before_minim);
+    bind_int   (stmt_clause_stats, bindAt++, size);
+    bind_int64 (stmt_clause_stats, bindAt++, conflicts_this_restart);
+    bind_int   (stmt_clause_stats, bindAt++, num_overlap_literals);
+    bind_int   (stmt_clause_stats, bindAt++, antec_data.num());
+    bind_int   (stmt_clause_stats, bindAt++, antec_data.sum_size());
+    bind_int   (stmt_clause_stats, bindAt++, is_decision);
+
+    bind_int   (stmt_clause_stats, bindAt++, backtrack_level);
+    bind_int64 (stmt_clause_stats, bindAt++, decision_level);
+    bind_int64 (stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.prev(1));
+    bind_int64 (stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.prev(2));
+    bind_int64 (stmt_clause_stats, bindAt++, trail_depth);
+    bind_text(stmt_clause_stats, bindAt++, restart_type);
+
+    bind_int   (stmt_clause_stats, bindAt++, antec_data.binIrred);
+    bind_int   (stmt_clause_stats, bindAt++, antec_data.binRed);
+    bind_int   (stmt_clause_stats, bindAt++, antec_data.longIrred);
+    bind_int   (stmt_clause_stats, bindAt++, antec_data.longRed);
 
     bind_null_or_double(stmt_clause_stats, bindAt, antec_data.glue_long_reds,avg);
     bind_null_or_double(stmt_clause_stats, bindAt, antec_data.glue_long_reds,avg);
@@ -795,14 +1076,14 @@ void SQLiteStats::dump_clause_stats(
     bind_null_or_double(stmt_clause_stats, bindAt, hist.antec_data_sum_sizeHistLT,avg);
     bind_null_or_double(stmt_clause_stats, bindAt, hist.overlapHistLT,avg);
 
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHist.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHistLonger.avg_nocheck());
+    bind_double(stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.avg_nocheck());
+    bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHist.avg_nocheck());
+    bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHistLonger.avg_nocheck());
     bind_null_or_double(stmt_clause_stats, bindAt,   hist.numResolutionsHist,avg);
     bind_null_or_double(stmt_clause_stats, bindAt,   hist.conflSizeHist,avg);
     bind_null_or_double(stmt_clause_stats, bindAt,   hist.trailDepthDeltaHist,avg);
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.backtrackLevelHist.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.glueHist.avg_nocheck());
+    bind_double(stmt_clause_stats, bindAt++, hist.backtrackLevelHist.avg_nocheck());
+    bind_double(stmt_clause_stats, bindAt++, hist.glueHist.avg_nocheck());
     bind_null_or_double(stmt_clause_stats, bindAt,   hist.glueHist.getLongtTerm(),avg);
 
     run_sqlite_step(stmt_clause_stats, "dump_clause_stats");
@@ -816,24 +1097,24 @@ void SQLiteStats::var_data_fintime(
     , const double rel_activity
 ) {
     int bindAt = 1;
-    sqlite3_bind_int   (stmt_var_data_fintime, bindAt++, var);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, vardata.sumConflicts_at_picktime);
+    bind_int   (stmt_var_data_fintime, bindAt++, var);
+    bind_int64 (stmt_var_data_fintime, bindAt++, vardata.sumConflicts_at_picktime);
 
-    sqlite3_bind_double (stmt_var_data_fintime, bindAt++, rel_activity);
+    bind_double (stmt_var_data_fintime, bindAt++, rel_activity);
 
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, vardata.inside_conflict_clause);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, vardata.inside_conflict_clause_antecedents);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, vardata.inside_conflict_clause_glue);
+    bind_int64 (stmt_var_data_fintime, bindAt++, vardata.inside_conflict_clause);
+    bind_int64 (stmt_var_data_fintime, bindAt++, vardata.inside_conflict_clause_antecedents);
+    bind_int64 (stmt_var_data_fintime, bindAt++, vardata.inside_conflict_clause_glue);
 
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumDecisions);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumPropagations);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumAntecedents);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumAntecedentsLits);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumConflictClauseLits);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumDecisionBasedCl);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumClLBD);
-    sqlite3_bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumClSize);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumDecisions);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumConflicts);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumPropagations);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumAntecedents);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumAntecedentsLits);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumConflictClauseLits);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumDecisionBasedCl);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumClLBD);
+    bind_int64 (stmt_var_data_fintime, bindAt++, solver->sumClSize);
 
     run_sqlite_step(stmt_var_data_fintime, "var_data_fintime");
 }
@@ -845,52 +1126,52 @@ void SQLiteStats::var_data_picktime(
     , const double rel_activity
 ) {
     int bindAt = 1;
-    sqlite3_bind_int   (stmt_var_data_picktime, bindAt++, var);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.level);
-    sqlite3_bind_double(stmt_var_data_picktime, bindAt++, rel_activity);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->latest_vardist_feature_calc);
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_antecedents);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_glue);
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_antecedents_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_glue_during);
-
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_decided);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_decided_pos);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_propagated);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_propagated_pos);
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_seen_in_1uip);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_decided_on);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_propagated);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_canceled);
-
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumDecisions);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumPropagations);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumAntecedents);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumAntecedentsLits);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflictClauseLits);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumDecisionBasedCl);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumClLBD);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumClSize);
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumConflicts_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumDecisions_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumPropagations_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumAntecedents_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumAntecedentsLits_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumConflictClauseLits_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumDecisionBasedCl_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumClLBD_below_during);
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumClSize_below_during);
-
-    sqlite3_bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_flipped);
+    bind_int   (stmt_var_data_picktime, bindAt++, var);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.level);
+    bind_double(stmt_var_data_picktime, bindAt++, rel_activity);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->latest_vardist_feature_calc);
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_antecedents);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_glue);
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_antecedents_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.inside_conflict_clause_glue_during);
+
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_decided);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_decided_pos);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_propagated);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.num_propagated_pos);
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_seen_in_1uip);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_decided_on);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_propagated);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_canceled);
+
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumDecisions);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumPropagations);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumAntecedents);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumAntecedentsLits);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflictClauseLits);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumDecisionBasedCl);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumClLBD);
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumClSize);
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumConflicts_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumDecisions_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumPropagations_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumAntecedents_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumAntecedentsLits_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumConflictClauseLits_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumDecisionBasedCl_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumClLBD_below_during);
+    bind_int64 (stmt_var_data_picktime, bindAt++, vardata.sumClSize_below_during);
+
+    bind_int64 (stmt_var_data_picktime, bindAt++, solver->sumConflicts-vardata.last_flipped);
 
     run_sqlite_step(stmt_var_data_picktime, "var_data_picktime");
 }
@@ -901,37 +1182,37 @@ void SQLiteStats::var_dist(
     , const Solver* solver
 ) {
     int bindAt = 1;
-    sqlite3_bind_int(stmt_var_dist, bindAt++, var);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, solver->latest_vardist_feature_calc);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, solver->sumConflicts);
+    bind_int(stmt_var_dist, bindAt++, var);
+    bind_int64(stmt_var_dist, bindAt++, solver->latest_vardist_feature_calc);
+    bind_int64(stmt_var_dist, bindAt++, solver->sumConflicts);
 
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, solver->longIrredCls.size());
+    bind_int64(stmt_var_dist, bindAt++, solver->longIrredCls.size());
     uint32_t num = 0;
     for(auto& x: solver->longRedCls) {
         num+=x.size();
     }
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, num);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, solver->binTri.irredBins);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, solver->binTri.redBins);
+    bind_int64(stmt_var_dist, bindAt++, num);
+    bind_int64(stmt_var_dist, bindAt++, solver->binTri.irredBins);
+    bind_int64(stmt_var_dist, bindAt++, solver->binTri.redBins);
 
 
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.red.num_times_in_bin_clause);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.red.num_times_in_long_clause);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.red.satisfies_cl);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.red.falsifies_cl);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.red.tot_num_lit_of_bin_it_appears_in);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.red.tot_num_lit_of_long_cls_it_appears_in);
-    sqlite3_bind_double(stmt_var_dist, bindAt++, data.red.sum_var_act_of_cls);
+    bind_int64(stmt_var_dist, bindAt++, data.red.num_times_in_bin_clause);
+    bind_int64(stmt_var_dist, bindAt++, data.red.num_times_in_long_clause);
+    bind_int64(stmt_var_dist, bindAt++, data.red.satisfies_cl);
+    bind_int64(stmt_var_dist, bindAt++, data.red.falsifies_cl);
+    bind_int64(stmt_var_dist, bindAt++, data.red.tot_num_lit_of_bin_it_appears_in);
+    bind_int64(stmt_var_dist, bindAt++, data.red.tot_num_lit_of_long_cls_it_appears_in);
+    bind_double(stmt_var_dist, bindAt++, data.red.sum_var_act_of_cls);
 
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.irred.num_times_in_bin_clause);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.irred.num_times_in_long_clause);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.irred.satisfies_cl);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.irred.falsifies_cl);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.irred.tot_num_lit_of_bin_it_appears_in);
-    sqlite3_bind_int64(stmt_var_dist, bindAt++, data.irred.tot_num_lit_of_long_cls_it_appears_in);
-    sqlite3_bind_double(stmt_var_dist, bindAt++, data.irred.sum_var_act_of_cls);
+    bind_int64(stmt_var_dist, bindAt++, data.irred.num_times_in_bin_clause);
+    bind_int64(stmt_var_dist, bindAt++, data.irred.num_times_in_long_clause);
+    bind_int64(stmt_var_dist, bindAt++, data.irred.satisfies_cl);
+    bind_int64(stmt_var_dist, bindAt++, data.irred.falsifies_cl);
+    bind_int64(stmt_var_dist, bindAt++, data.irred.tot_num_lit_of_bin_it_appears_in);
+    bind_int64(stmt_var_dist, bindAt++, data.irred.tot_num_lit_of_long_cls_it_appears_in);
+    bind_double(stmt_var_dist, bindAt++, data.irred.sum_var_act_of_cls);
 
-    sqlite3_bind_double(stmt_var_dist, bindAt++, data.tot_act_long_red_cls);
+    bind_double(stmt_var_dist, bindAt++, data.tot_act_long_red_cls);
 
     run_sqlite_step(stmt_var_dist, "var_dist");
 }
@@ -944,9 +1225,9 @@ void SQLiteStats::dec_var_clid(
     assert(clid != 0);
 
     int bindAt = 1;
-    sqlite3_bind_int(stmt_dec_var_clid, bindAt++, var);
-    sqlite3_bind_int64(stmt_dec_var_clid, bindAt++, sumConflicts_at_picktime);
-    sqlite3_bind_int64(stmt_dec_var_clid, bindAt++, clid);
+    bind_int(stmt_dec_var_clid, bindAt++, var);
+    bind_int64(stmt_dec_var_clid, bindAt++, sumConflicts_at_picktime);
+    bind_int64(stmt_dec_var_clid, bindAt++, clid);
 
     run_sqlite_step(stmt_dec_var_clid, "dec_var_clid");
 }
@@ -959,8 +1240,8 @@ void SQLiteStats::cl_last_in_solver(
     assert(clid != 0);
 
     int bindAt = 1;
-    sqlite3_bind_int64(stmt_delete_cl, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int64(stmt_delete_cl, bindAt++, clid);
+    bind_int64(stmt_delete_cl, bindAt++, solver->sumConflicts);
+    bind_int64(stmt_delete_cl, bindAt++, clid);
 
     run_sqlite_step(stmt_delete_cl, "cl_last_in_solver");
 }
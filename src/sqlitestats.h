@@ -22,10 +22,42 @@ THE SOFTWARE.
 
 #include "sqlstats.h"
 #include "satzilla_features.h"
+#include "spscqueue.h"
 #include <sqlite3.h>
+#include <thread>
+#include <atomic>
 
 namespace CMSat {
 
+//A bound value of a queued row
+struct SQLValue
+{
+    enum class Type : uint8_t {null, integer, real, text};
+    Type type = Type::null;
+    union {
+        int64_t i;
+        double d;
+    };
+};
+
+//Row waiting to be written by the writer thread. A row with a NULL stmt
+//is a raw SQL command, which is in "text".
+struct SQLRow
+{
+    sqlite3_stmt* stmt = NULL;
+    const char* name = NULL;
+    vector<SQLValue> vals;
+    std::string text; ///<Only one text value per row is supported
+};
+
+struct SQLWriterStats
+{
+    uint64_t rows_written = 0;
+    uint64_t rows_dropped = 0;
+    uint64_t producer_waits = 0;
+    uint64_t transactions = 0;
+};
+
 class SQLiteStats: public SQLStats
 {
 public:
@@ -49,6 +81,13 @@ public:
         , double time_passed
     ) override;
 
+    void inprocess(
+        const Solver* solver
+        , const string& name
+        , const InprocessCall& call
+        , double budget_mult
+    ) override;
+
     void mem_used(
         const Solver* solver
         , const string& name
@@ -157,12 +196,34 @@ private:
     void init_var_data_fintime_STMT();
     void init_dec_var_clid_STMT();
     void run_sqlite_step(sqlite3_stmt* stmt, const char* name);
+    void exec_sql(const string& sql, const char* name);
+
+    //Binding either goes to the statement directly, or to the staged row
+    //that run_sqlite_step() will queue for the writer thread
+    void bind_null(sqlite3_stmt* stmt, int at);
+    void bind_int(sqlite3_stmt* stmt, int at, int64_t val);
+    void bind_int64(sqlite3_stmt* stmt, int at, int64_t val);
+    void bind_double(sqlite3_stmt* stmt, int at, double val);
+    void bind_text(sqlite3_stmt* stmt, int at, const string& val);
+    SQLValue& staged_val(int at);
+
+    //Asynchronous writing
+    void start_writer(const Solver* solver);
+    void stop_writer();
+    void queue_row(sqlite3_stmt* stmt, const char* name);
+    bool droppable(const sqlite3_stmt* stmt) const;
+    void writer_thread();
+    void write_row(SQLRow& row);
+    void step_stmt(sqlite3_stmt* stmt, const char* name);
+    void exec_transaction_cmd(const char* cmd);
+    void print_writer_stats() const;
 
     void writeQuestionMarks(size_t num, std::stringstream& ss);
     void initReduceDBSTMT();
 
     sqlite3_stmt *stmtTimePassed = NULL;
     sqlite3_stmt *stmtMemUsed = NULL;
+    sqlite3_stmt *stmtInprocess = NULL;
     sqlite3_stmt *stmtReduceDB = NULL;
     sqlite3_stmt *stmtRst = NULL;
     sqlite3_stmt *stmtVarRst = NULL;
@@ -178,6 +239,15 @@ private:
     sqlite3 *db = NULL;
     bool setup_ok = false;
     const string filename;
+
+    SPSCQueue<SQLRow>* queue = NULL;
+    SQLRow staged;
+    std::thread writer;
+    std::atomic<bool> writer_stop;
+    uint32_t batch_rows = 0;
+    bool drop_when_full = false;
+    int verbosity = 0;
+    SQLWriterStats writer_stats;
 };
 
 }
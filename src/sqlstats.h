@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "satzilla_features.h"
 #include "searchstats.h"
 #include "vardata.h"
+#include "inprocessscheduler.h"
 
 namespace CMSat {
 
@@ -56,6 +57,13 @@ public:
         , double time_passed
     ) = 0;
 
+    virtual void inprocess(
+        const Solver* solver
+        , const string& name
+        , const InprocessCall& call
+        , double budget_mult
+    ) = 0;
+
     virtual void mem_used(
         const Solver* solver
         , const string& name
@@ -25,7 +25,10 @@ THE SOFTWARE.
 #include "solver.h"
 #include "occsimplifier.h"
 #include "clauseallocator.h"
+#include "sparsegauss.h"
+#ifdef USE_M4RI
 #include <m4ri/m4ri.h>
+#endif
 #include <limits>
 #include <cstddef>
 #include "sqlstats.h"
@@ -37,8 +40,10 @@ using std::endl;
 TopLevelGauss::TopLevelGauss(Solver* _solver) :
     solver(_solver)
 {
+    #ifdef USE_M4RI
     //NOT THREAD SAFE BUG
     m4ri_build_all_codes();
+    #endif
 }
 
 bool TopLevelGauss::toplevelgauss(const vector<Xor>& _xors, vector<Lit>* _out_changed_occur)
@@ -47,6 +52,8 @@ bool TopLevelGauss::toplevelgauss(const vector<Xor>& _xors, vector<Lit>* _out_ch
     runStats.clear();
     runStats.numCalls = 1;
     xors = _xors;
+    sparse_budget = solver->conf.xor_sparse_gauss_time_limitM*1000LL*1000LL
+        *solver->conf.global_timeout_multiplier;
 
     size_t origTrailSize = solver->trail_size();
     extractInfo();
@@ -185,17 +192,87 @@ bool TopLevelGauss::extractInfoFromBlock(
     const vector<uint32_t>& thisXors = xors_in_blocks[blockNum];
     assert(thisXors.size() > 1 && "We pre-filter the set such that *every* block contains at least 2 xors");
 
-    //Set up matrix
-    uint64_t numCols = block.size()+1; //we need augmented column
-    uint64_t matSize = numCols*thisXors.size();
-    matSize /= 1000ULL*1000ULL;
-    if (matSize > solver->conf.maxXORMatrix) {
-        //this matrix is way too large, skip :(
-        if (solver->conf.verbosity) {
-            cout << "c skipping matrix " << thisXors.size() << " x " << numCols << " size:" << matSize << endl;
+    //Small, dense blocks go to M4RI, everything else is eliminated sparse
+    uint64_t nonzeros = 0;
+    for(const uint32_t x: thisXors) {
+        nonzeros += xors[x].size();
+    }
+    const double density = (double)nonzeros
+        / ((double)thisXors.size()*(double)block.size());
+
+    #ifdef USE_M4RI
+    const uint64_t matSize = (uint64_t)(block.size()+1)*thisXors.size()
+        /(1000ULL*1000ULL);
+    if (solver->conf.doM4RI
+        && density >= solver->conf.xor_dense_density
+        && matSize <= solver->conf.maxXORMatrix
+    ) {
+        runStats.denseBlocks++;
+        return extractInfoDense(block, thisXors);
+    }
+    #endif
+
+    if (solver->conf.verbosity >= 2) {
+        cout << "c [toplevel-xor] sparse block "
+        << thisXors.size() << " x " << block.size()
+        << " density: " << std::setprecision(4) << density
+        << endl;
+    }
+    runStats.sparseBlocks++;
+    return extractInfoSparse(block, thisXors);
+}
+
+bool TopLevelGauss::extractInfoSparse(
+    const vector<uint32_t>& block
+    , const vector<uint32_t>& thisXors
+) {
+    SparseGauss gauss(block.size());
+    vector<uint32_t> cols;
+    for(const uint32_t x: thisXors) {
+        const Xor& thisXor = xors[x];
+        assert(thisXor.size() > 2 && "All XORs must be larger than 2-long");
+        cols.clear();
+        for(uint32_t v: thisXor) {
+            cols.push_back(outerToInterVarMap[v]);
         }
-        return solver->okay();
+        gauss.add_row(cols, thisXor.rhs);
     }
+
+    if (!gauss.eliminate(sparse_budget)) {
+        runStats.time_outs++;
+    }
+    sparse_budget -= gauss.get_stats().work;
+    runStats.sparseFillIn += gauss.get_stats().fill_in;
+
+    //Rows are sums of the original XORs even after a time-out
+    vector<Lit> lits;
+    if (gauss.inconsistent()) {
+        return add_found_xor(lits, true);
+    }
+    for(size_t i = 0; i < gauss.num_rows(); i++) {
+        const vector<uint32_t>& r = gauss.row(i);
+        if (r.empty() || r.size() > 2) {
+            continue;
+        }
+        lits.clear();
+        for(const uint32_t c: r) {
+            lits.push_back(Lit(interToOUterVarMap[c], false));
+        }
+        if (!add_found_xor(lits, gauss.rhs(i))) {
+            break;
+        }
+    }
+
+    return solver->okay();
+}
+
+#ifdef USE_M4RI
+bool TopLevelGauss::extractInfoDense(
+    const vector<uint32_t>& block
+    , const vector<uint32_t>& thisXors
+) {
+    //Set up matrix
+    uint64_t numCols = block.size()+1; //we need augmented column
     mzd_t *mat = mzd_init(thisXors.size(), numCols);
     assert(mzd_is_zero(mat));
 
@@ -239,43 +316,45 @@ bool TopLevelGauss::extractInfoFromBlock(
 
         //Extract RHS
         const bool rhs = mzd_read_bit(mat, i, numCols-1);
+        if (!add_found_xor(lits, rhs))
+            break;
+    }
 
-        switch(lits.size()) {
-            case 0:
-                //0-long XOR clause is equal to 1? If so, it's UNSAT
-                if (rhs) {
-                    solver->add_xor_clause_inter(lits, 1, false);
-                    assert(!solver->okay());
-                    goto end;
-                }
-                break;
+    //Free mat, and return what need to be returned
+    mzd_free(mat);
 
-            case 1: {
-                runStats.newUnits++;
-                solver->add_xor_clause_inter(lits, rhs, false);
-                if (!solver->okay())
-                    goto end;
-                break;
-            }
+    return solver->okay();
+}
+#endif
 
-            case 2: {
-                runStats.newBins++;
-                out_changed_occur->insert(out_changed_occur->end(), lits.begin(), lits.end());
-                solver->add_xor_clause_inter(lits, rhs, false);
-                if (!solver->okay())
-                    goto end;
-                break;
+bool TopLevelGauss::add_found_xor(vector<Lit>& lits, const bool rhs)
+{
+    switch(lits.size()) {
+        case 0:
+            //0-long XOR clause is equal to 1? If so, it's UNSAT
+            if (rhs) {
+                solver->add_xor_clause_inter(lits, 1, false);
+                assert(!solver->okay());
             }
+            break;
 
-            default:
-                //if resulting xor is larger than 2-long, we cannot extract anything.
-                break;
+        case 1: {
+            runStats.newUnits++;
+            solver->add_xor_clause_inter(lits, rhs, false);
+            break;
         }
-    }
 
-    //Free mat, and return what need to be returned
-    end:
-    mzd_free(mat);
+        case 2: {
+            runStats.newBins++;
+            out_changed_occur->insert(out_changed_occur->end(), lits.begin(), lits.end());
+            solver->add_xor_clause_inter(lits, rhs, false);
+            break;
+        }
+
+        default:
+            //if resulting xor is larger than 2-long, we cannot extract anything.
+            break;
+    }
 
     return solver->okay();
 }
@@ -421,6 +500,13 @@ void TopLevelGauss::Stats::print_short(const Solver* solver) const
     << solver->conf.print_times(blockCutTime)
     << endl;
 
+    cout
+    << "c [xor-m4ri] blcks dense: " << denseBlocks
+    << " sparse: " << sparseBlocks
+    << " sparse fill-in: " << sparseFillIn
+    << " T-out: " << time_outs
+    << endl;
+
     cout
     << "c [xor-m4ri] extr info. "
     << " unit: " << newUnits
@@ -433,15 +519,18 @@ void TopLevelGauss::Stats::print_short(const Solver* solver) const
 TopLevelGauss::Stats& TopLevelGauss::Stats::operator+=(const TopLevelGauss::Stats& other)
 {
     numCalls += other.numCalls;
-    extractTime += other.numCalls;
-    blockCutTime += other.numCalls;
-
-    numVarsInBlocks += other.numCalls;
-    numBlocks += other.numCalls;
-
-    time_outs += other.numCalls;
-    newUnits += other.numCalls;
-    newBins += other.numCalls;
+    extractTime += other.extractTime;
+    blockCutTime += other.blockCutTime;
+
+    numVarsInBlocks += other.numVarsInBlocks;
+    numBlocks += other.numBlocks;
+    denseBlocks += other.denseBlocks;
+    sparseBlocks += other.sparseBlocks;
+    sparseFillIn += other.sparseFillIn;
+
+    time_outs += other.time_outs;
+    newUnits += other.newUnits;
+    newBins += other.newBins;
 
     zeroDepthAssigns += other.zeroDepthAssigns;
     return *this;
@@ -64,6 +64,9 @@ public:
         //XOR stats
         uint64_t numVarsInBlocks = 0;
         uint64_t numBlocks = 0;
+        uint64_t denseBlocks = 0;
+        uint64_t sparseBlocks = 0;
+        uint64_t sparseFillIn = 0;
 
         //Usefulness stats
         uint64_t time_outs = 0;
@@ -84,6 +87,11 @@ private:
     bool extractInfo();
     void cutIntoBlocks(const vector<size_t>& xorsToUse);
     bool extractInfoFromBlock(const vector<uint32_t>& block, const size_t blockNum);
+    bool extractInfoSparse(const vector<uint32_t>& block, const vector<uint32_t>& thisXors);
+    #ifdef USE_M4RI
+    bool extractInfoDense(const vector<uint32_t>& block, const vector<uint32_t>& thisXors);
+    #endif
+    bool add_found_xor(vector<Lit>& lits, const bool rhs);
     void move_xors_into_blocks();
 
     //Major calculated data and indexes to this data
@@ -96,6 +104,7 @@ private:
 
     vector<Xor> xors;
     vector<vector<uint32_t> > xors_in_blocks;
+    int64_t sparse_budget; ///<Work left for the sparse elimination this call
 };
 
 }
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include <iostream>
 #include <iomanip>
 #include <set>
+#include <thread>
 using std::cout;
 using std::endl;
 
@@ -520,9 +521,74 @@ bool VarReplacer::replaceImplicit()
 /**
 @brief Replaces variables in long clauses
 */
+//Replaces the literals of cs[from..to) in-place. The original first two
+//literals of changed clauses are saved, they are still watched.
+void VarReplacer::replace_lits_in_range(
+    const vector<ClOffset>& cs
+    , const size_t from
+    , const size_t to
+    , vector<Lit>& orig_watched
+    , uint64_t& replaced_lits
+) const {
+    for(size_t at = from; at < to; at++) {
+        Clause& c = *solver->cl_alloc.ptr(cs[at]);
+        const Lit origLit1 = c[0];
+        const Lit origLit2 = c[1];
+        bool changed = false;
+        for (Lit& l: c) {
+            if (isReplaced_fast(l)) {
+                changed = true;
+                l = get_lit_replaced_with_fast(l);
+                replaced_lits++;
+            }
+        }
+        if (changed) {
+            orig_watched[at*2] = origLit1;
+            orig_watched[at*2+1] = origLit2;
+        }
+    }
+}
+
+//Only the literal replacement is done in parallel, the rest needs the
+//watchlists and the stats
+void VarReplacer::replace_lits_par(
+    const vector<ClOffset>& cs
+    , vector<Lit>& orig_watched
+) {
+    orig_watched.assign(cs.size()*2, lit_Undef);
+    const size_t num_threads = solver->conf.scc_threads;
+    const size_t chunk = (cs.size() + num_threads - 1)/num_threads;
+    vector<uint64_t> replaced_lits(num_threads, 0);
+
+    vector<std::thread> thds;
+    for(size_t t = 1; t < num_threads; t++) {
+        const size_t from = std::min(t*chunk, cs.size());
+        const size_t to = std::min(from + chunk, cs.size());
+        thds.push_back(std::thread(&VarReplacer::replace_lits_in_range, this
+            , std::cref(cs), from, to, std::ref(orig_watched), std::ref(replaced_lits[t])));
+    }
+    replace_lits_in_range(cs, 0, std::min(chunk, cs.size()), orig_watched, replaced_lits[0]);
+    for(std::thread& t: thds) {
+        t.join();
+    }
+
+    for(const uint64_t r: replaced_lits) {
+        runStats.replacedLits += r;
+    }
+}
+
 bool VarReplacer::replace_set(vector<ClOffset>& cs)
 {
     assert(!solver->drat->something_delayed());
+
+    //With DRAT, the original clause must be logged before it's changed
+    const bool par = solver->conf.scc_threads > 1
+        && !solver->drat->enabled()
+        && cs.size() >= solver->conf.scc_par_min_cls;
+    if (par) {
+        replace_lits_par(cs, par_orig_watched);
+    }
+
     vector<ClOffset>::iterator i = cs.begin();
     vector<ClOffset>::iterator j = i;
     for (vector<ClOffset>::iterator end = cs.end(); i != end; i++) {
@@ -534,16 +600,24 @@ bool VarReplacer::replace_set(vector<ClOffset>& cs)
         assert(c.size() > 2);
 
         bool changed = false;
-        (*solver->drat) << deldelay << c << fin;
-
-        const Lit origLit1 = c[0];
-        const Lit origLit2 = c[1];
-
-        for (Lit& l: c) {
-            if (isReplaced_fast(l)) {
-                changed = true;
-                l = get_lit_replaced_with_fast(l);
-                runStats.replacedLits++;
+        Lit origLit1;
+        Lit origLit2;
+        if (par) {
+            const size_t at = i - cs.begin();
+            origLit1 = par_orig_watched[at*2];
+            origLit2 = par_orig_watched[at*2+1];
+            changed = origLit1 != lit_Undef;
+        } else {
+            (*solver->drat) << deldelay << c << fin;
+            origLit1 = c[0];
+            origLit2 = c[1];
+
+            for (Lit& l: c) {
+                if (isReplaced_fast(l)) {
+                    changed = true;
+                    l = get_lit_replaced_with_fast(l);
+                    runStats.replacedLits++;
+                }
             }
         }
 
@@ -559,6 +633,7 @@ bool VarReplacer::replace_set(vector<ClOffset>& cs)
 
     }
     cs.resize(cs.size() - (i-j));
+    par_orig_watched.clear();
     assert(!solver->drat->something_delayed());
 
     return solver->okay();
@@ -1045,6 +1120,9 @@ bool VarReplacer::replace_if_enough_is_found(const size_t limit, uint64_t* bogop
     scc_finder->performSCC(bogoprops_given);
     if (scc_finder->get_num_binxors_found() < limit) {
         scc_finder->clear_binxors();
+
+        //These SCCs stay, the next search must find them again
+        solver->bins_since_scc_overflow = true;
         return solver->okay();
     }
 
@@ -146,6 +146,18 @@ class VarReplacer
         void checkUnsetSanity();
 
         bool replace_set(vector<ClOffset>& cs);
+        void replace_lits_par(
+            const vector<ClOffset>& cs
+            , vector<Lit>& orig_watched
+        );
+        void replace_lits_in_range(
+            const vector<ClOffset>& cs
+            , const size_t from
+            , const size_t to
+            , vector<Lit>& orig_watched
+            , uint64_t& replaced_lits
+        ) const;
+        vector<Lit> par_orig_watched;
         void attach_delayed_attach();
         void update_all_vardata_activities();
         void update_vardata_and_activities(
@@ -25,22 +25,277 @@ THE SOFTWARE.
 #define __WATCHARRAY_H__
 
 #include "watched.h"
+#include "watchpool.h"
 #include "Vec.h"
 #include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
+#include <new>
 
 namespace CMSat {
 using std::vector;
 
-typedef vec<Watched>& watch_subarray;
-typedef const vec<Watched>& watch_subarray_const;
+/**
+@brief The watchlist of a literal
+
+The same interface as vec<Watched>. The memory comes either from malloc or,
+if a pool is set, from the slab of the pool.
+*/
+class watch_list
+{
+public:
+    Watched* data;
+
+    watch_list() : data(NULL), sz(0), cap(0), pool(NULL) {}
+    ~watch_list()
+    {
+        clear(true);
+    }
+
+    Watched* begin()
+    {
+        return data;
+    }
+    Watched* end()
+    {
+        return data + sz;
+    }
+    const Watched* begin() const
+    {
+        return data;
+    }
+    const Watched* end() const
+    {
+        return data + sz;
+    }
+
+    uint32_t size() const
+    {
+        return sz;
+    }
+    uint32_t capacity() const
+    {
+        return cap;
+    }
+    bool empty() const
+    {
+        return sz == 0;
+    }
+
+    void shrink(uint32_t nelems)
+    {
+        assert(nelems <= sz);
+        sz -= nelems;
+    }
+    void shrink_(uint32_t nelems)
+    {
+        assert(nelems <= sz);
+        sz -= nelems;
+    }
+
+    void push(const Watched& elem)
+    {
+        if (sz == cap) {
+            grow(sz + 1);
+        }
+        data[sz++] = elem;
+    }
+    void pop()
+    {
+        assert(sz > 0);
+        sz--;
+    }
+
+    const Watched& operator[](uint32_t index) const
+    {
+        return data[index];
+    }
+    Watched& operator[](uint32_t index)
+    {
+        return data[index];
+    }
+    const Watched& last() const
+    {
+        return data[sz - 1];
+    }
+    Watched& last()
+    {
+        return data[sz - 1];
+    }
+
+    void resize(uint32_t s)
+    {
+        if (s > cap) {
+            grow(s);
+        }
+        for (uint32_t i = sz; i < s; i++) {
+            new (&data[i]) Watched();
+        }
+        sz = s;
+    }
+
+    void clear(bool dealloc = false)
+    {
+        sz = 0;
+        if (dealloc && data != NULL) {
+            if (pool) {
+                pool->release(data, cap);
+            } else {
+                free(data);
+            }
+            data = NULL;
+            cap = 0;
+        }
+    }
+
+    //Copy&clear, the destination cannot take over the memory of the pool
+    void moveTo(vec<Watched>& dest)
+    {
+        dest.clear();
+        dest.growTo(sz);
+        if (sz > 0) {
+            memcpy(dest.data, data, sz*sizeof(Watched));
+        }
+        clear(true);
+    }
+
+    void swap(watch_list& other)
+    {
+        std::swap(data, other.data);
+        std::swap(sz, other.sz);
+        std::swap(cap, other.cap);
+        std::swap(pool, other.pool);
+    }
+
+    void shrink_to_fit()
+    {
+        if (sz == 0) {
+            clear(true);
+            return;
+        }
+
+        if (pool) {
+            const uint32_t new_cap = WatchPool::round_cap(sz);
+            if (new_cap < cap) {
+                relocate(new_cap);
+            }
+            return;
+        }
+
+        Watched* data2 = (Watched*)realloc(data, sz*sizeof(Watched));
+        if (data2 == NULL) {
+            //We just keep the size then
+            return;
+        }
+        data = data2;
+        cap = sz;
+    }
+
+    //Only while the list holds no memory
+    void set_pool(WatchPool* _pool)
+    {
+        assert(data == NULL);
+        pool = _pool;
+    }
+
+    //Copy into a fresh block, used when the pool is compacted
+    void compact_into_pool(const bool fit)
+    {
+        assert(pool != NULL);
+        if (data == NULL) {
+            return;
+        }
+        if (sz == 0) {
+            pool->release_old(data, cap);
+            data = NULL;
+            cap = 0;
+            return;
+        }
+
+        const uint32_t new_cap = fit ? WatchPool::round_cap(sz) : cap;
+        Watched* data2 = pool->alloc(new_cap);
+        memcpy(data2, data, sz*sizeof(Watched));
+        pool->release_old(data, cap);
+        data = data2;
+        cap = new_cap;
+    }
+
+private:
+    uint32_t sz;
+    uint32_t cap;
+    WatchPool* pool;
+
+    //Don't allow copying (error prone)
+    watch_list(const watch_list&);
+    watch_list& operator=(const watch_list&);
+
+    void relocate(const uint32_t new_cap)
+    {
+        Watched* data2 = pool->alloc(new_cap);
+        if (sz > 0) {
+            memcpy(data2, data, sz*sizeof(Watched));
+        }
+        pool->release(data, cap);
+        pool->count_relocation();
+        data = data2;
+        cap = new_cap;
+    }
+
+    void grow(const uint32_t min_cap)
+    {
+        if (pool) {
+            relocate(WatchPool::round_cap(min_cap));
+            return;
+        }
+
+        //Grow by approximately 3/2, as vec<> does
+        uint64_t new_cap = std::max<uint64_t>((min_cap + 1) & ~1U, (cap + (cap >> 1) + 2) & ~1U);
+        if (new_cap > std::numeric_limits<uint32_t>::max()) {
+            throw std::bad_alloc();
+        }
+        Watched* data2 = (Watched*)realloc(data, new_cap*sizeof(Watched));
+        if (data2 == NULL) {
+            throw std::bad_alloc();
+        }
+        data = data2;
+        cap = new_cap;
+    }
+};
+
+typedef watch_list& watch_subarray;
+typedef const watch_list& watch_subarray_const;
 
 class watch_array
 {
 public:
-    vec<vec<Watched> > watches;
+    vec<watch_list> watches;
     vector<Lit> smudged_list;
     vector<char> smudged;
 
+    watch_array() {}
+    ~watch_array()
+    {
+        //The lists give their memory back to the pool
+        watches.clear(true);
+        delete pool;
+    }
+
+    //Only while there are no watchlists. Must be called before any use.
+    void enable_pool(const HugePages huge_pages)
+    {
+        assert(watches.size() == 0);
+        assert(pool == NULL);
+        pool = new WatchPool;
+        pool->get_pages().set_huge_pages(huge_pages);
+    }
+
+    WatchPool* get_pool() const
+    {
+        return pool;
+    }
+
     void smudge(const Lit lit) {
         if (!smudged[lit.toInt()]) {
             smudged_list.push_back(lit);
@@ -87,7 +342,7 @@ public:
     {
         assert(smudged_list.empty());
         if (watches.size() < new_size) {
-            watches.growTo(new_size);
+            grow_to(new_size);
         } else {
             watches.shrink(watches.size()-new_size);
         }
@@ -97,16 +352,13 @@ public:
     void insert(uint32_t num)
     {
         smudged.insert(smudged.end(), num, false);
-        watches.insert(num);
+        grow_to(watches.size() + num);
     }
 
     size_t mem_used() const
     {
-        double mem = watches.capacity()*sizeof(vec<Watched>);
-        for(size_t i = 0; i < watches.size(); i++) {
-            //1.2 is overhead
-            mem += (double)watches[i].capacity()*(double)sizeof(Watched)*1.2;
-        }
+        size_t mem = watches.capacity()*sizeof(watch_list);
+        mem += mem_used_alloc();
         mem += smudged.capacity()*sizeof(char);
         mem += smudged_list.capacity()*sizeof(Lit);
         return mem;
@@ -121,8 +373,8 @@ public:
     {
         __builtin_prefetch(watches[at].data);
     }
-    typedef vec<Watched>* iterator;
-    typedef const vec<Watched>* const_iterator;
+    typedef watch_list* iterator;
+    typedef const watch_list* const_iterator;
 
     iterator begin()
     {
@@ -146,16 +398,20 @@ public:
 
     void consolidate()
     {
-        /*for(auto& ws: watches) {
-            ws.shrink_to_fit();
-        }*/
+        if (pool && pool->worth_compacting()) {
+            compact_pool(false);
+        }
         watches.shrink_to_fit();
     }
 
     void full_consolidate()
     {
-        for(auto& ws: watches) {
-            ws.shrink_to_fit();
+        if (pool) {
+            compact_pool(true);
+        } else {
+            for(auto& ws: watches) {
+                ws.shrink_to_fit();
+            }
         }
         watches.shrink_to_fit();
     }
@@ -166,6 +422,10 @@ public:
 
     size_t mem_used_alloc() const
     {
+        if (pool) {
+            return pool->mem_used();
+        }
+
         size_t mem = 0;
         for(auto& ws: watches) {
             mem += ws.capacity()*sizeof(Watched);
@@ -177,10 +437,34 @@ public:
     size_t mem_used_array() const
     {
         size_t mem = 0;
-        mem += watches.capacity()*sizeof(vector<Watched>);
+        mem += watches.capacity()*sizeof(watch_list);
         mem += sizeof(watch_array);
         return mem;
     }
+
+private:
+    WatchPool* pool = NULL;
+
+    void grow_to(const size_t new_size)
+    {
+        const size_t old_size = watches.size();
+        watches.growTo(new_size);
+        if (pool) {
+            for(size_t i = old_size; i < new_size; i++) {
+                watches[i].set_pool(pool);
+            }
+        }
+    }
+
+    //Copies the lists in literal order to fresh chunks, frees the old chunks
+    void compact_pool(const bool fit)
+    {
+        pool->start_compaction();
+        for(auto& ws: watches) {
+            ws.compact_into_pool(fit);
+        }
+        pool->finish_compaction();
+    }
 };
 
 inline void swap(watch_subarray a, watch_subarray b)
@@ -0,0 +1,181 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "watchpool.h"
+#include "watched.h"
+#include <cstdlib>
+#include <cassert>
+#include <new>
+
+using namespace CMSat;
+
+WatchPool::WatchPool()
+{
+    for(uint32_t i = 0; i <= num_classes; i++) {
+        free_list[i] = NULL;
+    }
+}
+
+WatchPool::~WatchPool()
+{
+    //Large watchlists are freed by their owners, chunks are freed by "pages"
+    assert(stats.large_bytes == 0);
+}
+
+uint32_t WatchPool::round_cap(const uint32_t min_cap)
+{
+    if (min_cap > (1U << 31)) {
+        throw std::bad_alloc();
+    }
+    uint32_t cap = 2;
+    while(cap < min_cap) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+uint32_t WatchPool::class_of(const uint32_t cap)
+{
+    assert(cap >= 2 && (cap & (cap-1)) == 0);
+    return __builtin_ctz(cap);
+}
+
+void WatchPool::new_chunk()
+{
+    //Carve the tail of the current chunk so it is not lost
+    for(uint32_t cls = num_classes; cls >= 1; cls--) {
+        const size_t bytes = (size_t)sizeof(Watched) << cls;
+        while((size_t)(bump_end - bump) >= bytes) {
+            push_free(bump, cls);
+            bump += bytes;
+        }
+    }
+
+    char* p = (char*)pages.alloc(chunk_bytes);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    chunks.push_back(p);
+    stats.chunk_bytes += chunk_bytes;
+    bump = p;
+    bump_end = p + chunk_bytes;
+}
+
+void WatchPool::push_free(char* p, const uint32_t cls)
+{
+    *(char**)p = free_list[cls];
+    free_list[cls] = p;
+    free_bytes += (size_t)sizeof(Watched) << cls;
+}
+
+Watched* WatchPool::alloc(const uint32_t cap)
+{
+    const uint32_t cls = class_of(cap);
+    const size_t bytes = (size_t)cap*sizeof(Watched);
+    if (cls > num_classes) {
+        void* p = malloc(bytes);
+        if (p == NULL) {
+            throw std::bad_alloc();
+        }
+        stats.large_bytes += bytes;
+        return (Watched*)p;
+    }
+
+    char* p = free_list[cls];
+    if (p != NULL) {
+        free_list[cls] = *(char**)p;
+        free_bytes -= bytes;
+    } else {
+        if ((size_t)(bump_end - bump) < bytes) {
+            new_chunk();
+        }
+        p = bump;
+        bump += bytes;
+    }
+    stats.used_bytes += bytes;
+    return (Watched*)p;
+}
+
+void WatchPool::release(Watched* p, const uint32_t cap)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    const uint32_t cls = class_of(cap);
+    const size_t bytes = (size_t)cap*sizeof(Watched);
+    if (cls > num_classes) {
+        free(p);
+        stats.large_bytes -= bytes;
+        return;
+    }
+    push_free((char*)p, cls);
+    stats.used_bytes -= bytes;
+}
+
+void WatchPool::start_compaction()
+{
+    assert(old_chunks.empty());
+    old_chunks.swap(chunks);
+    for(uint32_t i = 0; i <= num_classes; i++) {
+        free_list[i] = NULL;
+    }
+    bump = NULL;
+    bump_end = NULL;
+    free_bytes = 0;
+    stats.used_bytes = 0;
+}
+
+void WatchPool::release_old(Watched* p, const uint32_t cap)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    if (class_of(cap) > num_classes) {
+        free(p);
+        stats.large_bytes -= (size_t)cap*sizeof(Watched);
+    }
+}
+
+void WatchPool::finish_compaction()
+{
+    for(char* p: old_chunks) {
+        pages.dealloc(p);
+        stats.chunk_bytes -= chunk_bytes;
+    }
+    old_chunks.clear();
+    stats.compactions++;
+}
+
+bool WatchPool::worth_compacting() const
+{
+    return chunks.size() > 1 && free_bytes*3 > stats.chunk_bytes;
+}
+
+size_t WatchPool::mem_used() const
+{
+    size_t mem = stats.chunk_bytes + stats.large_bytes;
+    mem += chunks.capacity()*sizeof(char*);
+    return mem;
+}
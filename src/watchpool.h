@@ -0,0 +1,113 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef __WATCHPOOL_H__
+#define __WATCHPOOL_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "pagealloc.h"
+
+namespace CMSat {
+
+using std::vector;
+
+class Watched;
+
+struct WatchPoolStats
+{
+    uint64_t chunk_bytes = 0; ///<all memory of the slab chunks
+    uint64_t used_bytes = 0; ///<handed out to watchlists from the chunks
+    uint64_t large_bytes = 0; ///<watchlists too large for the slab, malloc-ed
+    uint64_t relocations = 0;
+    uint64_t compactions = 0;
+};
+
+/**
+@brief Slab of memory for the watchlists, carved into power-of-two sized blocks
+
+Every block size has its own free list. A growing watchlist is relocated to a
+block of the next size, its old block going to the free list. Compaction
+copies all the watchlists, in literal order, into fresh chunks so that the
+watchlists of neighbouring literals are next to each other in memory.
+*/
+class WatchPool
+{
+public:
+    WatchPool();
+    ~WatchPool();
+    PageAlloc& get_pages();
+
+    //Capacity of the block that holds at least "min_cap" watches
+    static uint32_t round_cap(const uint32_t min_cap);
+
+    //"cap" must be what round_cap() returned
+    Watched* alloc(const uint32_t cap);
+    void release(Watched* p, const uint32_t cap);
+    void count_relocation();
+
+    //Between these, alloc() uses new chunks and release() of old blocks is a no-op
+    void start_compaction();
+    void release_old(Watched* p, const uint32_t cap);
+    void finish_compaction();
+    bool worth_compacting() const;
+
+    const WatchPoolStats& get_stats() const;
+    size_t mem_used() const;
+
+private:
+    static const uint32_t num_classes = 15; ///<blocks of 2^1..2^15 watches
+    static const size_t chunk_bytes = 2ULL*1024ULL*1024ULL;
+    static uint32_t class_of(const uint32_t cap);
+    void new_chunk();
+    void push_free(char* p, const uint32_t cls);
+
+    PageAlloc pages;
+    vector<char*> chunks;
+    vector<char*> old_chunks;
+    char* bump = NULL;
+    char* bump_end = NULL;
+    char* free_list[num_classes+1];
+    WatchPoolStats stats;
+    uint64_t free_bytes = 0;
+};
+
+inline PageAlloc& WatchPool::get_pages()
+{
+    return pages;
+}
+
+inline const WatchPoolStats& WatchPool::get_stats() const
+{
+    return stats;
+}
+
+inline void WatchPool::count_relocation()
+{
+    stats.relocations++;
+}
+
+} //end namespace
+
+#endif //__WATCHPOOL_H__
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "varreplacer.h"
 
 #include <limits>
+#include <thread>
+#include <atomic>
 //#define XOR_DEBUG
 
 using namespace CMSat;
@@ -47,12 +49,9 @@ XorFinder::XorFinder(OccSimplifier* _occsimplifier, Solver* _solver) :
     tmp_vars_xor_two.reserve(2000);
 }
 
+//Clauses already used by find_xors_based_on_buckets() are marked and skipped
 void XorFinder::find_xors_based_on_long_clauses()
 {
-    #ifdef DEBUG_MARKED_CLAUSE
-    assert(solver->no_marked_clauses());
-    #endif
-
     vector<Lit> lits;
     for (vector<ClOffset>::iterator
         it = occsimplifier->clauses.begin()
@@ -100,6 +99,201 @@ void XorFinder::find_xors_based_on_long_clauses()
     }
 }
 
+//A fully encoded XOR of size k is 2^(k-1) clauses over the same vars.
+//Clauses are bucketed by the hash of their vars and their size, and only
+//buckets large enough to hold such an encoding are checked, possibly in
+//parallel. The clauses used are marked, so the occurrence-based search
+//afterwards only spends its budget on the XORs encoded with shorter clauses
+void XorFinder::find_xors_based_on_buckets()
+{
+    vector<BucketCl> cands;
+    for (const ClOffset offset: occsimplifier->clauses) {
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        xor_find_time_limit -= 1;
+        if (cl->freed() || cl->getRemoved() || cl->red()
+            || cl->size() < 3
+            || cl->size() > solver->conf.maxXorToFind
+        ) {
+            continue;
+        }
+
+        uint64_t hash = cl->size();
+        for (const Lit l: *cl) {
+            hash = (hash ^ l.var()) * 0x100000001b3ULL;
+        }
+        BucketCl c;
+        c.hash = hash;
+        c.size = cl->size();
+        c.offset = offset;
+        cands.push_back(c);
+    }
+    std::sort(cands.begin(), cands.end());
+    xor_find_time_limit -= (int64_t)cands.size()*4;
+
+    //Chunks end at bucket boundaries, so they can be checked independently
+    const uint32_t num_threads = std::max(1U, solver->conf.xor_find_threads);
+    const size_t chunk_size = cands.size()/(num_threads*8) + 1;
+    vector<size_t> chunk_start(1, 0);
+    for (size_t i = chunk_size; i < cands.size(); i++) {
+        if (i - chunk_start.back() >= chunk_size
+            && cands[i-1] < cands[i]
+        ) {
+            chunk_start.push_back(i);
+        }
+    }
+    chunk_start.push_back(cands.size());
+
+    const size_t num_chunks = chunk_start.size()-1;
+    vector<vector<BucketXor> > found(num_chunks);
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+        for(size_t k = next++; k < num_chunks; k = next++) {
+            check_buckets(cands, chunk_start[k], chunk_start[k+1], found[k]);
+        }
+    };
+    vector<std::thread> thds;
+    for(uint32_t i = 1; i < num_threads && i < num_chunks; i++) {
+        thds.push_back(std::thread(work));
+    }
+    work();
+    for(std::thread& t: thds) {
+        t.join();
+    }
+
+    //Applied in the order of the chunks, so the result is independent of
+    //the threads
+    for(const vector<BucketXor>& fs: found) {
+        for(const BucketXor& f: fs) {
+            for(const ClOffset offs: f.offsets) {
+                Clause* cl = solver->cl_alloc.ptr(offs);
+                cl->stats.marked_clause = true;
+                cl->set_used_in_xor(true);
+                cl->set_used_in_xor_full(true);
+            }
+            add_found_xor(f.found);
+            runStats.bucketXors++;
+            runStats.bucketCls += f.offsets.size();
+            xor_find_time_limit -= f.offsets.size();
+        }
+    }
+}
+
+void XorFinder::check_buckets(
+    const vector<BucketCl>& cands
+    , const size_t from
+    , const size_t to
+    , vector<BucketXor>& found
+) const {
+    vector<const Clause*> cls;
+    vector<ClOffset> offsets;
+    vector<size_t> order;
+    for(size_t i = from; i < to;) {
+        size_t end = i+1;
+        while(end < to && !(cands[i] < cands[end])) {
+            end++;
+        }
+
+        //Too few clauses for a full encoding
+        const uint32_t size = cands[i].size;
+        if (end - i < (1ULL << (size-1))) {
+            i = end;
+            continue;
+        }
+
+        //Separate the hash collisions by sorting on the vars
+        order.clear();
+        for(size_t j = i; j < end; j++) {
+            order.push_back(j);
+        }
+        std::sort(order.begin(), order.end(),
+            [&](const size_t a, const size_t b) {
+                const Clause& ca = *solver->cl_alloc.ptr(cands[a].offset);
+                const Clause& cb = *solver->cl_alloc.ptr(cands[b].offset);
+                for(uint32_t k = 0; k < size; k++) {
+                    if (ca[k].var() != cb[k].var()) {
+                        return ca[k].var() < cb[k].var();
+                    }
+                }
+                return a < b;
+            }
+        );
+
+        cls.clear();
+        offsets.clear();
+        for(size_t j = 0; j < order.size(); j++) {
+            const Clause* cl = solver->cl_alloc.ptr(cands[order[j]].offset);
+            bool same = !cls.empty();
+            for(uint32_t k = 0; same && k < size; k++) {
+                same = (*cl)[k].var() == (*cls[0])[k].var();
+            }
+            if (!same) {
+                check_same_vars(cls, offsets, found);
+                cls.clear();
+                offsets.clear();
+            }
+            cls.push_back(cl);
+            offsets.push_back(cands[order[j]].offset);
+        }
+        check_same_vars(cls, offsets, found);
+        i = end;
+    }
+}
+
+//Clauses are sorted, so bit i of the sign pattern belongs to the i-th var
+void XorFinder::check_same_vars(
+    const vector<const Clause*>& cls
+    , const vector<ClOffset>& offsets
+    , vector<BucketXor>& found
+) const {
+    if (cls.empty()) {
+        return;
+    }
+    const uint32_t size = cls[0]->size();
+    const uint32_t needed = 1U << (size-1);
+    if (cls.size() < needed) {
+        return;
+    }
+
+    vector<char> comb(1U << size, 0);
+    uint32_t num[2] = {0, 0};
+    for(const Clause* cl: cls) {
+        uint32_t which = 0;
+        for(uint32_t k = 0; k < size; k++) {
+            if (k > 0 && (*cl)[k-1].var() >= (*cl)[k].var()) {
+                //Not sorted, leave it to the occurrence-based search
+                return;
+            }
+            which |= (uint32_t)(*cl)[k].sign() << k;
+        }
+        if (!comb[which]) {
+            comb[which] = 1;
+            num[__builtin_popcount(which) & 1]++;
+        }
+    }
+
+    for(uint32_t parity = 0; parity < 2; parity++) {
+        if (num[parity] != needed) {
+            continue;
+        }
+        BucketXor f;
+        vector<uint32_t> vars;
+        for(const Lit l: *cls[0]) {
+            vars.push_back(l.var());
+        }
+        f.found = Xor(vars, parity == 0, vector<uint32_t>());
+        for(size_t i = 0; i < cls.size(); i++) {
+            uint32_t signs = 0;
+            for(const Lit l: *cls[i]) {
+                signs += l.sign();
+            }
+            if ((signs & 1) == parity) {
+                f.offsets.push_back(offsets[i]);
+            }
+        }
+        found.push_back(f);
+    }
+}
+
 void XorFinder::clean_equivalent_xors(vector<Xor>& txors)
 {
     if (!txors.empty()) {
@@ -176,6 +370,9 @@ void XorFinder::find_xors()
     assert(solver->no_marked_clauses());
     #endif
 
+    if (solver->conf.xor_find_buckets) {
+        find_xors_based_on_buckets();
+    }
     find_xors_based_on_long_clauses();
     assert(runStats.foundXors == xors.size());
 
@@ -991,7 +1188,8 @@ void XorFinder::Stats::print_short(const Solver* solver, double time_remain) con
         << " min sz " << std::setw(2) << std::fixed << std::setprecision(1)
         << minsize
         << " max sz " << std::setw(2) << std::fixed << std::setprecision(1)
-        << maxsize;
+        << maxsize
+        << " bucketed " << bucketXors;
     }
     cout
     << solver->conf.print_times(findTime, time_outs, time_remain)
@@ -1005,6 +1203,8 @@ XorFinder::Stats& XorFinder::Stats::operator+=(const XorFinder::Stats& other)
 
     //XOR
     foundXors += other.foundXors;
+    bucketXors += other.bucketXors;
+    bucketCls += other.bucketCls;
     sumSizeXors += other.sumSizeXors;
 
     //Usefulness
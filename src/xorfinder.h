@@ -172,6 +172,8 @@ public:
 
         //XOR stats
         uint64_t foundXors = 0;
+        uint64_t bucketXors = 0;
+        uint64_t bucketCls = 0;
         uint64_t sumSizeXors = 0;
         uint32_t minsize = std::numeric_limits<uint32_t>::max();
         uint32_t maxsize = std::numeric_limits<uint32_t>::min();
@@ -192,6 +194,39 @@ private:
     PossibleXor poss_xor;
     void add_found_xor(const Xor& found_xor);
     void find_xors_based_on_long_clauses();
+
+    //Fully encoded XORs, found by grouping clauses on the same variables
+    struct BucketCl
+    {
+        uint64_t hash;
+        uint32_t size;
+        ClOffset offset;
+
+        bool operator<(const BucketCl& other) const
+        {
+            if (hash != other.hash) {
+                return hash < other.hash;
+            }
+            return size < other.size;
+        }
+    };
+    struct BucketXor
+    {
+        Xor found;
+        vector<ClOffset> offsets;
+    };
+    void find_xors_based_on_buckets();
+    void check_buckets(
+        const vector<BucketCl>& cands
+        , const size_t from
+        , const size_t to
+        , vector<BucketXor>& found
+    ) const;
+    void check_same_vars(
+        const vector<const Clause*>& cls
+        , const vector<ClOffset>& offsets
+        , vector<BucketXor>& found
+    ) const;
     void print_found_xors();
     bool xor_has_interesting_var(const Xor& x);
     void clean_xors_from_empty(vector<Xor>& thisxors);
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "gtest/gtest.h"
 
 #include <fstream>
+#include <random>
 
 #include "cryptominisat5/cryptominisat.h"
 #include "src/solverconf.h"
@@ -663,6 +664,58 @@ TEST(xor_interface, xor3)
     EXPECT_EQ( pairs.size(), 2u);
 }
 
+//Matrices are kept across the solve calls and updated with the new XORs
+TEST(xor_interface, xor_incremental_kept_matrices)
+{
+    SolverConf conf;
+    conf.simplify_at_every_startup = true;
+    conf.gaussconf.autodisable = false;
+    SATSolver s(&conf);
+    const uint32_t n = 14;
+    s.new_vars(n);
+
+    std::mt19937 mtrand(3);
+    vector<std::pair<uint32_t, bool> > xors;
+    for(uint32_t round = 0; round < 12; round++) {
+        for(uint32_t i = 0; i < 2; i++) {
+            vector<uint32_t> vars;
+            uint32_t mask = 0;
+            while(vars.size() < 3 + mtrand() % 2) {
+                const uint32_t v = mtrand() % n;
+                if (!(mask & (1U << v))) {
+                    vars.push_back(v);
+                    mask |= 1U << v;
+                }
+            }
+            const bool rhs = mtrand() & 1;
+            s.add_xor_clause(vars, rhs);
+            xors.push_back(std::make_pair(mask, rhs));
+        }
+        const vector<Lit> assumps {Lit(mtrand() % n, mtrand() & 1)};
+
+        bool sat = false;
+        for(uint32_t a = 0; a < (1U << n) && !sat; a++) {
+            bool ok = ((a >> assumps[0].var()) & 1) != assumps[0].sign();
+            for(const auto& x: xors) {
+                ok &= (__builtin_popcount(a & x.first) & 1) == x.second;
+            }
+            sat |= ok;
+        }
+
+        lbool ret = s.solve(&assumps);
+        ASSERT_EQ(ret, sat ? l_True : l_False);
+        if (ret == l_True) {
+            uint32_t a = 0;
+            for(uint32_t v = 0; v < n; v++) {
+                a |= (uint32_t)(s.get_model()[v] == l_True) << v;
+            }
+            for(const auto& x: xors) {
+                EXPECT_EQ((__builtin_popcount(a & x.first) & 1) == 1, x.second);
+            }
+        }
+    }
+}
+
 TEST(error_throw, multithread_newvar)
 {
     SATSolver s;
@@ -801,6 +854,112 @@ TEST(statistics, last_vs_sum_conflicts)
     EXPECT_EQ(s.get_last_conflicts(), 2);
 }
 
+TEST(statistics, phases)
+{
+    SATSolver s;
+    s.set_no_simplify();
+    s.new_vars(10);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("1, -2"));
+    s.add_clause(str_to_cl("-1, 2"));
+
+    lbool ret = s.solve();
+    EXPECT_EQ(ret, l_True);
+    SolverStats stats = s.get_stats();
+    ASSERT_EQ(stats.threads.size(), 1);
+    EXPECT_EQ(stats.total.conflicts, 1);
+    EXPECT_EQ(stats.total.phases["analyze"].calls, 1);
+    EXPECT_EQ(stats.total.phases["minimize"].calls, 1);
+    EXPECT_GT(stats.total.phases["propagate"].calls, 0);
+    EXPECT_GT(stats.total.phases["search"].time, 0);
+
+    double sum = 0;
+    for(const auto& p: stats.total.phases) {
+        EXPECT_GE(p.second.time, 0);
+        sum += p.second.time;
+    }
+    EXPECT_GT(sum, 0);
+}
+
+TEST(statistics, last_vs_sum_phases)
+{
+    SATSolver s;
+    s.set_no_simplify();
+    s.new_vars(10);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("1, -2"));
+    s.add_clause(str_to_cl("-1, 2"));
+    s.add_clause(str_to_cl("-1, -2"));
+
+    s.set_max_confl(0);
+    lbool ret = s.solve();
+    EXPECT_EQ(ret, l_Undef);
+    SolverStats first = s.get_stats();
+    EXPECT_EQ(first.total.phases["analyze"].calls, 0);
+
+    s.set_max_confl(2);
+    ret = s.solve();
+    EXPECT_EQ(ret, l_False);
+    SolverStats last = s.get_last_stats();
+    SolverStats sum = s.get_stats();
+    EXPECT_EQ(last.total.conflicts, 2);
+    EXPECT_EQ(last.total.phases["analyze"].calls, 2);
+    EXPECT_EQ(sum.total.phases["analyze"].calls, 2);
+    EXPECT_LT(last.total.phases["search"].time, sum.total.phases["search"].time);
+    EXPECT_GT(first.total.phases["search"].time, 0);
+}
+
+TEST(statistics, phases_simplify)
+{
+    SATSolver s;
+    s.new_vars(10);
+    s.add_clause(str_to_cl("1, 2, 3"));
+    s.add_clause(str_to_cl("-1, 2, 4"));
+    s.add_clause(str_to_cl("-2, 3, 5"));
+    s.add_clause(str_to_cl("-3, -4, 6"));
+
+    lbool ret = s.simplify();
+    EXPECT_EQ(ret, l_Undef);
+    SolverStats stats = s.get_stats();
+    ASSERT_EQ(stats.threads.size(), 1);
+    EXPECT_EQ(stats.total.phases["inprocess"].calls, 1);
+    EXPECT_GT(stats.total.phases["inprocess"].time, 0);
+    EXPECT_FALSE(stats.total.techniques.empty());
+    EXPECT_GE(stats.total.cpu_time, 0);
+
+    double tech_sum = 0;
+    for(const auto& p: stats.total.techniques) {
+        EXPECT_GT(p.second.calls, 0);
+        tech_sum += p.second.time;
+    }
+    EXPECT_LE(tech_sum, stats.total.phases["inprocess"].time);
+}
+
+TEST(statistics, last_vs_sum_phases_simplify)
+{
+    SATSolver s;
+    s.new_vars(10);
+    s.add_clause(str_to_cl("1, 2, 3"));
+    s.add_clause(str_to_cl("-1, 2, 4"));
+    s.add_clause(str_to_cl("-2, 3, 5"));
+
+    lbool ret = s.simplify();
+    EXPECT_EQ(ret, l_Undef);
+    SolverStats first = s.get_stats();
+    EXPECT_EQ(first.total.phases["inprocess"].calls, 1);
+
+    s.add_clause(str_to_cl("-3, -4, 6"));
+    ret = s.simplify();
+    EXPECT_EQ(ret, l_Undef);
+    SolverStats last = s.get_last_stats();
+    SolverStats sum = s.get_stats();
+    EXPECT_EQ(last.total.phases["inprocess"].calls, 1);
+    EXPECT_EQ(sum.total.phases["inprocess"].calls, 2);
+    EXPECT_GT(last.total.phases["inprocess"].time, 0);
+    EXPECT_LT(last.total.phases["inprocess"].time, sum.total.phases["inprocess"].time);
+    EXPECT_LE(last.total.cpu_time, sum.total.cpu_time);
+}
+
 TEST(propagate, trivial_1)
 {
     SATSolver s;
@@ -952,6 +1111,43 @@ TEST(sampling, indep2)
 }
 
 
+TEST(sampling, extend_vars)
+{
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    SATSolver s(&conf);
+
+    //Chains of implications get eliminated
+    s.new_vars(30);
+    for(uint32_t i = 0; i < 29; i++) {
+        s.add_clause(vector<Lit>{Lit(i, true), Lit(i+1, false)});
+    }
+    s.add_clause(str_to_cl("1, 15, -30"));
+
+    vector<uint32_t> x{10U, 20U};
+    s.set_extend_vars(&x);
+    vector<Lit> assumps{Lit(5, false)};
+    lbool ret = s.solve(&assumps);
+    EXPECT_EQ(ret, l_True);
+    EXPECT_EQ(s.get_model()[5], l_True);
+    EXPECT_EQ(s.get_model()[10], l_True);
+    EXPECT_EQ(s.get_model()[20], l_True);
+
+    ret = s.solve();
+    EXPECT_EQ(ret, l_True);
+    assumps.clear();
+    for(uint32_t v: x) {
+        ASSERT_NE(s.get_model()[v], l_Undef);
+        assumps.push_back(Lit(v, s.get_model()[v] == l_False));
+    }
+    s.set_extend_vars(NULL);
+    ret = s.solve(&assumps);
+    EXPECT_EQ(ret, l_True);
+    for(uint32_t i = 0; i < 30; i++) {
+        EXPECT_NE(s.get_model()[i], l_Undef);
+    }
+}
+
 
 TEST(xor_recovery, find_1_3_xor)
 {
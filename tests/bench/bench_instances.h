@@ -0,0 +1,207 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef CMSAT_BENCH_INSTANCES_H
+#define CMSAT_BENCH_INSTANCES_H
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+
+//Generated instances shared by the micro- and the macro-benchmarks. Only the
+//raw output of std::mt19937 is used, so the instances are the same with
+//every standard library.
+namespace CMSatBench {
+
+using std::vector;
+using std::string;
+
+struct Instance
+{
+    string name;
+    uint32_t num_vars = 0;
+    vector<vector<int> > clauses;
+    vector<std::pair<vector<int>, bool> > xors;
+
+    string to_dimacs() const
+    {
+        std::stringstream ss;
+        ss << "p cnf " << num_vars << " " << clauses.size() + xors.size() << "\n";
+        for(const auto& cl: clauses) {
+            for(const int l: cl) {
+                ss << l << " ";
+            }
+            ss << "0\n";
+        }
+        for(const auto& x: xors) {
+            ss << "x";
+            for(size_t i = 0; i < x.first.size(); i++) {
+                const int v = x.first[i];
+                ss << ((i == 0 && !x.second) ? -v : v) << " ";
+            }
+            ss << "0\n";
+        }
+        return ss.str();
+    }
+};
+
+inline uint32_t rnd_below(std::mt19937& rnd, const uint32_t n)
+{
+    return rnd() % n;
+}
+
+//k distinct variables, random signs
+inline vector<int> random_clause(std::mt19937& rnd, const uint32_t num_vars, const uint32_t k)
+{
+    vector<int> cl;
+    while(cl.size() < k) {
+        const int v = rnd_below(rnd, num_vars) + 1;
+        bool dup = false;
+        for(const int l: cl) {
+            dup |= (l == v || l == -v);
+        }
+        if (!dup) {
+            cl.push_back((rnd() & 1) ? v : -v);
+        }
+    }
+    return cl;
+}
+
+inline Instance random_ksat(
+    const uint32_t num_vars
+    , const double ratio
+    , const uint32_t k
+    , const uint32_t seed
+) {
+    Instance inst;
+    std::stringstream name;
+    name << "rnd" << k << "sat-n" << num_vars << "-r" << ratio << "-s" << seed;
+    inst.name = name.str();
+    inst.num_vars = num_vars;
+
+    std::mt19937 rnd(seed);
+    const uint64_t num_cls = (uint64_t)(ratio*(double)num_vars);
+    for(uint64_t i = 0; i < num_cls; i++) {
+        inst.clauses.push_back(random_clause(rnd, num_vars, k));
+    }
+    return inst;
+}
+
+//Random XORs over a planted solution, so it is always satisfiable. With
+//as_cnf the XORs are given as their CNF encoding, to be recovered
+inline Instance planted_xor(
+    const uint32_t num_vars
+    , const uint32_t num_xors
+    , const uint32_t xor_len
+    , const uint32_t num_extra_cls
+    , const bool as_cnf
+    , const uint32_t seed
+) {
+    Instance inst;
+    std::stringstream name;
+    name << "xor" << xor_len << "-n" << num_vars << "-x" << num_xors
+    << "-c" << num_extra_cls << (as_cnf ? "-cnf" : "") << "-s" << seed;
+    inst.name = name.str();
+    inst.num_vars = num_vars;
+
+    std::mt19937 rnd(seed);
+    vector<bool> sol(num_vars+1);
+    for(uint32_t i = 1; i <= num_vars; i++) {
+        sol[i] = rnd() & 1;
+    }
+
+    for(uint32_t i = 0; i < num_xors; i++) {
+        vector<int> vars = random_clause(rnd, num_vars, xor_len);
+        bool rhs = false;
+        for(int& v: vars) {
+            v = std::abs(v);
+            rhs ^= sol[v];
+        }
+
+        if (!as_cnf) {
+            inst.xors.push_back(std::make_pair(vars, rhs));
+            continue;
+        }
+        for(uint32_t signs = 0; signs < (1U << xor_len); signs++) {
+            //A clause is falsified only by setting every variable to its
+            //sign, so it bans exactly one assignment. Ban the wrong parities
+            bool parity = false;
+            vector<int> cl;
+            for(uint32_t j = 0; j < xor_len; j++) {
+                const bool neg = (signs >> j) & 1;
+                parity ^= neg;
+                cl.push_back(neg ? -vars[j] : vars[j]);
+            }
+            if (parity != rhs) {
+                inst.clauses.push_back(cl);
+            }
+        }
+    }
+
+    //Clauses satisfied by the planted solution
+    uint32_t extra = 0;
+    while(extra < num_extra_cls) {
+        const vector<int> cl = random_clause(rnd, num_vars, 3);
+        for(const int l: cl) {
+            if (sol[std::abs(l)] == (l > 0)) {
+                inst.clauses.push_back(cl);
+                extra++;
+                break;
+            }
+        }
+    }
+    return inst;
+}
+
+//num_holes+1 pigeons into num_holes holes, unsatisfiable
+inline Instance pigeonhole(const uint32_t num_holes)
+{
+    Instance inst;
+    inst.name = "php-" + std::to_string(num_holes+1) + "-" + std::to_string(num_holes);
+    const uint32_t pigeons = num_holes+1;
+    inst.num_vars = pigeons*num_holes;
+    auto var = [=](uint32_t p, uint32_t h) {return (int)(p*num_holes + h + 1);};
+
+    for(uint32_t p = 0; p < pigeons; p++) {
+        vector<int> cl;
+        for(uint32_t h = 0; h < num_holes; h++) {
+            cl.push_back(var(p, h));
+        }
+        inst.clauses.push_back(cl);
+    }
+    for(uint32_t h = 0; h < num_holes; h++) {
+        for(uint32_t p1 = 0; p1 < pigeons; p1++) {
+            for(uint32_t p2 = p1+1; p2 < pigeons; p2++) {
+                inst.clauses.push_back(vector<int>{-var(p1, h), -var(p2, h)});
+            }
+        }
+    }
+    return inst;
+}
+
+}
+
+#endif //CMSAT_BENCH_INSTANCES_H
@@ -0,0 +1,137 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#ifndef CMSAT_BENCH_SOLVER_H
+#define CMSAT_BENCH_SOLVER_H
+
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+
+#include "src/solver.h"
+#include "src/solverconf.h"
+#include "bench_instances.h"
+
+namespace CMSatBench {
+
+using namespace CMSat;
+
+inline SolverConf bench_conf()
+{
+    SolverConf conf;
+    conf.verbosity = 0;
+    return conf;
+}
+
+//Drives the internals of the solver directly, without simplification
+class BenchSolver : public Solver
+{
+public:
+    BenchSolver(const SolverConf* _conf, std::atomic<bool>* _must_interrupt) :
+        Solver(_conf, _must_interrupt)
+    {}
+
+    void load(const Instance& inst)
+    {
+        new_vars(inst.num_vars);
+        vector<Lit> lits;
+        for(const auto& cl: inst.clauses) {
+            lits.clear();
+            for(const int l: cl) {
+                lits.push_back(Lit(std::abs(l)-1, l < 0));
+            }
+            add_clause_outer(lits);
+        }
+        order.resize(nVars());
+        for(uint32_t i = 0; i < nVars(); i++) {
+            order[i] = i;
+        }
+        std::mt19937 rnd(1);
+        std::shuffle(order.begin(), order.end(), rnd);
+    }
+
+    //Makes decisions in a fixed order until a conflict or the end of the
+    //variables is reached. Returns the conflict, if any
+    PropBy decide_until_conflict()
+    {
+        for(; at < order.size(); at++) {
+            const uint32_t var = order[at];
+            if (value(var) != l_Undef) {
+                continue;
+            }
+            new_decision_level();
+            enqueue<false>(Lit(var, at % 2));
+            PropBy confl = propagate<false>();
+            if (!confl.isNULL()) {
+                at++;
+                return confl;
+            }
+        }
+        return PropBy();
+    }
+
+    //Conflict analysis is protected in Searcher.
+    //Returns FALSE if the conflict is at level 0
+    bool analyze(PropBy confl)
+    {
+        ConflictData data = find_conflict_level(confl);
+        if (data.nHighestLevel == 0) {
+            return false;
+        }
+
+        uint32_t backtrack_level;
+        uint32_t glue;
+        uint32_t glue_before_minim;
+        analyze_conflict<false>(confl, backtrack_level, glue, glue_before_minim);
+        return true;
+    }
+
+    size_t learnt_size() const
+    {
+        return learnt_clause.size();
+    }
+
+    void restart()
+    {
+        cancelUntil(0);
+        if (at >= order.size()) {
+            at = 0;
+        }
+    }
+
+    //Bytes taken by the clauses and their watches, without the
+    //preallocated but unused part of the clause memory
+    uint64_t clause_mem() const
+    {
+        return cl_alloc.live_bytes() + watches.mem_used_alloc();
+    }
+
+private:
+    vector<uint32_t> order;
+    size_t at = 0;
+};
+
+}
+
+#endif //CMSAT_BENCH_SOLVER_H
@@ -0,0 +1,263 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+
+#include "cryptominisat5/cryptominisat.h"
+#include "bench_instances.h"
+#include "bench_solver.h"
+#include "src/streambuffer.h"
+#include "src/dimacsparser.h"
+
+using namespace CMSat;
+using namespace CMSatBench;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace {
+
+struct MacroCase
+{
+    Instance inst;
+    int64_t max_confl;
+};
+
+//Fixed set of instances. The conflict limits keep the amount of work the same
+//even if a change makes an instance easier or harder to solve.
+vector<MacroCase> macro_suite()
+{
+    vector<MacroCase> suite;
+    suite.push_back(MacroCase{random_ksat(400, 4.26, 3, 10), 30000});
+    suite.push_back(MacroCase{random_ksat(20000, 4.0, 3, 11), 10000});
+    suite.push_back(MacroCase{random_ksat(130, 20.0, 5, 12), 30000});
+    suite.push_back(MacroCase{pigeonhole(9), 30000});
+    suite.push_back(MacroCase{planted_xor(2000, 1900, 4, 0, true, 13), 100000});
+    suite.push_back(MacroCase{planted_xor(3000, 2800, 3, 4000, false, 14), 100000});
+    return suite;
+}
+
+struct MacroResult
+{
+    string name;
+    uint32_t vars = 0;
+    uint64_t clauses = 0;
+    uint64_t xors = 0;
+    uint64_t dimacs_bytes = 0;
+    lbool result = l_Undef;
+    double parse_time = 0;
+    double solve_time = 0;
+    uint64_t clause_mem = 0;
+    ThreadStats stats;
+};
+
+double seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+MacroResult run_case(const MacroCase& c, const uint32_t repeat, const double confl_mult)
+{
+    MacroResult res;
+    res.name = c.inst.name;
+    res.vars = c.inst.num_vars;
+    res.clauses = c.inst.clauses.size();
+    res.xors = c.inst.xors.size();
+    const string text = c.inst.to_dimacs();
+    res.dimacs_bytes = text.size();
+
+    {
+        SolverConf conf = bench_conf();
+        std::atomic<bool> must_inter(false);
+        BenchSolver s(&conf, &must_inter);
+        s.load(c.inst);
+        res.clause_mem = s.clause_mem();
+    }
+
+    //Best of "repeat" runs. With one thread the search is deterministic, so
+    //the counters are the same for each run
+    for(uint32_t i = 0; i < repeat; i++) {
+        SATSolver solver;
+        solver.set_max_confl(std::max<int64_t>(1, c.max_confl*confl_mult));
+
+        auto start = std::chrono::steady_clock::now();
+        DimacsParser<StreamBuffer<const char*, CH>, SATSolver> parser(&solver, NULL, 0);
+        if (!parser.parse_DIMACS(text.c_str(), true)) {
+            cerr << "ERROR: could not parse generated instance " << c.inst.name << endl;
+            exit(-1);
+        }
+        const double parse_time = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        const lbool ret = solver.solve();
+        const double solve_time = seconds_since(start);
+
+        if (i == 0 || parse_time < res.parse_time) {
+            res.parse_time = parse_time;
+        }
+        if (i == 0 || solve_time < res.solve_time) {
+            res.solve_time = solve_time;
+            res.result = ret;
+            res.stats = solver.get_stats().total;
+        }
+    }
+
+    return res;
+}
+
+double safe_div(const double a, const double b)
+{
+    return b == 0 ? 0 : a/b;
+}
+
+string result_str(const lbool r)
+{
+    if (r == l_True) return "SAT";
+    if (r == l_False) return "UNSAT";
+    return "UNKNOWN";
+}
+
+void print_phases(std::ostream& out, const std::map<string, PhaseStats>& phases)
+{
+    bool first = true;
+    for(const auto& p: phases) {
+        out << (first ? "" : ",") << "\n        \"" << p.first << "\": {"
+        << "\"calls\": " << p.second.calls
+        << ", \"time\": " << p.second.time << "}";
+        first = false;
+    }
+}
+
+void write_json(std::ostream& out, const vector<MacroResult>& results, const uint32_t repeat)
+{
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"version\": \"" << SATSolver::get_version() << "\",\n";
+    out << "  \"sha1\": \"" << SATSolver::get_version_sha1() << "\",\n";
+    out << "  \"repeat\": " << repeat << ",\n";
+    out << "  \"instances\": [";
+    for(size_t i = 0; i < results.size(); i++) {
+        const MacroResult& r = results[i];
+        const ThreadStats& st = r.stats;
+        const PhaseStats gauss = st.phases.count("gauss") ? st.phases.at("gauss") : PhaseStats();
+        out << (i == 0 ? "" : ",") << "\n    {\n";
+        out << "      \"name\": \"" << r.name << "\",\n";
+        out << "      \"vars\": " << r.vars << ",\n";
+        out << "      \"clauses\": " << r.clauses << ",\n";
+        out << "      \"xors\": " << r.xors << ",\n";
+        out << "      \"result\": \"" << result_str(r.result) << "\",\n";
+        out << "      \"parse_time\": " << r.parse_time << ",\n";
+        out << "      \"parse_mb_per_sec\": " << safe_div(r.dimacs_bytes/(1024.0*1024.0), r.parse_time) << ",\n";
+        out << "      \"solve_time\": " << r.solve_time << ",\n";
+        out << "      \"cpu_time\": " << st.cpu_time << ",\n";
+        out << "      \"conflicts\": " << st.conflicts << ",\n";
+        out << "      \"propagations\": " << st.propagations << ",\n";
+        out << "      \"decisions\": " << st.decisions << ",\n";
+        out << "      \"conflicts_per_sec\": " << safe_div(st.conflicts, r.solve_time) << ",\n";
+        out << "      \"props_per_sec\": " << safe_div(st.propagations, r.solve_time) << ",\n";
+        out << "      \"gauss_calls_per_sec\": " << safe_div(gauss.calls, gauss.time) << ",\n";
+        out << "      \"clause_bytes_per_clause\": " << safe_div(r.clause_mem, r.clauses) << ",\n";
+        out << "      \"phases\": {";
+        print_phases(out, st.phases);
+        out << "\n      }\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void print_usage()
+{
+    cout
+    << "Usage: cmsat-bench [google benchmark options]\n"
+    << "       cmsat-bench --macro [--json FILE] [--repeat N] [--filter STR] [--quick]\n"
+    << "\n"
+    << "Without --macro the microbenchmarks are run, see --benchmark_filter,\n"
+    << "--benchmark_format=json etc. With --macro a fixed suite of generated\n"
+    << "instances is solved and the throughput is written as JSON. Compare two\n"
+    << "runs with scripts/speed-check/compare_bench.py\n"
+    << "\n"
+    << "  --json FILE   write the JSON here instead of stdout\n"
+    << "  --repeat N    solve every instance N times, report the best (default 3)\n"
+    << "  --filter STR  only run instances whose name contains STR\n"
+    << "  --quick       10x lower conflict limits, for a smoke test\n";
+}
+
+}
+
+int run_macro_benchmarks(int argc, char** argv)
+{
+    string json_fname;
+    string filter;
+    uint32_t repeat = 3;
+    double confl_mult = 1.0;
+    for(int i = 1; i < argc; i++) {
+        const string arg = argv[i];
+        const bool has_val = i+1 < argc;
+        if (arg == "--macro") {
+            continue;
+        } else if (arg == "--json" && has_val) {
+            json_fname = argv[++i];
+        } else if (arg == "--repeat" && has_val) {
+            repeat = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--filter" && has_val) {
+            filter = argv[++i];
+        } else if (arg == "--quick") {
+            confl_mult = 0.1;
+        } else {
+            print_usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    vector<MacroResult> results;
+    for(const MacroCase& c: macro_suite()) {
+        if (!filter.empty() && c.inst.name.find(filter) == string::npos) {
+            continue;
+        }
+        cerr << "c running " << c.inst.name << " ..." << std::flush;
+        results.push_back(run_case(c, repeat, confl_mult));
+        const MacroResult& r = results.back();
+        cerr << " " << result_str(r.result)
+        << " T: " << std::fixed << std::setprecision(2) << r.solve_time
+        << " confl/s: " << std::setprecision(0) << safe_div(r.stats.conflicts, r.solve_time)
+        << " props/s: " << safe_div(r.stats.propagations, r.solve_time)
+        << endl;
+    }
+
+    if (json_fname.empty()) {
+        write_json(cout, results, repeat);
+    } else {
+        std::ofstream out(json_fname.c_str());
+        if (!out) {
+            cerr << "ERROR: cannot open " << json_fname << " for writing" << endl;
+            return 1;
+        }
+        write_json(out, results, repeat);
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+#include "cryptominisat5/cryptominisat.h"
+#include "bench_instances.h"
+#include "bench_solver.h"
+#include "src/clauseallocator.h"
+#include "src/packedmatrix.h"
+#include "src/streambuffer.h"
+#include "src/dimacsparser.h"
+
+using namespace CMSat;
+using namespace CMSatBench;
+
+namespace {
+
+//3-SAT below the threshold: long propagation chains, conflicts are rare
+void BM_propagate(benchmark::State& state)
+{
+    const Instance inst = random_ksat(state.range(0), 4.0, 3, 1);
+    SolverConf conf = bench_conf();
+    std::atomic<bool> must_inter(false);
+    BenchSolver s(&conf, &must_inter);
+    s.load(inst);
+
+    const uint64_t props_before = s.propStats.propagations;
+    for (auto _ : state) {
+        s.decide_until_conflict();
+        s.restart();
+    }
+    state.counters["props"] = benchmark::Counter(
+        s.propStats.propagations - props_before, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_propagate)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+//Only the analysis is timed, the search for the conflict is not
+void BM_analyze_conflict(benchmark::State& state)
+{
+    const Instance inst = random_ksat(state.range(0), 4.26, 3, 2);
+    SolverConf conf = bench_conf();
+    std::atomic<bool> must_inter(false);
+    BenchSolver s(&conf, &must_inter);
+    s.load(inst);
+
+    uint64_t lits = 0;
+    for (auto _ : state) {
+        PropBy confl;
+        while((confl = s.decide_until_conflict()).isNULL()) {
+            s.restart();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        if (!s.analyze(confl)) {
+            state.SkipWithError("conflict at level 0");
+            break;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+        lits += s.learnt_size();
+        s.restart();
+    }
+    state.counters["learnt_len"] = benchmark::Counter(lits, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_analyze_conflict)->Arg(300)->Arg(3000)->UseManualTime();
+
+void fill_random(PackedMatrix& m, const uint32_t rows, const uint32_t cols, std::mt19937& rnd)
+{
+    m.resize(rows, cols);
+    for(uint32_t r = 0; r < rows; r++) {
+        PackedRow row = m[r];
+        row.setZero();
+        row.rhs() = rnd() & 1;
+        for(uint32_t c = 0; c < cols; c++) {
+            if (rnd() & 1) {
+                row.setBit(c);
+            }
+        }
+    }
+}
+
+void BM_packedrow_xor(benchmark::State& state)
+{
+    const uint32_t cols = state.range(0);
+    std::mt19937 rnd(3);
+    PackedMatrix m;
+    fill_random(m, 2, cols, rnd);
+    PackedRow a = m[0];
+    const PackedRow b = m[1];
+
+    for (auto _ : state) {
+        a.xor_in(b);
+        benchmark::DoNotOptimize(a.rhs());
+    }
+    state.SetBytesProcessed(state.iterations()*((cols+63)/64)*8);
+}
+BENCHMARK(BM_packedrow_xor)->RangeMultiplier(4)->Range(64, 16384);
+
+void BM_packedrow_popcnt(benchmark::State& state)
+{
+    const uint32_t cols = state.range(0);
+    std::mt19937 rnd(4);
+    PackedMatrix m;
+    fill_random(m, 1, cols, rnd);
+    const PackedRow a = m[0];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.popcnt());
+    }
+    state.SetBytesProcessed(state.iterations()*((cols+63)/64)*8);
+}
+BENCHMARK(BM_packedrow_popcnt)->RangeMultiplier(4)->Range(64, 16384);
+
+//Full Gauss-Jordan elimination of a random square matrix
+void BM_packed_gauss_jordan(benchmark::State& state)
+{
+    const uint32_t n = state.range(0);
+    std::mt19937 rnd(5);
+    PackedMatrix orig;
+    fill_random(orig, n, n, rnd);
+    PackedMatrix m;
+    m.resize(n, n);
+
+    for (auto _ : state) {
+        for(uint32_t r = 0; r < n; r++) {
+            m[r] = orig[r];
+        }
+
+        uint32_t pivot_row = 0;
+        for(uint32_t col = 0; col < n && pivot_row < n; col++) {
+            uint32_t r = pivot_row;
+            while(r < n && !m[r][col]) {
+                r++;
+            }
+            if (r == n) {
+                continue;
+            }
+            if (r != pivot_row) {
+                m[r].swapBoth(m[pivot_row]);
+            }
+            const PackedRow pivot = m[pivot_row];
+            for(uint32_t r2 = 0; r2 < n; r2++) {
+                if (r2 != pivot_row && m[r2][col]) {
+                    m[r2].xor_in(pivot);
+                }
+            }
+            pivot_row++;
+        }
+        benchmark::DoNotOptimize(pivot_row);
+    }
+    state.counters["rows"] = benchmark::Counter(
+        state.iterations()*n, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_packed_gauss_jordan)->Arg(128)->Arg(512)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+//The allocator only reclaims memory when consolidating, so every iteration
+//uses a new one
+void BM_clause_alloc_free(benchmark::State& state)
+{
+    const uint32_t len = state.range(0);
+    const uint32_t batch = 4096;
+    vector<Lit> lits;
+    for(uint32_t i = 0; i < len; i++) {
+        lits.push_back(Lit(i, i % 2));
+    }
+
+    vector<Clause*> cls(batch);
+    for (auto _ : state) {
+        ClauseAllocator alloc;
+        for(Clause*& c: cls) {
+            c = alloc.Clause_new(lits, 0
+                #ifdef STATS_NEEDED
+                , 0
+                #endif
+            );
+        }
+        for(Clause* c: cls) {
+            alloc.clauseFree(c);
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*batch);
+}
+BENCHMARK(BM_clause_alloc_free)->Arg(3)->Arg(10)->Arg(50);
+
+void BM_clause_consolidate(benchmark::State& state)
+{
+    const Instance inst = random_ksat(state.range(0), 4.0, 5, 6);
+    SolverConf conf = bench_conf();
+    std::atomic<bool> must_inter(false);
+    BenchSolver s(&conf, &must_inter);
+    s.load(inst);
+
+    for (auto _ : state) {
+        s.cl_alloc.consolidate(&s, true, true);
+    }
+    state.SetBytesProcessed(state.iterations()*s.cl_alloc.mem_used());
+    state.counters["bytes_per_clause"] =
+        (double)s.cl_alloc.mem_used()/(double)s.longIrredCls.size();
+}
+BENCHMARK(BM_clause_consolidate)->Arg(20000)->Arg(200000)->Unit(benchmark::kMillisecond);
+
+void BM_dimacs_parse(benchmark::State& state)
+{
+    Instance inst = random_ksat(state.range(0), 4.26, 3, 7);
+    const Instance xors = planted_xor(state.range(0), state.range(0)/10, 4, 0, false, 7);
+    inst.xors = xors.xors;
+    const string text = inst.to_dimacs();
+
+    for (auto _ : state) {
+        SATSolver solver;
+        DimacsParser<StreamBuffer<const char*, CH>, SATSolver> parser(&solver, NULL, 0);
+        if (!parser.parse_DIMACS(text.c_str(), true)) {
+            state.SkipWithError("parse error");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations()*text.size());
+}
+BENCHMARK(BM_dimacs_parse)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+}
+
+int run_micro_benchmarks(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
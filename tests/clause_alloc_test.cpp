@@ -71,7 +71,94 @@ TEST_F(clause_allocator, add_1)
         }
     }
     s->cl_alloc.consolidate(s, true);
-    lbool ret = s->solve_with_assumptions(NULL);
+    lbool ret = s->solve_with_assumptions(NULL, false);
+    EXPECT_EQ(ret, l_True);
+}
+
+TEST_F(clause_allocator, consolidate_only_fragmented)
+{
+    vector<Lit> cl;
+    srand(0);
+    for(size_t i = 0; i < 40ULL*1000ULL; i++) {
+        cl.resize(100);
+        uint32_t var = rand() % 100;
+        for(Lit& l: cl) {
+            l = Lit(var, rand() % 2);
+            var += 1 + rand() % 400;
+        }
+        s->add_clause_outer(cl);
+    }
+    const size_t orig_num_segs = s->cl_alloc.num_segments();
+    EXPECT_GT(orig_num_segs, 2U);
+
+    //Free most clauses of the first segment only
+    size_t j = 0;
+    size_t at = 0;
+    for(ClOffset offs: s->longIrredCls) {
+        if ((offs >> CL_SEG_BITS) == 0 && (at++ % 10) != 0) {
+            s->detachClause(offs);
+            s->free_cl(offs);
+        } else {
+            s->longIrredCls[j++] = offs;
+        }
+    }
+    s->longIrredCls.resize(j);
+
+    vector<ClOffset> offs_before = s->longIrredCls;
+    vector<vector<Lit> > lits_before;
+    for(ClOffset offs: s->longIrredCls) {
+        const Clause& c = *s->cl_alloc.ptr(offs);
+        lits_before.push_back(vector<Lit>(c.begin(), c.end()));
+    }
+
+    s->cl_alloc.consolidate(s);
+    EXPECT_LE(s->cl_alloc.num_segments(), orig_num_segs);
+
+    ASSERT_EQ(s->longIrredCls.size(), lits_before.size());
+    for(size_t i = 0; i < s->longIrredCls.size(); i++) {
+        const ClOffset offs = s->longIrredCls[i];
+        const Clause& c = *s->cl_alloc.ptr(offs);
+        EXPECT_EQ(vector<Lit>(c.begin(), c.end()), lits_before[i]);
+
+        //Only the fragmented segment was evacuated
+        if ((offs_before[i] >> CL_SEG_BITS) != 0) {
+            EXPECT_EQ(offs, offs_before[i]);
+        } else {
+            EXPECT_NE(offs >> CL_SEG_BITS, 0U);
+        }
+    }
+
+    lbool ret = s->solve_with_assumptions(NULL, false);
+    EXPECT_EQ(ret, l_True);
+}
+
+TEST_F(clause_allocator, offset_shift)
+{
+    SolverConf conf;
+    conf.cl_offset_shift = 2;
+    Solver s2(&conf, &must_inter);
+    s2.new_vars(1000);
+    EXPECT_EQ(s2.cl_alloc.get_offset_shift(), 2U);
+
+    vector<Lit> cl;
+    srand(0);
+    for(size_t i = 0; i < 1000; i++) {
+        cl.resize(3 + i % 7);
+        uint32_t var = rand() % 10;
+        for(Lit& l: cl) {
+            l = Lit(var, rand() % 2);
+            var += 1 + rand() % 100;
+        }
+        s2.add_clause_outer(cl);
+    }
+    for(ClOffset offs: s2.longIrredCls) {
+        const Clause* c = s2.cl_alloc.ptr(offs);
+        EXPECT_EQ(s2.cl_alloc.get_offset(c), offs);
+        EXPECT_EQ(((uintptr_t)c) % (4*sizeof(BASE_DATA_TYPE)), 0U);
+    }
+    s2.cl_alloc.consolidate(&s2, true);
+
+    lbool ret = s2.solve_with_assumptions(NULL, false);
     EXPECT_EQ(ret, l_True);
 }
 
@@ -0,0 +1,160 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include "cryptominisat5/cryptominisat.h"
+#include "src/bignum.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct count : public ::testing::Test {
+    //Number of models of the clauses projected to "vars", by trying
+    //every assignment
+    static uint64_t brute_force(
+        const vector<vector<Lit>>& cls, uint32_t num_vars, const vector<unsigned>& vars)
+    {
+        std::set<uint64_t> models;
+        for(uint64_t i = 0; i < (1ULL << num_vars); i++) {
+            bool sat = true;
+            for(const auto& cl: cls) {
+                bool cl_sat = false;
+                for(const Lit l: cl) {
+                    cl_sat |= (bool)((i >> l.var()) & 1) != l.sign();
+                }
+                sat &= cl_sat;
+            }
+            if (sat) {
+                uint64_t proj = 0;
+                for(size_t j = 0; j < vars.size(); j++) {
+                    proj |= ((i >> vars[j]) & 1ULL) << j;
+                }
+                models.insert(proj);
+            }
+        }
+        return models.size();
+    }
+
+    SATSolver s;
+    string num;
+};
+
+TEST_F(count, bignum)
+{
+    BigNum a(0xffffffffULL);
+    a += BigNum(1);
+    EXPECT_EQ(a.to_string(), "4294967296");
+    a *= BigNum(1000000007ULL);
+    EXPECT_EQ(a.to_string(), "4294967326064771072");
+    BigNum b(3);
+    b <<= 100;
+    EXPECT_EQ(b.to_string(), "3802951800684688204490109616128");
+    EXPECT_EQ(BigNum(0).to_string(), "0");
+    b *= BigNum(0);
+    EXPECT_TRUE(b.is_zero());
+}
+
+TEST_F(count, all_vars)
+{
+    s.new_vars(3);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("-2, -3"));
+    EXPECT_EQ(s.count_models(num), l_True);
+    EXPECT_EQ(num, "4");
+}
+
+TEST_F(count, unsat)
+{
+    s.new_vars(2);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("1, -2"));
+    s.add_clause(str_to_cl("-1"));
+    EXPECT_EQ(s.count_models(num), l_False);
+    EXPECT_EQ(num, "0");
+}
+
+TEST_F(count, huge_count)
+{
+    s.new_vars(200);
+    s.add_clause(str_to_cl("1, 2"));
+    EXPECT_EQ(s.count_models(num), l_True);
+
+    //3*2^198
+    BigNum expected(3);
+    expected <<= 198;
+    EXPECT_EQ(num, expected.to_string());
+}
+
+TEST_F(count, projection_and_assumptions)
+{
+    s.new_vars(4);
+    s.add_clause(str_to_cl("1, 2, 3"));
+    s.add_clause(str_to_cl("-3, 4"));
+
+    const vector<unsigned> vars = {0, 1};
+    EXPECT_EQ(s.count_models(num, &vars), l_True);
+    EXPECT_EQ(num, "4");
+
+    const vector<Lit> assumps = str_to_cl("-4");
+    EXPECT_EQ(s.count_models(num, &vars, &assumps), l_True);
+    EXPECT_EQ(num, "3");
+
+    //Solving still works afterwards
+    EXPECT_EQ(s.solve(), l_True);
+}
+
+TEST_F(count, random_against_brute_force)
+{
+    const uint32_t num_vars = 16;
+    srand(11);
+    for(uint32_t round = 0; round < 20; round++) {
+        SATSolver s2;
+        s2.new_vars(num_vars);
+        vector<vector<Lit>> cls;
+        const uint32_t num_cls = 10 + rand() % 40;
+        for(uint32_t i = 0; i < num_cls; i++) {
+            vector<Lit> cl;
+            const uint32_t size = 2 + rand() % 3;
+            for(uint32_t j = 0; j < size; j++) {
+                cl.push_back(Lit(rand() % num_vars, rand() % 2));
+            }
+            cls.push_back(cl);
+            s2.add_clause(cl);
+        }
+
+        vector<unsigned> vars;
+        for(uint32_t v = 0; v < num_vars; v++) {
+            if (rand() % 2) {
+                vars.push_back(v);
+            }
+        }
+        EXPECT_EQ(s2.count_models(num, &vars), brute_force(cls, num_vars, vars) ? l_True : l_False);
+        EXPECT_EQ(num, std::to_string(brute_force(cls, num_vars, vars)));
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/solver.h"
+#include "src/lookahead.h"
+#include "src/solverconf.h"
+#include "cryptominisat5/cryptominisat.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct lookahead : public ::testing::Test {
+    lookahead()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        s = new Solver(&conf, &must_inter);
+        s->new_vars(30);
+    }
+    ~lookahead()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    std::atomic<bool> must_inter;
+};
+
+static bool clash(const vector<Lit>& a, const vector<Lit>& b)
+{
+    for(const Lit l: a) {
+        if (std::find(b.begin(), b.end(), ~l) != b.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_F(lookahead, cubes_are_disjoint)
+{
+    for(uint32_t i = 1; i < 20; i++) {
+        s->add_clause_outer(str_to_cl(
+            std::to_string(i) + ", " + std::to_string(i+1) + ", -" + std::to_string(i+2)));
+    }
+
+    Lookahead la(s);
+    vector<vector<Lit>> cubes;
+    EXPECT_TRUE(la.split(vector<Lit>(), 3, cubes));
+    EXPECT_EQ(cubes.size(), 8u);
+    for(size_t i = 0; i < cubes.size(); i++) {
+        EXPECT_EQ(cubes[i].size(), 3u);
+        for(size_t j = i+1; j < cubes.size(); j++) {
+            EXPECT_TRUE(clash(cubes[i], cubes[j]));
+        }
+    }
+    EXPECT_EQ(s->decisionLevel(), 0u);
+}
+
+TEST_F(lookahead, keeps_prefix)
+{
+    s->add_clause_outer(str_to_cl("1, 2, 3"));
+    s->add_clause_outer(str_to_cl("-1, 4, 5"));
+    s->add_clause_outer(str_to_cl("-4, 5, 6"));
+
+    Lookahead la(s);
+    vector<vector<Lit>> cubes;
+    const vector<Lit> prefix = str_to_cl("-2, 7");
+    EXPECT_TRUE(la.split(prefix, 2, cubes));
+    EXPECT_FALSE(cubes.empty());
+    for(const auto& cube: cubes) {
+        ASSERT_GE(cube.size(), 2u);
+        EXPECT_EQ(cube[0], prefix[0]);
+        EXPECT_EQ(cube[1], prefix[1]);
+    }
+}
+
+TEST_F(lookahead, failed_lit_is_unit)
+{
+    s->add_clause_outer(str_to_cl("1, 2"));
+    s->add_clause_outer(str_to_cl("1, -2"));
+    s->add_clause_outer(str_to_cl("3, 4, 5"));
+
+    Lookahead la(s);
+    vector<vector<Lit>> cubes;
+    EXPECT_TRUE(la.split(vector<Lit>(), 1, cubes));
+    EXPECT_EQ(la.get_units(), str_to_cl("1"));
+    check_zero_assigned_lits_contains(s, "1");
+}
+
+TEST_F(lookahead, refuted_prefix)
+{
+    s->add_clause_outer(str_to_cl("-1, 2"));
+    s->add_clause_outer(str_to_cl("-1, -2"));
+
+    Lookahead la(s);
+    vector<vector<Lit>> cubes;
+    EXPECT_FALSE(la.split(str_to_cl("1"), 2, cubes));
+    EXPECT_TRUE(cubes.empty());
+    EXPECT_TRUE(s->okay());
+}
+
+//Pigeons in holes. The last pigeon is only there if "guard" is set.
+static void add_php(SATSolver& s, uint32_t pigeons, uint32_t holes, Lit guard = lit_Undef)
+{
+    const uint32_t base = s.nVars();
+    s.new_vars(pigeons*holes);
+    for(uint32_t p = 0; p < pigeons; p++) {
+        vector<Lit> cl;
+        if (guard != lit_Undef && p+1 == pigeons) {
+            cl.push_back(~guard);
+        }
+        for(uint32_t h = 0; h < holes; h++) {
+            cl.push_back(Lit(base+p*holes+h, false));
+        }
+        s.add_clause(cl);
+    }
+    for(uint32_t h = 0; h < holes; h++) {
+        for(uint32_t p = 0; p < pigeons; p++) {
+            for(uint32_t p2 = p+1; p2 < pigeons; p2++) {
+                s.add_clause(vector<Lit>{Lit(base+p*holes+h, true), Lit(base+p2*holes+h, true)});
+            }
+        }
+    }
+}
+
+struct cube_solve : public ::testing::Test {
+    cube_solve()
+    {
+        SolverConf conf;
+        conf.cube_and_conquer = true;
+        conf.cube_confl_budget = 100;
+        s = new SATSolver(&conf);
+        s->set_num_threads(3);
+    }
+    ~cube_solve()
+    {
+        delete s;
+    }
+    SATSolver* s;
+};
+
+TEST_F(cube_solve, unsat)
+{
+    add_php(*s, 7, 6);
+    EXPECT_EQ(s->solve(), l_False);
+    EXPECT_FALSE(s->okay());
+}
+
+TEST_F(cube_solve, sat)
+{
+    add_php(*s, 6, 6);
+    ASSERT_EQ(s->solve(), l_True);
+    const vector<lbool>& model = s->get_model();
+    for(uint32_t h = 0; h < 6; h++) {
+        uint32_t num = 0;
+        for(uint32_t p = 0; p < 6; p++) {
+            num += model[p*6+h] == l_True;
+        }
+        EXPECT_LE(num, 1u);
+    }
+}
+
+TEST_F(cube_solve, unsat_under_assumptions)
+{
+    s->new_vars(2);
+    const Lit a = Lit(0, false);
+    const Lit b = Lit(1, false);
+    add_php(*s, 7, 6, a);
+
+    vector<Lit> assumps{a, b};
+    EXPECT_EQ(s->solve(&assumps), l_False);
+    EXPECT_FALSE(s->get_conflict().empty());
+    for(const Lit lit: s->get_conflict()) {
+        EXPECT_TRUE(lit == ~a || lit == ~b);
+    }
+    EXPECT_TRUE(s->okay());
+    EXPECT_EQ(s->solve(), l_True);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,282 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <random>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "cryptominisat5/cryptominisat.h"
+#include "src/distconn.h"
+#include "src/distcoordinator.h"
+using namespace CMSat;
+
+static DistConn* connect_local(const uint32_t port)
+{
+    DistConn* conn = DistConn::connect_to("127.0.0.1", port, 5.0);
+    EXPECT_TRUE(conn != NULL);
+    return conn;
+}
+
+//Waits for the next message, without letting the other side block
+static bool wait_msg(DistConn* conn, DistMsg& type, vector<uint32_t>& payload)
+{
+    for(int i = 0; i < 500; i++) {
+        if (conn->next_msg(type, payload)) {
+            return true;
+        }
+        conn->flush(false);
+        conn->wait_readable(0.01);
+        const bool alive = conn->receive();
+        if (conn->next_msg(type, payload)) {
+            return true;
+        }
+        if (!alive) {
+            return false;
+        }
+    }
+    return false;
+}
+
+TEST(dist_test, conn_roundtrip)
+{
+    uint32_t port;
+    const int listen_fd = DistConn::listen_on(0, port);
+    ASSERT_GE(listen_fd, 0);
+    DistConn* client = connect_local(port);
+    DistConn* server = NULL;
+    while(server == NULL) {
+        server = DistConn::accept_from(listen_fd);
+    }
+
+    //Much larger than the socket buffers, so writes are partial
+    vector<uint32_t> big(1000*1000);
+    for(size_t i = 0; i < big.size(); i++) {
+        big[i] = i*7;
+    }
+    client->queue(DistMsg::hello, {dist_protocol_version, 42});
+    client->queue(DistMsg::clauses, big);
+    client->queue(DistMsg::stop, {});
+
+    DistMsg type;
+    vector<uint32_t> payload;
+    vector<DistMsg> types;
+    while(types.size() < 3) {
+        client->flush(false);
+        ASSERT_TRUE(server->receive());
+        while(server->next_msg(type, payload)) {
+            types.push_back(type);
+            if (type == DistMsg::hello) {
+                EXPECT_EQ(payload, vector<uint32_t>({dist_protocol_version, 42}));
+            } else if (type == DistMsg::clauses) {
+                EXPECT_EQ(payload, big);
+            } else {
+                EXPECT_TRUE(payload.empty());
+            }
+        }
+    }
+    EXPECT_EQ(types, vector<DistMsg>({DistMsg::hello, DistMsg::clauses, DistMsg::stop}));
+    EXPECT_FALSE(client->has_output());
+
+    delete client;
+    EXPECT_FALSE(server->receive());
+    delete server;
+    close(listen_fd);
+}
+
+TEST(dist_test, coordinator_relays_and_stops)
+{
+    DistCoordinator coord(0, 2, 0);
+    vector<lbool> model;
+    lbool ret = l_Undef;
+    std::thread th([&]() { ret = coord.run(model, 30); });
+
+    DistConn* w0 = connect_local(coord.get_port());
+    DistConn* w1 = connect_local(coord.get_port());
+    w0->queue(DistMsg::hello, {dist_protocol_version, 10});
+    w1->queue(DistMsg::hello, {dist_protocol_version, 10});
+    DistMsg type;
+    vector<uint32_t> payload;
+    ASSERT_TRUE(wait_msg(w0, type, payload));
+    EXPECT_EQ(type, DistMsg::welcome);
+    ASSERT_TRUE(wait_msg(w1, type, payload));
+    EXPECT_EQ(type, DistMsg::welcome);
+
+    //unit 1, binary (-2 3), long (1 2 -4) with glue 2, and the same unit again
+    const uint32_t u = Lit(0, false).toInt();
+    w0->queue(DistMsg::clauses, {
+        1, 1, u
+        , 2, 1, Lit(1, true).toInt(), Lit(2, false).toInt()
+        , 3, 2, Lit(0, false).toInt(), Lit(1, false).toInt(), Lit(3, true).toInt()
+        , 1, 1, u
+    });
+    w0->flush(true);
+    ASSERT_TRUE(wait_msg(w1, type, payload));
+    EXPECT_EQ(type, DistMsg::clauses);
+    EXPECT_EQ(payload.size(), 3u + 4u + 5u);
+    EXPECT_EQ(payload[2], u);
+
+    //The other worker finds a solution, the first one is stopped
+    vector<uint32_t> res = {toInt(l_True)};
+    for(uint32_t i = 0; i < 10; i++) {
+        res.push_back(toInt(i % 2 ? l_True : l_False));
+    }
+    w1->queue(DistMsg::result, res);
+    w1->flush(true);
+    ASSERT_TRUE(wait_msg(w0, type, payload));
+    EXPECT_EQ(type, DistMsg::stop);
+    th.join();
+
+    EXPECT_EQ(ret, l_True);
+    ASSERT_EQ(model.size(), 10u);
+    EXPECT_EQ(model[0], l_False);
+    EXPECT_EQ(model[1], l_True);
+    EXPECT_EQ(coord.get_stats().units, 1u);
+    EXPECT_EQ(coord.get_stats().bins, 1u);
+    EXPECT_EQ(coord.get_stats().longs, 1u);
+    EXPECT_EQ(coord.get_stats().duplicates, 1u);
+    delete w0;
+    delete w1;
+}
+
+TEST(dist_test, opposite_units_are_unsat)
+{
+    DistCoordinator coord(0, 2, 0);
+    vector<lbool> model;
+    lbool ret = l_Undef;
+    std::thread th([&]() { ret = coord.run(model, 30); });
+
+    DistConn* w0 = connect_local(coord.get_port());
+    DistConn* w1 = connect_local(coord.get_port());
+    w0->queue(DistMsg::hello, {dist_protocol_version, 5});
+    w0->queue(DistMsg::clauses, {1, 1, Lit(3, false).toInt()});
+    w0->flush(true);
+    w1->queue(DistMsg::hello, {dist_protocol_version, 5});
+    w1->queue(DistMsg::clauses, {1, 1, Lit(3, true).toInt()});
+    w1->flush(true);
+    th.join();
+
+    EXPECT_EQ(ret, l_False);
+    delete w0;
+    delete w1;
+}
+
+TEST(dist_test, rejects_different_problem)
+{
+    DistCoordinator coord(0, 2, 0);
+    vector<lbool> model;
+    lbool ret = l_True;
+    std::thread th([&]() { ret = coord.run(model, 30); });
+
+    DistConn* w0 = connect_local(coord.get_port());
+    DistConn* w1 = connect_local(coord.get_port());
+    w0->queue(DistMsg::hello, {dist_protocol_version, 5});
+    DistMsg type;
+    vector<uint32_t> payload;
+    ASSERT_TRUE(wait_msg(w0, type, payload));
+    w1->queue(DistMsg::hello, {dist_protocol_version, 6});
+    EXPECT_FALSE(wait_msg(w1, type, payload));
+
+    //Everyone left without an answer
+    delete w0;
+    th.join();
+    EXPECT_EQ(ret, l_Undef);
+    delete w1;
+}
+
+//Satisfiable 3-SAT around the threshold, planted so it can't be UNSAT
+static vector<vector<Lit>> planted_3sat(const uint32_t n, const uint32_t m, const uint32_t seed)
+{
+    std::mt19937 mtrand(seed);
+    vector<bool> sol(n);
+    for(uint32_t i = 0; i < n; i++) {
+        sol[i] = mtrand() % 2;
+    }
+    vector<vector<Lit>> cls;
+    while(cls.size() < m) {
+        vector<Lit> cl;
+        bool sat = false;
+        for(int i = 0; i < 3; i++) {
+            const Lit l(mtrand() % n, mtrand() % 2);
+            sat |= (sol[l.var()] ^ l.sign());
+            cl.push_back(l);
+        }
+        if (sat) {
+            cls.push_back(cl);
+        }
+    }
+    return cls;
+}
+
+TEST(dist_test, worker_processes_solve)
+{
+    const uint32_t n = 300;
+    const vector<vector<Lit>> cls = planted_3sat(n, n*4.2, 3);
+
+    //Fork before the coordinator's thread exists
+    DistCoordinator coord(0, 2, 0);
+    vector<pid_t> pids;
+    for(uint32_t w = 0; w < 2; w++) {
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {
+            SATSolver s;
+            s.set_dist_worker("127.0.0.1", coord.get_port());
+            s.new_vars(n);
+            s.set_default_polarity(w == 0);
+            for(const auto& cl: cls) {
+                s.add_clause(cl);
+            }
+            const lbool ret = s.solve();
+            _exit(ret == l_True ? 10 : (ret == l_False ? 20 : 0));
+        }
+        pids.push_back(pid);
+    }
+
+    vector<lbool> model;
+    const lbool ret = coord.run(model, 60);
+    for(const pid_t pid: pids) {
+        int status;
+        waitpid(pid, &status, 0);
+        EXPECT_TRUE(WIFEXITED(status));
+        EXPECT_NE(WEXITSTATUS(status), 20);
+    }
+
+    ASSERT_EQ(ret, l_True);
+    ASSERT_EQ(model.size(), n);
+    for(const auto& cl: cls) {
+        bool sat = false;
+        for(const Lit l: cl) {
+            sat |= model[l.var()] == (l.sign() ? l_False : l_True);
+        }
+        EXPECT_TRUE(sat);
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -126,6 +126,74 @@ TEST_F(distill_test, tri_transitive)
     check_irred_cls_contains(s, "1, 2");
 }
 
+//Parallel distillation
+
+struct distill_par_test : public ::testing::Test {
+    distill_par_test()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.distill_threads = 3;
+        conf.distill_par_batch = 2;
+        s = new Solver(&conf, &must_inter);
+        distill_long_cls = s->distill_long_cls;
+    }
+    ~distill_par_test()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    DistillerLong* distill_long_cls;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(distill_par_test, long_by1_transitive)
+{
+    s->new_vars(5);
+    s->add_clause_outer(str_to_cl("1, -5"));
+    s->add_clause_outer(str_to_cl("5, -2"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"));
+
+    distill_long_cls->distill(false);
+    check_irred_cls_contains(s, "1, 3, 4");
+}
+
+TEST_F(distill_par_test, long_by1_nodistill)
+{
+    s->new_vars(5);
+    s->add_clause_outer(str_to_cl("-1, 3"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, 4"));
+
+    distill_long_cls->distill(false);
+    check_irred_cls_contains(s, "1, 2, 3, 4");
+}
+
+TEST_F(distill_par_test, tri_transitive)
+{
+    s->new_vars(5);
+    s->add_clause_outer(str_to_cl("1, 2, 4"));
+    s->add_clause_outer(str_to_cl("-4, -3"));
+    s->add_clause_outer(str_to_cl("1, 2, 3"));
+
+    distill_long_cls->distill(false);
+    check_irred_cls_contains(s, "1, 2");
+}
+
+//Each clause is distilled using the other one, both must be shortened
+TEST_F(distill_par_test, same_batch)
+{
+    s->new_vars(6);
+    s->add_clause_outer(str_to_cl("1, 2, 3, 5"));
+    s->add_clause_outer(str_to_cl("1, 2, 3, -5"));
+    s->add_clause_outer(str_to_cl("1, 2, 4, 6"));
+    s->add_clause_outer(str_to_cl("1, 2, 4, -6"));
+
+    distill_long_cls->distill(false);
+    check_irred_cls_contains(s, "1, 2, 3");
+    check_irred_cls_contains(s, "1, 2, 4");
+}
+
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
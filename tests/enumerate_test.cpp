@@ -0,0 +1,181 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include "cryptominisat5/cryptominisat.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct enumerate : public ::testing::Test {
+    typedef std::set<string> Models;
+
+    static string to_str(const vector<lbool>& vals)
+    {
+        string s;
+        for(const lbool v: vals) {
+            s += v == l_True ? '1' : (v == l_False ? '0' : 'u');
+        }
+        return s;
+    }
+
+    std::function<bool(const vector<lbool>&)> collect(Models& models)
+    {
+        return [&models](const vector<lbool>& vals) {
+            EXPECT_TRUE(models.insert(to_str(vals)).second);
+            return true;
+        };
+    }
+
+    //Models of the clauses projected to "vars", by trying every assignment
+    static Models brute_force(
+        const vector<vector<Lit>>& cls, uint32_t num_vars, const vector<unsigned>& vars)
+    {
+        Models models;
+        for(uint32_t i = 0; i < (1U << num_vars); i++) {
+            bool sat = true;
+            for(const auto& cl: cls) {
+                bool cl_sat = false;
+                for(const Lit l: cl) {
+                    cl_sat |= (bool)((i >> l.var()) & 1) != l.sign();
+                }
+                sat &= cl_sat;
+            }
+            if (sat) {
+                vector<lbool> vals;
+                for(const unsigned v: vars) {
+                    vals.push_back(((i >> v) & 1) ? l_True : l_False);
+                }
+                models.insert(to_str(vals));
+            }
+        }
+        return models;
+    }
+
+    SATSolver s;
+};
+
+TEST_F(enumerate, all_vars)
+{
+    s.new_vars(3);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("-2, -3"));
+
+    Models models;
+    EXPECT_EQ(s.enumerate(collect(models)), l_False);
+    EXPECT_EQ(models, brute_force({str_to_cl("1, 2"), str_to_cl("-2, -3")}, 3, {0, 1, 2}));
+}
+
+TEST_F(enumerate, unsat)
+{
+    s.new_vars(2);
+    s.add_clause(str_to_cl("1"));
+    s.add_clause(str_to_cl("-1"));
+
+    Models models;
+    EXPECT_EQ(s.enumerate(collect(models)), l_False);
+    EXPECT_TRUE(models.empty());
+}
+
+TEST_F(enumerate, projection)
+{
+    s.new_vars(4);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("3, 4"));
+
+    Models models;
+    const vector<unsigned> vars = {0, 1};
+    EXPECT_EQ(s.enumerate(collect(models), &vars), l_False);
+    EXPECT_EQ(models.size(), 3u);
+}
+
+TEST_F(enumerate, max_then_continue)
+{
+    s.new_vars(5);
+    s.add_clause(str_to_cl("1, 2, 3"));
+
+    Models models;
+    const vector<unsigned> vars = {0, 1, 2};
+    EXPECT_EQ(s.enumerate(collect(models), &vars, 2), l_True);
+    EXPECT_EQ(models.size(), 2u);
+
+    //Model of the last call is kept and blocked
+    const vector<lbool> last(s.get_model().begin(), s.get_model().begin()+3);
+    EXPECT_TRUE(models.count(to_str(last)));
+
+    EXPECT_EQ(s.enumerate(collect(models), &vars), l_False);
+    EXPECT_EQ(models.size(), 7u);
+}
+
+TEST_F(enumerate, callback_stops)
+{
+    s.new_vars(4);
+    uint64_t num = 0;
+    EXPECT_EQ(s.enumerate([&](const vector<lbool>&) { return ++num < 3; }), l_True);
+    EXPECT_EQ(num, 3u);
+}
+
+TEST_F(enumerate, assumptions)
+{
+    s.new_vars(3);
+    s.add_clause(str_to_cl("1, 2, 3"));
+
+    Models models;
+    const vector<unsigned> vars = {1, 2};
+    const vector<Lit> assumps = str_to_cl("-1");
+    EXPECT_EQ(s.enumerate(collect(models), &vars, ~0ULL, &assumps), l_False);
+    EXPECT_EQ(models.size(), 3u);
+    EXPECT_EQ(s.get_conflict(), str_to_cl("1"));
+
+    //Models blocked under the assumption are still there without it
+    models.clear();
+    EXPECT_EQ(s.enumerate(collect(models), &vars), l_False);
+    EXPECT_EQ(models.size(), 4u);
+}
+
+TEST_F(enumerate, random_against_brute_force)
+{
+    const uint32_t num_vars = 14;
+    s.new_vars(num_vars);
+    srand(7);
+    vector<vector<Lit>> cls;
+    for(uint32_t i = 0; i < 30; i++) {
+        vector<Lit> cl;
+        for(uint32_t j = 0; j < 3; j++) {
+            cl.push_back(Lit(rand() % num_vars, rand() % 2));
+        }
+        cls.push_back(cl);
+        s.add_clause(cl);
+    }
+
+    Models models;
+    const vector<unsigned> vars = {0, 2, 3, 5, 7, 8, 11, 13};
+    EXPECT_EQ(s.enumerate(collect(models), &vars), l_False);
+    EXPECT_EQ(models, brute_force(cls, num_vars, vars));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
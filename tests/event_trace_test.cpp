@@ -0,0 +1,145 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#include "src/eventtrace.h"
+using namespace CMSat;
+
+struct TraceFile
+{
+    explicit TraceFile(const string& fname)
+    {
+        std::ifstream f(fname.c_str(), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+
+    template<class T> T get()
+    {
+        T t;
+        memcpy(&t, data.data() + at, sizeof(T));
+        at += sizeof(T);
+        return t;
+    }
+
+    string get_str()
+    {
+        const uint16_t len = get<uint16_t>();
+        string s(data.data() + at, len);
+        at += len;
+        return s;
+    }
+
+    vector<char> data;
+    size_t at = 0;
+};
+
+TEST(event_trace_test, keeps_newest)
+{
+    EventTrace t(0, 3);
+    for(uint64_t i = 0; i < 10; i++) {
+        t.instant(TraceType::restart, i % 2 ? "odd" : "even", i, i*10);
+    }
+    EXPECT_EQ(t.num_recorded(), 10u);
+
+    const string fname = "event_trace_test.trace";
+    ASSERT_TRUE(EventTrace::dump(vector<const EventTrace*>{&t}, fname));
+
+    TraceFile f(fname);
+    EXPECT_EQ(string(f.data.data(), 8), "CMSTRACE");
+    f.at = 8;
+    EXPECT_EQ(f.get<uint32_t>(), 1u);
+    EXPECT_EQ(f.get<uint32_t>(), 1u);
+    EXPECT_EQ(f.get<uint32_t>(), 0u);
+    ASSERT_EQ(f.get<uint32_t>(), 2u);
+    const string name0 = f.get_str();
+    const string name1 = f.get_str();
+    EXPECT_EQ(name0, "even");
+    EXPECT_EQ(name1, "odd");
+
+    //Buffer is rounded up to 4, so events 6..9 are kept, oldest first
+    ASSERT_EQ(f.get<uint64_t>(), 4u);
+    for(uint64_t i = 6; i < 10; i++) {
+        const TraceEvent ev = f.get<TraceEvent>();
+        EXPECT_EQ(ev.conflicts, i);
+        EXPECT_EQ(ev.arg, i*10);
+        EXPECT_EQ(ev.dur_ns, 0u);
+        EXPECT_EQ(ev.type, (uint8_t)TraceType::restart);
+        EXPECT_EQ(ev.name, i % 2 ? 1 : 0);
+    }
+    EXPECT_EQ(f.at, f.data.size());
+    std::remove(fname.c_str());
+}
+
+TEST(event_trace_test, span_duration)
+{
+    EventTrace t(1, 8);
+    const uint64_t start = EventTrace::now();
+    t.span(TraceType::inprocess, "occ", start, 5, 7);
+    EXPECT_EQ(t.num_recorded(), 1u);
+}
+
+TEST(event_trace_test, dump_request_waits_for_all_threads)
+{
+    const string fname = "event_trace_req_test.trace";
+    std::remove(fname.c_str());
+    EventTrace t0(0, 4);
+    EventTrace t1(1, 4);
+    t0.instant(TraceType::restart, "a", 1);
+    t1.instant(TraceType::restart, "b", 2);
+
+    TraceDumpRequest req(fname, 2);
+    EXPECT_FALSE(req.pending());
+    req.add_snapshot(t0);
+    EXPECT_FALSE(std::ifstream(fname.c_str()).good());
+
+    req.request();
+    EXPECT_TRUE(req.pending());
+    req.add_snapshot(t0);
+    req.add_snapshot(t0);
+    EXPECT_TRUE(req.pending());
+    EXPECT_FALSE(std::ifstream(fname.c_str()).good());
+
+    //Recorded after the snapshot, must not be in the dump
+    t0.instant(TraceType::restart, "a", 3);
+    req.add_snapshot(t1);
+    EXPECT_FALSE(req.pending());
+
+    TraceFile f(fname);
+    f.at = 12;
+    ASSERT_EQ(f.get<uint32_t>(), 2u);
+    EXPECT_EQ(f.get<uint32_t>(), 0u);
+    ASSERT_EQ(f.get<uint32_t>(), 1u);
+    EXPECT_EQ(f.get_str(), "a");
+    EXPECT_EQ(f.get<uint64_t>(), 1u);
+    std::remove(fname.c_str());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "src/solver.h"
+#include "src/solverconf.h"
+#include "src/inprocessscheduler.h"
+#include "src/subsumeimplicit.h"
+using namespace CMSat;
+#include "test_helper.h"
+
+struct inprocess_sched : public ::testing::Test {
+    inprocess_sched()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.do_inprocess_sched_adapt = true;
+        conf.inprocess_sched_unproductive_drop = 2;
+        s = new Solver(&conf, &must_inter);
+        s->new_vars(30);
+        sched = s->inprocess_sched;
+    }
+    ~inprocess_sched()
+    {
+        delete s;
+    }
+
+    void run_sub_impl()
+    {
+        const int at = sched->find_technique("sub-impl");
+        if (sched->should_run(at)) {
+            sched->start(at);
+            s->subsumeImplicit->subsume_implicit();
+            sched->finish(at);
+        }
+        sched->end_round();
+    }
+
+    Solver* s;
+    InprocessScheduler* sched;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(inprocess_sched, unknown_token)
+{
+    EXPECT_EQ(sched->find_technique("lucky"), -1);
+    EXPECT_EQ(sched->find_technique("occ-bve"), -1);
+    EXPECT_NE(sched->find_technique("occ"), -1);
+}
+
+TEST_F(inprocess_sched, records_yield)
+{
+    s->add_clause_outer(str_to_cl("1, 2"));
+    s->add_clause_outer(str_to_cl("1, 2"));
+    run_sub_impl();
+
+    const int at = sched->find_technique("sub-impl");
+    const InprocessScheduler::TechStats& t = sched->get_stats()[at];
+    EXPECT_EQ(t.calls, 1U);
+    EXPECT_EQ(t.total.cls_removed, 1U);
+    EXPECT_EQ(t.total.lits_removed, 2U);
+    EXPECT_EQ(t.skip_rounds_left, 0U);
+}
+
+TEST_F(inprocess_sched, restores_timeout_multiplier)
+{
+    const double orig = s->conf.global_timeout_multiplier;
+    run_sub_impl();
+    EXPECT_EQ(s->conf.global_timeout_multiplier, orig);
+}
+
+TEST_F(inprocess_sched, skips_unproductive)
+{
+    s->add_clause_outer(str_to_cl("1, 2"));
+    s->add_clause_outer(str_to_cl("3, 4"));
+    const int at = sched->find_technique("sub-impl");
+    const InprocessScheduler::TechStats& t = sched->get_stats()[at];
+
+    run_sub_impl();
+    run_sub_impl();
+    EXPECT_EQ(t.calls, 2U);
+    EXPECT_EQ(t.skip_rounds_left, 1U);
+
+    run_sub_impl();
+    EXPECT_EQ(t.calls, 2U);
+    EXPECT_EQ(t.skipped, 1U);
+    EXPECT_EQ(t.skip_rounds_left, 0U);
+
+    run_sub_impl();
+    EXPECT_EQ(t.calls, 3U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -168,6 +168,65 @@ TEST_F(intree, trans_red_and_hyper_bin_1)
     check_red_cls_contains(s, "-3, 6");
 }
 
+//Parallel probing
+
+struct intree_par : public ::testing::Test {
+    intree_par()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.do_hyperbin_and_transred = true;
+        conf.intree_threads = 3;
+        s = new Solver(&conf, &must_inter);
+        s->new_vars(30);
+        inp = s->intree;
+    }
+    ~intree_par()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    InTree* inp;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(intree_par, fail_2)
+{
+    s->add_clause_outer(str_to_cl(" 1,  2"));
+    s->add_clause_outer(str_to_cl("-2,  3"));
+    s->add_clause_outer(str_to_cl("-2,  4"));
+    s->add_clause_outer(str_to_cl("-2,  5"));
+    s->add_clause_outer(str_to_cl("-3, -4, -5, 1"));
+
+    inp->intree_probe();
+    check_zero_assigned_lits_contains(s, "1");
+}
+
+TEST_F(intree_par, fail_3)
+{
+    s->add_clause_outer(str_to_cl(" 1,  2"));
+    s->add_clause_outer(str_to_cl("-2,  3"));
+    s->add_clause_outer(str_to_cl("-2,  4"));
+    s->add_clause_outer(str_to_cl("-2,  5"));
+    s->add_clause_outer(str_to_cl("-3, -4, -5, 6"));
+    s->add_clause_outer(str_to_cl("-4, -5, -6"));
+
+    inp->intree_probe();
+    check_zero_assigned_lits_contains(s, "1");
+}
+
+TEST_F(intree_par, hyper_bin_1)
+{
+    s->add_clause_outer(str_to_cl(" 1,  2"));
+    s->add_clause_outer(str_to_cl("-2,  3"));
+    s->add_clause_outer(str_to_cl("-2,  4"));
+    s->add_clause_outer(str_to_cl("-3, -4, 5"));
+
+    inp->intree_probe();
+    check_red_cls_contains(s, "-2, 5");
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -24,9 +24,11 @@ THE SOFTWARE.
 
 #include <fstream>
 #include <memory>
+#include <random>
 
 #include "src/solver.h"
 #include "src/sccfinder.h"
+#include "src/sccfinderpar.h"
 #include "src/solverconf.h"
 using namespace CMSat;
 #include "test_helper.h"
@@ -184,6 +186,83 @@ TEST(scc_test, limit_test2)
     EXPECT_EQ(scc.get_binxors().size(), 0U);
 }
 
+TEST(scc_test, incremental_finds_new)
+{
+    SolverConf conf;
+
+    std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
+    Solver s(&conf, tmp.get());
+    s.new_vars(6);
+    s.add_clause_outer(str_to_cl("1, -2"));
+    s.add_clause_outer(str_to_cl("3, -4"));
+
+    SCCFinder scc(&s);
+    scc.performSCC();
+    EXPECT_EQ(scc.get_binxors().size(), 0U);
+    scc.clear_binxors();
+
+    s.add_clause_outer(str_to_cl("2, -1"));
+    scc.performSCC();
+    EXPECT_EQ(scc.get_binxors().size(), 1U);
+    EXPECT_EQ(scc.get_stats().numIncremental, 1U);
+}
+
+TEST(scc_test, par_find_two_circle2_3)
+{
+    SolverConf conf;
+    conf.scc_threads = 3;
+
+    std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
+    Solver s(&conf, tmp.get());
+    s.new_vars(6);
+    s.add_clause_outer(str_to_cl("1, -2"));
+    s.add_clause_outer(str_to_cl("2, -3"));
+    s.add_clause_outer(str_to_cl("3, -1"));
+
+    s.add_clause_outer(str_to_cl("4, -5"));
+    s.add_clause_outer(str_to_cl("5, -6"));
+    s.add_clause_outer(str_to_cl("6, -4"));
+
+    //Every SCC is represented by its smallest literal
+    SCCFinder scc(&s);
+    scc.performSCC();
+    EXPECT_EQ(scc.get_binxors().size(), 4U);
+}
+
+//Forward-backward must give the same SCCs as Tarjan
+TEST(scc_test, par_fw_bw_same_as_tarjan)
+{
+    SolverConf conf;
+
+    std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
+    Solver s(&conf, tmp.get());
+    const uint32_t num_vars = 300;
+    s.new_vars(num_vars);
+    std::mt19937 mtrand(1);
+    for(uint32_t i = 0; i < 330; i++) {
+        const Lit lit1 = Lit(mtrand() % num_vars, mtrand() % 2);
+        const Lit lit2 = Lit(mtrand() % num_vars, mtrand() % 2);
+        if (lit1.var() != lit2.var()) {
+            s.add_clause_outer(vector<Lit>{lit1, lit2});
+        }
+    }
+
+    vector<uint32_t> vertices;
+    for(uint32_t i = 0; i < num_vars*2; i++) {
+        vertices.push_back(i);
+    }
+    vector<vector<uint32_t> > sccs_tarjan;
+    SCCFinderPar tarjan(&s, 1, num_vars*2);
+    tarjan.find(vertices, sccs_tarjan);
+
+    vector<vector<uint32_t> > sccs_fw_bw;
+    SCCFinderPar fw_bw(&s, 4, 1);
+    fw_bw.find(vertices, sccs_fw_bw);
+
+    EXPECT_FALSE(sccs_tarjan.empty());
+    EXPECT_EQ(sccs_tarjan, sccs_fw_bw);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,169 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include "src/sparsegauss.h"
+using namespace CMSat;
+
+//Rank of rows over GF(2), RHS in the top bit
+static size_t rank_of(vector<uint64_t> rows)
+{
+    size_t rank = 0;
+    for(uint32_t bit = 0; bit < 64; bit++) {
+        size_t piv = rank;
+        while(piv < rows.size() && !((rows[piv] >> bit) & 1)) {
+            piv++;
+        }
+        if (piv == rows.size()) {
+            continue;
+        }
+        std::swap(rows[rank], rows[piv]);
+        for(size_t i = 0; i < rows.size(); i++) {
+            if (i != rank && ((rows[i] >> bit) & 1)) {
+                rows[i] ^= rows[rank];
+            }
+        }
+        rank++;
+    }
+    return rank;
+}
+
+static uint64_t pack(const vector<uint32_t>& cols, const bool rhs)
+{
+    uint64_t r = (uint64_t)rhs << 63;
+    for(const uint32_t c: cols) {
+        r ^= 1ULL << c;
+    }
+    return r;
+}
+
+TEST(sparse_gauss_test, unit)
+{
+    SparseGauss g(3);
+    g.add_row(vector<uint32_t>{0, 1, 2}, true);
+    g.add_row(vector<uint32_t>{2, 1}, false);
+    EXPECT_TRUE(g.eliminate(1000));
+    EXPECT_FALSE(g.inconsistent());
+
+    bool found = false;
+    for(size_t i = 0; i < g.num_rows(); i++) {
+        if (g.row(i) == vector<uint32_t>{0}) {
+            EXPECT_TRUE(g.rhs(i));
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(sparse_gauss_test, duplicates_cancel)
+{
+    SparseGauss g(3);
+    g.add_row(vector<uint32_t>{1, 0, 1}, false);
+    ASSERT_EQ(g.num_rows(), 1u);
+    EXPECT_EQ(g.row(0), vector<uint32_t>{0});
+
+    g.add_row(vector<uint32_t>{2, 2}, true);
+    EXPECT_TRUE(g.inconsistent());
+}
+
+TEST(sparse_gauss_test, inconsistent)
+{
+    SparseGauss g(3);
+    g.add_row(vector<uint32_t>{0, 1}, true);
+    g.add_row(vector<uint32_t>{1, 2}, false);
+    g.add_row(vector<uint32_t>{0, 2}, false);
+    g.eliminate(1000);
+    EXPECT_TRUE(g.inconsistent());
+}
+
+TEST(sparse_gauss_test, random_same_span)
+{
+    std::mt19937 mtrand(1);
+    for(int iter = 0; iter < 300; iter++) {
+        const uint32_t num_cols = 2 + mtrand() % 40;
+        const uint32_t num_rows = 1 + mtrand() % 40;
+        SparseGauss g(num_cols);
+        vector<uint64_t> orig;
+        for(uint32_t i = 0; i < num_rows; i++) {
+            vector<uint32_t> cols;
+            const uint32_t sz = 1 + mtrand() % 5;
+            for(uint32_t j = 0; j < sz; j++) {
+                cols.push_back(mtrand() % num_cols);
+            }
+            const bool rhs = mtrand() & 1;
+            g.add_row(cols, rhs);
+            orig.push_back(pack(cols, rhs));
+        }
+        const bool full = g.eliminate(iter % 3 == 0 ? 20 : 1000*1000);
+
+        //Inconsistent iff the RHS raises the rank
+        vector<uint64_t> no_rhs;
+        for(uint64_t r: orig) {
+            no_rhs.push_back(r & ~(1ULL << 63));
+        }
+        const size_t rank = rank_of(orig);
+        if (full) {
+            EXPECT_EQ(g.inconsistent(), rank != rank_of(no_rhs));
+        }
+        if (g.inconsistent()) {
+            continue;
+        }
+
+        //Rows are in the span of the originals, and span all of it
+        vector<uint64_t> res;
+        for(size_t i = 0; i < g.num_rows(); i++) {
+            res.push_back(pack(g.row(i), g.rhs(i)));
+        }
+        EXPECT_EQ(rank_of(res), rank);
+        vector<uint64_t> both = orig;
+        both.insert(both.end(), res.begin(), res.end());
+        EXPECT_EQ(rank_of(both), rank);
+
+        //Reduced form: every non-empty row has a column no other row has
+        if (full) {
+            vector<uint32_t> occ(num_cols, 0);
+            for(size_t i = 0; i < g.num_rows(); i++) {
+                for(uint32_t c: g.row(i)) {
+                    occ[c]++;
+                }
+            }
+            for(size_t i = 0; i < g.num_rows(); i++) {
+                if (g.row(i).empty()) {
+                    continue;
+                }
+                bool has_own = false;
+                for(uint32_t c: g.row(i)) {
+                    has_own |= occ[c] == 1;
+                }
+                EXPECT_TRUE(has_own);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
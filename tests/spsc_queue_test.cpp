@@ -0,0 +1,118 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "src/spscqueue.h"
+using namespace CMSat;
+using std::vector;
+
+TEST(spsc_queue_test, capacity_rounded)
+{
+    SPSCQueue<int> q(100);
+    EXPECT_EQ(q.capacity(), 128u);
+    EXPECT_TRUE(q.empty());
+    EXPECT_TRUE(q.front() == NULL);
+}
+
+TEST(spsc_queue_test, full_and_empty)
+{
+    SPSCQueue<int> q(4);
+    for(int i = 0; i < 4; i++) {
+        int* slot = q.start_push();
+        ASSERT_TRUE(slot != NULL);
+        *slot = i;
+        q.finish_push();
+    }
+    EXPECT_TRUE(q.start_push() == NULL);
+    EXPECT_EQ(q.size(), 4u);
+
+    for(int i = 0; i < 4; i++) {
+        int* slot = q.front();
+        ASSERT_TRUE(slot != NULL);
+        EXPECT_EQ(*slot, i);
+        q.pop();
+    }
+    EXPECT_TRUE(q.front() == NULL);
+    EXPECT_TRUE(q.start_push() != NULL);
+}
+
+TEST(spsc_queue_test, slots_reused)
+{
+    SPSCQueue<vector<int> > q(2);
+    vector<int>* slot = q.start_push();
+    slot->resize(1000);
+    q.finish_push();
+    q.pop();
+
+    q.start_push();
+    q.finish_push();
+    slot = q.start_push();
+    EXPECT_GE(slot->capacity(), 1000u);
+}
+
+TEST(spsc_queue_test, two_threads)
+{
+    const uint64_t num = 200000;
+    SPSCQueue<uint64_t> q(64);
+    uint64_t sum = 0;
+    uint64_t expected_next = 0;
+    bool in_order = true;
+
+    std::thread consumer([&]() {
+        uint64_t got = 0;
+        while(got < num) {
+            uint64_t* v = q.front();
+            if (v == NULL) {
+                std::this_thread::yield();
+                continue;
+            }
+            in_order &= (*v == expected_next);
+            expected_next++;
+            sum += *v;
+            q.pop();
+            got++;
+        }
+    });
+
+    for(uint64_t i = 0; i < num; i++) {
+        uint64_t* slot;
+        while((slot = q.start_push()) == NULL) {
+            std::this_thread::yield();
+        }
+        *slot = i;
+        q.finish_push();
+    }
+    consumer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(sum, num*(num-1)/2);
+    EXPECT_TRUE(q.empty());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
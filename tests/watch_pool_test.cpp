@@ -0,0 +1,153 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <stdlib.h>
+
+#include "src/watcharray.h"
+using namespace CMSat;
+
+//The long clause offset encodes the literal and the position in the list
+static Watched make_watch(const uint32_t lit, const uint32_t at)
+{
+    return Watched(lit*100000 + at, Lit(0, false));
+}
+
+static void fill(watch_array& w, const uint32_t num_lits, const uint32_t seed)
+{
+    srand(seed);
+    w.resize(num_lits);
+    for(uint32_t i = 0; i < 20000; i++) {
+        const uint32_t lit = rand() % num_lits;
+        w.at(lit).push(make_watch(lit, w.at(lit).size()));
+    }
+}
+
+static void check(const watch_array& w)
+{
+    for(uint32_t lit = 0; lit < w.size(); lit++) {
+        const watch_list& ws = w.at(lit);
+        for(uint32_t i = 0; i < ws.size(); i++) {
+            EXPECT_EQ(ws[i].get_offset(), lit*100000 + i);
+        }
+    }
+}
+
+TEST(watch_pool_test, same_as_malloc)
+{
+    watch_array plain;
+    watch_array pooled;
+    pooled.enable_pool(HugePages::none);
+    fill(plain, 500, 1);
+    fill(pooled, 500, 1);
+
+    for(uint32_t lit = 0; lit < 500; lit++) {
+        EXPECT_EQ(plain.at(lit).size(), pooled.at(lit).size());
+    }
+    check(pooled);
+    EXPECT_GT(pooled.get_pool()->get_stats().relocations, 0U);
+}
+
+TEST(watch_pool_test, capacity_is_power_of_two)
+{
+    watch_array w;
+    w.enable_pool(HugePages::none);
+    w.resize(2);
+    for(uint32_t i = 0; i < 1000; i++) {
+        w.at(0).push(make_watch(0, i));
+        const uint32_t cap = w.at(0).capacity();
+        EXPECT_EQ(cap & (cap-1), 0U);
+        EXPECT_GE(cap, w.at(0).size());
+    }
+    check(w);
+}
+
+TEST(watch_pool_test, freed_blocks_are_reused)
+{
+    watch_array w;
+    w.enable_pool(HugePages::none);
+    w.resize(1000);
+    for(uint32_t lit = 0; lit < 1000; lit++) {
+        for(uint32_t i = 0; i < 30; i++) {
+            w.at(lit).push(make_watch(lit, i));
+        }
+    }
+    const uint64_t chunk_bytes = w.get_pool()->get_stats().chunk_bytes;
+    for(uint32_t lit = 0; lit < 1000; lit++) {
+        w.at(lit).clear(true);
+    }
+    EXPECT_EQ(w.get_pool()->get_stats().used_bytes, 0U);
+    for(uint32_t lit = 0; lit < 1000; lit++) {
+        for(uint32_t i = 0; i < 30; i++) {
+            w.at(lit).push(make_watch(lit, i));
+        }
+    }
+    EXPECT_EQ(w.get_pool()->get_stats().chunk_bytes, chunk_bytes);
+    check(w);
+}
+
+TEST(watch_pool_test, compaction_keeps_lists)
+{
+    watch_array w;
+    w.enable_pool(HugePages::none);
+    fill(w, 300, 2);
+    for(uint32_t lit = 0; lit < 300; lit += 2) {
+        w.at(lit).shrink(w.at(lit).size()/2);
+    }
+    w.full_consolidate();
+    EXPECT_EQ(w.get_pool()->get_stats().compactions, 1U);
+    check(w);
+
+    //Lists are in literal order in memory after compaction
+    const Watched* last = NULL;
+    for(uint32_t lit = 0; lit < 300; lit++) {
+        if (w.at(lit).empty()) {
+            continue;
+        }
+        if (last != NULL) {
+            EXPECT_GT(w.at(lit).begin(), last);
+        }
+        last = w.at(lit).begin();
+    }
+}
+
+TEST(watch_pool_test, large_list)
+{
+    watch_array w;
+    w.enable_pool(HugePages::none);
+    w.resize(2);
+    for(uint32_t i = 0; i < 100000; i++) {
+        w.at(1).push(make_watch(1, i));
+    }
+    EXPECT_GT(w.get_pool()->get_stats().large_bytes, 0U);
+    check(w);
+    w.full_consolidate();
+    check(w);
+    w.at(1).clear(true);
+    EXPECT_EQ(w.get_pool()->get_stats().large_bytes, 0U);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -31,9 +31,7 @@ THE SOFTWARE.
 using namespace CMSat;
 #include "test_helper.h"
 #include "src/toplevelgaussabst.h"
-#ifdef USE_M4RI
 #include "src/toplevelgauss.h"
-#endif
 
 struct xor_finder : public ::testing::Test {
     xor_finder()
@@ -146,6 +144,58 @@ TEST_F(xor_finder, find_4_4)
     check_xors_eq(finder.xors, "1, 2, 3, 4 = 1");
 }
 
+TEST_F(xor_finder, find_bucketed_no_budget)
+{
+    //Only the bucketed pass can find them
+    s->conf.xor_finder_time_limitM = 0;
+    s->add_clause_outer(str_to_cl("-1, 2, 3"));
+    s->add_clause_outer(str_to_cl("1, -2, 3"));
+    s->add_clause_outer(str_to_cl("1, 2, -3"));
+    s->add_clause_outer(str_to_cl("-1, -2, -3"));
+
+    s->add_clause_outer(str_to_cl("-4, -5, 6, 7"));
+    s->add_clause_outer(str_to_cl("4, -5, -6, 7"));
+    s->add_clause_outer(str_to_cl("4, 5, -6, -7"));
+    s->add_clause_outer(str_to_cl("-4, 5,  -6, 7"));
+    s->add_clause_outer(str_to_cl("-4, 5,  6, -7"));
+    s->add_clause_outer(str_to_cl("4, -5,  6, -7"));
+    s->add_clause_outer(str_to_cl("-4, -5, -6, -7"));
+    s->add_clause_outer(str_to_cl("4, 5, 6, 7"));
+
+    //Incomplete, same vars
+    s->add_clause_outer(str_to_cl("8, 9, 10"));
+    s->add_clause_outer(str_to_cl("-8, -9, 10"));
+    s->add_clause_outer(str_to_cl("-8, 9, -10"));
+
+    occsimp->setup();
+    XorFinder finder(occsimp, s);
+    finder.find_xors();
+    check_xors_eq(finder.xors, "1, 2, 3 = 0; 4, 5, 6, 7 = 1");
+    EXPECT_EQ(finder.get_stats().bucketXors, 2U);
+}
+
+TEST_F(xor_finder, find_bucketed_threads)
+{
+    s->conf.xor_find_threads = 4;
+    s->conf.xor_finder_time_limitM = 0;
+    for(uint32_t i = 0; i < 8; i++) {
+        const string a = std::to_string(i*3+1);
+        const string b = std::to_string(i*3+2);
+        const string c = std::to_string(i*3+3);
+        s->add_clause_outer(str_to_cl(a + ", " + b + ", " + c));
+        s->add_clause_outer(str_to_cl("-" + a + ", -" + b + ", " + c));
+        s->add_clause_outer(str_to_cl("-" + a + ", " + b + ", -" + c));
+        s->add_clause_outer(str_to_cl(a + ", -" + b + ", -" + c));
+    }
+
+    occsimp->setup();
+    XorFinder finder(occsimp, s);
+    finder.find_xors();
+    EXPECT_EQ(finder.xors.size(), 8U);
+    check_xors_contains(finder.xors, "1, 2, 3 = 1");
+    check_xors_contains(finder.xors, "22, 23, 24 = 1");
+}
+
 /*
  * These tests only work if the matching is non-exact
  * i.e. if size is not checked for equality
@@ -375,25 +425,19 @@ struct xor_finder2 : public ::testing::Test {
         occsimp = s->occsimplifier;
         finder = new XorFinder(occsimp, s);
         finder->grab_mem();
-        #ifdef USE_M4RI
         topLevelGauss = new TopLevelGauss(s);
-        #endif
     }
     ~xor_finder2()
     {
         delete s;
         delete finder;
-        #ifdef USE_M4RI
         delete topLevelGauss;
-        #endif
     }
     Solver* s = NULL;
     OccSimplifier* occsimp = NULL;
     std::atomic<bool> must_inter;
     XorFinder* finder;
-    #ifdef USE_M4RI
     TopLevelGaussAbst *topLevelGauss;
-    #endif
 };
 
 
@@ -566,7 +610,6 @@ TEST_F(xor_finder2, xor_unit)
     EXPECT_EQ(finder->xors.size(), 0u);
 }
 
-#ifdef USE_M4RI
 TEST_F(xor_finder2, xor_unit2_2)
 {
     s->add_clause_outer(str_to_cl("-4"));
@@ -575,7 +618,16 @@ TEST_F(xor_finder2, xor_unit2_2)
     bool ret = topLevelGauss->toplevelgauss(finder->xors, &out_changed_occur);
     EXPECT_FALSE(ret);
 }
-#endif
+
+TEST_F(xor_finder2, toplevel_sparse_bin)
+{
+    s->conf.doM4RI = false;
+    finder->xors = str_to_xors("1, 2, 3 = 0; 2, 3, 4 = 1;");
+    vector<Lit> out_changed_occur;
+    bool ret = topLevelGauss->toplevelgauss(finder->xors, &out_changed_occur);
+    EXPECT_TRUE(ret);
+    check_irred_cls_eq(s, "1, 4; -1, -4");
+}
 
 TEST_F(xor_finder2, xor_binx)
 {